@@ -25,10 +25,10 @@ struct Exposure
 };
 
 varying vec2 Texture;
+varying vec4 Color;
 
 uniform int         imageChannels;
 uniform int         colorMode;
-uniform vec4        color;
 uniform mat4        colorMatrix;
 uniform bool        colorMatrixEnabled;
 uniform bool        colorInvert;
@@ -130,39 +130,39 @@ void main()
 {
     if (COLOR_MODE_SOLID_COLOR == colorMode)
     {
-        gl_FragColor = color;
+        gl_FragColor = Color;
     }
     else if (COLOR_MODE_COLOR_WITH_TEXTURE_ALPHA == colorMode)
     {
         vec4 t = texture2D(textureSampler, Texture);
-        gl_FragColor.r = color.r;
-        gl_FragColor.g = color.g;
-        gl_FragColor.b = color.b;
-        gl_FragColor.a = color.a * t.r;
+        gl_FragColor.r = Color.r;
+        gl_FragColor.g = Color.g;
+        gl_FragColor.b = Color.b;
+        gl_FragColor.a = Color.a * t.r;
     }
     else if (COLOR_MODE_COLOR_WITH_TEXTURE_ALPHA_R == colorMode)
     {
         vec4 t = texture2D(textureSampler, Texture);
-        gl_FragColor.r = color.r;
+        gl_FragColor.r = Color.r;
         gl_FragColor.g = 0.0;
         gl_FragColor.b = 0.0;
-        gl_FragColor.a = color.a * t.r;
+        gl_FragColor.a = Color.a * t.r;
     }
     else if (COLOR_MODE_COLOR_WITH_TEXTURE_ALPHA_G == colorMode)
     {
         vec4 t = texture2D(textureSampler, Texture);
         gl_FragColor.r = 0.0;
-        gl_FragColor.g = color.g;
+        gl_FragColor.g = Color.g;
         gl_FragColor.b = 0.0;
-        gl_FragColor.a = color.a * t.g;
+        gl_FragColor.a = Color.a * t.g;
     }
     else if (COLOR_MODE_COLOR_WITH_TEXTURE_ALPHA_B == colorMode)
     {
         vec4 t = texture2D(textureSampler, Texture);
         gl_FragColor.r = 0.0;
         gl_FragColor.g = 0.0;
-        gl_FragColor.b = color.b;
-        gl_FragColor.a = color.a * t.b;
+        gl_FragColor.b = Color.b;
+        gl_FragColor.a = Color.a * t.b;
     }
     else if (COLOR_MODE_COLOR_AND_TEXTURE == colorMode)
     {
@@ -232,10 +232,10 @@ void main()
 			t.b = t.a;
 		}
 		
-        gl_FragColor = color * t;
+        gl_FragColor = Color * t;
     }
     else if (COLOR_MODE_SHADOW == colorMode)
     {
-        gl_FragColor = color * Texture.x;
+        gl_FragColor = Color * Texture.x;
     }
 }
@@ -6,8 +6,10 @@
 
 attribute vec3 aPos;
 attribute vec2 aTexture;
+attribute vec4 aColor;
 
 varying vec2 Texture;
+varying vec4 Color;
 
 uniform struct Transform
 {
@@ -18,4 +20,5 @@ void main()
 {
     gl_Position = transform.mvp * vec4(aPos, 1.0);
     Texture = aTexture;
+    Color = aColor;
 }
@@ -4,8 +4,8 @@
 
 #version 410
 
-in vec3 aPos;
-in vec2 aTexture;
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec2 aTexture;
 
 out vec2 Texture;
 
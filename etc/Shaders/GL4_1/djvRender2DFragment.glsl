@@ -23,11 +23,11 @@ struct Exposure
 };
 
 in vec2 Texture;
+in vec4 Color;
 out vec4 FragColor;
 
 uniform int         imageChannels       = 0;
 uniform int         colorMode           = 0;
-uniform vec4        color;
 uniform int         colorSpace          = 0;
 uniform sampler3D   colorSpaceSampler;
 uniform mat4        colorMatrix;
@@ -133,39 +133,39 @@ void main()
 {
     if (COLOR_MODE_SOLID_COLOR == colorMode)
     {
-        FragColor = color;
+        FragColor = Color;
     }
     else if (COLOR_MODE_COLOR_WITH_TEXTURE_ALPHA == colorMode)
     {
         vec4 t = texture(textureSampler, Texture);
-        FragColor.r = color.r;
-        FragColor.g = color.g;
-        FragColor.b = color.b;
-        FragColor.a = color.a * t.r;
+        FragColor.r = Color.r;
+        FragColor.g = Color.g;
+        FragColor.b = Color.b;
+        FragColor.a = Color.a * t.r;
     }
     else if (COLOR_MODE_COLOR_WITH_TEXTURE_ALPHA_R == colorMode)
     {
         vec4 t = texture(textureSampler, Texture);
-        FragColor.r = color.r;
+        FragColor.r = Color.r;
         FragColor.g = 0.0;
         FragColor.b = 0.0;
-        FragColor.a = color.a * t.r;
+        FragColor.a = Color.a * t.r;
     }
     else if (COLOR_MODE_COLOR_WITH_TEXTURE_ALPHA_G == colorMode)
     {
         vec4 t = texture(textureSampler, Texture);
         FragColor.r = 0.0;
-        FragColor.g = color.g;
+        FragColor.g = Color.g;
         FragColor.b = 0.0;
-        FragColor.a = color.a * t.g;
+        FragColor.a = Color.a * t.g;
     }
     else if (COLOR_MODE_COLOR_WITH_TEXTURE_ALPHA_B == colorMode)
     {
         vec4 t = texture(textureSampler, Texture);
         FragColor.r = 0.0;
         FragColor.g = 0.0;
-        FragColor.b = color.b;
-        FragColor.a = color.a * t.b;
+        FragColor.b = Color.b;
+        FragColor.a = Color.a * t.b;
     }
     else if (COLOR_MODE_COLOR_AND_TEXTURE == colorMode)
     {
@@ -238,10 +238,10 @@ void main()
             t.b = t.a;
         }
 
-        FragColor = t * color;
+        FragColor = t * Color;
     }
     else if (COLOR_MODE_SHADOW == colorMode)
     {
-        FragColor = color * Texture.x;
+        FragColor = Color * Texture.x;
     }
 }
@@ -4,9 +4,11 @@
 
 #version 410
 
-in vec3 aPos;
-in vec2 aTexture;
-in vec3 aNormal;
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec2 aTexture;
+layout(location = 2) in vec3 aNormal;
+layout(location = 4) in mat4 aInstanceM;
+layout(location = 8) in mat4 aInstanceNormals;
 
 layout(location = 0) out vec3 Position;
 layout(location = 1) out vec2 Texture;
@@ -14,15 +16,14 @@ layout(location = 2) out vec3 Normal;
 
 uniform struct Transform
 {
-    mat4 m;
-    mat4 mvp;
-    mat3 normals;
+    mat4 vp;
 } transform;
 
 void main()
 {
-    gl_Position = transform.mvp * vec4(aPos, 1.0);
-    Position = vec3(transform.m * vec4(aPos, 1.0));
+    vec4 p = aInstanceM * vec4(aPos, 1.0);
+    gl_Position = transform.vp * p;
+    Position = vec3(p);
     Texture = aTexture;
-    Normal = vec3(transform.normals * aNormal);
+    Normal = mat3(aInstanceNormals) * aNormal;
 }
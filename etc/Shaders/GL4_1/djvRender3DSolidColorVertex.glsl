@@ -4,18 +4,19 @@
 
 #version 410
 
-in vec3 aPos;
+layout(location = 0) in vec3 aPos;
+layout(location = 4) in mat4 aInstanceM;
 
 layout(location = 0) out vec3 Position;
 
 uniform struct Transform
 {
-    mat4 m;
-    mat4 mvp;
+    mat4 vp;
 } transform;
 
 void main()
 {
-    gl_Position = transform.mvp * vec4(aPos, 1.0);
-    Position = vec3(transform.m * vec4(aPos, 1.0));
+    vec4 p = aInstanceM * vec4(aPos, 1.0);
+    gl_Position = transform.vp * p;
+    Position = vec3(p);
 }
@@ -5,12 +5,17 @@
 
 #include <djvAV/IFF.h>
 
+#include <djvImage/Parallel.h>
+
 #include <djvSystem/File.h>
 #include <djvSystem/FileIO.h>
 #include <djvSystem/TextSystem.h>
 
 #include <djvCore/StringFormat.h>
 
+#include <algorithm>
+#include <atomic>
+
 using namespace djv::Core;
 
 namespace djv
@@ -34,37 +39,109 @@ namespace djv
                         return size;
                     }
 
-                    size_t readRle(const std::shared_ptr<System::File::IO>& io, uint8_t* out, size_t size)
+                    const uint8_t* readRle(const uint8_t* in, const uint8_t* inEnd, uint8_t* out, size_t size)
                     {
-                        const size_t pos = io->getPos();
                         const uint8_t* const end = out + size;
                         while (out < end)
                         {
                             // Information.
-                            uint8_t in = 0;
-                            io->readU8(&in);
-                            const uint8_t count = (in & 0x7f) + 1;
-                            const bool run = (in & 0x80) ? true : false;
+                            if (in >= inEnd)
+                            {
+                                return nullptr;
+                            }
+                            const uint8_t count = (*in & 0x7f) + 1;
+                            const bool run = (*in & 0x80) ? true : false;
+                            ++in;
+                            const size_t length = std::min(static_cast<size_t>(count), static_cast<size_t>(end - out));
 
                             // Find runs.
                             if (!run)
                             {
                                 // Verbatim.
-                                io->readU8(out, count);
-                                out += count;
+                                if (in + count > inEnd)
+                                {
+                                    return nullptr;
+                                }
+                                memcpy(out, in, length);
+                                in += count;
                             }
                             else
                             {
                                 // Duplicate.
-                                io->readU8(&in);
-                                const uint8_t p = in;
-                                for (int i = 0; i < count; i++)
+                                if (in >= inEnd)
+                                {
+                                    return nullptr;
+                                }
+                                memset(out, *in, length);
+                                ++in;
+                            }
+                            out += length;
+                        }
+                        return in;
+                    }
+
+                    //! This struct provides a compressed tile.
+                    struct Tile
+                    {
+                        uint16_t xmin = 0;
+                        uint16_t ymin = 0;
+                        uint16_t xmax = 0;
+                        uint16_t ymax = 0;
+                        std::vector<uint8_t> data;
+                    };
+
+                    //! Get the byte offsets of the compressed channels in a pixel.
+                    //! The channels are stored in reverse order, and 16-bit
+                    //! channels are stored as separate high and low byte planes.
+                    const int* getChannelMap(Image::Type type)
+                    {
+                        static const int u8[] = { 0, 1, 2, 3 };
+                        static const int rgb16LSB[] = { 0, 2, 4, 1, 3, 5 };
+                        static const int rgba16LSB[] = { 0, 2, 4, 7, 1, 3, 5, 6 };
+                        static const int rgb16MSB[] = { 1, 3, 5, 0, 2, 4 };
+                        static const int rgba16MSB[] = { 1, 3, 5, 7, 0, 2, 4, 6 };
+                        const int* out = nullptr;
+                        const bool lsb = Memory::getEndian() == Memory::Endian::LSB;
+                        switch (type)
+                        {
+                        case Image::Type::RGB_U8:
+                        case Image::Type::RGBA_U8: out = u8; break;
+                        case Image::Type::RGB_U16: out = lsb ? rgb16LSB : rgb16MSB; break;
+                        case Image::Type::RGBA_U16: out = lsb ? rgba16LSB : rgba16MSB; break;
+                        default: break;
+                        }
+                        return out;
+                    }
+
+                    //! Decompress a tile into the image. Returns false if the
+                    //! compressed data does not match the tile size.
+                    bool readTile(const Tile& tile, const int* channelMap, Image::Data* out)
+                    {
+                        const size_t byteCount = Image::getByteCount(out->getType());
+                        const size_t tw = static_cast<size_t>(tile.xmax) - tile.xmin + 1;
+                        const size_t th = static_cast<size_t>(tile.ymax) - tile.ymin + 1;
+                        std::vector<uint8_t> plane(tw * th);
+                        const uint8_t* p = tile.data.data();
+                        const uint8_t* const end = p + tile.data.size();
+                        for (int c = static_cast<int>(byteCount) - 1; c >= 0; --c)
+                        {
+                            p = readRle(p, end, plane.data(), plane.size());
+                            if (!p)
+                            {
+                                return false;
+                            }
+                            const uint8_t* inP = plane.data();
+                            const size_t mc = channelMap[c];
+                            for (uint16_t py = tile.ymin; py <= tile.ymax; ++py)
+                            {
+                                uint8_t* outP = out->getData(tile.xmin, py) + mc;
+                                for (size_t px = 0; px < tw; ++px, ++inP, outP += byteCount)
                                 {
-                                    *out++ = p;
+                                    *outP = *inP;
                                 }
                             }
                         }
-                        return io->getPos() - pos;
+                        return p == end;
                     }
 
                 } // namespace
@@ -112,6 +189,10 @@ namespace djv
                     const size_t channelByteCount = Image::getByteCount(Image::getDataType(info.video[0].type));
                     const size_t byteCount = Image::getByteCount(info.video[0].type);
 
+                    // Compressed tiles are read first and then decompressed in
+                    // parallel.
+                    std::vector<Tile> tiles;
+
                     // Read FOR4 <size> TBMP block
                     while (!io->isEOF())
                     {
@@ -238,38 +319,20 @@ namespace djv
                                             // Tile compress.
                                             if (tile_compress)
                                             {
-                                                int p = 0;
-
-                                                // Map: RGB(A)8 BGRA to RGBA
-                                                for (int c = (channels * channelByteCount) - 1;
-                                                    c >= 0;
-                                                    --c)
-                                                {
-                                                    std::vector<uint8_t> in(static_cast<size_t>(tw) * static_cast<size_t>(th));
-                                                    uint8_t* inP = in.data();
-
-                                                    // Uncompress.
-                                                    p += readRle(io, in.data(), static_cast<size_t>(tw) * static_cast<size_t>(th));
-
-                                                    for (uint16_t py = ymin; py <= ymax; py++)
-                                                    {
-                                                        uint8_t* out_dy = out->getData(0, py);
-
-                                                        for (uint16_t px = xmin; px <= xmax; px++)
-                                                        {
-                                                            uint8_t* outP = out_dy + px * byteCount + c;
-                                                            *outP++ = *inP++;
-                                                        }
-                                                    }
-                                                }
-
-                                                // Test.
-                                                if (p != imageSize - 8)
+                                                if (imageSize < 8)
                                                 {
                                                     throw System::File::Error(String::Format("{0}: {1}").
                                                         arg(fileName).
                                                         arg(_textSystem->getText(DJV_TEXT("error_file_not_supported"))));
                                                 }
+                                                Tile tile;
+                                                tile.xmin = xmin;
+                                                tile.ymin = ymin;
+                                                tile.xmax = xmax;
+                                                tile.ymax = ymax;
+                                                tile.data.resize(imageSize - 8);
+                                                io->read(tile.data.data(), tile.data.size());
+                                                tiles.push_back(std::move(tile));
                                             }
                                             else
                                             {
@@ -318,71 +381,20 @@ namespace djv
                                         {
                                             if (tile_compress)
                                             {
-                                                // Set bytes.
-                                                int p = 0;
-
-                                                // Set map.
-                                                int* map = NULL;
-
-                                                if (Memory::getEndian() == Memory::Endian::LSB)
-                                                {
-                                                    int rgb16[] = { 0, 2, 4, 1, 3, 5 };
-                                                    int rgba16[] = { 0, 2, 4, 7, 1, 3, 5, 6 };
-
-                                                    if (info.video[0].type == Image::Type::RGB_U16)
-                                                    {
-                                                        map = rgb16;
-                                                    }
-                                                    else
-                                                    {
-                                                        map = rgba16;
-                                                    }
-                                                }
-                                                else
-                                                {
-                                                    int rgb16[] = { 1, 3, 5, 0, 2, 4 };
-                                                    int rgba16[] = { 1, 3, 5, 7, 0, 2, 4, 6 };
-
-                                                    if (info.video[0].type == Image::Type::RGB_U16)
-                                                    {
-                                                        map = rgb16;
-                                                    }
-                                                    else
-                                                    {
-                                                        map = rgba16;
-                                                    }
-                                                }
-
-                                                // Map: RGB(A)8 BGRA to RGBA
-                                                for (int c = (channels * channelByteCount) - 1; c >= 0; --c)
-                                                {
-                                                    int mc = map[c];
-
-                                                    std::vector<uint8_t> in(static_cast<size_t>(tw) * static_cast<size_t>(th));
-                                                    uint8_t* inP = in.data();
-
-                                                    // Uncompress.
-                                                    p += readRle(io, in.data(), static_cast<size_t>(tw) * static_cast<size_t>(th));
-
-                                                    for (uint16_t py = ymin; py <= ymax; py++)
-                                                    {
-                                                        uint8_t* out_dy = out->getData(0, py);
-
-                                                        for (uint16_t px = xmin; px <= xmax; px++)
-                                                        {
-                                                            uint8_t* outP = out_dy + px * byteCount + mc;
-                                                            *outP++ = *inP++;
-                                                        }
-                                                    }
-                                                }
-
-                                                // Test.
-                                                if (p != imageSize - 8)
+                                                if (imageSize < 8)
                                                 {
                                                     throw System::File::Error(String::Format("{0}: {1}").
                                                         arg(fileName).
                                                         arg(_textSystem->getText(DJV_TEXT("error_file_not_supported"))));
                                                 }
+                                                Tile tile;
+                                                tile.xmin = xmin;
+                                                tile.ymin = ymin;
+                                                tile.xmax = xmax;
+                                                tile.ymax = ymax;
+                                                tile.data.resize(imageSize - 8);
+                                                io->read(tile.data.data(), tile.data.size());
+                                                tiles.push_back(std::move(tile));
                                             }
                                             else
                                             {
@@ -477,6 +489,49 @@ namespace djv
                         }
                     }
 
+                    // Decompress the tiles in parallel, a row of tiles at a time.
+                    if (!tiles.empty())
+                    {
+                        const int* channelMap = getChannelMap(info.video[0].type);
+                        std::stable_sort(
+                            tiles.begin(),
+                            tiles.end(),
+                            [](const Tile& a, const Tile& b)
+                            {
+                                return a.ymin < b.ymin;
+                            });
+                        std::vector<size_t> tileRows;
+                        for (size_t i = 0; i < tiles.size(); ++i)
+                        {
+                            if (0 == i || tiles[i].ymin != tiles[i - 1].ymin)
+                            {
+                                tileRows.push_back(i);
+                            }
+                        }
+                        tileRows.push_back(tiles.size());
+                        Image::Data* outP = out.get();
+                        std::atomic<bool> error(false);
+                        Image::parallelScanlines(
+                            static_cast<uint16_t>(tileRows.size() - 1),
+                            out->getDataByteCount(),
+                            [&tiles, &tileRows, channelMap, outP, &error](uint16_t begin, uint16_t end)
+                            {
+                                for (size_t i = tileRows[begin]; i < tileRows[end] && !error; ++i)
+                                {
+                                    if (!readTile(tiles[i], channelMap, outP))
+                                    {
+                                        error = true;
+                                    }
+                                }
+                            });
+                        if (error)
+                        {
+                            throw System::File::Error(String::Format("{0}: {1}").
+                                arg(fileName).
+                                arg(_textSystem->getText(DJV_TEXT("error_file_not_supported"))));
+                        }
+                    }
+
                     return out;
                 }
 
@@ -6,6 +6,9 @@
 
 #include <djvAV/SpeedFunc.h>
 
+#include <algorithm>
+#include <cstdlib>
+
 using namespace djv::Core;
 
 namespace djv
@@ -34,9 +37,14 @@ namespace djv
                 _max = value;
             }
 
+            std::vector<VideoFrame> VideoQueue::getFrames() const
+            {
+                return std::vector<VideoFrame>(_queue.begin(), _queue.end());
+            }
+
             void VideoQueue::addFrame(const VideoFrame& value)
             {
-                _queue.push(value);
+                _queue.push_back(value);
             }
 
             VideoFrame VideoQueue::popFrame()
@@ -45,17 +53,14 @@ namespace djv
                 if (_queue.size())
                 {
                     out = _queue.front();
-                    _queue.pop();
+                    _queue.pop_front();
                 }
                 return out;
             }
 
             void VideoQueue::clearFrames()
             {
-                while (_queue.size())
-                {
-                    _queue.pop();
-                }
+                _queue.clear();
             }
 
             void VideoQueue::setFinished(bool value)
@@ -127,39 +132,28 @@ namespace djv
                 _cacheUpdate();
             }
 
-            Math::Frame::Sequence Cache::getFrames() const
+            void Cache::setMaxByteCount(size_t value)
+            {
+                if (value == _maxByteCount)
+                    return;
+                _maxByteCount = value;
+                _layerUpdate();
+            }
+
+            void Cache::setLayer(size_t value)
             {
-                Math::Frame::Sequence out;
-                std::vector<Math::Frame::Index> frames;
+                if (value == _layer)
+                    return;
+                _layer = value;
+                _frames = Math::Frame::Sequence();
                 for (const auto& i : _cache)
                 {
-                    frames.push_back(i.first);
-                }
-                const size_t size = frames.size();
-                if (size)
-                {
-                    std::sort(frames.begin(), frames.end());
-                    Math::Frame::Number rangeStart = frames[0];
-                    Math::Frame::Number prevFrame = frames[0];
-                    size_t i = 1;
-                    for (; i < size; prevFrame = frames[i], ++i)
-                    {
-                        if (frames[i] != prevFrame + 1)
-                        {
-                            out.add(Math::Frame::Range(rangeStart, prevFrame));
-                            rangeStart = frames[i];
-                        }
-                    }
-                    if (size > 1)
+                    if (i.second.find(_layer) != i.second.end())
                     {
-                        out.add(Math::Frame::Range(rangeStart, prevFrame));
-                    }
-                    else
-                    {
-                        out.add(Math::Frame::Range(rangeStart));
+                        _frames.add(Math::Frame::Range(i.first));
                     }
                 }
-                return out;
+                _layerUpdate();
             }
 
             void Cache::setSequenceSize(size_t value)
@@ -194,13 +188,25 @@ namespace djv
                 _cacheUpdate();
             }
 
-            void Cache::add(Math::Frame::Index index, const std::shared_ptr<Image::Data>& image)
+            void Cache::add(Math::Frame::Index index, size_t layer, const std::shared_ptr<Image::Data>& image)
             {
-                _cache[index] = image;
-                _cacheUpdate();
+                // Adding an image does not change the frames to be cached, so
+                // the sequence is only computed the first time.
+                if (!_sequence.isValid())
+                {
+                    _sequenceUpdate();
+                }
+                if (!_sequence.contains(index))
+                    return;
+                _cache[index][layer] = image;
+                if (layer == _layer)
+                {
+                    _frames.add(Math::Frame::Range(index));
+                }
+                _layerUpdate();
             }
 
-            void Cache::_cacheUpdate()
+            void Cache::_sequenceUpdate()
             {
                 const auto range = _inOutPoints.getRange(_sequenceSize);
                 Math::Frame::Index frame = _currentFrame;
@@ -277,6 +283,11 @@ namespace djv
                 }
                 default: break;
                 }
+            }
+
+            void Cache::_cacheUpdate()
+            {
+                _sequenceUpdate();
                 auto i = _cache.begin();
                 while (i != _cache.end())
                 {
@@ -284,9 +295,54 @@ namespace djv
                     ++i;
                     if (!_sequence.contains(j->first))
                     {
+                        if (j->second.find(_layer) != j->second.end())
+                        {
+                            _frames.remove(Math::Frame::Range(j->first));
+                        }
                         _cache.erase(j);
                     }
                 }
+                _layerUpdate();
+            }
+
+            void Cache::_layerUpdate()
+            {
+                // Remove images from the other layers until the cache fits in the
+                // maximum byte count, starting with the frames furthest from the
+                // current frame.
+                if (!_maxByteCount)
+                    return;
+                size_t byteCount = getTotalByteCount();
+                if (byteCount <= _maxByteCount)
+                    return;
+                std::vector<std::pair<Math::Frame::Index, Math::Frame::Index> > frames;
+                for (const auto& i : _cache)
+                {
+                    frames.push_back(std::make_pair(std::abs(i.first - _currentFrame), i.first));
+                }
+                std::sort(frames.begin(), frames.end());
+                for (auto i = frames.rbegin(); i != frames.rend() && byteCount > _maxByteCount; ++i)
+                {
+                    auto& layers = _cache[i->second];
+                    auto j = layers.begin();
+                    while (j != layers.end() && byteCount > _maxByteCount)
+                    {
+                        auto k = j;
+                        ++j;
+                        if (k->first != _layer)
+                        {
+                            if (k->second)
+                            {
+                                byteCount -= k->second->getDataByteCount();
+                            }
+                            layers.erase(k);
+                        }
+                    }
+                    if (layers.empty())
+                    {
+                        _cache.erase(i->second);
+                    }
+                }
             }
 
         } // namespace IO
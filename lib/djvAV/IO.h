@@ -11,6 +11,7 @@
 #include <djvMath/FrameNumber.h>
 #include <djvMath/Rational.h>
 
+#include <deque>
 #include <future>
 #include <queue>
 #include <set>
@@ -76,6 +77,10 @@ namespace djv
                 size_t getCount() const;
                 VideoFrame getFrame() const;
 
+                //! Get all of the frames in the queue, starting with the next
+                //! frame.
+                std::vector<VideoFrame> getFrames() const;
+
                 void addFrame(const VideoFrame&);
                 VideoFrame popFrame();
                 void clearFrames();
@@ -93,7 +98,7 @@ namespace djv
 
             private:
                 size_t _max = 0;
-                std::queue<VideoFrame> _queue;
+                std::deque<VideoFrame> _queue;
                 bool _finished = false;
             };
 
@@ -192,7 +197,10 @@ namespace djv
                 Reverse
             };
 
-            //! This class provides a frame cache.
+            //! This class provides a frame cache. Images are keyed by frame and
+            //! layer so that multi-layer files can switch layers without being
+            //! re-read. The frame window is computed for the current layer, other
+            //! layers are kept while they fit in the maximum byte count.
             class Cache
             {
             public:
@@ -204,15 +212,29 @@ namespace djv
                 size_t getMax() const;
                 size_t getCount() const;
                 size_t getTotalByteCount() const;
+                size_t getLayerByteCount(size_t layer) const;
+                size_t getMaxByteCount() const;
 
                 void setMax(size_t);
+                void setMaxByteCount(size_t);
+
+                ///@}
+
+                //! \name Layers
+                ///@{
+
+                size_t getLayer() const;
+
+                void setLayer(size_t);
 
                 ///@}
 
                 //! \name Frames
                 ///@{
 
-                Math::Frame::Sequence getFrames() const;
+                //! Get the frames in the cache for the current layer. The frames
+                //! are updated as images are added and removed.
+                const Math::Frame::Sequence& getFrames() const;
                 size_t getReadBehind() const;
                 const Math::Frame::Sequence& getSequence() const;
 
@@ -222,17 +244,24 @@ namespace djv
                 void setCurrentFrame(Math::Frame::Index);
 
                 bool contains(Math::Frame::Index) const;
+                bool contains(Math::Frame::Index, size_t layer) const;
                 bool get(Math::Frame::Index, std::shared_ptr<Image::Data>&) const;
+                bool get(Math::Frame::Index, size_t layer, std::shared_ptr<Image::Data>&) const;
 
                 void add(Math::Frame::Index, const std::shared_ptr<Image::Data>&);
+                void add(Math::Frame::Index, size_t layer, const std::shared_ptr<Image::Data>&);
                 void clear();
 
                 ///@}
 
             private:
+                void _sequenceUpdate();
                 void _cacheUpdate();
+                void _layerUpdate();
 
                 size_t _max = 0;
+                size_t _maxByteCount = 0;
+                size_t _layer = 0;
                 size_t _sequenceSize = 0;
                 InOutPoints _inOutPoints;
                 Direction _direction = Direction::Forward;
@@ -240,7 +269,8 @@ namespace djv
                 //! \todo Should this be configurable?
                 size_t _readBehind = 10;
                 Math::Frame::Sequence _sequence;
-                std::map<Math::Frame::Index, std::shared_ptr<Image::Data> > _cache;
+                Math::Frame::Sequence _frames;
+                std::map<Math::Frame::Index, std::map<size_t, std::shared_ptr<Image::Data> > > _cache;
             };
 
         } // namespace IO
@@ -127,7 +127,15 @@ namespace djv
             
             inline size_t Cache::getCount() const
             {
-                return _cache.size();
+                size_t out = 0;
+                for (const auto& i : _cache)
+                {
+                    if (i.second.find(_layer) != i.second.end())
+                    {
+                        ++out;
+                    }
+                }
+                return out;
             }
 
             inline size_t Cache::getTotalByteCount() const
@@ -135,14 +143,41 @@ namespace djv
                 size_t out = 0;
                 for (const auto& i : _cache)
                 {
-                    if (i.second)
+                    for (const auto& j : i.second)
                     {
-                        out += i.second->getDataByteCount();
+                        if (j.second)
+                        {
+                            out += j.second->getDataByteCount();
+                        }
                     }
                 }
                 return out;
             }
 
+            inline size_t Cache::getLayerByteCount(size_t layer) const
+            {
+                size_t out = 0;
+                for (const auto& i : _cache)
+                {
+                    const auto j = i.second.find(layer);
+                    if (j != i.second.end() && j->second)
+                    {
+                        out += j->second->getDataByteCount();
+                    }
+                }
+                return out;
+            }
+
+            inline size_t Cache::getMaxByteCount() const
+            {
+                return _maxByteCount;
+            }
+
+            inline size_t Cache::getLayer() const
+            {
+                return _layer;
+            }
+
             inline size_t Cache::getReadBehind() const
             {
                 return _readBehind;
@@ -155,23 +190,50 @@ namespace djv
 
             inline bool Cache::contains(Math::Frame::Index value) const
             {
-                return _cache.find(value) != _cache.end();
+                return contains(value, _layer);
+            }
+
+            inline bool Cache::contains(Math::Frame::Index value, size_t layer) const
+            {
+                const auto i = _cache.find(value);
+                return i != _cache.end() && i->second.find(layer) != i->second.end();
             }
 
             inline bool Cache::get(Math::Frame::Index index, std::shared_ptr<Image::Data>& out) const
             {
+                return get(index, _layer, out);
+            }
+
+            inline bool Cache::get(Math::Frame::Index index, size_t layer, std::shared_ptr<Image::Data>& out) const
+            {
+                bool found = false;
                 const auto i = _cache.find(index);
-                const bool found = i != _cache.end();
-                if (found)
+                if (i != _cache.end())
                 {
-                    out = i->second;
+                    const auto j = i->second.find(layer);
+                    found = j != i->second.end();
+                    if (found)
+                    {
+                        out = j->second;
+                    }
                 }
                 return found;
             }
 
+            inline void Cache::add(Math::Frame::Index index, const std::shared_ptr<Image::Data>& image)
+            {
+                add(index, _layer, image);
+            }
+
+            inline const Math::Frame::Sequence& Cache::getFrames() const
+            {
+                return _frames;
+            }
+
             inline void Cache::clear()
             {
                 _cache.clear();
+                _frames = Math::Frame::Sequence();
             }
 
         } // namespace IO
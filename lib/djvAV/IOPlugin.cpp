@@ -53,6 +53,7 @@ namespace djv
             {
                 IIO::_init(fileInfo, options, textSystem, resourceSystem, logSystem);
                 _options = options;
+                _layer = options.layer;
             }
 
             IRead::~IRead()
@@ -106,6 +107,18 @@ namespace djv
                 _cacheMaxByteCount = value;
             }
 
+            size_t IRead::getLayer() const
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return _layer;
+            }
+
+            void IRead::setLayer(size_t value)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _layer = value;
+            }
+
             void IWrite::_init(
                 const System::File::Info& fileInfo,
                 const Info& info,
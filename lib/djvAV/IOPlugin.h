@@ -75,7 +75,7 @@ namespace djv
                 std::shared_ptr<System::ResourceSystem> _resourceSystem;
                 std::shared_ptr<System::TextSystem> _textSystem;
                 System::File::Info _fileInfo;
-                std::mutex _mutex;
+                mutable std::mutex _mutex;
                 VideoQueue _videoQueue;
                 AudioQueue _audioQueue;
                 size_t _threadCount = 4;
@@ -139,8 +139,20 @@ namespace djv
 
                 ///@}
 
+                //! \name Layers
+                ///@{
+
+                //! Get whether the layer can be changed without re-opening the file.
+                virtual bool canSetLayer() const;
+                size_t getLayer() const;
+
+                void setLayer(size_t);
+
+                ///@}
+
             protected:
                 ReadOptions _options;
+                size_t _layer = 0;
                 InOutPoints _inOutPoints;
                 Direction _direction = Direction::Forward;
                 bool _playback = false;
@@ -157,6 +169,11 @@ namespace djv
             struct WriteOptions : IOOptions
             {
                 std::string colorSpace;
+
+                //! The color space of the images being written. If this and
+                //! the color space above are set the images are converted on
+                //! the CPU before they are written.
+                std::string inputColorSpace;
             };
 
             //! This class provides the interface for writing.
@@ -33,6 +33,11 @@ namespace djv
                 return false;
             }
 
+            inline bool IRead::canSetLayer() const
+            {
+                return false;
+            }
+
             inline bool IRead::isCacheEnabled() const
             {
                 return _cacheEnabled;
@@ -30,10 +30,15 @@
 
 #include <djvGL/GLFWSystem.h>
 
+#include <djvImage/DataPool.h>
+
 #include <djvSystem/Context.h>
 #include <djvSystem/File.h>
 #include <djvSystem/TextSystem.h>
+#include <djvSystem/Timer.h>
+#include <djvSystem/TimerFunc.h>
 
+#include <djvCore/MemoryFunc.h>
 #include <djvCore/StringFormat.h>
 #include <djvCore/StringFunc.h>
 
@@ -52,6 +57,7 @@ namespace djv
                 std::map<std::string, std::shared_ptr<IPlugin> > plugins;
                 std::set<std::string> sequenceExtensions;
                 std::set<std::string> nonSequenceExtensions;
+                std::shared_ptr<System::Timer> statsTimer;
             };
 
             void IOSystem::_init(const std::shared_ptr<System::Context>& context)
@@ -108,6 +114,23 @@ namespace djv
                     ss << "    File extensions: " << String::joinSet(i.second->getFileExtensions(), ", ") << '\n';
                     _log(ss.str());
                 }
+
+                p.statsTimer = System::Timer::create(context);
+                p.statsTimer->setRepeating(true);
+                p.statsTimer->start(
+                    System::getTimerDuration(System::TimerValue::VerySlow),
+                    [this](const std::chrono::steady_clock::time_point&, const Time::Duration&)
+                {
+                    const auto stats = Image::DataPool::getGlobal()->getStats();
+                    std::stringstream ss;
+                    ss << "Image data pool allocations: " << stats.allocCount << '\n';
+                    ss << "Image data pool reuses: " << stats.reuseCount << '\n';
+                    ss << "Image data pool releases: " << stats.releaseCount << '\n';
+                    ss << "Image data pool huge pages: " << stats.hugePageCount << '\n';
+                    ss << "Image data pool used: " << stats.usedCount << ", " << Memory::getSizeLabel(stats.usedByteCount) << '\n';
+                    ss << "Image data pool free: " << stats.freeCount << ", " << Memory::getSizeLabel(stats.freeByteCount);
+                    _log(ss.str());
+                });
             }
 
             IOSystem::IOSystem() :
@@ -139,6 +139,9 @@ namespace djv
                 protected:
                     Info _readInfo(const std::string& fileName) override;
                     std::shared_ptr<Image::Data> _readImage(const std::string& fileName) override;
+                    std::map<size_t, std::shared_ptr<Image::Data> > _readImages(
+                        const std::string& fileName,
+                        const std::vector<size_t>& layers) override;
 
                 private:
                     struct File;
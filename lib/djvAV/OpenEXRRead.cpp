@@ -140,75 +140,120 @@ namespace djv
 
                 std::shared_ptr<Image::Data> Read::_readImage(const std::string& fileName)
                 {
+                    const auto images = _readImages(fileName, { _options.layer });
+                    return images.size() ? images.begin()->second : nullptr;
+                }
+
+                std::map<size_t, std::shared_ptr<Image::Data> > Read::_readImages(
+                    const std::string& fileName,
+                    const std::vector<size_t>& layers)
+                {
+                    std::map<size_t, std::shared_ptr<Image::Data> > out;
                     File f;
                     Info info = _open(fileName, f);
-                    Image::Info imageInfo = info.video[std::min(_options.layer, info.video.size() - 1)];
-                    std::shared_ptr<Image::Data> out = Image::Data::create(imageInfo);
-                    out->setPluginName(pluginName);
-                    out->setTags(info.tags);
-                    const size_t channels = Image::getChannelCount(imageInfo.type);
-                    const size_t channelByteCount = Image::getByteCount(getDataType(imageInfo.type));
-                    const size_t cb = channels * channelByteCount;
-                    const size_t scb = imageInfo.size.w * channels * channelByteCount;
-                    if (f.fast)
+                    if (info.video.empty())
                     {
-                        Imf::FrameBuffer frameBuffer;
-                        for (size_t c = 0; c < channels; ++c)
+                        return out;
+                    }
+
+                    // Add the channels for all of the layers to a single frame
+                    // buffer so the file is only decoded once.
+                    struct LayerData
+                    {
+                        size_t layer = 0;
+                        std::shared_ptr<Image::Data> image;
+                        size_t cb = 0;
+                        size_t scb = 0;
+                        std::vector<char> buf;
+                    };
+                    std::vector<LayerData> layerData;
+                    for (const auto i : layers)
+                    {
+                        const size_t layer = std::min(i, info.video.size() - 1);
+                        if (out.find(layer) == out.end())
                         {
-                            const std::string& name = f.layers[_options.layer].channels[c].name;
-                            const glm::ivec2& sampling = f.layers[_options.layer].channels[c].sampling;
-                            frameBuffer.insert(
-                                name.c_str(),
-                                Imf::Slice(
-                                    toImf(Image::getDataType(imageInfo.type)),
-                                    (char*)out->getData() + (c * channelByteCount),
-                                    cb,
-                                    scb,
-                                    sampling.x,
-                                    sampling.y,
-                                    0.F));
+                            const Image::Info& imageInfo = info.video[layer];
+                            auto image = Image::Data::create(imageInfo);
+                            image->setPluginName(pluginName);
+                            image->setTags(info.tags);
+                            out[layer] = image;
+                            LayerData data;
+                            data.layer = layer;
+                            data.image = image;
+                            const size_t channels = Image::getChannelCount(imageInfo.type);
+                            data.cb = channels * Image::getByteCount(getDataType(imageInfo.type));
+                            data.scb = imageInfo.size.w * data.cb;
+                            if (!f.fast)
+                            {
+                                data.buf.resize(f.dataWindow.w() * data.cb);
+                            }
+                            layerData.push_back(std::move(data));
                         }
-                        f.f->setFrameBuffer(frameBuffer);
-                        f.f->readPixels(f.displayWindow.min.y, f.displayWindow.max.y);
                     }
-                    else
+                    Imf::FrameBuffer frameBuffer;
+                    for (const auto& data : layerData)
                     {
-                        Imf::FrameBuffer frameBuffer;
-                        std::vector<char> buf(f.dataWindow.w() * cb);
-                        for (int c = 0; c < channels; ++c)
+                        const Image::Type type = data.image->getType();
+                        const size_t channels = Image::getChannelCount(type);
+                        const size_t channelByteCount = Image::getByteCount(getDataType(type));
+                        for (size_t c = 0; c < channels; ++c)
                         {
-                            const std::string& name = f.layers[_options.layer].channels[c].name;
-                            const glm::ivec2& sampling = f.layers[_options.layer].channels[c].sampling;
+                            const std::string& name = f.layers[data.layer].channels[c].name;
+                            const glm::ivec2& sampling = f.layers[data.layer].channels[c].sampling;
                             frameBuffer.insert(
                                 name.c_str(),
+                                f.fast ?
+                                Imf::Slice(
+                                    toImf(Image::getDataType(type)),
+                                    (char*)data.image->getData() + (c * channelByteCount),
+                                    data.cb,
+                                    data.scb,
+                                    sampling.x,
+                                    sampling.y,
+                                    0.F) :
                                 Imf::Slice(
-                                    toImf(Image::getDataType(imageInfo.type)),
-                                    buf.data() - (f.dataWindow.min.x * cb) + (c * channelByteCount),
-                                    cb,
+                                    toImf(Image::getDataType(type)),
+                                    (char*)data.buf.data() - (f.dataWindow.min.x * data.cb) + (c * channelByteCount),
+                                    data.cb,
                                     0,
                                     sampling.x,
                                     sampling.y,
                                     0.F));
                         }
-                        f.f->setFrameBuffer(frameBuffer);
+                    }
+                    f.f->setFrameBuffer(frameBuffer);
+
+                    if (f.fast)
+                    {
+                        f.f->readPixels(f.displayWindow.min.y, f.displayWindow.max.y);
+                    }
+                    else
+                    {
                         for (int y = f.displayWindow.min.y; y <= f.displayWindow.max.y; ++y)
                         {
-                            uint8_t* p = out->getData() + ((y - f.displayWindow.min.y) * scb);
-                            uint8_t* end = p + scb;
-                            if (y >= f.intersectedWindow.min.y && y <= f.intersectedWindow.max.y)
+                            const bool intersects = y >= f.intersectedWindow.min.y && y <= f.intersectedWindow.max.y;
+                            if (intersects)
                             {
-                                size_t size = (f.intersectedWindow.min.x - f.displayWindow.min.x) * cb;
-                                memset(p, 0, size);
-                                p += size;
-                                size = f.intersectedWindow.w() * cb;
                                 f.f->readPixels(y, y);
-                                memcpy(
-                                    p,
-                                    buf.data() + std::max(f.displayWindow.min.x - f.dataWindow.min.x, 0) * cb,
-                                    size);
-                                p += size;
                             }
-                            memset(p, 0, end - p);
+                            for (const auto& data : layerData)
+                            {
+                                uint8_t* p = data.image->getData() + ((y - f.displayWindow.min.y) * data.scb);
+                                uint8_t* end = p + data.scb;
+                                if (intersects)
+                                {
+                                    size_t size = (f.intersectedWindow.min.x - f.displayWindow.min.x) * data.cb;
+                                    memset(p, 0, size);
+                                    p += size;
+                                    size = f.intersectedWindow.w() * data.cb;
+                                    memcpy(
+                                        p,
+                                        data.buf.data() + std::max(f.displayWindow.min.x - f.dataWindow.min.x, 0) * data.cb,
+                                        size);
+                                    p += size;
+                                }
+                                memset(p, 0, end - p);
+                            }
                         }
                     }
                     return out;
@@ -4,12 +4,18 @@
 
 #include <djvAV/RLA.h>
 
+#include <djvImage/Parallel.h>
+
 #include <djvSystem/File.h>
 #include <djvSystem/FileIO.h>
 #include <djvSystem/TextSystem.h>
 
 #include <djvCore/StringFormat.h>
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
 using namespace djv::Core;
 
 namespace djv
@@ -48,31 +54,65 @@ namespace djv
 
                 namespace
                 {
-                    void readRle(
-                        const std::shared_ptr<System::File::IO>& io,
+                    //! Get the size of a channel in a scanline. The size is
+                    //! stored as a big endian 16-bit integer before the data.
+                    const uint8_t* readSize(const uint8_t* in, const uint8_t* end, size_t& size)
+                    {
+                        if (in + 2 > end)
+                        {
+                            return nullptr;
+                        }
+                        const int16_t value = static_cast<int16_t>((in[0] << 8) | in[1]);
+                        in += 2;
+                        if (value < 0 || in + value > end)
+                        {
+                            return nullptr;
+                        }
+                        size = static_cast<size_t>(value);
+                        return in;
+                    }
+
+                    const uint8_t* readRle(
+                        const uint8_t* in,
+                        const uint8_t* end,
                         uint8_t* out,
                         size_t size,
                         size_t channels,
                         size_t bytes)
                     {
-                        int16_t _size = 0;
-                        io->read16(&_size);
-                        std::vector<uint8_t> buf;
-                        buf.resize(_size);
-                        io->read(buf.data(), _size);
-                        const uint8_t* p = buf.data();
+                        size_t bufSize = 0;
+                        in = readSize(in, end, bufSize);
+                        if (!in)
+                        {
+                            return nullptr;
+                        }
+                        const uint8_t* p = in;
+                        const uint8_t* const bufEnd = in + bufSize;
+                        const size_t outInc = channels * bytes;
                         for (size_t b = 0; b < bytes; ++b)
                         {
                             uint8_t* outP = out + (Memory::Endian::LSB == Memory::getEndian() ? (bytes - 1 - b) : b);
-                            const size_t outInc = channels * bytes;
                             for (size_t i = 0; i < size;)
                             {
+                                if (p >= bufEnd)
+                                {
+                                    return nullptr;
+                                }
                                 int count = *((const int8_t*)p);
                                 ++p;
+
+                                // Runs that go past the end of the scanline are
+                                // clipped so that scanlines can be decoded in
+                                // parallel.
                                 if (count >= 0)
                                 {
                                     ++count;
-                                    for (int j = 0; j < count; ++j, outP += outInc)
+                                    if (p >= bufEnd)
+                                    {
+                                        return nullptr;
+                                    }
+                                    const size_t length = std::min(static_cast<size_t>(count), size - i);
+                                    for (size_t j = 0; j < length; ++j, outP += outInc)
                                     {
                                         *outP = *p;
                                     }
@@ -81,27 +121,37 @@ namespace djv
                                 else
                                 {
                                     count = -count;
-                                    for (int j = 0; j < count; ++j, ++p, outP += outInc)
+                                    if (p + count > bufEnd)
                                     {
-                                        *outP = *p;
+                                        return nullptr;
+                                    }
+                                    const size_t length = std::min(static_cast<size_t>(count), size - i);
+                                    for (size_t j = 0; j < length; ++j, outP += outInc)
+                                    {
+                                        *outP = p[j];
                                     }
+                                    p += count;
                                 }
                                 i += count;
                             }
                         }
+                        return bufEnd;
                     }
 
-                    void readFloat(
-                        const std::shared_ptr<System::File::IO>& io,
+                    const uint8_t* readFloat(
+                        const uint8_t* in,
+                        const uint8_t* end,
                         uint8_t* out,
                         size_t size,
                         size_t channels)
                     {
-                        int16_t _size = 0;
-                        io->read16(&_size);
-                        std::vector<uint8_t> buf(_size);
-                        io->read(buf.data(), _size);
-                        const uint8_t* p = buf.data();
+                        size_t bufSize = 0;
+                        in = readSize(in, end, bufSize);
+                        if (!in || bufSize < size * 4)
+                        {
+                            return nullptr;
+                        }
+                        const uint8_t* p = in;
                         const size_t outInc = channels * 4;
                         if (Memory::Endian::LSB == Memory::getEndian())
                         {
@@ -123,6 +173,7 @@ namespace djv
                                 out[3] = p[3];
                             }
                         }
+                        return in + bufSize;
                     }
 
                 } // namespace
@@ -136,25 +187,54 @@ namespace djv
                     out->setPluginName(pluginName);
 
                     const size_t w = info.video[0].size.w;
-                    const size_t h = info.video[0].size.h;
+                    const uint16_t h = info.video[0].size.h;
                     const size_t channels = Image::getChannelCount(info.video[0].type);
                     const size_t bytes = Image::getByteCount(Image::getDataType(info.video[0].type));
                     const Image::DataType dataType = Image::getDataType(info.video[0].type);
-                    uint8_t* dataP = out->getData();
-                    for (uint16_t y = 0; y < h; ++y, dataP += w * channels * bytes)
-                    {
-                        io->setPos(_rleOffset[y]);
-                        for (int c = 0; c < channels; ++c)
+
+                    // Read the scanline data into memory, the scanline table
+                    // gives the offset of each scanline so they can be decoded
+                    // in parallel.
+                    const size_t pos = io->getPos();
+                    const size_t size = io->getSize() - pos;
+                    std::vector<uint8_t> buf(size);
+                    io->read(buf.data(), size);
+                    const uint8_t* const bufP = buf.data();
+                    const uint8_t* const bufEnd = bufP + size;
+                    uint8_t* const dataP = out->getData();
+                    std::atomic<bool> error(false);
+                    Image::parallelScanlines(
+                        h,
+                        out->getDataByteCount(),
+                        [this, bufP, bufEnd, dataP, pos, size, w, channels, bytes, dataType, &error](uint16_t begin, uint16_t end)
                         {
-                            if (Image::DataType::F32 == dataType)
-                            {
-                                readFloat(io, dataP + c * bytes, w, channels);
-                            }
-                            else
+                            for (uint16_t y = begin; y < end && !error; ++y)
                             {
-                                readRle(io, dataP + c * bytes, w, channels, bytes);
+                                const size_t offset = static_cast<size_t>(_rleOffset[y]);
+                                const uint8_t* p = offset >= pos && offset - pos < size ? bufP + (offset - pos) : nullptr;
+                                uint8_t* rowP = dataP + y * w * channels * bytes;
+                                for (size_t c = 0; c < channels && p; ++c)
+                                {
+                                    if (Image::DataType::F32 == dataType)
+                                    {
+                                        p = readFloat(p, bufEnd, rowP + c * bytes, w, channels);
+                                    }
+                                    else
+                                    {
+                                        p = readRle(p, bufEnd, rowP + c * bytes, w, channels, bytes);
+                                    }
+                                }
+                                if (!p)
+                                {
+                                    error = true;
+                                }
                             }
-                        }
+                        });
+                    if (error)
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(_textSystem->getText(DJV_TEXT("error_read_scanline"))));
                     }
 
                     return out;
@@ -235,6 +315,12 @@ namespace djv
                     }
                     const int w = header.active[1] - header.active[0] + 1;
                     const int h = header.active[3] - header.active[2] + 1;
+                    if (w <= 0 || h <= 0 || w > std::numeric_limits<uint16_t>::max() || h > std::numeric_limits<uint16_t>::max())
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(_textSystem->getText(DJV_TEXT("error_file_not_supported"))));
+                    }
 
                     // Read the scanline table.
                     _rleOffset.resize(h);
@@ -4,12 +4,17 @@
 
 #include <djvAV/SGI.h>
 
+#include <djvImage/Parallel.h>
+
 #include <djvSystem/File.h>
 #include <djvSystem/FileIO.h>
 #include <djvSystem/TextSystem.h>
 
 #include <djvCore/StringFormat.h>
 
+#include <algorithm>
+#include <atomic>
+
 using namespace djv::Core;
 
 namespace djv
@@ -48,142 +53,129 @@ namespace djv
 
                 namespace
                 {
-                    template<typename T>
-                    bool read(
-                        const void* in,
-                        const void* end,
-                        void*       out,
-                        size_t      size,
-                        bool        endian)
+                    //! Decode a scanline of RLE data. The values are big endian
+                    //! and are copied without conversion. Packets that run past
+                    //! the end of the scanline are clipped.
+                    bool readRle(
+                        const uint8_t* in,
+                        const uint8_t* end,
+                        uint8_t*       out,
+                        size_t         size,
+                        size_t         bytes)
                     {
-                        const size_t bytes = sizeof(T);
-                        const T* inP = reinterpret_cast<const T*>(in);
-                        T* outP = reinterpret_cast<T*>(out);
-                        const T* const outEnd = outP + size;
-                        while (outP < outEnd)
+                        const uint8_t* const outEnd = out + size * bytes;
+                        while (out < outEnd)
                         {
                             // Information.
-                            if (inP > end)
+                            if (in + bytes > end)
                             {
                                 return false;
                             }
-                            const size_t count = *inP & 0x7f;
-                            const bool   run = !(*inP & 0x80);
-                            const size_t length = run ? 1 : count;
-                            ++inP;
-
-                            // Unpack.
-                            if (inP + length > end)
+                            const uint8_t code = in[bytes - 1];
+                            const size_t  count = code & 0x7f;
+                            const bool    run = !(code & 0x80);
+                            in += bytes;
+                            if (0 == count)
                             {
                                 return false;
                             }
+                            const size_t length = std::min(count, static_cast<size_t>(outEnd - out) / bytes);
+
+                            // Unpack.
                             if (run)
                             {
-                                if (!endian)
+                                if (in + bytes > end)
                                 {
-                                    for (size_t j = 0; j < count; ++j, ++outP)
-                                    {
-                                        *outP = *inP;
-                                    }
+                                    return false;
+                                }
+                                if (1 == bytes)
+                                {
+                                    memset(out, *in, length);
                                 }
                                 else
                                 {
-                                    Memory::endian(inP, outP, 1, bytes);
-                                    Memory::endian(inP, outP, 1, bytes);
-                                    if (count > 1)
+                                    for (size_t j = 0; j < length; ++j)
                                     {
-                                        for (size_t j = 0; j < count - 1; ++j)
-                                        {
-                                            outP[1 + j] = outP[0];
-                                        }
+                                        memcpy(out + j * bytes, in, bytes);
                                     }
-                                    outP += count;
                                 }
-                                ++inP;
+                                in += bytes;
                             }
                             else
                             {
-                                if (!endian)
+                                if (in + count * bytes > end)
                                 {
-                                    for (size_t j = 0; j < length; ++j, ++inP, ++outP)
-                                    {
-                                        *outP = *inP;
-                                    }
-                                }
-                                else
-                                {
-                                    Memory::endian(inP, outP, length, bytes);
-                                    inP += length;
-                                    outP += length;
+                                    return false;
                                 }
+                                memcpy(out, in, length * bytes);
+                                in += count * bytes;
                             }
+                            out += length * bytes;
                         }
                         return true;
                     }
 
-                    bool readRle(
-                        const void* in,
-                        const void* end,
-                        void*       out,
-                        size_t      size,
-                        size_t      bytes,
-                        bool        endian)
+                    template<typename T, size_t channels>
+                    void planarInterleave(
+                        const T* in,
+                        size_t   planeSize,
+                        T*       out,
+                        size_t   w)
                     {
-                        switch (bytes)
+                        // The channel count is a template parameter so the
+                        // compiler can unroll and vectorize the inner loop.
+                        for (size_t c = 0; c < channels; ++c)
                         {
-                        case 1: return read<uint8_t>(in, end, out, size, false);
-                        case 2: return read<uint16_t>(in, end, out, size, endian);
+                            const T* inP = in + c * planeSize;
+                            T* outP = out + c;
+                            for (size_t x = 0; x < w; ++x)
+                            {
+                                outP[x * channels] = inP[x];
+                            }
+                        }
+                    }
+
+                    template<typename T>
+                    void planarInterleave(
+                        const std::shared_ptr<Image::Data>& in,
+                        std::shared_ptr<Image::Data>& out,
+                        uint16_t y)
+                    {
+                        const size_t w = out->getWidth();
+                        const size_t planeSize = w * in->getHeight();
+                        const T* inP = reinterpret_cast<const T*>(in->getData()) + y * w;
+                        T* outP = reinterpret_cast<T*>(out->getData(y));
+                        switch (Image::getChannelCount(out->getType()))
+                        {
+                        case 1: memcpy(outP, inP, w * sizeof(T)); break;
+                        case 2: planarInterleave<T, 2>(inP, planeSize, outP, w); break;
+                        case 3: planarInterleave<T, 3>(inP, planeSize, outP, w); break;
+                        case 4: planarInterleave<T, 4>(inP, planeSize, outP, w); break;
                         default: break;
                         }
-                        return false;
                     }
 
                     void planarInterleave(
                         const std::shared_ptr<Image::Data>& in,
                         std::shared_ptr<Image::Data>& out)
                     {
-                        const size_t w = out->getWidth();
-                        const size_t h = out->getHeight();
-                        const size_t channels = Image::getChannelCount(out->getType());
-                        const size_t pixelByteCount = out->getPixelByteCount();
+                        const uint16_t h = out->getHeight();
                         const size_t channelByteCount = Image::getByteCount(Image::getDataType(out->getType()));
-                        for (size_t c = 0; c < channels; ++c)
-                        {
-                            for (size_t y = 0; y < h; ++y)
+                        Image::parallelScanlines(
+                            h,
+                            out->getDataByteCount(),
+                            [&in, &out, channelByteCount](uint16_t begin, uint16_t end)
                             {
-                                const uint8_t* inP = in->getData() + (c * in->getHeight() + y) * in->getWidth() * channelByteCount;
-                                uint8_t* outP = out->getData(0, y) + c * channelByteCount;
-                                for (
-                                    size_t x = 0;
-                                    x < w;
-                                    ++x, inP += channelByteCount,
-                                    outP += pixelByteCount)
+                                for (uint16_t y = begin; y < end; ++y)
                                 {
                                     switch (channelByteCount)
                                     {
-                                    case 4:
-                                        outP[3] = inP[3];
-                                        outP[2] = inP[2];
-                                        outP[1] = inP[1];
-                                        outP[0] = inP[0];
-                                        break;
-                                    case 3:
-                                        outP[2] = inP[2];
-                                        outP[1] = inP[1];
-                                        outP[0] = inP[0];
-                                        break;
-                                    case 2:
-                                        outP[1] = inP[1];
-                                        outP[0] = inP[0];
-                                        break;
-                                    case 1:
-                                        outP[0] = inP[0];
-                                        break;
+                                    case 1: planarInterleave<uint8_t>(in, out, y); break;
+                                    case 2: planarInterleave<uint16_t>(in, out, y); break;
                                     default: break;
                                     }
                                 }
-                            }
-                        }
+                            });
                     }
 
                 } // namespace
@@ -203,41 +195,54 @@ namespace djv
                     const size_t bytes = Image::getByteCount(Image::getDataType(imageInfo.type));
                     const size_t dataByteCount = out->getDataByteCount();
                     std::shared_ptr<Image::Data> tmp = Image::Data::create(imageInfo);
+                    // The data is read without endian conversion, the image
+                    // layout is big endian.
                     if (!_compression)
                     {
-                        if (1 == bytes)
-                        {
-                            io->readU8(tmp->getData(), dataByteCount);
-                        }
-                        else
-                        {
-                            io->read(tmp->getData(), size / bytes, bytes);
-                        }
+                        io->read(tmp->getData(), dataByteCount);
                     }
                     else
                     {
                         std::vector<uint8_t> rleData(size);
-                        io->read(rleData.data(), size / bytes, bytes);
+                        io->read(rleData.data(), size);
+                        // The scanline table gives the offset of each row,
+                        // so the rows can be decoded in parallel.
                         const uint8_t* inP = rleData.data();
                         const uint8_t* end = inP + size;
                         uint8_t* outP = tmp->getData();
-                        for (size_t c = 0; c < channels; ++c)
-                        {
-                            for (size_t y = 0; y < imageInfo.size.h; ++y, outP += imageInfo.size.w * bytes)
+                        const uint16_t h = imageInfo.size.h;
+                        const size_t w = imageInfo.size.w;
+                        std::atomic<bool> error(false);
+                        Image::parallelScanlines(
+                            h,
+                            dataByteCount,
+                            [this, inP, end, outP, h, w, channels, bytes, pos, &error](uint16_t begin, uint16_t endY)
                             {
-                                if (!readRle(
-                                    inP + _rleOffset[y + imageInfo.size.h * c] - pos,
-                                    end,
-                                    outP,
-                                    imageInfo.size.w,
-                                    bytes,
-                                    io->hasEndianConversion()))
+                                for (size_t c = 0; c < channels && !error; ++c)
                                 {
-                                    throw System::File::Error(String::Format("{0}: {1}").
-                                        arg(fileName).
-                                        arg(_textSystem->getText(DJV_TEXT("error_read_scanline"))));
+                                    for (uint16_t y = begin; y < endY; ++y)
+                                    {
+                                        const size_t offset = _rleOffset[y + h * c];
+                                        if (offset < pos ||
+                                            offset - pos >= static_cast<size_t>(end - inP) ||
+                                            !readRle(
+                                                inP + offset - pos,
+                                                end,
+                                                outP + (c * h + y) * w * bytes,
+                                                w,
+                                                bytes))
+                                        {
+                                            error = true;
+                                            break;
+                                        }
+                                    }
                                 }
-                            }
+                            });
+                        if (error)
+                        {
+                            throw System::File::Error(String::Format("{0}: {1}").
+                                arg(fileName).
+                                arg(_textSystem->getText(DJV_TEXT("error_read_scanline"))));
                         }
                     }
 
@@ -337,6 +342,15 @@ namespace djv
                     io->open(fileName, System::File::Mode::Read);
                     Image::Info imageInfo;
                     Header().read(io, imageInfo, _compression, _textSystem);
+                    if (_compression)
+                    {
+                        // Read the scanline offset and size tables.
+                        const size_t size = imageInfo.size.h * Image::getChannelCount(imageInfo.type);
+                        _rleOffset.resize(size);
+                        _rleSize.resize(size);
+                        io->readU32(_rleOffset.data(), size);
+                        io->readU32(_rleSize.data(), size);
+                    }
                     Info info;
                     info.fileName = fileName;
                     info.videoSpeed = _speed;
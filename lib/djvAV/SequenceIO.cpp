@@ -6,6 +6,8 @@
 
 #include <djvGL/ImageConvert.h>
 
+#include <djvOCIO/CPUProcessor.h>
+
 #include <djvAV/SpeedFunc.h>
 
 #include <djvSystem/Context.h>
@@ -23,7 +25,9 @@
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+#include <cstring>
 #include <future>
+#include <set>
 
 using namespace djv::Core;
 
@@ -43,14 +47,17 @@ namespace djv
             struct ISequenceRead::Future
             {
                 Math::Frame::Number frame = Math::Frame::invalid;
-                std::shared_ptr<Image::Data> image;
+                std::vector<size_t> layers;
+                std::map<size_t, std::shared_ptr<Image::Data> > images;
             };
 
             struct ISequenceRead::Private
             {
                 Math::Frame::Number frame = Math::Frame::invalid;
                 std::promise<Info> infoPromise;
+                std::vector<size_t> layerByteCounts;
                 std::vector<std::future<Future> > cacheFutures;
+                std::set<std::pair<Math::Frame::Number, size_t> > cachePending;
                 std::condition_variable queueCV;
                 Direction direction = Direction::Forward;
                 Math::Frame::Number seek = Math::Frame::invalid;
@@ -99,6 +106,10 @@ namespace djv
                     {
                         info = _readInfo(fileName);
                         info.fileName = _fileInfo.getFileName();
+                        for (const auto& i : info.video)
+                        {
+                            p.layerByteCounts.push_back(i.getDataByteCount());
+                        }
                         p.infoPromise.set_value(info);
                     }
                     catch (const std::exception&)
@@ -140,25 +151,13 @@ namespace djv
                             cacheEnabled = _cacheEnabled;
                             cacheMaxByteCount = _cacheMaxByteCount;
                         }
-                        if (!cacheEnabled)
-                        {
-                            _cache.clear();
-                        }
-                        if (info.video.size() && _options.layer < info.video.size())
-                        {
-                            const size_t dataByteCount = info.video[_options.layer].getDataByteCount();
-                            _cache.setMax(dataByteCount ? (cacheMaxByteCount / dataByteCount) : 0);
-                            _cache.setSequenceSize(info.videoSequence.getFrameCount());
-                            _cache.setInOutPoints(inOutPoints);
-                        }
-                        else
-                        {
-                            _cache.setMax(0);
-                        }
 
-                        // Check to see if there is work to be done.
+                        // Check to see if there is work to be done. The layer is
+                        // read together with the seek so that a layer change followed
+                        // by a seek never fills the queue with the previous layer.
                         size_t queueCount = 0;
                         Math::Frame::Number seek = Math::Frame::invalid;
+                        size_t layer = 0;
                         {
                             std::unique_lock<std::mutex> lock(_mutex);
                             if (p.queueCV.wait_for(
@@ -184,7 +183,28 @@ namespace djv
                                     _videoQueue.clearFrames();
                                 }
                             }
+                            layer = _layer;
                         }
+
+                        // Update the cache.
+                        if (!cacheEnabled)
+                        {
+                            _cache.clear();
+                        }
+                        if (info.video.size() && layer < info.video.size())
+                        {
+                            const size_t dataByteCount = info.video[layer].getDataByteCount();
+                            _cache.setLayer(layer);
+                            _cache.setMax(dataByteCount ? (cacheMaxByteCount / dataByteCount) : 0);
+                            _cache.setMaxByteCount(cacheMaxByteCount);
+                            _cache.setSequenceSize(info.videoSequence.getFrameCount());
+                            _cache.setInOutPoints(inOutPoints);
+                        }
+                        else
+                        {
+                            _cache.setMax(0);
+                        }
+
                         if (seek != Math::Frame::invalid)
                         {
                             p.frame = seek;
@@ -199,13 +219,13 @@ namespace djv
                         size_t read = 0;
                         if (queueCount > 0)
                         {
-                            read = _readQueue(queueCount, loop, cacheEnabled);
+                            read = _readQueue(queueCount, loop, cacheEnabled, layer);
                         }
 
                         // Fill the cache.
                         if (cacheEnabled)
                         {
-                            _readCache(playback ? (threadCount / 2) : threadCount, inOutPoints);
+                            _readCache(playback ? (threadCount / 2) : threadCount, inOutPoints, layer, cacheMaxByteCount);
                         }
 
                         // Update information.
@@ -263,6 +283,25 @@ namespace djv
                 return _sequence.getFrameCount() > 1;
             }
 
+            bool ISequenceRead::canSetLayer() const
+            {
+                return true;
+            }
+
+            std::map<size_t, std::shared_ptr<Image::Data> > ISequenceRead::_readImages(
+                const std::string& fileName,
+                const std::vector<size_t>& layers)
+            {
+                // Only the first layer is supported, other layers are returned
+                // empty so they are treated as failed and not read again.
+                std::map<size_t, std::shared_ptr<Image::Data> > out;
+                for (const auto i : layers)
+                {
+                    out[i] = 0 == i ? _readImage(fileName) : nullptr;
+                }
+                return out;
+            }
+
             void ISequenceRead::_finish()
             {
                 DJV_PRIVATE_PTR();
@@ -288,20 +327,29 @@ namespace djv
                 return std::min(queueMax, threadCount);
             }
 
-            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(Math::Frame::Number i, std::string fileName)
+            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(
+                Math::Frame::Number i,
+                std::string fileName,
+                std::vector<size_t> layers)
             {
                 return std::async(
                     std::launch::async,
-                    [this, i, fileName]
+                    [this, i, fileName, layers]
                     {
                         Future out;
                         out.frame = i;
+                        out.layers = layers;
                         try
                         {
-                            out.image = _readImage(fileName);
+                            out.images = _readImages(fileName, layers);
                         }
                         catch (const std::exception& e)
                         {
+                            // Keep the failed layers so they are not read again.
+                            for (const auto j : layers)
+                            {
+                                out.images[j] = nullptr;
+                            }
                             _logSystem->log(
                                 "djv::AV::ISequenceRead",
                                 String::Format("{0}: {1}").arg(fileName).arg(e.what()),
@@ -311,7 +359,7 @@ namespace djv
                     });
             }
 
-            size_t ISequenceRead::_readQueue(size_t count, bool loop, bool cacheEnabled)
+            size_t ISequenceRead::_readQueue(size_t count, bool loop, bool cacheEnabled, size_t layer)
             {
                 DJV_PRIVATE_PTR();
 
@@ -322,7 +370,7 @@ namespace djv
                 for (size_t i = 0; i < count; ++i)
                 {
                     std::shared_ptr<Image::Data> cachedImage;
-                    if (cacheEnabled && _cache.get(p.frame, cachedImage))
+                    if (cacheEnabled && _cache.get(p.frame, layer, cachedImage))
                     {
                         images.push_back(std::make_pair(p.frame, cachedImage));
                     }
@@ -334,13 +382,13 @@ namespace djv
                             {
                                 const Math::Frame::Number frameNumber = _sequence.getFrame(p.frame);
                                 const std::string fileName = _fileInfo.getFileName(frameNumber);
-                                futures.push_back(_getFuture(p.frame, fileName));
+                                futures.push_back(_getFuture(p.frame, fileName, { layer }));
                             }
                         }
                         else
                         {
                             const std::string fileName = _fileInfo.getFileName();
-                            futures.push_back(_getFuture(p.frame, fileName));
+                            futures.push_back(_getFuture(p.frame, fileName, { layer }));
                         }
                     }
 
@@ -371,13 +419,20 @@ namespace djv
                 for (auto& future : futures)
                 {
                     const auto result = future.get();
-                    images.push_back(std::make_pair(result.frame, result.image));
+                    const auto i = result.images.find(layer);
+                    images.push_back(std::make_pair(result.frame, i != result.images.end() ? i->second : nullptr));
                     if (cacheEnabled)
                     {
+                        for (const auto& j : result.images)
+                        {
 #if defined(DJV_MMAP)
-                        result.image->detach();
+                            if (j.second)
+                            {
+                                j.second->detach();
+                            }
 #endif // DJV_MMAP
-                        _cache.add(result.frame, result.image);
+                            _cache.add(result.frame, j.first, j.second);
+                        }
                     }
                 }
 
@@ -403,7 +458,11 @@ namespace djv
                 return futures.size();
             }
 
-            void ISequenceRead::_readCache(size_t count, const AV::IO::InOutPoints& inOutPoints)
+            void ISequenceRead::_readCache(
+                size_t count,
+                const AV::IO::InOutPoints& inOutPoints,
+                size_t layer,
+                size_t cacheMaxByteCount)
             {
                 DJV_PRIVATE_PTR();
 
@@ -416,13 +475,58 @@ namespace djv
                         frame = _videoQueue.getFrame().frame;
                     }
                 }
-                if (count > 0 && frame != Math::Frame::invalid)
+                if (count > 0 && frame != Math::Frame::invalid && layer < p.layerByteCounts.size())
                 {
                     const size_t sequenceFrameCount = _sequence.getFrameCount();
                     const auto range = inOutPoints.getRange(sequenceFrameCount);
                     _cache.setDirection(p.direction);
                     _cache.setCurrentFrame(frame);
                     const size_t readBehind = _cache.getReadBehind();
+                    const size_t max = std::min(_cache.getMax(), sequenceFrameCount);
+
+                    // The other layers are only cached with the space left over
+                    // once the frames for the current layer have been reserved.
+                    const size_t layerCount = p.layerByteCounts.size();
+                    const size_t reserveByteCount = max * p.layerByteCounts[layer];
+                    size_t otherByteCount = _cache.getTotalByteCount() - _cache.getLayerByteCount(layer);
+                    for (const auto& i : p.cachePending)
+                    {
+                        if (i.second != layer)
+                        {
+                            otherByteCount += p.layerByteCounts[i.second];
+                        }
+                    }
+                    auto request = [this, &p, layer, layerCount, reserveByteCount, cacheMaxByteCount, &otherByteCount]
+                        (Math::Frame::Number frame)
+                    {
+                        std::vector<size_t> layers;
+                        if (!_cache.contains(frame, layer) &&
+                            p.cachePending.find(std::make_pair(frame, layer)) == p.cachePending.end())
+                        {
+                            layers.push_back(layer);
+                        }
+                        for (size_t i = 0; i < layerCount; ++i)
+                        {
+                            if (i != layer &&
+                                !_cache.contains(frame, i) &&
+                                p.cachePending.find(std::make_pair(frame, i)) == p.cachePending.end() &&
+                                reserveByteCount + otherByteCount + p.layerByteCounts[i] <= cacheMaxByteCount)
+                            {
+                                layers.push_back(i);
+                                otherByteCount += p.layerByteCounts[i];
+                            }
+                        }
+                        if (layers.size())
+                        {
+                            for (const auto i : layers)
+                            {
+                                p.cachePending.insert(std::make_pair(frame, i));
+                            }
+                            const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
+                            p.cacheFutures.push_back(_getFuture(frame, fileName, layers));
+                        }
+                    };
+
                     switch (p.direction)
                     {
                     case Direction::Forward:
@@ -435,14 +539,9 @@ namespace djv
                                 frame = range.getMax();
                             }
                         }
-                        const size_t max = std::min(_cache.getMax(), sequenceFrameCount);
                         for (size_t i = 0; i < max && p.cacheFutures.size() < count; ++i)
                         {
-                            if (!_cache.contains(frame))
-                            {
-                                const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
-                                p.cacheFutures.push_back(_getFuture(frame, fileName));
-                            }
+                            request(frame);
                             ++frame;
                             if (frame > range.getMax())
                             {
@@ -461,14 +560,9 @@ namespace djv
                                 frame = range.getMin();
                             }
                         }
-                        const size_t max = std::min(_cache.getMax(), sequenceFrameCount);
-                        for (Math::Frame::Number i = 0; i < max && p.cacheFutures.size() < count; ++i)
+                        for (size_t i = 0; i < max && p.cacheFutures.size() < count; ++i)
                         {
-                            if (!_cache.contains(frame))
-                            {
-                                const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
-                                p.cacheFutures.push_back(_getFuture(frame, fileName));
-                            }
+                            request(frame);
                             --frame;
                             if (frame < range.getMin())
                             {
@@ -489,10 +583,20 @@ namespace djv
                         i->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                     {
                         const auto result = i->get();
+                        for (const auto& j : result.images)
+                        {
 #if defined(DJV_MMAP)
-                        result.image->detach();
+                            if (j.second)
+                            {
+                                j.second->detach();
+                            }
 #endif // DJV_MMAP
-                        _cache.add(result.frame, result.image);
+                            _cache.add(result.frame, j.first, j.second);
+                        }
+                        for (const auto j : result.layers)
+                        {
+                            p.cachePending.erase(std::make_pair(result.frame, j));
+                        }
                         i = p.cacheFutures.erase(i);
                     }
                     else
@@ -508,6 +612,7 @@ namespace djv
                 Math::Frame::Number frameNumber = Math::Frame::invalid;
                 GLFWwindow * glfwWindow = nullptr;
                 std::shared_ptr<GL::ImageConvert> convert;
+                std::shared_ptr<OCIO::CPUProcessor> colorSpaceProcessor;
                 std::thread thread;
                 std::atomic<bool> running;
             };
@@ -540,6 +645,21 @@ namespace djv
                     }
                 }
 
+                const OCIO::Convert colorSpace(options.inputColorSpace, options.colorSpace);
+                if (colorSpace.isValid() && colorSpace.input != colorSpace.output)
+                {
+                    try
+                    {
+                        p.colorSpaceProcessor = OCIO::CPUProcessor::create(colorSpace);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileInfo.getFileName()).
+                            arg(e.what()));
+                    }
+                }
+
 #if defined(DJV_GL_ES2)
                 glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
                 glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
@@ -622,6 +742,17 @@ namespace djv
                                         ++p.frameNumber;
                                     }
                                     auto image = images[i];
+                                    if (p.colorSpaceProcessor)
+                                    {
+                                        // The images may be shared with other
+                                        // readers, so convert a copy.
+                                        auto tmp = Image::Data::create(image->getInfo());
+                                        tmp->setPluginName(image->getPluginName());
+                                        tmp->setTags(image->getTags());
+                                        memcpy(tmp->getData(), image->getData(), image->getDataByteCount());
+                                        p.colorSpaceProcessor->apply(*tmp);
+                                        image = tmp;
+                                    }
                                     const Image::Type imageType = _getImageType(image->getType());
                                     if (Image::Type::None == imageType)
                                     {
@@ -33,10 +33,19 @@ namespace djv
                 std::future<Info> getInfo() override;
                 void seek(int64_t, Direction) override;
                 bool hasCache() const override;
+                bool canSetLayer() const override;
 
             protected:
                 virtual Info _readInfo(const std::string& fileName) = 0;
                 virtual std::shared_ptr<Image::Data> _readImage(const std::string& fileName) = 0;
+
+                //! Read the given layers of an image. The default implementation
+                //! only supports the first layer, which is read with _readImage();
+                //! other layers are returned as null images. Plugins that support
+                //! multiple layers should decode them in a single pass.
+                virtual std::map<size_t, std::shared_ptr<Image::Data> > _readImages(
+                    const std::string& fileName,
+                    const std::vector<size_t>& layers);
                 void _finish();
 
                 Math::Rational _speed;
@@ -46,9 +55,9 @@ namespace djv
                 bool _hasWork() const;
                 size_t _getQueueCount(size_t threadCount) const;
                 struct Future;
-                std::future<Future> _getFuture(Math::Frame::Number, std::string fileName);
-                size_t _readQueue(size_t count, bool loop, bool cacheEnabled);
-                void _readCache(size_t count, const AV::IO::InOutPoints&);
+                std::future<Future> _getFuture(Math::Frame::Number, std::string fileName, std::vector<size_t> layers);
+                size_t _readQueue(size_t count, bool loop, bool cacheEnabled, size_t layer);
+                void _readCache(size_t count, const AV::IO::InOutPoints&, size_t layer, size_t cacheMaxByteCount);
 
                 DJV_PRIVATE();
             };
@@ -4,6 +4,8 @@
 
 #include <djvAV/Targa.h>
 
+#include <djvImage/Parallel.h>
+
 #include <djvSystem/File.h>
 #include <djvSystem/FileIO.h>
 #include <djvSystem/TextSystem.h>
@@ -48,90 +50,82 @@ namespace djv
 
                 namespace
                 {
-                    const uint8_t* readRle(
+                    template<size_t channels>
+                    void copyPixels(const uint8_t* in, uint8_t* out, size_t size, bool run)
+                    {
+                        const size_t inInc = run ? 0 : channels;
+                        for (size_t j = 0; j < size; ++j, in += inInc, out += channels)
+                        {
+                            for (size_t c = 0; c < channels; ++c)
+                            {
+                                out[c] = in[c];
+                            }
+                        }
+                    }
+
+                    //! Find the end of the RLE data for a scanline without
+                    //! decoding it.
+                    const uint8_t* skipRle(
                         const uint8_t* in,
                         const uint8_t* end,
-                        uint8_t*       out,
                         size_t         size,
                         size_t         channels)
                     {
-                        const uint8_t* const outEnd = out + size * channels;
-                        while (out < outEnd)
+                        for (size_t x = 0; x < size;)
                         {
-                            // Information.
-                            if (in > end)
+                            if (in >= end)
                             {
                                 return nullptr;
                             }
-                            const uint8_t count  = (*in & 0x7f) + 1;
-                            const bool    run    = (*in & 0x80) ? true : false;
-                            const size_t  length = run ? 1 : count;
-                            ++in;
-
-                            // Unpack.
-                            if (in + length * channels > end)
+                            const size_t count = (*in & 0x7f) + 1;
+                            const bool   run   = (*in & 0x80) ? true : false;
+                            in += 1 + (run ? 1 : count) * channels;
+                            if (in > end)
                             {
                                 return nullptr;
                             }
-                            if (run)
-                            {
-                                for (size_t j = 0; j < count; ++j, out += channels)
-                                {
-                                    switch (channels)
-                                    {
-                                    case 4:
-                                        out[3] = in[3];
-                                        out[2] = in[2];
-                                        out[1] = in[1];
-                                        out[0] = in[0];
-                                        break;
-                                    case 3:
-                                        out[2] = in[2];
-                                        out[1] = in[1];
-                                        out[0] = in[0];
-                                        break;
-                                    case 2:
-                                        out[1] = in[1];
-                                        out[0] = in[0];
-                                        break;
-                                    case 1:
-                                        out[0] = in[0];
-                                        break;
-                                    default: break;
-                                    }
-                                }
-                                in += channels;
-                            }
-                            else
+                            x += count;
+                        }
+                        return in;
+                    }
+
+                    //! Decode the RLE data for a scanline. Packets that run past
+                    //! the end of the scanline are clipped so that scanlines can
+                    //! be decoded in parallel.
+                    void readRle(
+                        const uint8_t* in,
+                        uint8_t*       out,
+                        size_t         size,
+                        size_t         channels)
+                    {
+                        for (size_t x = 0; x < size;)
+                        {
+                            const size_t count = (*in & 0x7f) + 1;
+                            const bool   run   = (*in & 0x80) ? true : false;
+                            ++in;
+                            const size_t length = std::min(count, size - x);
+                            switch (channels)
                             {
-                                for (size_t j = 0; j < count; ++j, in += channels, out += channels)
-                                {
-                                    switch (channels)
-                                    {
-                                    case 4:
-                                        out[3] = in[3];
-                                        out[2] = in[2];
-                                        out[1] = in[1];
-                                        out[0] = in[0];
-                                        break;
-                                    case 3:
-                                        out[2] = in[2];
-                                        out[1] = in[1];
-                                        out[0] = in[0];
-                                        break;
-                                    case 2:
-                                        out[1] = in[1];
-                                        out[0] = in[0];
-                                        break;
-                                    case 1:
-                                        out[0] = in[0];
-                                        break;
-                                    default: break;
-                                    }
-                                }
+                            case 1: copyPixels<1>(in, out, length, run); break;
+                            case 2: copyPixels<2>(in, out, length, run); break;
+                            case 3: copyPixels<3>(in, out, length, run); break;
+                            case 4: copyPixels<4>(in, out, length, run); break;
+                            default: break;
                             }
+                            in += (run ? 1 : count) * channels;
+                            out += length * channels;
+                            x += count;
+                        }
+                    }
+
+                    void bgrSwap(uint8_t* p, size_t size, size_t channels)
+                    {
+                        for (size_t x = 0; x < size; ++x, p += channels)
+                        {
+                            const uint8_t tmp = p[0];
+                            p[0] = p[2];
+                            p[2] = tmp;
                         }
-                        return in;
                     }
 
                 } // namespace
@@ -145,26 +139,43 @@ namespace djv
                     out->setPluginName(pluginName);
 
                     const Image::Info& imageInfo = info.video[0];
+                    const uint16_t h = imageInfo.size.h;
+                    const size_t w = imageInfo.size.w;
                     const size_t channels = Image::getChannelCount(imageInfo.type);
+                    const bool bgr = _bgr;
+                    Image::Data* outP = out.get();
                     if (!_compression)
                     {
                         io->read(out->getData(), out->getDataByteCount());
+                        if (bgr)
+                        {
+                            Image::parallelScanlines(
+                                h,
+                                out->getDataByteCount(),
+                                [outP, w, channels](uint16_t begin, uint16_t end)
+                                {
+                                    for (uint16_t y = begin; y < end; ++y)
+                                    {
+                                        bgrSwap(outP->getData(0, y), w, channels);
+                                    }
+                                });
+                        }
                     }
                     else
                     {
                         const size_t tmpSize = io->getSize() - io->getPos();
                         std::vector<uint8_t> tmp(tmpSize);
                         io->read(tmp.data(), tmpSize);
+
+                        // Find where each scanline starts, then decode the
+                        // scanlines in parallel.
+                        std::vector<const uint8_t*> scanlines(h);
                         const uint8_t* p = tmp.data();
                         const uint8_t* const end = p + tmpSize;
-                        for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                        for (uint16_t y = 0; y < h; ++y)
                         {
-                            p = readRle(
-                                p,
-                                end,
-                                out->getData(0, y),
-                                imageInfo.size.w,
-                                channels);
+                            scanlines[y] = p;
+                            p = skipRle(p, end, w, channels);
                             if (!p)
                             {
                                 throw System::File::Error(String::Format("{0}: {1}").
@@ -172,20 +183,21 @@ namespace djv
                                     arg(_textSystem->getText(DJV_TEXT("error_read_scanline"))));
                             }
                         }
-                    }
-
-                    if (_bgr)
-                    {
-                        for (uint16_t y = 0; y < imageInfo.size.h; ++y)
-                        {
-                            uint8_t* p = out->getData(0, y);
-                            for (uint16_t x = 0; x < imageInfo.size.w; ++x, p += channels)
+                        Image::parallelScanlines(
+                            h,
+                            out->getDataByteCount(),
+                            [&scanlines, outP, w, channels, bgr](uint16_t begin, uint16_t end)
                             {
-                                const uint8_t tmp = p[0];
-                                p[0] = p[2];
-                                p[2] = tmp;
-                            }
-                        }
+                                for (uint16_t y = begin; y < end; ++y)
+                                {
+                                    uint8_t* rowP = outP->getData(0, y);
+                                    readRle(scanlines[y], rowP, w, channels);
+                                    if (bgr)
+                                    {
+                                        bgrSwap(rowP, w, channels);
+                                    }
+                                }
+                            });
                     }
 
                     return out;
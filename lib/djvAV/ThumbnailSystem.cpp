@@ -10,6 +10,8 @@
 
 #include <djvImage/Data.h>
 
+#include <djvOCIO/CPUProcessor.h>
+
 #include <djvSystem/Context.h>
 #include <djvSystem/LogSystem.h>
 #include <djvSystem/ResourceSystem.h>
@@ -24,7 +26,10 @@
 #include <GLFW/glfw3.h>
 
 #include <atomic>
+#include <cstring>
+#include <list>
 #include <mutex>
+#include <set>
 #include <thread>
 
 using namespace djv::Core;
@@ -49,6 +54,7 @@ namespace djv
 
                 InfoRequest(InfoRequest&& other) noexcept :
                     uid(other.uid),
+                    priority(other.priority),
                     fileInfo(other.fileInfo),
                     read(std::move(other.read)),
                     infoFuture(std::move(other.infoFuture)),
@@ -63,6 +69,7 @@ namespace djv
                     if (this != &other)
                     {
                         uid = other.uid;
+                        priority = other.priority;
                         fileInfo = other.fileInfo;
                         read = std::move(other.read);
                         infoFuture = std::move(other.infoFuture);
@@ -72,6 +79,7 @@ namespace djv
                 }
 
                 UID uid = 0;
+                int priority = 0;
                 System::File::Info fileInfo;
                 std::shared_ptr<IO::IRead> read;
                 std::future<IO::Info> infoFuture;
@@ -86,10 +94,13 @@ namespace djv
 
                 ImageRequest(ImageRequest&& other) noexcept :
                     uid(other.uid),
+                    priority(other.priority),
                     fileInfo(other.fileInfo),
                     size(std::move(other.size)),
                     type(std::move(other.type)),
+                    colorSpace(std::move(other.colorSpace)),
                     read(std::move(other.read)),
+                    infoFuture(std::move(other.infoFuture)),
                     promise(std::move(other.promise))
                 {}
 
@@ -101,23 +112,66 @@ namespace djv
                     if (this != &other)
                     {
                         uid = other.uid;
+                        priority = other.priority;
                         fileInfo = other.fileInfo;
                         size = std::move(other.size);
                         type = std::move(other.type);
+                        colorSpace = std::move(other.colorSpace);
                         read = std::move(other.read);
+                        infoFuture = std::move(other.infoFuture);
                         promise = std::move(other.promise);
                     }
                     return *this;
                 }
 
                 UID uid = 0;
+                int priority = 0;
                 System::File::Info fileInfo;
                 Image::Size size;
                 Image::Type type = Image::Type::None;
+                OCIO::Convert colorSpace;
                 std::shared_ptr<IO::IRead> read;
+                std::future<IO::Info> infoFuture;
                 std::promise<std::shared_ptr<Image::Data> > promise;
             };
 
+            //! Get the request with the highest priority. Requests with the
+            //! same priority are handled in the order they were made.
+            template<typename T>
+            typename std::list<T>::iterator getNextRequest(std::list<T>& requests)
+            {
+                auto out = requests.begin();
+                for (auto i = requests.begin(); i != requests.end(); ++i)
+                {
+                    if (i->priority > out->priority)
+                    {
+                        out = i;
+                    }
+                }
+                return out;
+            }
+
+            //! Remove the cancelled requests that are being processed.
+            template<typename T>
+            void removeCancelled(std::list<T>& requests, const std::set<UID>& cancelled)
+            {
+                if (!cancelled.empty())
+                {
+                    auto i = requests.begin();
+                    while (i != requests.end())
+                    {
+                        if (cancelled.find(i->uid) != cancelled.end())
+                        {
+                            i = requests.erase(i);
+                        }
+                        else
+                        {
+                            ++i;
+                        }
+                    }
+                }
+            }
+
             size_t getInfoCacheKey(const System::File::Info& fileInfo)
             {
                 size_t out = 0;
@@ -125,13 +179,19 @@ namespace djv
                 return out;
             }
 
-            size_t getImageCacheKey(const System::File::Info& fileInfo, const Image::Size& size, Image::Type type)
+            size_t getImageCacheKey(
+                const System::File::Info& fileInfo,
+                const Image::Size&        size,
+                Image::Type               type,
+                const OCIO::Convert&      colorSpace)
             {
                 size_t out = 0;
                 Memory::hashCombine(out, fileInfo.getFileName());
                 Memory::hashCombine(out, size.w);
                 Memory::hashCombine(out, size.h);
                 Memory::hashCombine(out, type);
+                Memory::hashCombine(out, colorSpace.input);
+                Memory::hashCombine(out, colorSpace.output);
                 return out;
             }
 
@@ -166,8 +226,11 @@ namespace djv
             std::list<ImageRequest> imageRequests;
             std::condition_variable requestCV;
             std::mutex requestMutex;
+            std::set<UID> cancelledInfoRequests;
+            std::set<UID> cancelledImageRequests;
             std::list<InfoRequest> pendingInfoRequests;
             std::list<ImageRequest> pendingImageRequests;
+            std::atomic<size_t> cancelledCount;
 
             Memory::Cache<size_t, IO::Info> infoCache;
             std::atomic<float> infoCachePercentage;
@@ -197,6 +260,7 @@ namespace djv
             p.imageCache.setMax(imageCacheMax);
             p.imageCachePercentage = 0.F;
             p.clearCache = false;
+            p.cancelledCount = 0;
 
 #if defined(DJV_GL_ES2)
             glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
@@ -230,7 +294,8 @@ namespace djv
                 std::stringstream ss;
                 {
                     ss << "Info cache: " << p.infoCachePercentage << "%\n";
-                    ss << "Image cache: " << p.imageCachePercentage << '%';
+                    ss << "Image cache: " << p.imageCachePercentage << "%\n";
+                    ss << "Cancelled requests: " << p.cancelledCount;
                 }
                 _log(ss.str());
             });
@@ -238,8 +303,10 @@ namespace djv
             auto logSystem = context->getSystemT<System::LogSystem>();
             auto resourceSystem = context->getSystemT<System::ResourceSystem>();
             p.running = true;
+            // The context owns the systems so it outlives the thread.
+            auto contextP = context.get();
             p.thread = std::thread(
-                [this, resourceSystem, logSystem]
+                [this, resourceSystem, logSystem, contextP]
             {
                 DJV_PRIVATE_PTR();
                 try
@@ -293,6 +360,10 @@ namespace djv
                         {
                             _handleImageRequests(convert);
                         }
+                        if (infoRequests || imageRequests)
+                        {
+                            contextP->wake();
+                        }
                     }
                 }
                 catch (const std::exception& e)
@@ -345,10 +416,11 @@ namespace djv
             return out;
         }
 
-        ThumbnailSystem::InfoFuture ThumbnailSystem::getInfo(const System::File::Info& fileInfo)
+        ThumbnailSystem::InfoFuture ThumbnailSystem::getInfo(const System::File::Info& fileInfo, int priority)
         {
             DJV_PRIVATE_PTR();
             InfoRequest request;
+            request.priority = priority;
             request.fileInfo = fileInfo;
             auto future = request.promise.get_future();
             {
@@ -375,19 +447,28 @@ namespace djv
                 {
                     p.infoRequests.erase(--(i.base()));
                 }
+                else
+                {
+                    p.cancelledInfoRequests.insert(uid);
+                }
             }
+            ++p.cancelledCount;
         }
 
         ThumbnailSystem::ImageFuture ThumbnailSystem::getImage(
             const System::File::Info& fileInfo,
             const Image::Size&        size,
-            Image::Type               type)
+            Image::Type               type,
+            int                       priority,
+            const OCIO::Convert&      colorSpace)
         {
             DJV_PRIVATE_PTR();
             ImageRequest request;
+            request.priority = priority;
             request.fileInfo = fileInfo;
             request.size = size;
             request.type = type;
+            request.colorSpace = colorSpace;
             auto future = request.promise.get_future();
             {
                 std::unique_lock<std::mutex> lock(p.requestMutex);
@@ -413,7 +494,12 @@ namespace djv
                 {
                     p.imageRequests.erase(--(i.base()));
                 }
+                else
+                {
+                    p.cancelledImageRequests.insert(uid);
+                }
             }
+            ++p.cancelledCount;
         }
 
         float ThumbnailSystem::getInfoCachePercentage() const
@@ -443,8 +529,9 @@ namespace djv
                     std::unique_lock<std::mutex> lock(p.requestMutex);
                     if (p.infoRequests.size())
                     {
-                        i = std::move(p.infoRequests.front());
-                        p.infoRequests.pop_front();
+                        const auto j = getNextRequest(p.infoRequests);
+                        i = std::move(*j);
+                        p.infoRequests.erase(j);
                     }
                     else
                     {
@@ -480,6 +567,15 @@ namespace djv
                 }
             }
 
+            // Stop the requests that have been cancelled.
+            std::set<UID> cancelled;
+            {
+                std::unique_lock<std::mutex> lock(p.requestMutex);
+                cancelled = std::move(p.cancelledInfoRequests);
+                p.cancelledInfoRequests.clear();
+            }
+            removeCancelled(p.pendingInfoRequests, cancelled);
+
             // Process pending requests.
             auto i = p.pendingInfoRequests.begin();
             while (i != p.pendingInfoRequests.end())
@@ -526,15 +622,16 @@ namespace djv
                     std::unique_lock<std::mutex> lock(p.requestMutex);
                     if (p.imageRequests.size())
                     {
-                        i = std::move(p.imageRequests.front());
-                        p.imageRequests.pop_front();
+                        const auto j = getNextRequest(p.imageRequests);
+                        i = std::move(*j);
+                        p.imageRequests.erase(j);
                     }
                     else
                     {
                         break;
                     }
                 }
-                const auto key = getImageCacheKey(i.fileInfo, i.size, i.type);
+                const auto key = getImageCacheKey(i.fileInfo, i.size, i.type, i.colorSpace);
                 std::shared_ptr<Image::Data> image;
                 p.imageCache.get(key, image);
                 if (image)
@@ -545,16 +642,11 @@ namespace djv
                 {
                     try
                     {
+                        // Don't wait for the information here, the file is
+                        // opened and decoded by the I/O thread.
                         i.read = p.io->read(i.fileInfo);
-                        const auto info = i.read->getInfo().get();
-                        if (info.video.size() > 0)
-                        {
-                            p.pendingImageRequests.push_back(std::move(i));
-                        }
-                        else
-                        {
-                            i.promise.set_value(nullptr);
-                        }
+                        i.infoFuture = i.read->getInfo();
+                        p.pendingImageRequests.push_back(std::move(i));
                     }
                     catch (const std::exception&)
                     {
@@ -570,10 +662,53 @@ namespace djv
                 }
             }
 
+            // Stop the requests that have been cancelled.
+            std::set<UID> cancelled;
+            {
+                std::unique_lock<std::mutex> lock(p.requestMutex);
+                cancelled = std::move(p.cancelledImageRequests);
+                p.cancelledImageRequests.clear();
+            }
+            removeCancelled(p.pendingImageRequests, cancelled);
+
             // Process pending requests.
             auto i = p.pendingImageRequests.begin();
             while (i != p.pendingImageRequests.end())
             {
+                if (i->infoFuture.valid())
+                {
+                    if (i->infoFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                    {
+                        ++i;
+                        continue;
+                    }
+                    bool video = false;
+                    try
+                    {
+                        video = i->infoFuture.get().video.size() > 0;
+                        if (!video)
+                        {
+                            i->promise.set_value(nullptr);
+                        }
+                    }
+                    catch (const std::exception&)
+                    {
+                        try
+                        {
+                            i->promise.set_exception(std::current_exception());
+                        }
+                        catch (const std::exception& e)
+                        {
+                            _log(e.what(), System::LogLevel::Error);
+                        }
+                    }
+                    if (!video)
+                    {
+                        i = p.pendingImageRequests.erase(i);
+                        continue;
+                    }
+                }
+
                 std::shared_ptr<Image::Data> image;
                 bool finished = false;
                 {
@@ -592,6 +727,7 @@ namespace djv
                 {
                     try
                     {
+                        bool copy = false;
                         Image::Size imageSize = image->getSize();
                         imageSize.w *= image->getInfo().pixelAspectRatio;
                         if (i->size != imageSize || i->type != Image::Type::None)
@@ -617,8 +753,21 @@ namespace djv
                             tmp->setTags(image->getTags());
                             convert->process(*image, info, *tmp);
                             image = tmp;
+                            copy = true;
+                        }
+                        if (i->colorSpace.isValid() && i->colorSpace.input != i->colorSpace.output)
+                        {
+                            if (!copy)
+                            {
+                                auto tmp = Image::Data::create(image->getInfo());
+                                tmp->setPluginName(image->getPluginName());
+                                tmp->setTags(image->getTags());
+                                memcpy(tmp->getData(), image->getData(), image->getDataByteCount());
+                                image = tmp;
+                            }
+                            OCIO::CPUProcessor::create(i->colorSpace)->apply(*image);
                         }
-                        p.imageCache.add(getImageCacheKey(i->fileInfo, i->size, i->type), image);
+                        p.imageCache.add(getImageCacheKey(i->fileInfo, i->size, i->type, i->colorSpace), image);
                         p.imageCachePercentage = p.imageCache.getPercentageUsed();
                         i->promise.set_value(image);
                     }
@@ -6,6 +6,8 @@
 
 #include <djvImage/Type.h>
 
+#include <djvOCIO/OCIO.h>
+
 #include <djvSystem/ISystem.h>
 
 #include <djvCore/UID.h>
@@ -53,6 +55,10 @@ namespace djv
         };
         
         //! This class provides a system for generating thumbnail images from files.
+        //!
+        //! Requests with a higher priority are handled first. Requests that
+        //! are cancelled are removed from the queue, or stopped if they are
+        //! already being processed.
         class ThumbnailSystem : public System::ISystem
         {
             DJV_NON_COPYABLE(ThumbnailSystem);
@@ -79,7 +85,7 @@ namespace djv
             };
             
             //! Get information about a file.
-            InfoFuture getInfo(const System::File::Info&);
+            InfoFuture getInfo(const System::File::Info&, int priority = 0);
 
             //! Cancel information about a file.
             void cancelInfo(Core::UID);
@@ -93,11 +99,15 @@ namespace djv
                 Core::UID uid = 0;
             };
 
-            //! Get a thumbnail image.
+            //! Get a thumbnail image. If a color space conversion is given
+            //! it is applied on the CPU, for use without the GPU color
+            //! management in Render2D.
             ImageFuture getImage(
                 const System::File::Info& path,
                 const Image::Size&        size,
-                Image::Type               type = Image::Type::None);
+                Image::Type               type       = Image::Type::None,
+                int                       priority   = 0,
+                const OCIO::Convert&      colorSpace = OCIO::Convert());
 
             //! Cancel a thumbnail image.
             void cancelImage(Core::UID);
@@ -11,14 +11,17 @@
 #include <djvSystem/LogSystem.h>
 #include <djvSystem/ResourceSystem.h>
 #include <djvSystem/TextSystem.h>
+#include <djvSystem/TimerFunc.h>
 
 #include <djvCore/ErrorFunc.h>
 #include <djvCore/OS.h>
 #include <djvCore/StringFormat.h>
 #include <djvCore/StringFunc.h>
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
+#include <thread>
 
 using namespace djv::Core;
 
@@ -30,6 +33,7 @@ namespace djv
         {
             //! \todo Should this be configurable?
             const size_t frameRate = 60;
+            const System::TimerValue idleTimeout = System::TimerValue::Medium;
 
         } // namespace
 
@@ -98,21 +102,23 @@ namespace djv
         void Application::run()
         {
             DJV_PRIVATE_PTR();
-            auto time = std::chrono::steady_clock::now();
-            Time::Duration delta = Time::Duration::zero();
+            const auto idleDuration = System::getTimerDuration(idleTimeout);
             p.running = true;
             while (p.running)
             {
+                const auto start = std::chrono::steady_clock::now();
                 tick();
 
-                auto end = std::chrono::steady_clock::now();
-                delta = std::chrono::duration_cast<Time::Duration>(end - time);
-                while (delta < std::chrono::microseconds(1000000 / frameRate))
+                // Tick at most at the frame rate. If none of the systems need
+                // to be ticked sooner, wait until the next deadline or until
+                // a worker thread wakes us up.
+                std::this_thread::sleep_until(start + std::chrono::microseconds(1000000 / frameRate));
+                const auto now = std::chrono::steady_clock::now();
+                const auto deadline = std::min(getTickDeadline(), now + idleDuration);
+                if (p.running && deadline > now)
                 {
-                    end = std::chrono::steady_clock::now();
-                    delta = std::chrono::duration_cast<Time::Duration>(end - time);
+                    _wait(deadline);
                 }
-                time = end;
             }
         }
 
@@ -42,6 +42,18 @@ namespace djv
                 First = MSB
             };
 
+            //! This enumeration provides the SIMD instruction sets used by
+            //! the memory and image kernels.
+            enum class SIMD
+            {
+                None,  //!< Scalar code
+                SSSE3, //!< 128-bit byte shuffles
+                AVX2,  //!< 256-bit integer operations
+
+                Count,
+                First = None
+            };
+
         } // namespace Memory
     } // namespace Core
 } // namespace djv
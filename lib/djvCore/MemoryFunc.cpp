@@ -6,16 +6,177 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <functional>
 
 #include <cstring>
 
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define DJV_CORE_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define DJV_CORE_SSSE3
+#define DJV_CORE_AVX2
+#else // _MSC_VER
+#define DJV_CORE_SSSE3 __attribute__((target("ssse3")))
+#define DJV_CORE_AVX2 __attribute__((target("avx2")))
+#endif // _MSC_VER
+#endif // DJV_CORE_X86
+
 namespace djv
 {
     namespace Core
     {
         namespace Memory
         {
+            namespace
+            {
+#if defined(DJV_CORE_X86)
+                //! Byte shuffles that reverse the bytes of 2, 4, and 8 byte
+                //! words, repeated for both halves of a 256-bit register.
+                const uint8_t endianShuffle2[32] =
+                {
+                    1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                    1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14
+                };
+                const uint8_t endianShuffle4[32] =
+                {
+                    3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                    3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+                };
+                const uint8_t endianShuffle8[32] =
+                {
+                    7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                    7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
+                };
+
+                DJV_CORE_SSSE3 size_t endianSSSE3(
+                    const uint8_t* in,
+                    uint8_t*       out,
+                    size_t         byteCount,
+                    const uint8_t* shuffle) noexcept
+                {
+                    const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle));
+                    size_t i = 0;
+                    for (; i + 16 <= byteCount; i += 16)
+                    {
+                        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_shuffle_epi8(v, mask));
+                    }
+                    return i;
+                }
+
+                DJV_CORE_AVX2 size_t endianAVX2(
+                    const uint8_t* in,
+                    uint8_t*       out,
+                    size_t         byteCount,
+                    const uint8_t* shuffle) noexcept
+                {
+                    const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(shuffle));
+                    size_t i = 0;
+                    for (; i + 64 <= byteCount; i += 64)
+                    {
+                        const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+                        const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + 32));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_shuffle_epi8(v0, mask));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 32), _mm256_shuffle_epi8(v1, mask));
+                    }
+                    for (; i + 32 <= byteCount; i += 32)
+                    {
+                        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_shuffle_epi8(v, mask));
+                    }
+                    return i;
+                }
+#endif // DJV_CORE_X86
+
+                //! Convert the endianness of as many words as possible with SIMD
+                //! instructions. The input and output may be the same. Returns
+                //! the number of words that were converted.
+                size_t endianSIMD(
+                    const void* in,
+                    void*       out,
+                    size_t      size,
+                    size_t      wordSize) noexcept
+                {
+                    size_t count = 0;
+#if defined(DJV_CORE_X86)
+                    const uint8_t* shuffle = nullptr;
+                    switch (wordSize)
+                    {
+                    case 2: shuffle = endianShuffle2; break;
+                    case 4: shuffle = endianShuffle4; break;
+                    case 8: shuffle = endianShuffle8; break;
+                    default: break;
+                    }
+                    if (shuffle)
+                    {
+                        const uint8_t* inP = reinterpret_cast<const uint8_t*>(in);
+                        uint8_t* outP = reinterpret_cast<uint8_t*>(out);
+                        const size_t byteCount = size * wordSize;
+                        size_t i = 0;
+                        switch (getSIMD())
+                        {
+                        case SIMD::AVX2:
+                            i = endianAVX2(inP, outP, byteCount, shuffle);
+                            i += endianSSSE3(inP + i, outP + i, byteCount - i, shuffle);
+                            break;
+                        case SIMD::SSSE3:
+                            i = endianSSSE3(inP, outP, byteCount, shuffle);
+                            break;
+                        default: break;
+                        }
+                        count = i / wordSize;
+                    }
+#endif // DJV_CORE_X86
+                    return count;
+                }
+
+                SIMD detectSIMD() noexcept
+                {
+                    SIMD out = SIMD::None;
+#if defined(DJV_CORE_X86)
+                    bool ssse3 = false;
+                    bool avx2 = false;
+#if defined(_MSC_VER)
+                    int info[4] = { 0, 0, 0, 0 };
+                    __cpuid(info, 0);
+                    const int ids = info[0];
+                    __cpuid(info, 1);
+                    ssse3 = (info[2] & (1 << 9)) != 0;
+                    const bool osxsave = (info[2] & (1 << 27)) != 0;
+                    const bool avx = (info[2] & (1 << 28)) != 0;
+                    if (ids >= 7 && osxsave && avx && 6 == (_xgetbv(0) & 6))
+                    {
+                        __cpuidex(info, 7, 0);
+                        avx2 = (info[1] & (1 << 5)) != 0;
+                    }
+#else // _MSC_VER
+                    __builtin_cpu_init();
+                    ssse3 = __builtin_cpu_supports("ssse3");
+                    avx2 = __builtin_cpu_supports("avx2");
+#endif // _MSC_VER
+                    if (avx2)
+                    {
+                        out = SIMD::AVX2;
+                    }
+                    else if (ssse3)
+                    {
+                        out = SIMD::SSSE3;
+                    }
+#endif // DJV_CORE_X86
+                    return out;
+                }
+
+                std::atomic<SIMD>& getSIMDValue() noexcept
+                {
+                    static std::atomic<SIMD> value(getSupportedSIMD());
+                    return value;
+                }
+
+            } // namespace
+
             std::string getSizeLabel(uint64_t value)
             {
                 std::stringstream ss;
@@ -66,7 +227,9 @@ namespace djv
                 size_t size,
                 size_t wordSize) noexcept
             {
-                uint8_t* p = reinterpret_cast<uint8_t*>(in);
+                const size_t simd = endianSIMD(in, in, size, wordSize);
+                size -= simd;
+                uint8_t* p = reinterpret_cast<uint8_t*>(in) + simd * wordSize;
                 uint8_t tmp;
                 switch (wordSize)
                 {
@@ -119,8 +282,10 @@ namespace djv
                 size_t      size,
                 size_t      wordSize) noexcept
             {
-                const uint8_t* inP = reinterpret_cast<const uint8_t*>(in);
-                uint8_t* outP = reinterpret_cast<uint8_t*>(out);
+                const size_t simd = endianSIMD(in, out, size, wordSize);
+                size -= simd;
+                const uint8_t* inP = reinterpret_cast<const uint8_t*>(in) + simd * wordSize;
+                uint8_t* outP = reinterpret_cast<uint8_t*>(out) + simd * wordSize;
                 switch (wordSize)
                 {
                 case 2:
@@ -162,11 +327,27 @@ namespace djv
                     }
                     break;
                 default:
-                    memcpy(out, in, size * wordSize);
+                    memcpy(outP, inP, size * wordSize);
                     break;
                 }
             }
 
+            SIMD getSupportedSIMD() noexcept
+            {
+                static const SIMD value = detectSIMD();
+                return value;
+            }
+
+            SIMD getSIMD() noexcept
+            {
+                return getSIMDValue();
+            }
+
+            void setSIMD(SIMD value) noexcept
+            {
+                getSIMDValue() = std::min(value, getSupportedSIMD());
+            }
+
             DJV_ENUM_HELPERS_IMPLEMENTATION(Unit);
             DJV_ENUM_HELPERS_IMPLEMENTATION(Endian);
 
@@ -36,7 +36,8 @@ namespace djv
             //! Get the opposite of the given endian.
             Endian opposite(Endian) noexcept;
 
-            //! Convert the endianness of a block of memory in place.
+            //! Convert the endianness of a block of memory in place. Word sizes
+            //! of 2, 4, and 8 use the SIMD instruction set from getSIMD().
             void endian(
                 void*  in,
                 size_t size,
@@ -51,6 +52,22 @@ namespace djv
 
             ///@}
 
+            //! \name SIMD
+            ///@{
+
+            //! Get the SIMD instruction set supported by the CPU.
+            SIMD getSupportedSIMD() noexcept;
+
+            //! Get the SIMD instruction set used by the kernels.
+            SIMD getSIMD() noexcept;
+
+            //! Set the SIMD instruction set used by the kernels. The value is
+            //! limited to what the CPU supports. This is intended for
+            //! comparing the kernels against the scalar code.
+            void setSIMD(SIMD) noexcept;
+
+            ///@}
+
             //! Combine hashes.
             //!
             //! References:
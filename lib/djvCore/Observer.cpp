@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCore/Observer.h>
+
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace Observer
+        {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const size_t dispatchPassesMax = 10;
+
+                std::vector<std::weak_ptr<IDeferred> >& getQueue()
+                {
+                    thread_local std::vector<std::weak_ptr<IDeferred> > queue;
+                    return queue;
+                }
+
+            } // namespace
+
+            IDeferred::~IDeferred()
+            {}
+
+            void queueDeferred(const std::weak_ptr<IDeferred>& value)
+            {
+                getQueue().push_back(value);
+            }
+
+            size_t getDeferredCount()
+            {
+                return getQueue().size();
+            }
+
+            void dispatchDeferred()
+            {
+                auto& queue = getQueue();
+                std::vector<std::weak_ptr<IDeferred> > subjects;
+                for (size_t i = 0; i < dispatchPassesMax && !queue.empty(); ++i)
+                {
+                    // Swap the queue so that observers can defer new changes
+                    // while the subjects are being dispatched.
+                    subjects.swap(queue);
+                    for (const auto& j : subjects)
+                    {
+                        if (auto subject = j.lock())
+                        {
+                            subject->dispatchDeferred();
+                        }
+                    }
+                    subjects.clear();
+                }
+            }
+
+        } // namespace Observer
+    } // namespace Core
+} // namespace djv
@@ -6,6 +6,8 @@
 
 #include <djvCore/Core.h>
 
+#include <memory>
+
 namespace djv
 {
     namespace Core
@@ -20,6 +22,35 @@ namespace djv
                 Suppress
             };
 
+            //! This class provides the interface for subjects that can defer
+            //! notifications.
+            class IDeferred
+            {
+            public:
+                virtual ~IDeferred() = 0;
+
+                //! Notify the observers of the deferred changes.
+                virtual void dispatchDeferred() = 0;
+            };
+
+            //! \name Deferred Notifications
+            ///@{
+
+            //! Queue a subject to be dispatched. The queue is per thread.
+            void queueDeferred(const std::weak_ptr<IDeferred>&);
+
+            //! Get the number of subjects waiting to be dispatched on the
+            //! current thread.
+            size_t getDeferredCount();
+
+            //! Dispatch the subjects that are waiting on the current thread.
+            //! Subjects that are deferred again by the observers are also
+            //! dispatched, up to a maximum number of passes. This is called by
+            //! the application context each tick.
+            void dispatchDeferred();
+
+            ///@}
+
         } // namespace Observer
     } // namespace Core
 } // namespace djv
@@ -66,15 +66,27 @@ namespace djv
             protected:
                 void _add(const std::weak_ptr<Value<T> >&);
                 void _removeExpired();
+                void _pruneExpired();
+                void _notify(const T&);
 
+                //! Expired observers are counted and removed in batches, they
+                //! are never removed while the observers are being notified.
                 std::vector<std::weak_ptr<Value<T> > > _observers;
+                size_t _expiredCount = 0;
+                size_t _notifyDepth = 0;
 
                 friend class Value<T>;
             };
 
             //! This class provides a value subject.
+            //!
+            //! Changes can be deferred with setDeferred() so that several
+            //! changes during a tick only notify the observers once.
             template<typename T>
-            class ValueSubject : public IValueSubject<T>
+            class ValueSubject :
+                public IValueSubject<T>,
+                public IDeferred,
+                public std::enable_shared_from_this<ValueSubject<T> >
             {
                 DJV_NON_COPYABLE(ValueSubject);
 
@@ -95,10 +107,18 @@ namespace djv
                 //! Set the value only if it has changed.
                 bool setIfChanged(const T&);
 
+                //! Set the value only if it has changed, and notify the
+                //! observers when the deferred notifications are dispatched.
+                //! The new value is available from get() immediately.
+                bool setDeferred(const T&);
+
                 const T& get() const override;
 
+                void dispatchDeferred() override;
+
             private:
                 T _value = T();
+                bool _deferred = false;
             };
 
         } // namespace Observer
@@ -54,7 +54,7 @@ namespace djv
             template<typename T>
             inline size_t IValueSubject<T>::getObserversCount() const
             {
-                return _observers.size();
+                return _observers.size() - _expiredCount;
             }
 
             template<typename T>
@@ -66,18 +66,44 @@ namespace djv
             template<typename T>
             inline void IValueSubject<T>::_removeExpired()
             {
-                auto i = _observers.begin();
-                while (i != _observers.end())
+                ++_expiredCount;
+                _pruneExpired();
+            }
+
+            template<typename T>
+            inline void IValueSubject<T>::_pruneExpired()
+            {
+                if (0 == _notifyDepth && _expiredCount > 0 && _expiredCount * 2 >= _observers.size())
                 {
-                    if (i->expired())
-                    {
-                        i = _observers.erase(i);
-                    }
-                    else
+                    _observers.erase(
+                        std::remove_if(
+                            _observers.begin(),
+                            _observers.end(),
+                            [](const std::weak_ptr<Value<T> >& value)
+                            {
+                                return value.expired();
+                            }),
+                        _observers.end());
+                    _expiredCount = 0;
+                }
+            }
+
+            template<typename T>
+            inline void IValueSubject<T>::_notify(const T& value)
+            {
+                // Observers may be added or destroyed by the callbacks, so the
+                // list is indexed instead of iterated.
+                ++_notifyDepth;
+                const size_t size = _observers.size();
+                for (size_t i = 0; i < size; ++i)
+                {
+                    if (auto observer = _observers[i].lock())
                     {
-                        ++i;
+                        observer->doCallback(value);
                     }
                 }
+                --_notifyDepth;
+                _pruneExpired();
             }
 
             template<typename T>
@@ -116,13 +142,8 @@ namespace djv
             inline void ValueSubject<T>::setAlways(const T& value)
             {
                 _value = value;
-                for (const auto& s : IValueSubject<T>::_observers)
-                {
-                    if (auto observer = s.lock())
-                    {
-                        observer->doCallback(_value);
-                    }
-                }
+                _deferred = false;
+                IValueSubject<T>::_notify(_value);
             }
 
             template<typename T>
@@ -131,12 +152,21 @@ namespace djv
                 if (value == _value)
                     return false;
                 _value = value;
-                for (const auto& s : IValueSubject<T>::_observers)
+                _deferred = false;
+                IValueSubject<T>::_notify(_value);
+                return true;
+            }
+
+            template<typename T>
+            inline bool ValueSubject<T>::setDeferred(const T& value)
+            {
+                if (value == _value)
+                    return false;
+                _value = value;
+                if (!_deferred)
                 {
-                    if (auto observer = s.lock())
-                    {
-                        observer->doCallback(_value);
-                    }
+                    _deferred = true;
+                    queueDeferred(std::enable_shared_from_this<ValueSubject<T> >::shared_from_this());
                 }
                 return true;
             }
@@ -147,6 +177,16 @@ namespace djv
                 return _value;
             }
 
+            template<typename T>
+            inline void ValueSubject<T>::dispatchDeferred()
+            {
+                if (_deferred)
+                {
+                    _deferred = false;
+                    IValueSubject<T>::_notify(_value);
+                }
+            }
+
         } // namespace Observer
     } // namespace Core
 } // namespace djv
@@ -18,10 +18,12 @@
 #include <djvGL/GLFWSystem.h>
 
 #include <djvSystem/TextSystem.h>
+#include <djvSystem/TimerFunc.h>
 
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -31,6 +33,13 @@ namespace djv
 {
     namespace Desktop
     {
+        namespace
+        {
+            //! \todo Should this be configurable?
+            const System::TimerValue idleTimeout = System::TimerValue::Medium;
+
+        } // namespace
+
         struct Application::Private
         {
             std::shared_ptr<EventSystem> eventSystem;
@@ -61,6 +70,14 @@ namespace djv
             GLFWSystem::create(shared_from_this());
             UI::UISystem::create(resetSettings, shared_from_this());
             p.eventSystem = EventSystem::create(getSystemT<GL::GLFW::GLFWSystem>()->getWindow(), shared_from_this());
+
+            // Wake the event loop with an empty event, glfwPostEmptyEvent()
+            // can be called from any thread.
+            setWakeCallback(
+                []
+                {
+                    glfwPostEmptyEvent();
+                });
         }
         
         Application::Application() :
@@ -68,7 +85,10 @@ namespace djv
         {}
         
         Application::~Application()
-        {}
+        {
+            // The window system is destroyed with the context systems.
+            setWakeCallback(nullptr);
+        }
 
         std::shared_ptr<Application> Application::create(std::list<std::string>& args)
         {
@@ -85,11 +105,30 @@ namespace djv
             {
                 glfwShowWindow(glfwWindow);
                 _setRunning(true);
+                const auto idleDuration = System::getTimerDuration(idleTimeout);
+                glfwPollEvents();
                 while (_isRunning() && glfwWindow && !glfwWindowShouldClose(glfwWindow))
                 {
-                    glfwPollEvents();
                     tick();
-                    glfwSwapBuffers(glfwWindow);
+
+                    // Only swap the buffers when the window has been painted.
+                    if (p.eventSystem->swapRequestReset())
+                    {
+                        glfwSwapBuffers(glfwWindow);
+                    }
+
+                    // Wait for input events, the next system deadline, or a
+                    // wake up from a worker thread.
+                    const auto now = std::chrono::steady_clock::now();
+                    const auto deadline = std::min(getTickDeadline(), now + idleDuration);
+                    if (deadline > now)
+                    {
+                        glfwWaitEventsTimeout(std::chrono::duration<double>(deadline - now).count());
+                    }
+                    else
+                    {
+                        glfwPollEvents();
+                    }
                 }
             }
         }
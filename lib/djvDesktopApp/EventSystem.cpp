@@ -34,6 +34,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 #endif // DJV_GL_ES2
 
+#include <cmath>
 #include <codecvt>
 #include <locale>
 
@@ -69,6 +70,7 @@ namespace djv
             glm::vec2 contentScale = glm::vec2(1.F, 1.F);
             std::shared_ptr<Render2D::Render> render;
             std::shared_ptr<GL::OffscreenBuffer> offscreenBuffer;
+            bool swapRequest = false;
 #if defined(DJV_GL_ES2)
             std::shared_ptr<GL::Shader> shader;
 #endif // DJV_GL_ES2
@@ -173,6 +175,14 @@ namespace djv
             glfwSetClipboardString(p.glfwWindow, value.c_str());
         }
 
+        bool EventSystem::swapRequestReset()
+        {
+            DJV_PRIVATE_PTR();
+            const bool out = p.swapRequest;
+            p.swapRequest = false;
+            return out;
+        }
+
         void EventSystem::tick()
         {
             UI::EventSystem::tick();
@@ -216,7 +226,8 @@ namespace djv
 
             if (p.offscreenBuffer)
             {
-                const bool redrawRequest = _redrawRequestReset();
+                Math::BBox2f redrawRegion;
+                const bool redrawRequest = _redrawRequestReset(redrawRegion);
                 const auto& size = p.offscreenBuffer->getSize();
                 if (resizeRequest)
                 {
@@ -246,16 +257,27 @@ namespace djv
 
                 if (resizeRequest || redrawRequest)
                 {
+                    // Only repaint the damaged region unless the entire window
+                    // needs to be updated. The offscreen buffer preserves the
+                    // contents outside of the region from the previous frame.
+                    const Math::BBox2f bbox(0.F, 0.F, static_cast<float>(size.w), static_cast<float>(size.h));
+                    Math::BBox2f region = bbox;
+                    if (!resizeRequest && redrawRegion.isValid())
+                    {
+                        region = Math::BBox2f(
+                            glm::vec2(floorf(redrawRegion.min.x), floorf(redrawRegion.min.y)),
+                            glm::vec2(ceilf(redrawRegion.max.x), ceilf(redrawRegion.max.y))).intersect(bbox);
+                    }
                     p.offscreenBuffer->bind();
-                    p.render->beginFrame(size);
+                    p.render->beginFrame(size, region);
                     for (const auto& i : _getWindows())
                     {
                         if (auto window = i.lock())
                         {
                             if (window->isVisible())
                             {
-                                System::Event::Paint paintEvent(Math::BBox2f(0.F, 0.F, static_cast<float>(size.w), static_cast<float>(size.h)));
-                                System::Event::PaintOverlay paintOverlayEvent(Math::BBox2f(0.F, 0.F, static_cast<float>(size.w), static_cast<float>(size.h)));
+                                System::Event::Paint paintEvent(region);
+                                System::Event::PaintOverlay paintOverlayEvent(region);
                                 _paintRecursive(window, paintEvent, paintOverlayEvent);
                             }
                         }
@@ -263,10 +285,10 @@ namespace djv
                     p.render->endFrame();
 
                     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+                    _redraw();
                 }
             }
-
-            _redraw();
         }
 
         void EventSystem::_pushClipRect(const Math::BBox2f& value)
@@ -317,6 +339,7 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (p.offscreenBuffer)
             {
+                p.swapRequest = true;
                 glDisable(GL_DEPTH_TEST);
                 glDisable(GL_SCISSOR_TEST);
                 glDisable(GL_BLEND);
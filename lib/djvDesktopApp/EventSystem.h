@@ -37,6 +37,10 @@ namespace djv
             std::string getClipboard() const override;
             void setClipboard(const std::string&) override;
 
+            //! Get whether the window contents have changed since the last
+            //! call, and the window buffers need to be swapped.
+            bool swapRequestReset();
+
             void tick() override;
 
         protected:
@@ -18,6 +18,7 @@ namespace djv
             const std::array<size_t, static_cast<size_t>(VBOType::Count)> data =
             {
                 12, // 2 * sizeof(float) + 2 * sizeof(uint16_t)
+                16, // 2 * sizeof(float) + 2 * sizeof(uint16_t) + sizeof(PackedColor)
                 12, // 3 * sizeof(float)
                 16, // 3 * sizeof(float) + 2 * sizeof(uint16_t)
                 20, // 3 * sizeof(float) + 2 * sizeof(uint16_t) + sizeof(PackedNormal)
@@ -37,6 +38,7 @@ namespace djv
         GL,
         VBOType,
         DJV_TEXT("vbo_type_pos2_f32_uv_u16"),
+        DJV_TEXT("vbo_type_pos2_f32_uv_u16_color_u8"),
         DJV_TEXT("vbo_type_pos3_f32"),
         DJV_TEXT("vbo_type_pos3_f32_uv_u16"),
         DJV_TEXT("vbo_type_pos3_f32_uv_u16_normal_u10"),
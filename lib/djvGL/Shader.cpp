@@ -66,6 +66,16 @@ namespace djv
             _program = glCreateProgram();
             glAttachShader(_program, _vertex);
             glAttachShader(_program, _fragment);
+#if defined(DJV_GL_ES2)
+            // GLSL ES 1.00 does not have layout qualifiers so bind the
+            // attributes to the locations used by the VBO types. The 2D
+            // shaders use location 2 for the color and the 3D shaders use it
+            // for the normal.
+            glBindAttribLocation(_program, 0, "aPos");
+            glBindAttribLocation(_program, 1, "aTexture");
+            glBindAttribLocation(_program, 2, "aNormal");
+            glBindAttribLocation(_program, 2, "aColor");
+#endif // DJV_GL_ES2
             glLinkProgram(_program);
             glGetProgramiv(_program, GL_LINK_STATUS, &success);
             if (!success)
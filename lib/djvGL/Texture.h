@@ -45,6 +45,11 @@ namespace djv
             void set(const Image::Info&);
             void copy(const Image::Data&);
             void copy(const Image::Data&, uint16_t x, uint16_t y);
+#if !defined(DJV_GL_ES2)
+            //! Copy from the pixel buffer object that is bound to
+            //! GL_PIXEL_UNPACK_BUFFER, starting at the given byte offset.
+            void copyFromPixelBuffer(const Image::Info&, size_t offset = 0);
+#endif // DJV_GL_ES2
 
             void bind();
 
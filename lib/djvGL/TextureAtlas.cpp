@@ -5,9 +5,10 @@
 #include <djvGL/TextureAtlas.h>
 
 #include <djvGL/Texture.h>
+#include <djvGL/TextureAtlasPrivate.h>
 
-#include <djvMath/BBox.h>
-
+#include <algorithm>
+#include <list>
 #include <map>
 #include <tuple>
 
@@ -19,114 +20,56 @@ namespace djv
     {
         namespace
         {
-            uint64_t _timestamp = 0;
-
-        } // namespace
-
-        //! This class provides the nodes used for box packing.
-        //!
-        //! References:
-        //! - http://blackpawn.com/texts/lightmaps/
-        class TextureAtlas::BoxPackingNode : public std::enable_shared_from_this< TextureAtlas::BoxPackingNode>
-        {
-        private:
-            explicit BoxPackingNode(int border);
-
-        public:
-            static std::shared_ptr<BoxPackingNode> create(int border);
-
-            UID uid = 0;
-            uint64_t timestamp = 0;
-
-            Math::BBox2i bbox;
-            uint8_t border = 0;
-            uint8_t textureIndex = 0;
-            std::shared_ptr<BoxPackingNode> children[2];
-
-            bool isBranch() const { return children[0].get(); }
-            bool isOccupied() const { return uid != 0; }
-
-            std::shared_ptr<BoxPackingNode> insert(const std::shared_ptr<Image::Data>&);
-        };
-
-        TextureAtlas::BoxPackingNode::BoxPackingNode(int border) :
-            timestamp(++_timestamp),
-            border(border)
-        {}
-
-        std::shared_ptr<TextureAtlas::BoxPackingNode> TextureAtlas::BoxPackingNode::create(int border)
-        {
-            auto out = std::shared_ptr<BoxPackingNode>(new BoxPackingNode(border));
-            return out;
-        }
+            //! \todo Should this be configurable?
+            const float compactFragmentationMin = .25F;
 
-        std::shared_ptr<TextureAtlas::BoxPackingNode> TextureAtlas::BoxPackingNode::insert(const std::shared_ptr<Image::Data>& data)
-        {
-            if (isBranch())
+            struct Page
             {
-                if (auto node = children[0]->insert(data))
-                {
-                    return node;
-                }
-                return children[1]->insert(data);
-            }
-            else if (isOccupied())
+                std::shared_ptr<Texture> texture;
+                TextureAtlasPacker packer;
+                std::list<UID> lru;
+                bool dirty = false;
+            };
+
+            struct Item
             {
-                return nullptr;
-            }
-            else
+                TextureAtlasRect rect;
+                uint8_t textureIndex = 0;
+                uint64_t timestamp = 0;
+                std::list<UID>::iterator lru;
+            };
+
+            //! This struct provides the state of a compaction that is in
+            //! progress. The items are copied to the spare texture a few at a
+            //! time, and keep their old locations until the compaction is
+            //! finished and the textures are swapped.
+            struct Compaction
             {
-                const glm::ivec2& dataSize = glm::ivec2(data->getWidth(), data->getHeight()) + border * 2;
-                const glm::ivec2& bboxSize = bbox.getSize();
-                if (dataSize.x > bboxSize.x || dataSize.y > bboxSize.y)
-                {
-                    return nullptr;
-                }
-                if (dataSize == bboxSize)
-                {
-                    return shared_from_this();
-                }
-                children[0] = create(border);
-                children[1] = create(border);
-                const int dw = bboxSize.x - dataSize.x;
-                const int dh = bboxSize.y - dataSize.y;
-                if (dw > dh)
-                {
-                    children[0]->bbox.min.x = bbox.min.x;
-                    children[0]->bbox.min.y = bbox.min.y;
-                    children[0]->bbox.max.x = bbox.min.x + dataSize.x - 1;
-                    children[0]->bbox.max.y = bbox.max.y;
-                    children[1]->bbox.min.x = bbox.min.x + dataSize.x;
-                    children[1]->bbox.min.y = bbox.min.y;
-                    children[1]->bbox.max.x = bbox.max.x;
-                    children[1]->bbox.max.y = bbox.max.y;
-                }
-                else
-                {
-                    children[0]->bbox.min.x = bbox.min.x;
-                    children[0]->bbox.min.y = bbox.min.y;
-                    children[0]->bbox.max.x = bbox.max.x;
-                    children[0]->bbox.max.y = bbox.min.y + dataSize.y - 1;
-                    children[1]->bbox.min.x = bbox.min.x;
-                    children[1]->bbox.min.y = bbox.min.y + dataSize.y;
-                    children[1]->bbox.max.x = bbox.max.x;
-                    children[1]->bbox.max.y = bbox.max.y;
-                }
-                children[0]->textureIndex = textureIndex;
-                children[1]->textureIndex = textureIndex;
-                return children[0]->insert(data);
-            }
-        }
+                uint8_t textureIndex = 0;
+                TextureAtlasPacker packer;
+                std::vector<UID> uids;
+                size_t next = 0;
+                std::map<UID, TextureAtlasRect> rects;
+            };
+
+        } // namespace
 
         struct TextureAtlas::Private
         {
             uint8_t textureCount = 0;
             uint16_t textureSize = 0;
             Image::Type textureType = Image::Type::None;
+            GLenum filter = GL_LINEAR;
             uint8_t border = 0;
-            std::vector<std::shared_ptr<Texture> > textures;
-            std::vector<std::shared_ptr<BoxPackingNode> > boxPackingNodes;
-            std::map<UID, std::shared_ptr<BoxPackingNode> > cache;
+            std::vector<Page> pages;
+            std::shared_ptr<Texture> spareTexture;
+            std::unique_ptr<Compaction> compaction;
+            std::map<UID, Item> items;
+            UID uid = 0;
+            uint64_t timestamp = 0;
+            TextureAtlasStats stats;
+
+            void toTextureAtlasItem(const Item&, TextureAtlasItem&) const;
         };
 
         TextureAtlas::TextureAtlas(uint8_t textureCount, uint16_t textureSize, Image::Type textureType, GLenum filter, uint8_t border) :
@@ -136,19 +79,15 @@ namespace djv
             p.textureCount = textureCount;
             p.textureSize = textureSize;
             p.textureType = textureType;
+            p.filter = filter;
+            p.border = border;
 
             for (uint8_t i = 0; i < p.textureCount; ++i)
             {
-                auto texture = Texture::create(Image::Info(textureSize, textureSize, textureType), filter, filter);
-                p.textures.push_back(std::move(texture));
-
-                auto node = BoxPackingNode::create(border);
-                node->bbox.min.x = 0;
-                node->bbox.min.y = 0;
-                node->bbox.max.x = textureSize - 1;
-                node->bbox.max.y = textureSize - 1;
-                node->textureIndex = i;
-                p.boxPackingNodes.push_back(node);
+                Page page;
+                page.texture = Texture::create(Image::Info(textureSize, textureSize, textureType), filter, filter);
+                page.packer = TextureAtlasPacker(textureSize);
+                p.pages.push_back(std::move(page));
             }
         }
 
@@ -174,9 +113,9 @@ namespace djv
         {
             DJV_PRIVATE_PTR();
             std::vector<GLuint> out;
-            for (const auto& i : p.textures)
+            for (const auto& i : p.pages)
             {
-                out.push_back(i->getID());
+                out.push_back(i.texture->getID());
             }
             return out;
         }
@@ -184,11 +123,14 @@ namespace djv
         bool TextureAtlas::getItem(UID uid, TextureAtlasItem& out)
         {
             DJV_PRIVATE_PTR();
-            const auto& i = p.cache.find(uid);
-            if (i != p.cache.end())
+            const auto i = p.items.find(uid);
+            if (i != p.items.end())
             {
-                _toTextureAtlasItem(i->second, out);
-                i->second->timestamp = ++_timestamp;
+                auto& item = i->second;
+                auto& lru = p.pages[item.textureIndex].lru;
+                lru.splice(lru.end(), lru, item.lru);
+                item.timestamp = ++p.timestamp;
+                p.toTextureAtlasItem(item, out);
                 return true;
             }
             return false;
@@ -197,73 +139,121 @@ namespace djv
         UID TextureAtlas::addItem(const std::shared_ptr<Image::Data>& data, TextureAtlasItem& out)
         {
             DJV_PRIVATE_PTR();
-
-            static UID _uid = 0;
-
-            for (uint8_t i = 0; i < p.textureCount; ++i)
+            const int w = std::max(data->getWidth() + p.border * 2, 1);
+            const int h = std::max(data->getHeight() + p.border * 2, 1);
+            if (w > p.textureSize || h > p.textureSize)
+                return 0;
+
+            Item item;
+            bool found = false;
+            for (uint8_t i = 0; i < p.textureCount && !found; ++i)
             {
-                if (auto node = p.boxPackingNodes[i]->insert(data))
+                if (p.pages[i].packer.insert(w, h, item.rect))
                 {
-                    // The data has been added to the atlas.
-                    node->uid = ++_uid;
-                    p.textures[node->textureIndex]->copy(*data, node->bbox.min.x + p.border, node->bbox.min.y + p.border);
-                    p.cache[node->uid] = node;
-                    _toTextureAtlasItem(node, out);
-                    return node->uid;
+                    item.textureIndex = i;
+                    found = true;
                 }
             }
 
-            // The atlas is full, over-write older data.
-            std::vector<std::shared_ptr<BoxPackingNode> > nodes;
-            for (uint8_t i = 0; i < p.textureCount; ++i)
+            if (!found)
             {
-                _getAllNodes(p.boxPackingNodes[i], nodes);
-            }
-            std::sort(nodes.begin(), nodes.end(),
-                [](const std::shared_ptr<BoxPackingNode>& a, const std::shared_ptr<BoxPackingNode>& b)
-            {
-                const int aArea = a->bbox.getArea();
-                const int bArea = b->bbox.getArea();
-                return std::tie(aArea, a->timestamp) < std::tie(bArea, b->timestamp);
-            });
-            const glm::ivec2 dataSize = glm::ivec2(data->getWidth(), data->getHeight()) + p.border * 2;
-            for (auto node : nodes)
-            {
-                const glm::ivec2 nodeSize = node->bbox.getSize();
-                if (dataSize.x <= nodeSize.x && dataSize.y <= nodeSize.y)
+                // The atlas is full, evict the least recently used items from
+                // the texture with the oldest item until there is room.
+                size_t index = p.pages.size();
+                uint64_t timestamp = 0;
+                for (size_t i = 0; i < p.pages.size(); ++i)
                 {
-                    auto old = node;
-                    _removeFromAtlas(old);
-                    if (old->isBranch())
+                    const auto& lru = p.pages[i].lru;
+                    if (!lru.empty())
                     {
-                        for (uint8_t i = 0; i < 2; ++i)
+                        const uint64_t t = p.items[lru.front()].timestamp;
+                        if (index == p.pages.size() || t < timestamp)
                         {
-                            old->children[i].reset();
+                            index = i;
+                            timestamp = t;
                         }
                     }
-                    old->uid = 0;
-                    old->timestamp = ++_timestamp;
-                    if (auto node2 = old->insert(data))
+                }
+                if (index < p.pages.size())
+                {
+                    auto& page = p.pages[index];
+                    while (!found && !page.lru.empty())
                     {
-                        node2->uid = ++_uid;
-
-                        //! \todo Do we need to zero out the old data?
-                        //auto zero = Image::Data::create(Image::Info(data->getSize() + p.border * 2, p.textureType));
-                        //zero->zero();
-                        //p.textures[node2->texture]->copy(zero, node2->bbox.min);
+                        _evict(page.lru.front());
+                        if (page.lru.empty())
+                        {
+                            page.packer.clear();
+                            page.dirty = false;
+                        }
+                        found = page.packer.insert(w, h, item.rect);
+                    }
+                    item.textureIndex = static_cast<uint8_t>(index);
+                }
+            }
 
-                        p.textures[node2->textureIndex]->copy(
-                            *data,
-                            static_cast<uint16_t>(node2->bbox.min.x + p.border),
-                            static_cast<uint16_t>(node2->bbox.min.y + p.border));
-                        p.cache[node2->uid] = node2;
-                        _toTextureAtlasItem(node2, out);
+            UID out2 = 0;
+            if (found)
+            {
+                auto& page = p.pages[item.textureIndex];
+                page.texture->copy(
+                    *data,
+                    static_cast<uint16_t>(item.rect.x + p.border),
+                    static_cast<uint16_t>(item.rect.y + p.border));
+                out2 = ++p.uid;
+                item.timestamp = ++p.timestamp;
+                item.lru = page.lru.insert(page.lru.end(), out2);
+                p.items[out2] = item;
+                if (p.compaction && p.compaction->textureIndex == item.textureIndex)
+                {
+                    p.compaction->uids.push_back(out2);
+                }
+                p.toTextureAtlasItem(item, out);
+                ++p.stats.addCount;
+                p.stats.uploadByteCount += data->getDataByteCount();
+            }
+            return out2;
+        }
 
-                        return node2->uid;
+        bool TextureAtlas::compact(size_t itemMax)
+        {
+            DJV_PRIVATE_PTR();
+            if (!p.compaction)
+            {
+                size_t index = p.pages.size();
+                float fragmentation = compactFragmentationMin;
+                for (size_t i = 0; i < p.pages.size(); ++i)
+                {
+                    if (p.pages[i].dirty)
+                    {
+                        const float f = p.pages[i].packer.getFragmentation();
+                        if (f >= fragmentation)
+                        {
+                            index = i;
+                            fragmentation = f;
+                        }
                     }
                 }
+                if (index == p.pages.size())
+                    return false;
+
+                // Re-pack the items from largest to smallest.
+                auto& page = p.pages[index];
+                page.dirty = false;
+                p.compaction.reset(new Compaction);
+                p.compaction->textureIndex = static_cast<uint8_t>(index);
+                p.compaction->packer = TextureAtlasPacker(p.textureSize);
+                p.compaction->uids = std::vector<UID>(page.lru.begin(), page.lru.end());
+                std::stable_sort(
+                    p.compaction->uids.begin(),
+                    p.compaction->uids.end(),
+                    [&p](UID a, UID b)
+                    {
+                        const auto& aRect = p.items[a].rect;
+                        const auto& bRect = p.items[b].rect;
+                        return std::tie(bRect.h, bRect.w) < std::tie(aRect.h, aRect.w);
+                    });
             }
-            return 0;
+            return _compact(itemMax);
         }
 
         float TextureAtlas::getPercentageUsed() const
@@ -274,82 +264,151 @@ namespace djv
             {
                 for (uint8_t i = 0; i < p.textureCount; ++i)
                 {
-                    size_t used = 0;
-                    std::vector<std::shared_ptr<BoxPackingNode> > leafs;
-                    _getLeafNodes(p.boxPackingNodes[i], leafs);
-                    for (const auto& j : leafs)
-                    {
-                        if (j->isOccupied())
-                        {
-                            used += j->bbox.getArea();
-                        }
-                    }
-                    out += static_cast<float>(used);
+                    out += getPercentageUsed(i);
                 }
-                out /= static_cast<float>(p.textureSize * p.textureSize);
                 out /= static_cast<float>(p.textureCount);
-                out *= 100.F;
             }
             return out;
         }
 
-        void TextureAtlas::_getAllNodes(
-            const std::shared_ptr<BoxPackingNode>& node,
-            std::vector<std::shared_ptr<BoxPackingNode> >& out)
+        float TextureAtlas::getPercentageUsed(uint8_t textureIndex) const
         {
-            out.push_back(node);
-            if (node->isBranch())
+            DJV_PRIVATE_PTR();
+            float out = 0.F;
+            if (textureIndex < p.textureCount && p.textureSize)
             {
-                _getAllNodes(node->children[0], out);
-                _getAllNodes(node->children[1], out);
+                out = p.pages[textureIndex].packer.getUsedArea() /
+                    static_cast<float>(p.textureSize * p.textureSize) * 100.F;
             }
+            return out;
         }
 
-        void TextureAtlas::_getLeafNodes(
-            const std::shared_ptr<BoxPackingNode>& node,
-            std::vector<std::shared_ptr<BoxPackingNode> >& out) const
+        TextureAtlasStats TextureAtlas::getStats() const
         {
-            if (node->isBranch())
-            {
-                _getLeafNodes(node->children[0], out);
-                _getLeafNodes(node->children[1], out);
-            }
-            else
-            {
-                out.push_back(node);
-            }
+            DJV_PRIVATE_PTR();
+            TextureAtlasStats out = p.stats;
+            out.itemCount = p.items.size();
+            return out;
         }
 
-        void TextureAtlas::_toTextureAtlasItem(
-            const std::shared_ptr<BoxPackingNode>& node,
-            TextureAtlasItem& out)
+        void TextureAtlas::_evict(UID uid)
         {
             DJV_PRIVATE_PTR();
-            out.w = node->bbox.w();
-            out.h = node->bbox.h();
-            out.textureIndex = node->textureIndex;
-            out.textureU = Math::FloatRange(
-                (node->bbox.min.x + static_cast<float>(p.border))       / static_cast<float>(p.textureSize),
-                (node->bbox.max.x - static_cast<float>(p.border) + 1.F) / static_cast<float>(p.textureSize));
-            out.textureV = Math::FloatRange(
-                (node->bbox.min.y + static_cast<float>(p.border))       / static_cast<float>(p.textureSize),
-                (node->bbox.max.y - static_cast<float>(p.border) + 1.F) / static_cast<float>(p.textureSize));
+            const auto i = p.items.find(uid);
+            if (i != p.items.end())
+            {
+                auto& page = p.pages[i->second.textureIndex];
+                page.packer.remove(i->second.rect);
+                if (p.compaction && p.compaction->textureIndex == i->second.textureIndex)
+                {
+                    const auto j = p.compaction->rects.find(uid);
+                    if (j != p.compaction->rects.end())
+                    {
+                        p.compaction->packer.remove(j->second);
+                        p.compaction->rects.erase(j);
+                    }
+                }
+                page.lru.erase(i->second.lru);
+                page.dirty = true;
+                p.items.erase(i);
+                ++p.stats.evictCount;
+            }
         }
 
-        void TextureAtlas::_removeFromAtlas(const std::shared_ptr<BoxPackingNode>& node)
+        bool TextureAtlas::_compact(size_t itemMax)
         {
             DJV_PRIVATE_PTR();
-            auto i = p.cache.find(node->uid);
-            if (i != p.cache.end())
+            auto& compaction = *p.compaction;
+            auto& page = p.pages[compaction.textureIndex];
+            if (!p.spareTexture)
             {
-                node->uid = 0;
-                p.cache.erase(i);
+                p.spareTexture = Texture::create(
+                    Image::Info(p.textureSize, p.textureSize, p.textureType),
+                    p.filter,
+                    p.filter);
             }
-            if (node->isBranch())
+
+            // Attach the texture to a framebuffer so the items can be copied
+            // on the GPU.
+            GLint framebufferBinding = 0;
+            GLint textureBinding = 0;
+            glGetIntegerv(GL_FRAMEBUFFER_BINDING, &framebufferBinding);
+            glGetIntegerv(GL_TEXTURE_BINDING_2D, &textureBinding);
+            GLuint framebuffer = 0;
+            glGenFramebuffers(1, &framebuffer);
+            glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, page.texture->getID(), 0);
+            const bool complete = GL_FRAMEBUFFER_COMPLETE == glCheckFramebufferStatus(GL_FRAMEBUFFER);
+            bool out = false;
+            if (complete)
             {
-                _removeFromAtlas(node->children[0]);
-                _removeFromAtlas(node->children[1]);
+                // Copy the next items. Items that were evicted since the
+                // compaction started are skipped, and items that were added
+                // were appended to the list.
+                p.spareTexture->bind();
+                for (size_t i = 0; i < itemMax && compaction.next < compaction.uids.size(); ++compaction.next)
+                {
+                    const UID uid = compaction.uids[compaction.next];
+                    const auto j = p.items.find(uid);
+                    if (j == p.items.end() || j->second.textureIndex != compaction.textureIndex)
+                        continue;
+                    const auto& item = j->second;
+                    TextureAtlasRect rect;
+                    if (compaction.packer.insert(item.rect.w, item.rect.h, rect))
+                    {
+                        glCopyTexSubImage2D(
+                            GL_TEXTURE_2D,
+                            0,
+                            rect.x,
+                            rect.y,
+                            item.rect.x,
+                            item.rect.y,
+                            rect.w,
+                            rect.h);
+                        compaction.rects[uid] = rect;
+                    }
+                    else
+                    {
+                        _evict(uid);
+                    }
+                    ++i;
+                }
+
+                // When all of the items have been copied, move them to their
+                // new locations and swap the textures.
+                if (compaction.next == compaction.uids.size())
+                {
+                    for (const auto& i : compaction.rects)
+                    {
+                        p.items[i.first].rect = i.second;
+                    }
+                    page.packer = compaction.packer;
+                    std::swap(page.texture, p.spareTexture);
+                    ++p.stats.compactCount;
+                    out = true;
+                }
+            }
+            glBindFramebuffer(GL_FRAMEBUFFER, framebufferBinding);
+            glDeleteFramebuffers(1, &framebuffer);
+            glBindTexture(GL_TEXTURE_2D, textureBinding);
+            if (out || !complete)
+            {
+                p.compaction.reset();
             }
+            return out;
+        }
+
+        void TextureAtlas::Private::toTextureAtlasItem(const Item& item, TextureAtlasItem& out) const
+        {
+            out.w = item.rect.w;
+            out.h = item.rect.h;
+            out.textureIndex = item.textureIndex;
+            out.textureU = Math::FloatRange(
+                (item.rect.x + static_cast<float>(border))                / static_cast<float>(textureSize),
+                (item.rect.x + item.rect.w - static_cast<float>(border))  / static_cast<float>(textureSize));
+            out.textureV = Math::FloatRange(
+                (item.rect.y + static_cast<float>(border))                / static_cast<float>(textureSize),
+                (item.rect.y + item.rect.h - static_cast<float>(border))  / static_cast<float>(textureSize));
         }
 
     } // namespace GL
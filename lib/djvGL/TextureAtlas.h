@@ -32,7 +32,27 @@ namespace djv
             Math::FloatRange textureV;
         };
 
+        //! This struct provides texture atlas statistics. The counts are totals
+        //! since the atlas was created, compare them over time for the churn.
+        struct TextureAtlasStats
+        {
+            size_t itemCount       = 0; //!< The number of items in the atlas
+            size_t addCount        = 0; //!< The number of items added
+            size_t evictCount      = 0; //!< The number of items evicted to make room
+            size_t compactCount    = 0; //!< The number of textures compacted
+            size_t uploadByteCount = 0; //!< The number of bytes uploaded
+        };
+
         //! This class provides a texture atlas.
+        //!
+        //! Items are packed into each texture with a skyline, the space that
+        //! is left below the skyline and the space of evicted items is reused
+        //! for smaller items. When the atlas is full the least recently used
+        //! items are evicted from the texture with the oldest item.
+        //!
+        //! Evicting items leaves holes in the textures, compact() re-packs the
+        //! live items of the most fragmented texture into a new texture. The
+        //! items are copied a few at a time over several calls.
         class TextureAtlas
         {
             DJV_NON_COPYABLE(TextureAtlas);
@@ -46,25 +66,36 @@ namespace djv
             Image::Type getTextureType() const;
             std::vector<GLuint> getTextures() const;
 
+            //! Get an item. This also marks the item as recently used.
             bool getItem(Core::UID, TextureAtlasItem&);
 
+            //! Add an item. Returns zero if the item is larger than the
+            //! textures.
             Core::UID addItem(const std::shared_ptr<Image::Data>&, TextureAtlasItem&);
 
+            //! Compact the most fragmented texture if it is above the threshold.
+            //! At most the given number of items are copied, the compaction
+            //! continues with the next call. The item locations change when
+            //! the compaction is finished, so this should be called between
+            //! frames. Returns true if a texture finished compacting.
+            bool compact(size_t itemMax = 256);
+
+            //! \name Statistics
+            ///@{
+
+            //! Get the percentage of the atlas that is used.
             float getPercentageUsed() const;
 
+            //! Get the percentage of a texture that is used.
+            float getPercentageUsed(uint8_t textureIndex) const;
+
+            TextureAtlasStats getStats() const;
+
+            ///@}
+
         private:
-            class BoxPackingNode;
-
-            void _getAllNodes(
-                const std::shared_ptr<BoxPackingNode>&,
-                std::vector<std::shared_ptr<BoxPackingNode> >&);
-            void _getLeafNodes(
-                const std::shared_ptr<BoxPackingNode>&,
-                std::vector<std::shared_ptr<BoxPackingNode> >&) const;
-            void _toTextureAtlasItem(
-                const std::shared_ptr<BoxPackingNode>&,
-                TextureAtlasItem&);
-            void _removeFromAtlas(const std::shared_ptr<BoxPackingNode>&);
+            void _evict(Core::UID);
+            bool _compact(size_t itemMax);
 
             DJV_PRIVATE();
         };
@@ -0,0 +1,388 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvGL/TextureAtlasPrivate.h>
+
+#include <algorithm>
+#include <tuple>
+
+namespace djv
+{
+    namespace GL
+    {
+        namespace
+        {
+            bool intersects(const TextureAtlasRect& a, const TextureAtlasRect& b)
+            {
+                return
+                    a.x < b.x + b.w && b.x < a.x + a.w &&
+                    a.y < b.y + b.h && b.y < a.y + a.h;
+            }
+
+            bool contains(const TextureAtlasRect& a, const TextureAtlasRect& b)
+            {
+                return
+                    b.x >= a.x && b.x + b.w <= a.x + a.w &&
+                    b.y >= a.y && b.y + b.h <= a.y + a.h;
+            }
+
+            //! Combine two rectangles that touch into the rectangle that spans
+            //! both of them where they overlap.
+            bool combine(const TextureAtlasRect& a, const TextureAtlasRect& b, TextureAtlasRect& out)
+            {
+                const int x0 = std::max(a.x, b.x);
+                const int x1 = std::min(a.x + a.w, b.x + b.w);
+                const int y0 = std::max(a.y, b.y);
+                const int y1 = std::min(a.y + a.h, b.y + b.h);
+                if ((a.x + a.w == b.x || b.x + b.w == a.x) && y1 > y0)
+                {
+                    out = TextureAtlasRect(std::min(a.x, b.x), y0, a.w + b.w, y1 - y0);
+                    return true;
+                }
+                if ((a.y + a.h == b.y || b.y + b.h == a.y) && x1 > x0)
+                {
+                    out = TextureAtlasRect(x0, std::min(a.y, b.y), x1 - x0, a.h + b.h);
+                    return true;
+                }
+                return false;
+            }
+
+            size_t getArea(const TextureAtlasRect& value)
+            {
+                return static_cast<size_t>(value.w) * value.h;
+            }
+
+        } // namespace
+
+        TextureAtlasRect::TextureAtlasRect()
+        {}
+
+        TextureAtlasRect::TextureAtlasRect(int x, int y, int w, int h) :
+            x(x),
+            y(y),
+            w(w),
+            h(h)
+        {}
+
+        TextureAtlasPacker::TextureAtlasPacker(int size) :
+            _size(size)
+        {
+            clear();
+        }
+
+        size_t TextureAtlasPacker::getUsedArea() const
+        {
+            return _usedArea;
+        }
+
+        float TextureAtlasPacker::getFragmentation() const
+        {
+            size_t area = 0;
+            for (const auto& i : _skyline)
+            {
+                area += static_cast<size_t>(i.w) * i.y;
+            }
+            return _size > 0 ?
+                (area - _usedArea) / static_cast<float>(_size * _size) :
+                0.F;
+        }
+
+        size_t TextureAtlasPacker::getFreeCount() const
+        {
+            return _free.size();
+        }
+
+        bool TextureAtlasPacker::insert(int w, int h, TextureAtlasRect& out)
+        {
+            _minW = std::min(_minW, w);
+            _minH = std::min(_minH, h);
+            const bool result = _insertFree(w, h, out) || _insertSkyline(w, h, out);
+            if (result)
+            {
+                _usedArea += getArea(out);
+            }
+            return result;
+        }
+
+        void TextureAtlasPacker::remove(const TextureAtlasRect& value)
+        {
+            _usedArea -= getArea(value);
+            _addFree(value);
+            _limit();
+        }
+
+        void TextureAtlasPacker::clear()
+        {
+            _skyline.clear();
+            SkylineNode node;
+            node.w = _size;
+            _skyline.push_back(node);
+            _free.clear();
+            _usedArea = 0;
+            _minW = _size;
+            _minH = _size;
+        }
+
+        bool TextureAtlasPacker::_insertFree(int w, int h, TextureAtlasRect& out)
+        {
+            // Find the free rectangle with the best short side fit.
+            size_t index = _free.size();
+            int bestShort = 0;
+            int bestLong = 0;
+            for (size_t i = 0; i < _free.size(); ++i)
+            {
+                const auto& rect = _free[i];
+                if (w <= rect.w && h <= rect.h)
+                {
+                    const int dw = rect.w - w;
+                    const int dh = rect.h - h;
+                    const int shortSide = std::min(dw, dh);
+                    const int longSide = std::max(dw, dh);
+                    if (index == _free.size() ||
+                        std::tie(shortSide, longSide) < std::tie(bestShort, bestLong))
+                    {
+                        index = i;
+                        bestShort = shortSide;
+                        bestLong = longSide;
+                    }
+                }
+            }
+            if (index == _free.size())
+                return false;
+
+            out.x = _free[index].x;
+            out.y = _free[index].y;
+            out.w = w;
+            out.h = h;
+
+            // The free rectangles can overlap, split all of the ones that
+            // intersect the new item. The pieces that are too small for any
+            // item are dropped.
+            const size_t size = _free.size();
+            for (size_t i = 0; i < size; ++i)
+            {
+                const TextureAtlasRect rect = _free[i];
+                if (intersects(rect, out))
+                {
+                    TextureAtlasRect pieces[4];
+                    size_t pieceCount = 0;
+                    if (out.x > rect.x)
+                    {
+                        pieces[pieceCount++] = TextureAtlasRect(rect.x, rect.y, out.x - rect.x, rect.h);
+                    }
+                    if (out.x + out.w < rect.x + rect.w)
+                    {
+                        pieces[pieceCount++] = TextureAtlasRect(out.x + out.w, rect.y, rect.x + rect.w - out.x - out.w, rect.h);
+                    }
+                    if (out.y > rect.y)
+                    {
+                        pieces[pieceCount++] = TextureAtlasRect(rect.x, rect.y, rect.w, out.y - rect.y);
+                    }
+                    if (out.y + out.h < rect.y + rect.h)
+                    {
+                        pieces[pieceCount++] = TextureAtlasRect(rect.x, out.y + out.h, rect.w, rect.y + rect.h - out.y - out.h);
+                    }
+                    for (size_t j = 0; j < pieceCount; ++j)
+                    {
+                        if (!_isSliver(pieces[j]))
+                        {
+                            _free.push_back(pieces[j]);
+                        }
+                    }
+                    _free[i].w = 0;
+                }
+            }
+            _prune(size);
+            _limit();
+            return true;
+        }
+
+        bool TextureAtlasPacker::_insertSkyline(int w, int h, TextureAtlasRect& out)
+        {
+            // Skip the search if the item does not fit above the lowest node,
+            // which is the common case when the texture is full.
+            int minY = _size;
+            for (const auto& i : _skyline)
+            {
+                minY = std::min(minY, i.y);
+            }
+            if (minY + h > _size)
+                return false;
+
+            // Find the lowest position, and then the narrowest node.
+            size_t index = _skyline.size();
+            int bestY = 0;
+            int bestW = 0;
+            for (size_t i = 0; i < _skyline.size(); ++i)
+            {
+                int y = 0;
+                if (_fit(i, w, h, y) &&
+                    (index == _skyline.size() ||
+                     std::tie(y, _skyline[i].w) < std::tie(bestY, bestW)))
+                {
+                    index = i;
+                    bestY = y;
+                    bestW = _skyline[i].w;
+                }
+            }
+            if (index == _skyline.size())
+                return false;
+
+            out.x = _skyline[index].x;
+            out.y = bestY;
+            out.w = w;
+            out.h = h;
+
+            // Keep the space that is covered up below the new item.
+            for (size_t i = index; i < _skyline.size() && _skyline[i].x < out.x + w; ++i)
+            {
+                const auto& node = _skyline[i];
+                if (node.y < bestY)
+                {
+                    _addFree(TextureAtlasRect(
+                        node.x,
+                        node.y,
+                        std::min(node.x + node.w, out.x + w) - node.x,
+                        bestY - node.y));
+                }
+            }
+            _limit();
+
+            // Add the new node and shrink the nodes that it covers.
+            SkylineNode node;
+            node.x = out.x;
+            node.y = bestY + h;
+            node.w = w;
+            _skyline.insert(_skyline.begin() + index, node);
+            for (size_t i = index + 1; i < _skyline.size(); ++i)
+            {
+                const auto& prev = _skyline[i - 1];
+                auto& next = _skyline[i];
+                const int shrink = prev.x + prev.w - next.x;
+                if (shrink <= 0)
+                    break;
+                next.x += shrink;
+                next.w -= shrink;
+                if (next.w > 0)
+                    break;
+                _skyline.erase(_skyline.begin() + i);
+                --i;
+            }
+
+            // Merge the nodes that are at the same height.
+            for (size_t i = 1; i < _skyline.size(); ++i)
+            {
+                if (_skyline[i - 1].y == _skyline[i].y)
+                {
+                    _skyline[i - 1].w += _skyline[i].w;
+                    _skyline.erase(_skyline.begin() + i);
+                    --i;
+                }
+            }
+            return true;
+        }
+
+        bool TextureAtlasPacker::_fit(size_t index, int w, int h, int& y) const
+        {
+            const int x = _skyline[index].x;
+            if (x + w > _size)
+                return false;
+            y = 0;
+            for (size_t i = index; i < _skyline.size() && _skyline[i].x < x + w; ++i)
+            {
+                y = std::max(y, _skyline[i].y);
+            }
+            return y + h <= _size;
+        }
+
+        bool TextureAtlasPacker::_isSliver(const TextureAtlasRect& value) const
+        {
+            return value.w < _minW || value.h < _minH;
+        }
+
+        void TextureAtlasPacker::_addFree(const TextureAtlasRect& value)
+        {
+            if (_isSliver(value))
+                return;
+            for (const auto& i : _free)
+            {
+                if (contains(i, value))
+                    return;
+            }
+
+            // Combine the new space with the free rectangles next to it so the
+            // space can be used for larger items. The combined rectangles are
+            // not combined again, so the cost is linear in the number of free
+            // rectangles and the rectangles next to the new space.
+            const size_t first = _free.size();
+            _free.push_back(value);
+            for (size_t i = 0; i < first; ++i)
+            {
+                TextureAtlasRect rect;
+                if (combine(value, _free[i], rect) && !_isSliver(rect))
+                {
+                    _free.push_back(rect);
+                }
+            }
+            _prune(first);
+        }
+
+        void TextureAtlasPacker::_prune(size_t first)
+        {
+            // Remove the free rectangles that are empty or contained in other
+            // free rectangles. Only the rectangles starting at the given index
+            // are new, the others were already pruned. Removed rectangles are
+            // marked with a zero width.
+            for (size_t i = first; i < _free.size(); ++i)
+            {
+                auto& rect = _free[i];
+                for (size_t j = 0; j < _free.size() && rect.w > 0 && rect.h > 0; ++j)
+                {
+                    const auto& other = _free[j];
+                    if (i != j && other.w > 0 && contains(other, rect))
+                    {
+                        rect.w = 0;
+                    }
+                }
+                if (rect.w > 0 && rect.h > 0)
+                {
+                    for (size_t j = 0; j < first; ++j)
+                    {
+                        if (_free[j].w > 0 && contains(rect, _free[j]))
+                        {
+                            _free[j].w = 0;
+                        }
+                    }
+                }
+            }
+            size_t size = 0;
+            for (size_t i = 0; i < _free.size(); ++i)
+            {
+                if (_free[i].w > 0 && _free[i].h > 0)
+                {
+                    _free[size++] = _free[i];
+                }
+            }
+            _free.resize(size);
+        }
+
+        void TextureAtlasPacker::_limit()
+        {
+            // Keep the largest free rectangles.
+            if (_free.size() > textureAtlasFreeMax)
+            {
+                std::nth_element(
+                    _free.begin(),
+                    _free.begin() + textureAtlasFreeMax,
+                    _free.end(),
+                    [](const TextureAtlasRect& a, const TextureAtlasRect& b)
+                    {
+                        return getArea(a) > getArea(b);
+                    });
+                _free.resize(textureAtlasFreeMax);
+            }
+        }
+
+    } // namespace GL
+} // namespace djv
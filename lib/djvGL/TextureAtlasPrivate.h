@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace djv
+{
+    namespace GL
+    {
+        //! \todo Should this be configurable?
+        const size_t textureAtlasFreeMax = 1024;
+
+        //! This struct provides a rectangle in a texture atlas.
+        struct TextureAtlasRect
+        {
+            TextureAtlasRect();
+            TextureAtlasRect(int x, int y, int w, int h);
+
+            int x = 0;
+            int y = 0;
+            int w = 0;
+            int h = 0;
+        };
+
+        //! This class provides the packing for a texture atlas texture. The
+        //! items are placed bottom-left on a skyline. The space that is covered
+        //! up below the skyline and the space of removed items is kept in a list
+        //! of maximal free rectangles (MaxRects) and is tried first.
+        //!
+        //! Free rectangles that are narrower or shorter than every item that has
+        //! been inserted are dropped, and the list is limited to the largest
+        //! textureAtlasFreeMax rectangles, so the cost of each insert and remove
+        //! is linear in a bounded number of rectangles. The dropped space is
+        //! recovered when the texture is compacted.
+        //!
+        //! References:
+        //! - Jukka Jylanki, "A Thousand Ways to Pack the Bin"
+        class TextureAtlasPacker
+        {
+        public:
+            explicit TextureAtlasPacker(int size = 0);
+
+            size_t getUsedArea() const;
+
+            //! Get the area below the skyline that is not used, as a fraction
+            //! of the texture.
+            float getFragmentation() const;
+
+            size_t getFreeCount() const;
+
+            bool insert(int w, int h, TextureAtlasRect&);
+            void remove(const TextureAtlasRect&);
+            void clear();
+
+        private:
+            struct SkylineNode
+            {
+                int x = 0;
+                int y = 0;
+                int w = 0;
+            };
+
+            bool _insertFree(int w, int h, TextureAtlasRect&);
+            bool _insertSkyline(int w, int h, TextureAtlasRect&);
+            bool _fit(size_t index, int w, int h, int& y) const;
+            bool _isSliver(const TextureAtlasRect&) const;
+            void _addFree(const TextureAtlasRect&);
+            void _prune(size_t first);
+            void _limit();
+
+            int _size = 0;
+            std::vector<SkylineNode> _skyline;
+            std::vector<TextureAtlasRect> _free;
+            size_t _usedArea = 0;
+            int _minW = 0;
+            int _minH = 0;
+        };
+
+    } // namespace GL
+} // namespace djv
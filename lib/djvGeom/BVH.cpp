@@ -0,0 +1,261 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvGeom/BVH.h>
+
+#include <djvGeom/TriangleMesh.h>
+
+#include <array>
+#include <future>
+
+namespace djv
+{
+    namespace Geom
+    {
+        namespace
+        {
+            //! \todo Should these be configurable?
+            const size_t binCount          = 16;
+            const size_t leafSize          = 4;
+            const size_t maxDepth          = 60;
+            const size_t parallelCount     = 65536;
+            const size_t parallelDepth     = 4;
+            const float  traversalCost     = 1.F;
+            const float  intersectionCost  = 1.F;
+
+            float getArea(const Math::BBox3f& value)
+            {
+                const glm::vec3 size = value.getSize();
+                return 2.F * (size.x * size.y + size.y * size.z + size.z * size.x);
+            }
+
+            struct Builder
+            {
+                const std::vector<Math::BBox3f>& bboxes;
+                const std::vector<glm::vec3>&    centroids;
+                std::vector<uint32_t>&           indices;
+
+                void build(uint32_t begin, uint32_t end, std::vector<BVH::Node>& nodes, size_t depth) const;
+
+                bool split(uint32_t begin, uint32_t end, const Math::BBox3f& bbox, uint32_t& mid) const;
+            };
+
+            void Builder::build(uint32_t begin, uint32_t end, std::vector<BVH::Node>& nodes, size_t depth) const
+            {
+                const size_t nodeIndex = nodes.size();
+                nodes.emplace_back();
+                Math::BBox3f bbox = bboxes[indices[begin]];
+                for (uint32_t i = begin + 1; i < end; ++i)
+                {
+                    bbox.expand(bboxes[indices[i]]);
+                }
+                nodes[nodeIndex].bbox = bbox;
+
+                uint32_t mid = begin;
+                if (end - begin <= leafSize || depth >= maxDepth || !split(begin, end, bbox, mid))
+                {
+                    nodes[nodeIndex].offset = begin;
+                    nodes[nodeIndex].count = end - begin;
+                    return;
+                }
+
+                // The two halves of the index list are independent so large
+                // sub-trees can be built on separate threads.
+                if (end - begin >= parallelCount && depth < parallelDepth)
+                {
+                    std::vector<BVH::Node> rightNodes;
+                    auto future = std::async(
+                        std::launch::async,
+                        [this, mid, end, &rightNodes, depth]
+                        {
+                            build(mid, end, rightNodes, depth + 1);
+                        });
+                    build(begin, mid, nodes, depth + 1);
+                    future.get();
+                    const uint32_t base = static_cast<uint32_t>(nodes.size());
+                    nodes[nodeIndex].offset = base;
+                    for (auto node : rightNodes)
+                    {
+                        if (!node.isLeaf())
+                        {
+                            node.offset += base;
+                        }
+                        nodes.push_back(node);
+                    }
+                }
+                else
+                {
+                    build(begin, mid, nodes, depth + 1);
+                    nodes[nodeIndex].offset = static_cast<uint32_t>(nodes.size());
+                    build(mid, end, nodes, depth + 1);
+                }
+            }
+
+            bool Builder::split(uint32_t begin, uint32_t end, const Math::BBox3f& bbox, uint32_t& mid) const
+            {
+                Math::BBox3f centroidBBox(centroids[indices[begin]]);
+                for (uint32_t i = begin + 1; i < end; ++i)
+                {
+                    centroidBBox.expand(centroids[indices[i]]);
+                }
+                const glm::vec3 centroidSize = centroidBBox.getSize();
+
+                // Find the lowest cost split across the bins of each axis.
+                const size_t count = end - begin;
+                float bestCost = intersectionCost * count;
+                int bestAxis = -1;
+                size_t bestBin = 0;
+                for (int axis = 0; axis < 3; ++axis)
+                {
+                    if (centroidSize[axis] <= 0.F)
+                        continue;
+                    const float scale = binCount / centroidSize[axis];
+                    std::array<Math::BBox3f, binCount> binBBoxes;
+                    std::array<size_t, binCount> binCounts;
+                    binCounts.fill(0);
+                    for (uint32_t i = begin; i < end; ++i)
+                    {
+                        const uint32_t index = indices[i];
+                        const size_t bin = std::min(
+                            static_cast<size_t>((centroids[index][axis] - centroidBBox.min[axis]) * scale),
+                            binCount - 1);
+                        if (binCounts[bin])
+                        {
+                            binBBoxes[bin].expand(bboxes[index]);
+                        }
+                        else
+                        {
+                            binBBoxes[bin] = bboxes[index];
+                        }
+                        ++binCounts[bin];
+                    }
+
+                    // Sweep from the right to get the area of each right side.
+                    std::array<float, binCount> rightAreas;
+                    std::array<size_t, binCount> rightCounts;
+                    Math::BBox3f rightBBox;
+                    size_t rightCount = 0;
+                    for (size_t i = binCount - 1; i > 0; --i)
+                    {
+                        if (binCounts[i])
+                        {
+                            rightBBox = rightCount ? rightBBox : binBBoxes[i];
+                            rightBBox.expand(binBBoxes[i]);
+                            rightCount += binCounts[i];
+                        }
+                        rightAreas[i] = rightCount ? getArea(rightBBox) : 0.F;
+                        rightCounts[i] = rightCount;
+                    }
+
+                    // Sweep from the left and evaluate each split.
+                    Math::BBox3f leftBBox;
+                    size_t leftCount = 0;
+                    for (size_t i = 0; i < binCount - 1; ++i)
+                    {
+                        if (binCounts[i])
+                        {
+                            leftBBox = leftCount ? leftBBox : binBBoxes[i];
+                            leftBBox.expand(binBBoxes[i]);
+                            leftCount += binCounts[i];
+                        }
+                        if (leftCount && rightCounts[i + 1])
+                        {
+                            const float cost = traversalCost + intersectionCost *
+                                (getArea(leftBBox) * leftCount + rightAreas[i + 1] * rightCounts[i + 1]) /
+                                getArea(bbox);
+                            if (cost < bestCost)
+                            {
+                                bestCost = cost;
+                                bestAxis = axis;
+                                bestBin = i;
+                            }
+                        }
+                    }
+                }
+
+                if (bestAxis < 0)
+                {
+                    // Splitting is not cheaper than a leaf, only keep the
+                    // leaf if it is still small.
+                    if (count > leafSize * 4)
+                    {
+                        int axis = 0;
+                        const glm::vec3 size = bbox.getSize();
+                        if (size.y > size[axis]) axis = 1;
+                        if (size.z > size[axis]) axis = 2;
+                        mid = begin + static_cast<uint32_t>(count / 2);
+                        std::nth_element(
+                            indices.begin() + begin,
+                            indices.begin() + mid,
+                            indices.begin() + end,
+                            [this, axis](uint32_t a, uint32_t b)
+                            {
+                                return centroids[a][axis] < centroids[b][axis];
+                            });
+                        return true;
+                    }
+                    return false;
+                }
+
+                const float scale = binCount / centroidSize[bestAxis];
+                const float min = centroidBBox.min[bestAxis];
+                const auto i = std::partition(
+                    indices.begin() + begin,
+                    indices.begin() + end,
+                    [this, bestAxis, bestBin, scale, min](uint32_t index)
+                    {
+                        const size_t bin = std::min(
+                            static_cast<size_t>((centroids[index][bestAxis] - min) * scale),
+                            binCount - 1);
+                        return bin <= bestBin;
+                    });
+                mid = static_cast<uint32_t>(i - indices.begin());
+                if (mid == begin || mid == end)
+                {
+                    mid = begin + static_cast<uint32_t>(count / 2);
+                }
+                return true;
+            }
+
+        } // namespace
+
+        BVH::BVH()
+        {}
+
+        std::shared_ptr<BVH> BVH::create(const std::vector<Math::BBox3f>& bboxes)
+        {
+            auto out = std::shared_ptr<BVH>(new BVH);
+            const size_t size = bboxes.size();
+            if (size)
+            {
+                std::vector<glm::vec3> centroids(size);
+                out->_indices.resize(size);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    centroids[i] = bboxes[i].getCenter();
+                    out->_indices[i] = static_cast<uint32_t>(i);
+                }
+                out->_nodes.reserve(size / leafSize * 2);
+                const Builder builder = { bboxes, centroids, out->_indices };
+                builder.build(0, static_cast<uint32_t>(size), out->_nodes, 0);
+            }
+            return out;
+        }
+
+        std::shared_ptr<BVH> BVH::create(const TriangleMesh& mesh)
+        {
+            std::vector<Math::BBox3f> bboxes;
+            bboxes.reserve(mesh.triangles.size());
+            for (const auto& i : mesh.triangles)
+            {
+                Math::BBox3f bbox(mesh.v[i.v0.v - 1]);
+                bbox.expand(mesh.v[i.v1.v - 1]);
+                bbox.expand(mesh.v[i.v2.v - 1]);
+                bboxes.push_back(bbox);
+            }
+            return create(bboxes);
+        }
+
+    } // namespace Geom
+} // namespace djv
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <djvMath/BBox.h>
+
+#include <memory>
+#include <vector>
+
+namespace djv
+{
+    namespace Geom
+    {
+        class TriangleMesh;
+
+        //! This class provides a bounding volume hierarchy for accelerating
+        //! line intersections. The hierarchy is built top-down with a binned
+        //! surface area heuristic, large sub-trees are built in parallel.
+        class BVH
+        {
+            DJV_NON_COPYABLE(BVH);
+            BVH();
+
+        public:
+            //! Create a hierarchy from a list of bounding-boxes.
+            static std::shared_ptr<BVH> create(const std::vector<Math::BBox3f>&);
+
+            //! Create a hierarchy from the triangles of a mesh.
+            static std::shared_ptr<BVH> create(const TriangleMesh&);
+
+            //! This struct provides a node. Nodes are stored depth first, the
+            //! left child of an interior node immediately follows it and the
+            //! offset is the index of the right child. For leaf nodes the offset
+            //! is the first item in the index list.
+            struct Node
+            {
+                Math::BBox3f bbox = Math::BBox3f(0.F, 0.F, 0.F, 0.F, 0.F, 0.F);
+                uint32_t     offset = 0;
+                uint32_t     count  = 0;
+
+                bool isLeaf() const;
+            };
+
+            const std::vector<Node>& getNodes() const;
+            const std::vector<uint32_t>& getIndices() const;
+            const Math::BBox3f& getBBox() const;
+
+            //! Find the closest item along a line. The callback is given each
+            //! candidate item index and the current closest distance, it
+            //! returns true and updates the distance when the item is closer.
+            //! The distance is in units of the line direction.
+            template<typename T>
+            bool intersect(
+                const glm::vec3& pos,
+                const glm::vec3& dir,
+                float&           t,
+                const T&         callback) const;
+
+        private:
+            static bool _intersect(
+                const Math::BBox3f&,
+                const glm::vec3& pos,
+                const glm::vec3& invDir,
+                float            t,
+                float&           tNear);
+
+            std::vector<Node> _nodes;
+            std::vector<uint32_t> _indices;
+        };
+
+    } // namespace Geom
+} // namespace djv
+
+#include <djvGeom/BVHInline.h>
@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_GEOM_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace djv
+{
+    namespace Geom
+    {
+        inline bool BVH::Node::isLeaf() const
+        {
+            return count > 0;
+        }
+
+        inline const std::vector<BVH::Node>& BVH::getNodes() const
+        {
+            return _nodes;
+        }
+
+        inline const std::vector<uint32_t>& BVH::getIndices() const
+        {
+            return _indices;
+        }
+
+        inline const Math::BBox3f& BVH::getBBox() const
+        {
+            static const Math::BBox3f empty(0.F, 0.F, 0.F, 0.F, 0.F, 0.F);
+            return _nodes.size() ? _nodes[0].bbox : empty;
+        }
+
+        inline bool BVH::_intersect(
+            const Math::BBox3f& bbox,
+            const glm::vec3&    pos,
+            const glm::vec3&    invDir,
+            float               t,
+            float&              tNear)
+        {
+#if defined(DJV_GEOM_SSE2)
+            // The slabs are tested in the first three lanes, the last lane
+            // holds the line range.
+            const __m128 p = _mm_set_ps(0.F, pos.z, pos.y, pos.x);
+            const __m128 d = _mm_set_ps(0.F, invDir.z, invDir.y, invDir.x);
+            const __m128 t0 = _mm_mul_ps(_mm_sub_ps(_mm_set_ps(0.F, bbox.min.z, bbox.min.y, bbox.min.x), p), d);
+            const __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_set_ps(0.F, bbox.max.z, bbox.max.y, bbox.max.x), p), d);
+
+            // An axis-aligned line has an infinite inverse direction, so an
+            // origin on one of the bounding-box planes gives 0 * inf. The
+            // origin is inside the slab in that case.
+            const __m128 nan = _mm_cmpunord_ps(t0, t1);
+            const __m128 last = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+            __m128 tMin = _mm_min_ps(t0, t1);
+            __m128 tMax = _mm_max_ps(t0, t1);
+            tMin = _mm_or_ps(
+                _mm_andnot_ps(nan, tMin),
+                _mm_and_ps(nan, _mm_set1_ps(-std::numeric_limits<float>::infinity())));
+            tMax = _mm_or_ps(
+                _mm_andnot_ps(nan, tMax),
+                _mm_and_ps(nan, _mm_set1_ps(std::numeric_limits<float>::infinity())));
+            tMin = _mm_andnot_ps(last, tMin);
+            tMax = _mm_or_ps(_mm_andnot_ps(last, tMax), _mm_and_ps(last, _mm_set1_ps(t)));
+
+            // Find the largest minimum and the smallest maximum.
+            tMin = _mm_max_ps(tMin, _mm_shuffle_ps(tMin, tMin, _MM_SHUFFLE(1, 0, 3, 2)));
+            tMin = _mm_max_ps(tMin, _mm_shuffle_ps(tMin, tMin, _MM_SHUFFLE(2, 3, 0, 1)));
+            tMax = _mm_min_ps(tMax, _mm_shuffle_ps(tMax, tMax, _MM_SHUFFLE(1, 0, 3, 2)));
+            tMax = _mm_min_ps(tMax, _mm_shuffle_ps(tMax, tMax, _MM_SHUFFLE(2, 3, 0, 1)));
+            tNear = _mm_cvtss_f32(tMin);
+            return tNear <= _mm_cvtss_f32(tMax);
+#else // DJV_GEOM_SSE2
+            glm::vec3 t0 = (bbox.min - pos) * invDir;
+            glm::vec3 t1 = (bbox.max - pos) * invDir;
+            for (int i = 0; i < 3; ++i)
+            {
+                // An axis-aligned ray has an infinite inverse direction, so
+                // an origin on one of the bounding-box planes gives 0 * inf.
+                // The origin is inside the slab in that case.
+                if (std::isnan(t0[i]) || std::isnan(t1[i]))
+                {
+                    t0[i] = -std::numeric_limits<float>::infinity();
+                    t1[i] = std::numeric_limits<float>::infinity();
+                }
+            }
+            const glm::vec3 tMin = glm::min(t0, t1);
+            const glm::vec3 tMax = glm::max(t0, t1);
+            tNear = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.F));
+            const float tFar = std::min(std::min(tMax.x, tMax.y), std::min(tMax.z, t));
+            return tNear <= tFar;
+#endif // DJV_GEOM_SSE2
+        }
+
+        template<typename T>
+        inline bool BVH::intersect(
+            const glm::vec3& pos,
+            const glm::vec3& dir,
+            float&           t,
+            const T&         callback) const
+        {
+            bool out = false;
+            if (_nodes.empty())
+                return out;
+
+            const glm::vec3 invDir(1.F / dir.x, 1.F / dir.y, 1.F / dir.z);
+            float tNear = 0.F;
+            if (!_intersect(_nodes[0].bbox, pos, invDir, t, tNear))
+                return out;
+
+            // Visit the nearest child first so that the closest distance
+            // shrinks quickly and culls the rest of the hierarchy.
+            uint32_t stack[64];
+            size_t stackSize = 0;
+            stack[stackSize++] = 0;
+            while (stackSize > 0)
+            {
+                const Node& node = _nodes[stack[--stackSize]];
+                if (!_intersect(node.bbox, pos, invDir, t, tNear))
+                    continue;
+                if (node.isLeaf())
+                {
+                    for (uint32_t i = node.offset; i < node.offset + node.count; ++i)
+                    {
+                        out |= callback(_indices[i], t);
+                    }
+                }
+                else
+                {
+                    const uint32_t left = static_cast<uint32_t>(&node - _nodes.data()) + 1;
+                    const uint32_t right = node.offset;
+                    float tLeft = 0.F;
+                    float tRight = 0.F;
+                    const bool hitLeft = _intersect(_nodes[left].bbox, pos, invDir, t, tLeft);
+                    const bool hitRight = _intersect(_nodes[right].bbox, pos, invDir, t, tRight);
+                    if (hitLeft && hitRight)
+                    {
+                        if (tLeft <= tRight)
+                        {
+                            stack[stackSize++] = right;
+                            stack[stackSize++] = left;
+                        }
+                        else
+                        {
+                            stack[stackSize++] = left;
+                            stack[stackSize++] = right;
+                        }
+                    }
+                    else if (hitLeft)
+                    {
+                        stack[stackSize++] = left;
+                    }
+                    else if (hitRight)
+                    {
+                        stack[stackSize++] = right;
+                    }
+                }
+            }
+            return out;
+        }
+
+    } // namespace Geom
+} // namespace djv
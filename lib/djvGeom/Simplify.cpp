@@ -0,0 +1,486 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvGeom/Simplify.h>
+
+#include <glm/geometric.hpp>
+#include <glm/mat3x3.hpp>
+#include <glm/matrix.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+
+namespace djv
+{
+    namespace Geom
+    {
+        namespace
+        {
+            //! \todo Should these be configurable?
+            const double boundaryWeight = 1000.0;
+            const double flipThreshold  = .2;
+
+            //! This struct provides a symmetric 4x4 quadric matrix.
+            struct Quadric
+            {
+                std::array<double, 10> q = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+
+                Quadric() {}
+
+                //! Create a quadric from the plane ax + by + cz + d = 0.
+                Quadric(double a, double b, double c, double d, double weight)
+                {
+                    q[0] = a * a * weight; q[1] = a * b * weight; q[2] = a * c * weight; q[3] = a * d * weight;
+                    q[4] = b * b * weight; q[5] = b * c * weight; q[6] = b * d * weight;
+                    q[7] = c * c * weight; q[8] = c * d * weight;
+                    q[9] = d * d * weight;
+                }
+
+                Quadric& operator += (const Quadric& value)
+                {
+                    for (size_t i = 0; i < 10; ++i)
+                    {
+                        q[i] += value.q[i];
+                    }
+                    return *this;
+                }
+
+                Quadric operator + (const Quadric& value) const
+                {
+                    Quadric out = *this;
+                    out += value;
+                    return out;
+                }
+
+                double error(const glm::dvec3& v) const
+                {
+                    return
+                        q[0] * v.x * v.x + 2.0 * q[1] * v.x * v.y + 2.0 * q[2] * v.x * v.z + 2.0 * q[3] * v.x +
+                        q[4] * v.y * v.y + 2.0 * q[5] * v.y * v.z + 2.0 * q[6] * v.y +
+                        q[7] * v.z * v.z + 2.0 * q[8] * v.z +
+                        q[9];
+                }
+
+                //! Find the position that minimizes the error.
+                bool solve(glm::dvec3& out) const
+                {
+                    const glm::dmat3 a(
+                        q[0], q[1], q[2],
+                        q[1], q[4], q[5],
+                        q[2], q[5], q[7]);
+                    const double det = glm::determinant(a);
+                    if (std::abs(det) < 1.0e-12)
+                        return false;
+                    out = glm::inverse(a) * glm::dvec3(-q[3], -q[6], -q[8]);
+                    return true;
+                }
+            };
+
+            //! This struct provides a candidate edge collapse.
+            struct Collapse
+            {
+                double     cost     = 0.0;
+                uint32_t   a        = 0;
+                uint32_t   b        = 0;
+                uint32_t   aVersion = 0;
+                uint32_t   bVersion = 0;
+                glm::dvec3 pos;
+
+                bool operator > (const Collapse& other) const
+                {
+                    return cost > other.cost;
+                }
+            };
+
+            class Simplifier
+            {
+            public:
+                Simplifier(const TriangleMesh& mesh) :
+                    _mesh(mesh)
+                {}
+
+                void run(size_t triangleCount, TriangleMesh& out);
+
+            private:
+                static TriangleMesh::Vertex& _corner(TriangleMesh::Triangle& value, size_t index)
+                {
+                    return 0 == index ? value.v0 : (1 == index ? value.v1 : value.v2);
+                }
+
+                static const TriangleMesh::Vertex& _corner(const TriangleMesh::Triangle& value, size_t index)
+                {
+                    return 0 == index ? value.v0 : (1 == index ? value.v1 : value.v2);
+                }
+
+                glm::dvec3 _getNormal(const TriangleMesh::Triangle& value) const
+                {
+                    const glm::dvec3& v0 = _pos[value.v0.v - 1];
+                    const glm::dvec3& v1 = _pos[value.v1.v - 1];
+                    const glm::dvec3& v2 = _pos[value.v2.v - 1];
+                    return glm::cross(v1 - v0, v2 - v0);
+                }
+
+                bool _contains(const TriangleMesh::Triangle& value, uint32_t index) const
+                {
+                    const size_t v = static_cast<size_t>(index) + 1;
+                    return value.v0.v == v || value.v1.v == v || value.v2.v == v;
+                }
+
+                void _init();
+                void _push(uint32_t a, uint32_t b);
+                bool _flips(uint32_t index, uint32_t other, const glm::dvec3&) const;
+                void _collapse(const Collapse&);
+
+                const TriangleMesh& _mesh;
+                std::vector<glm::dvec3> _pos;
+                std::vector<Quadric> _quadrics;
+                std::vector<TriangleMesh::Triangle> _triangles;
+                std::vector<bool> _triangleDeleted;
+                std::vector<std::vector<uint32_t> > _vertexTriangles;
+                std::vector<bool> _vertexDeleted;
+                std::vector<uint32_t> _vertexVersion;
+                std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse> > _queue;
+                size_t _triangleCount = 0;
+            };
+
+            void Simplifier::_init()
+            {
+                const size_t vertexCount = _mesh.v.size();
+                _pos.resize(vertexCount);
+                for (size_t i = 0; i < vertexCount; ++i)
+                {
+                    _pos[i] = glm::dvec3(_mesh.v[i]);
+                }
+                _quadrics.resize(vertexCount);
+                _vertexTriangles.resize(vertexCount);
+                _vertexDeleted.resize(vertexCount, false);
+                _vertexVersion.resize(vertexCount, 0);
+
+                // Skip invalid and degenerate triangles.
+                _triangles.reserve(_mesh.triangles.size());
+                for (const auto& i : _mesh.triangles)
+                {
+                    if (i.v0.v && i.v1.v && i.v2.v &&
+                        i.v0.v <= vertexCount && i.v1.v <= vertexCount && i.v2.v <= vertexCount &&
+                        i.v0.v != i.v1.v && i.v1.v != i.v2.v && i.v2.v != i.v0.v)
+                    {
+                        _triangles.push_back(i);
+                    }
+                }
+                _triangleCount = _triangles.size();
+                _triangleDeleted.resize(_triangleCount, false);
+
+                // Accumulate the plane of each triangle into the quadrics of
+                // its vertices, and count the edges to find the boundaries.
+                std::unordered_map<uint64_t, std::pair<uint32_t, uint32_t> > edges;
+                for (uint32_t i = 0; i < static_cast<uint32_t>(_triangleCount); ++i)
+                {
+                    const auto& triangle = _triangles[i];
+                    const glm::dvec3 n = _getNormal(triangle);
+                    const double area = glm::length(n);
+                    if (area > 0.0)
+                    {
+                        const glm::dvec3 nn = n / area;
+                        const Quadric quadric(nn.x, nn.y, nn.z, -glm::dot(nn, _pos[triangle.v0.v - 1]), area);
+                        for (size_t j = 0; j < 3; ++j)
+                        {
+                            _quadrics[_corner(triangle, j).v - 1] += quadric;
+                        }
+                    }
+                    for (size_t j = 0; j < 3; ++j)
+                    {
+                        const uint32_t a = static_cast<uint32_t>(_corner(triangle, j).v - 1);
+                        const uint32_t b = static_cast<uint32_t>(_corner(triangle, (j + 1) % 3).v - 1);
+                        _vertexTriangles[a].push_back(i);
+                        const uint64_t key = (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+                        auto k = edges.find(key);
+                        if (k != edges.end())
+                        {
+                            ++k->second.first;
+                        }
+                        else
+                        {
+                            edges[key] = std::make_pair(1, i);
+                        }
+                    }
+                }
+
+                // Add planes perpendicular to the boundary edges so that the
+                // boundaries are preserved.
+                for (const auto& i : edges)
+                {
+                    const uint32_t a = static_cast<uint32_t>(i.first >> 32);
+                    const uint32_t b = static_cast<uint32_t>(i.first & 0xffffffff);
+                    if (1 == i.second.first)
+                    {
+                        const glm::dvec3 n = _getNormal(_triangles[i.second.second]);
+                        const glm::dvec3 edge = _pos[b] - _pos[a];
+                        const glm::dvec3 m = glm::cross(edge, n);
+                        const double length = glm::length(m);
+                        if (length > 0.0)
+                        {
+                            const glm::dvec3 mn = m / length;
+                            const Quadric quadric(
+                                mn.x, mn.y, mn.z, -glm::dot(mn, _pos[a]),
+                                boundaryWeight * glm::dot(edge, edge));
+                            _quadrics[a] += quadric;
+                            _quadrics[b] += quadric;
+                        }
+                    }
+                    _push(a, b);
+                }
+            }
+
+            void Simplifier::_push(uint32_t a, uint32_t b)
+            {
+                Collapse collapse;
+                collapse.a = a;
+                collapse.b = b;
+                collapse.aVersion = _vertexVersion[a];
+                collapse.bVersion = _vertexVersion[b];
+                const Quadric quadric = _quadrics[a] + _quadrics[b];
+
+                // Use the optimal position unless the quadric is singular or
+                // the position is far from the edge, otherwise use the best of
+                // the end points and the mid point.
+                const glm::dvec3 mid = (_pos[a] + _pos[b]) * .5;
+                const double length = glm::length(_pos[b] - _pos[a]);
+                glm::dvec3 pos;
+                if (quadric.solve(pos) && glm::length(pos - mid) <= length * 2.0)
+                {
+                    collapse.pos = pos;
+                    collapse.cost = quadric.error(pos);
+                }
+                else
+                {
+                    const std::array<glm::dvec3, 3> candidates = { _pos[a], _pos[b], mid };
+                    collapse.cost = std::numeric_limits<double>::max();
+                    for (const auto& i : candidates)
+                    {
+                        const double error = quadric.error(i);
+                        if (error < collapse.cost)
+                        {
+                            collapse.cost = error;
+                            collapse.pos = i;
+                        }
+                    }
+                }
+                _queue.push(collapse);
+            }
+
+            bool Simplifier::_flips(uint32_t index, uint32_t other, const glm::dvec3& pos) const
+            {
+                const size_t v = static_cast<size_t>(index) + 1;
+                for (const auto i : _vertexTriangles[index])
+                {
+                    if (_triangleDeleted[i] || _contains(_triangles[i], other))
+                        continue;
+                    const auto& triangle = _triangles[i];
+                    std::array<glm::dvec3, 3> p;
+                    for (size_t j = 0; j < 3; ++j)
+                    {
+                        const size_t k = _corner(triangle, j).v;
+                        p[j] = k == v ? pos : _pos[k - 1];
+                    }
+                    const glm::dvec3 n0 = _getNormal(triangle);
+                    const glm::dvec3 n1 = glm::cross(p[1] - p[0], p[2] - p[0]);
+                    const double l0 = glm::length(n0);
+                    const double l1 = glm::length(n1);
+                    if (l1 <= 0.0)
+                        return true;
+                    if (l0 > 0.0 && glm::dot(n0 / l0, n1 / l1) < flipThreshold)
+                        return true;
+                }
+                return false;
+            }
+
+            void Simplifier::_collapse(const Collapse& value)
+            {
+                const uint32_t a = value.a;
+                const uint32_t b = value.b;
+                const size_t av = static_cast<size_t>(a) + 1;
+                const size_t bv = static_cast<size_t>(b) + 1;
+
+                _pos[b] = value.pos;
+                _quadrics[b] += _quadrics[a];
+                _vertexDeleted[a] = true;
+                ++_vertexVersion[a];
+                ++_vertexVersion[b];
+
+                // Remove the triangles that share the edge and move the rest
+                // of the triangles from the removed vertex.
+                for (const auto i : _vertexTriangles[a])
+                {
+                    if (_triangleDeleted[i])
+                        continue;
+                    auto& triangle = _triangles[i];
+                    if (_contains(triangle, b))
+                    {
+                        _triangleDeleted[i] = true;
+                        --_triangleCount;
+                    }
+                    else
+                    {
+                        for (size_t j = 0; j < 3; ++j)
+                        {
+                            auto& corner = _corner(triangle, j);
+                            if (corner.v == av)
+                            {
+                                corner.v = bv;
+                            }
+                        }
+                        _vertexTriangles[b].push_back(i);
+                    }
+                }
+                _vertexTriangles[a].clear();
+                auto& triangles = _vertexTriangles[b];
+                triangles.erase(
+                    std::remove_if(
+                        triangles.begin(),
+                        triangles.end(),
+                        [this](uint32_t value)
+                        {
+                            return _triangleDeleted[value];
+                        }),
+                    triangles.end());
+                std::sort(triangles.begin(), triangles.end());
+                triangles.erase(std::unique(triangles.begin(), triangles.end()), triangles.end());
+
+                // Update the collapse costs of the neighboring edges.
+                std::vector<uint32_t> neighbors;
+                for (const auto i : triangles)
+                {
+                    const auto& triangle = _triangles[i];
+                    for (size_t j = 0; j < 3; ++j)
+                    {
+                        const uint32_t k = static_cast<uint32_t>(_corner(triangle, j).v - 1);
+                        if (k != b)
+                        {
+                            neighbors.push_back(k);
+                        }
+                    }
+                }
+                std::sort(neighbors.begin(), neighbors.end());
+                neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+                for (const auto i : neighbors)
+                {
+                    _push(b, i);
+                }
+            }
+
+            void Simplifier::run(size_t triangleCount, TriangleMesh& out)
+            {
+                _init();
+
+                while (_triangleCount > triangleCount && !_queue.empty())
+                {
+                    const Collapse collapse = _queue.top();
+                    _queue.pop();
+                    if (_vertexDeleted[collapse.a] || _vertexDeleted[collapse.b] ||
+                        _vertexVersion[collapse.a] != collapse.aVersion ||
+                        _vertexVersion[collapse.b] != collapse.bVersion)
+                        continue;
+                    if (_flips(collapse.a, collapse.b, collapse.pos) ||
+                        _flips(collapse.b, collapse.a, collapse.pos))
+                        continue;
+                    _collapse(collapse);
+                }
+
+                // Copy the remaining triangles and the data they reference.
+                out.clear();
+                const bool colors = _mesh.c.size() == _mesh.v.size();
+                std::vector<size_t> vMap(_mesh.v.size(), 0);
+                std::vector<size_t> tMap(_mesh.t.size(), 0);
+                std::vector<size_t> nMap(_mesh.n.size(), 0);
+                out.triangles.reserve(_triangleCount);
+                for (size_t i = 0; i < _triangles.size(); ++i)
+                {
+                    if (_triangleDeleted[i])
+                        continue;
+                    TriangleMesh::Triangle triangle = _triangles[i];
+                    for (size_t j = 0; j < 3; ++j)
+                    {
+                        auto& corner = _corner(triangle, j);
+                        size_t& v = vMap[corner.v - 1];
+                        if (!v)
+                        {
+                            out.v.push_back(glm::vec3(_pos[corner.v - 1]));
+                            if (colors)
+                            {
+                                out.c.push_back(_mesh.c[corner.v - 1]);
+                            }
+                            v = out.v.size();
+                        }
+                        corner.v = v;
+                        if (corner.t && corner.t <= tMap.size())
+                        {
+                            size_t& t = tMap[corner.t - 1];
+                            if (!t)
+                            {
+                                out.t.push_back(_mesh.t[corner.t - 1]);
+                                t = out.t.size();
+                            }
+                            corner.t = t;
+                        }
+                        else
+                        {
+                            corner.t = 0;
+                        }
+                        if (corner.n && corner.n <= nMap.size())
+                        {
+                            size_t& n = nMap[corner.n - 1];
+                            if (!n)
+                            {
+                                out.n.push_back(_mesh.n[corner.n - 1]);
+                                n = out.n.size();
+                            }
+                            corner.n = n;
+                        }
+                        else
+                        {
+                            corner.n = 0;
+                        }
+                    }
+                    out.triangles.push_back(triangle);
+                }
+                out.bboxUpdate();
+            }
+
+        } // namespace
+
+        void simplify(const TriangleMesh& in, size_t triangleCount, TriangleMesh& out)
+        {
+            Simplifier(in).run(triangleCount, out);
+        }
+
+        std::vector<std::shared_ptr<TriangleMesh> > createLODs(
+            const std::shared_ptr<TriangleMesh>& value,
+            size_t count,
+            size_t minTriangleCount)
+        {
+            std::vector<std::shared_ptr<TriangleMesh> > out;
+            out.push_back(value);
+            for (size_t i = 1; i < count; ++i)
+            {
+                const size_t prevTriangleCount = out.back()->triangles.size();
+                const size_t triangleCount = prevTriangleCount / 4;
+                if (triangleCount < minTriangleCount)
+                    break;
+                auto lod = std::shared_ptr<TriangleMesh>(new TriangleMesh);
+                simplify(*out.back(), triangleCount, *lod);
+
+                // Stop if the simplification could not make progress.
+                if (lod->triangles.size() * 10 > prevTriangleCount * 9)
+                    break;
+                out.push_back(lod);
+            }
+            return out;
+        }
+
+    } // namespace Geom
+} // namespace djv
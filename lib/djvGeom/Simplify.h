@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvGeom/TriangleMesh.h>
+
+#include <memory>
+#include <vector>
+
+namespace djv
+{
+    namespace Geom
+    {
+        //! \name Simplification
+        ///@{
+
+        //! Simplify a mesh by collapsing edges in the order of least quadric
+        //! error until the triangle count is reached. Open boundaries are
+        //! preserved and collapses that would flip triangles are rejected, so
+        //! the output may have more triangles than requested.
+        void simplify(const TriangleMesh& in, size_t triangleCount, TriangleMesh& out);
+
+        //! Create a chain of levels of detail for a mesh. The first level is
+        //! the given mesh, each following level has approximately a quarter
+        //! of the triangles of the previous one. The chain stops early when a
+        //! level would have less than the minimum number of triangles.
+        std::vector<std::shared_ptr<TriangleMesh> > createLODs(
+            const std::shared_ptr<TriangleMesh>&,
+            size_t count            = 4,
+            size_t minTriangleCount = 256);
+
+        ///@}
+
+    } // namespace Geom
+} // namespace djv
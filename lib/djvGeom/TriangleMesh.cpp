@@ -4,6 +4,8 @@
 
 #include <djvGeom/TriangleMesh.h>
 
+#include <djvGeom/BVH.h>
+
 #include <djvCore/UIDFunc.h>
 
 using namespace djv::Core;
@@ -16,6 +18,32 @@ namespace djv
             _uid(createUID())
         {}
 
+        TriangleMesh::TriangleMesh(const TriangleMesh& value) :
+            v(value.v),
+            c(value.c),
+            t(value.t),
+            n(value.n),
+            triangles(value.triangles),
+            bbox(value.bbox),
+            _uid(value._uid)
+        {}
+
+        TriangleMesh& TriangleMesh::operator = (const TriangleMesh& value)
+        {
+            if (&value != this)
+            {
+                v = value.v;
+                c = value.c;
+                t = value.t;
+                n = value.n;
+                triangles = value.triangles;
+                bbox = value.bbox;
+                _uid = value._uid;
+                bvhReset();
+            }
+            return *this;
+        }
+
         TriangleMesh::Vertex::Vertex()
         {}
 
@@ -29,10 +57,12 @@ namespace djv
             t.clear();
             n.clear();
             triangles.clear();
+            bvhReset();
         }
 
         void TriangleMesh::bboxUpdate()
         {
+            bvhReset();
             bbox.zero();
             if (v.size())
             {
@@ -44,5 +74,21 @@ namespace djv
             }
         }
 
+        const std::shared_ptr<BVH>& TriangleMesh::getBVH() const
+        {
+            if (!_bvh || _bvhVertexCount != v.size() || _bvhTriangleCount != triangles.size())
+            {
+                _bvh = BVH::create(*this);
+                _bvhVertexCount = v.size();
+                _bvhTriangleCount = triangles.size();
+            }
+            return _bvh;
+        }
+
+        void TriangleMesh::bvhReset()
+        {
+            _bvh.reset();
+        }
+
     } // namespace Geom
 } // namespace djv
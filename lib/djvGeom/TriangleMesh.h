@@ -10,18 +10,29 @@
 
 #include <djvCore/UID.h>
 
+#include <memory>
 #include <vector>
 
 namespace djv
 {
     namespace Geom
     {
+        class BVH;
+
         //! This struct provides a triangle mesh.
         class TriangleMesh
         {
         public:
             TriangleMesh();
 
+            //! The bounding volume hierarchy is not copied, it is built again
+            //! for the copy when it is first used.
+            TriangleMesh(const TriangleMesh&);
+            TriangleMesh(TriangleMesh&&) = default;
+
+            TriangleMesh& operator = (const TriangleMesh&);
+            TriangleMesh& operator = (TriangleMesh&&) = default;
+
             Core::UID getUID() const;
 
             //! This struct provides a vertex.
@@ -70,13 +81,26 @@ namespace djv
 
             void clear();
 
-            //! Compute the bounding-box of the mesh.
+            //! Compute the bounding-box of the mesh. This also resets the
+            //! bounding volume hierarchy, call it after modifying the vertices.
             void bboxUpdate();
 
+            //! Get the bounding volume hierarchy used for intersections. It is
+            //! built on first use and rebuilt after clear(), bboxUpdate(), or
+            //! bvhReset(), or when the number of vertices or triangles changes.
+            //! This function is not thread safe.
+            const std::shared_ptr<BVH>& getBVH() const;
+
+            //! Reset the bounding volume hierarchy after modifying the mesh in place.
+            void bvhReset();
+
             ///@}
 
         private:
             Core::UID _uid = 0;
+            mutable std::shared_ptr<BVH> _bvh;
+            mutable size_t _bvhVertexCount = 0;
+            mutable size_t _bvhTriangleCount = 0;
         };
 
     } // namespace Geom
@@ -4,8 +4,12 @@
 
 #include <djvGeom/TriangleMeshFunc.h>
 
+#include <djvGeom/BVH.h>
+
 #include <glm/geometric.hpp>
 
+#include <limits>
+
 using namespace djv::Core;
 
 namespace djv
@@ -125,6 +129,51 @@ namespace djv
             calcNormals(mesh);
         }
 
+        namespace
+        {
+            bool intersectTriangleDistance(
+                const glm::vec3& pos,
+                const glm::vec3& dir,
+                const glm::vec3& v0,
+                const glm::vec3& v1,
+                const glm::vec3& v2,
+                float&           t,
+                glm::vec3&       barycentric)
+            {
+                const float epsilon = .1e-6F;
+
+                const glm::vec3 edge1 = v1 - v0;
+                const glm::vec3 edge2 = v2 - v0;
+
+                const glm::vec3 h = glm::cross(dir, edge2);
+                const float a = glm::dot(edge1, h);
+                if (a > -epsilon && a < epsilon)
+                    return false;
+
+                const float f = 1.F / a;
+                const glm::vec3 s = pos - v0;
+                const float u = f * glm::dot(s, h);
+                if (u < 0.F || u > 1.F)
+                    return false;
+
+                const glm::vec3 q = glm::cross(s, edge1);
+                const float v = f * glm::dot(dir, q);
+                if (v < 0.F || u + v > 1.F)
+                    return false;
+
+                t = f * glm::dot(edge2, q);
+                if (t > epsilon)
+                {
+                    barycentric.x = 1.F - u - v;
+                    barycentric.y = u;
+                    barycentric.z = v;
+                    return true;
+                }
+                return false;
+            }
+
+        } // namespace
+
         bool intersectTriangle(
             const glm::vec3& pos,
             const glm::vec3& dir,
@@ -134,77 +183,65 @@ namespace djv
             glm::vec3&       out,
             glm::vec3&       barycentric)
         {
-            const float epsilon = .1e-6F;
-
-            const glm::vec3 edge1 = v1 - v0;
-            const glm::vec3 edge2 = v2 - v0;
-
-            const glm::vec3 h = glm::cross(dir, edge2);
-            const float a = glm::dot(edge1, h);
-            if (a > -epsilon && a < epsilon)
-                return false;
-
-            const float f = 1.F / a;
-            const glm::vec3 s = pos - v0;
-            const float u = f * glm::dot(s, h);
-            if (u < 0.F || u > 1.F)
-                return false;
-
-            const glm::vec3 q = glm::cross(s, edge1);
-            const float v = f * glm::dot(dir, q);
-            if (v < 0.F || u + v > 1.F)
-                return false;
-
-            const float t = f * glm::dot(edge2, q);
-            if (t > epsilon)
+            float t = 0.F;
+            const bool hit = intersectTriangleDistance(pos, dir, v0, v1, v2, t, barycentric);
+            if (hit)
             {
                 out = pos + dir * t;
-                barycentric.x = 1.F - u - v;
-                barycentric.y = u;
-                barycentric.z = v;
-                return true;
             }
-            return false;
+            return hit;
         }
 
-        bool intersect(
+        bool intersectTriangles(
             const glm::vec3&    pos,
             const glm::vec3&    dir,
             const TriangleMesh& mesh,
-            glm::vec3 &         hit)
+            float&              t,
+            size_t&             triangle,
+            glm::vec3&          barycentric)
         {
-            bool out = false;
-            float closest = 0.F;
-            glm::vec3 barycentric;
-            bool first = true;
-            size_t i = 0;
-            for (const auto& triangle : mesh.triangles)
-            {
-                const TriangleMesh::Vertex& vert0 = triangle.v0;
-                const TriangleMesh::Vertex& vert1 = triangle.v1;
-                const TriangleMesh::Vertex& vert2 = triangle.v2;
-
-                const glm::vec3& v0 = mesh.v[vert0.v - 1];
-                const glm::vec3& v1 = mesh.v[vert1.v - 1];
-                const glm::vec3& v2 = mesh.v[vert2.v - 1];
-                glm::vec3 hitTemp;
-                glm::vec3 barycentricTemp;
-                if (intersectTriangle(pos, dir, v0, v1, v2, hitTemp, barycentricTemp))
+            t = std::numeric_limits<float>::max();
+            return mesh.getBVH()->intersect(
+                pos,
+                dir,
+                t,
+                [&mesh, &pos, &dir, &triangle, &barycentric](uint32_t index, float& closest)
                 {
-                    const float distance = glm::distance(pos, hitTemp);
-                    if (distance < closest || first)
+                    const TriangleMesh::Triangle& tri = mesh.triangles[index];
+                    float tTemp = 0.F;
+                    glm::vec3 barycentricTemp;
+                    if (intersectTriangleDistance(
+                        pos,
+                        dir,
+                        mesh.v[tri.v0.v - 1],
+                        mesh.v[tri.v1.v - 1],
+                        mesh.v[tri.v2.v - 1],
+                        tTemp,
+                        barycentricTemp) && tTemp < closest)
                     {
-                        hit = hitTemp;
-                        out = true;
-                        closest = distance;
+                        closest = tTemp;
+                        triangle = index;
                         barycentric = barycentricTemp;
-                        first = false;
+                        return true;
                     }
-                }
+                    return false;
+                });
+        }
 
-                ++i;
+        bool intersect(
+            const glm::vec3&    pos,
+            const glm::vec3&    dir,
+            const TriangleMesh& mesh,
+            glm::vec3 &         hit)
+        {
+            float t = 0.F;
+            size_t index = 0;
+            glm::vec3 barycentric;
+            const bool out = intersectTriangles(pos, dir, mesh, t, index, barycentric);
+            if (out)
+            {
+                hit = pos + dir * t;
             }
-
             return out;
         }
 
@@ -217,42 +254,14 @@ namespace djv
             glm::vec2&          hitTexture,
             glm::vec3&          hitNormal)
         {
-            bool out = false;
-            float closest = 0.F;
-            glm::vec3 barycentric;
+            float t = 0.F;
             size_t index = 0;
-            bool first = true;
-            size_t i = 0;
-            for (const auto& triangle : mesh.triangles)
-            {
-                const TriangleMesh::Vertex& vert0 = triangle.v0;
-                const TriangleMesh::Vertex& vert1 = triangle.v1;
-                const TriangleMesh::Vertex& vert2 = triangle.v2;
-
-                const glm::vec3& v0 = mesh.v[vert0.v - 1];
-                const glm::vec3& v1 = mesh.v[vert1.v - 1];
-                const glm::vec3& v2 = mesh.v[vert2.v - 1];
-                glm::vec3 hitTemp;
-                glm::vec3 barycentricTemp;
-                if (intersectTriangle(pos, dir, v0, v1, v2, hitTemp, barycentricTemp))
-                {
-                    const float distance = glm::distance(pos, hitTemp);
-                    if (distance < closest || first)
-                    {
-                        hit = hitTemp;
-                        out = true;
-                        closest = distance;
-                        barycentric = barycentricTemp;
-                        index = i;
-                        first = false;
-                    }
-                }
-
-                ++i;
-            }
-
+            glm::vec3 barycentric;
+            const bool out = intersectTriangles(pos, dir, mesh, t, index, barycentric);
             if (out)
             {
+                hit = pos + dir * t;
+
                 const TriangleMesh::Vertex& vert0 = mesh.triangles[index].v0;
                 const TriangleMesh::Vertex& vert1 = mesh.triangles[index].v1;
                 const TriangleMesh::Vertex& vert2 = mesh.triangles[index].v2;
@@ -42,6 +42,17 @@ namespace djv
             glm::vec3&       hit,
             glm::vec3&       barycentric);
 
+        //! Intersect a line with the triangles of a mesh. The closest hit is
+        //! returned as a distance along the line in units of the direction,
+        //! the triangle index, and the barycentric coordinates.
+        bool intersectTriangles(
+            const glm::vec3&    pos,
+            const glm::vec3&    dir,
+            const TriangleMesh& mesh,
+            float&              t,
+            size_t&             triangle,
+            glm::vec3&          barycentric);
+
         //! Intersect a line with a mesh.
         bool intersect(
             const glm::vec3&    pos,
@@ -4,6 +4,8 @@
 
 #include <djvImage/Data.h>
 
+#include <djvImage/DataPool.h>
+
 #include <djvCore/UIDFunc.h>
 
 namespace djv
@@ -19,7 +21,8 @@ namespace djv
             _dataByteCount = info.getDataByteCount();
             if (_dataByteCount)
             {
-                _data = new uint8_t[_dataByteCount];
+                _pool = DataPool::getGlobal();
+                _data = _pool->allocate(_dataByteCount);
                 _p = _data;
             }
         }
@@ -29,7 +32,10 @@ namespace djv
 
         Data::~Data()
         {
-            delete[] _data;
+            if (_pool)
+            {
+                _pool->release(_data, _dataByteCount);
+            }
         }
 
         std::shared_ptr<Data> Data::create(const Info& info)
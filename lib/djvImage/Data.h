@@ -15,7 +15,10 @@ namespace djv
 {
     namespace Image
     {
-        //! This class provides image data.
+        class DataPool;
+
+        //! This class provides image data. The memory is allocated from the
+        //! global data pool.
         class Data
         {
             DJV_NON_COPYABLE(Data);
@@ -94,6 +97,7 @@ namespace djv
             size_t _scanlineByteCount = 0;
             size_t _dataByteCount = 0;
             std::string _pluginName;
+            std::shared_ptr<DataPool> _pool;
             uint8_t* _data = nullptr;
             const uint8_t* _p = nullptr;
             Tags _tags;
@@ -6,6 +6,10 @@
 
 #include <djvImage/Color.h>
 #include <djvImage/Data.h>
+#include <djvImage/Parallel.h>
+#include <djvImage/TypeFunc.h>
+
+#include <algorithm>
 
 namespace djv
 {
@@ -82,6 +86,59 @@ namespace djv
             return out;
         }
 
+        std::shared_ptr<Data> createMipmap(const std::shared_ptr<Data>& data)
+        {
+            std::shared_ptr<Data> out;
+            if (data && data->isValid())
+            {
+                const auto& info = data->getInfo();
+                const uint16_t w = info.size.w;
+                const uint16_t h = info.size.h;
+                const uint16_t outW = static_cast<uint16_t>((static_cast<size_t>(w) + 1) / 2);
+                const uint16_t outH = static_cast<uint16_t>((static_cast<size_t>(h) + 1) / 2);
+                Info outInfo(outW, outH, info.type);
+                outInfo.pixelAspectRatio = info.pixelAspectRatio;
+                outInfo.layout.mirror = info.layout.mirror;
+                out = Data::create(outInfo);
+
+                // Average the pixels as floating point values so that all of
+                // the image types can be handled the same way.
+                const uint8_t channelCount = getChannelCount(info.type);
+                const Type floatType = getFloatType(channelCount, 32);
+                const Data* in = data.get();
+                Data* outP = out.get();
+                parallelScanlines(
+                    outH,
+                    static_cast<size_t>(w) * static_cast<size_t>(h),
+                    [in, outP, w, h, outW, channelCount, floatType](uint16_t begin, uint16_t end)
+                    {
+                        const Type type = in->getType();
+                        std::vector<F32_T> row0(static_cast<size_t>(w) * channelCount);
+                        std::vector<F32_T> row1(static_cast<size_t>(w) * channelCount);
+                        std::vector<F32_T> outRow(static_cast<size_t>(outW) * channelCount);
+                        for (uint16_t y = begin; y < end; ++y)
+                        {
+                            const uint16_t y0 = y * 2;
+                            const uint16_t y1 = std::min(static_cast<uint16_t>(y0 + 1), static_cast<uint16_t>(h - 1));
+                            convert(in->getData(y0), type, row0.data(), floatType, w);
+                            convert(in->getData(y1), type, row1.data(), floatType, w);
+                            F32_T* outRowP = outRow.data();
+                            for (uint16_t x = 0; x < outW; ++x)
+                            {
+                                const size_t x0 = static_cast<size_t>(x) * 2 * channelCount;
+                                const size_t x1 = std::min(static_cast<size_t>(x) * 2 + 1, static_cast<size_t>(w - 1)) * channelCount;
+                                for (uint8_t c = 0; c < channelCount; ++c, ++outRowP)
+                                {
+                                    *outRowP = (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c]) * .25F;
+                                }
+                            }
+                            convert(outRow.data(), floatType, outP->getData(y), type, outW);
+                        }
+                    });
+            }
+            return out;
+        }
+
     } // namespace Image
 } // namespace djv
 
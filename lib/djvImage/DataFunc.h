@@ -18,6 +18,11 @@ namespace djv
 
         Color getAverageColor(const std::shared_ptr<Data>&);
 
+        //! Create the next mipmap level of an image by averaging blocks of
+        //! 2x2 pixels. Odd dimensions are rounded up and the last row or
+        //! column is repeated.
+        std::shared_ptr<Data> createMipmap(const std::shared_ptr<Data>&);
+
         ///@}
     
     } // namespace Image
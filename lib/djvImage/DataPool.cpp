@@ -0,0 +1,286 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvImage/DataPool.h>
+
+#include <djvCore/Memory.h>
+
+#if defined(DJV_PLATFORM_WINDOWS)
+#define NOMINMAX
+#include <windows.h>
+#else // DJV_PLATFORM_WINDOWS
+#include <sys/mman.h>
+#endif // DJV_PLATFORM_WINDOWS
+
+#include <map>
+#include <mutex>
+#include <new>
+#include <vector>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace Image
+    {
+        namespace
+        {
+            //! \todo Should this be configurable?
+            const size_t poolMinByteCount        = Memory::megabyte;
+            const size_t maxFreeByteCountDefault = 2 * Memory::gigabyte;
+            const size_t hugePageByteCount       = 2 * Memory::megabyte;
+
+            uint8_t* mapPages(size_t byteCount, bool hugePages, bool& hugePagesOut)
+            {
+                uint8_t* out = nullptr;
+                hugePagesOut = false;
+#if defined(DJV_PLATFORM_WINDOWS)
+                out = reinterpret_cast<uint8_t*>(VirtualAlloc(NULL, byteCount, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+#else // DJV_PLATFORM_WINDOWS
+                void* p = MAP_FAILED;
+#if defined(MAP_HUGETLB)
+                if (hugePages && 0 == byteCount % hugePageByteCount)
+                {
+                    p = mmap(NULL, byteCount, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                    hugePagesOut = p != MAP_FAILED;
+                }
+#endif // MAP_HUGETLB
+                if (MAP_FAILED == p)
+                {
+                    p = mmap(NULL, byteCount, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#if defined(MADV_HUGEPAGE)
+                    if (p != MAP_FAILED)
+                    {
+                        madvise(p, byteCount, MADV_HUGEPAGE);
+                    }
+#endif // MADV_HUGEPAGE
+                }
+                if (p != MAP_FAILED)
+                {
+                    out = reinterpret_cast<uint8_t*>(p);
+                }
+#endif // DJV_PLATFORM_WINDOWS
+                if (!out)
+                {
+                    throw std::bad_alloc();
+                }
+                return out;
+            }
+
+            void unmapPages(uint8_t* value, size_t byteCount)
+            {
+#if defined(DJV_PLATFORM_WINDOWS)
+                VirtualFree(value, 0, MEM_RELEASE);
+#else // DJV_PLATFORM_WINDOWS
+                munmap(value, byteCount);
+#endif // DJV_PLATFORM_WINDOWS
+            }
+
+        } // namespace
+
+        struct DataPool::Private
+        {
+            size_t maxFreeByteCount = maxFreeByteCountDefault;
+            bool hugePages = false;
+            std::map<size_t, std::vector<uint8_t*> > free;
+            DataPoolStats stats;
+            mutable std::mutex mutex;
+
+            void trim(size_t maxFreeByteCount, std::vector<std::pair<uint8_t*, size_t> >& out);
+        };
+
+        DataPool::DataPool() :
+            _p(new Private)
+        {}
+
+        DataPool::~DataPool()
+        {
+            trim();
+        }
+
+        std::shared_ptr<DataPool> DataPool::create()
+        {
+            return std::shared_ptr<DataPool>(new DataPool);
+        }
+
+        const std::shared_ptr<DataPool>& DataPool::getGlobal()
+        {
+            // Image data holds a reference to the pool, so the pool outlives
+            // any images that are destroyed during static destruction.
+            static const std::shared_ptr<DataPool> pool = create();
+            return pool;
+        }
+
+        size_t DataPool::getMaxFreeByteCount() const
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            return p.maxFreeByteCount;
+        }
+
+        void DataPool::setMaxFreeByteCount(size_t value)
+        {
+            DJV_PRIVATE_PTR();
+            std::vector<std::pair<uint8_t*, size_t> > unmap;
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.maxFreeByteCount = value;
+                p.trim(value, unmap);
+            }
+            for (const auto& i : unmap)
+            {
+                unmapPages(i.first, i.second);
+            }
+        }
+
+        bool DataPool::hasHugePages() const
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            return p.hugePages;
+        }
+
+        void DataPool::setHugePages(bool value)
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            p.hugePages = value;
+        }
+
+        uint8_t* DataPool::allocate(size_t byteCount)
+        {
+            DJV_PRIVATE_PTR();
+            const size_t sizeClass = getSizeClass(byteCount);
+            if (!sizeClass)
+            {
+                return new uint8_t[byteCount];
+            }
+
+            bool hugePages = false;
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.free.find(sizeClass);
+                if (i != p.free.end() && !i->second.empty())
+                {
+                    // Reuse the most recently released buffer since it is the
+                    // most likely to still be resident.
+                    uint8_t* out = i->second.back();
+                    i->second.pop_back();
+                    --p.stats.freeCount;
+                    p.stats.freeByteCount -= sizeClass;
+                    ++p.stats.reuseCount;
+                    ++p.stats.usedCount;
+                    p.stats.usedByteCount += sizeClass;
+                    return out;
+                }
+                hugePages = p.hugePages;
+            }
+
+            // Map the pages outside of the lock so other threads are not
+            // blocked by the system call.
+            bool hugePagesOut = false;
+            uint8_t* out = mapPages(sizeClass, hugePages, hugePagesOut);
+            std::lock_guard<std::mutex> lock(p.mutex);
+            ++p.stats.allocCount;
+            if (hugePagesOut)
+            {
+                ++p.stats.hugePageCount;
+            }
+            ++p.stats.usedCount;
+            p.stats.usedByteCount += sizeClass;
+            return out;
+        }
+
+        void DataPool::release(uint8_t* value, size_t byteCount)
+        {
+            DJV_PRIVATE_PTR();
+            if (!value)
+                return;
+            const size_t sizeClass = getSizeClass(byteCount);
+            if (!sizeClass)
+            {
+                delete[] value;
+                return;
+            }
+
+            bool unmap = false;
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                --p.stats.usedCount;
+                p.stats.usedByteCount -= sizeClass;
+                if (p.stats.freeByteCount + sizeClass <= p.maxFreeByteCount)
+                {
+                    p.free[sizeClass].push_back(value);
+                    ++p.stats.freeCount;
+                    p.stats.freeByteCount += sizeClass;
+                }
+                else
+                {
+                    ++p.stats.releaseCount;
+                    unmap = true;
+                }
+            }
+            if (unmap)
+            {
+                unmapPages(value, sizeClass);
+            }
+        }
+
+        void DataPool::trim()
+        {
+            DJV_PRIVATE_PTR();
+            std::vector<std::pair<uint8_t*, size_t> > unmap;
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.trim(0, unmap);
+            }
+            for (const auto& i : unmap)
+            {
+                unmapPages(i.first, i.second);
+            }
+        }
+
+        DataPoolStats DataPool::getStats() const
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            return p.stats;
+        }
+
+        size_t DataPool::getSizeClass(size_t byteCount)
+        {
+            size_t out = 0;
+            if (byteCount >= poolMinByteCount)
+            {
+                size_t power = 1;
+                while (power <= byteCount / 2)
+                {
+                    power *= 2;
+                }
+                const size_t step = power / 4;
+                out = (byteCount + step - 1) / step * step;
+            }
+            return out;
+        }
+
+        void DataPool::Private::trim(size_t value, std::vector<std::pair<uint8_t*, size_t> >& out)
+        {
+            // Release the largest buffers first.
+            auto i = free.rbegin();
+            while (stats.freeByteCount > value && i != free.rend())
+            {
+                while (stats.freeByteCount > value && !i->second.empty())
+                {
+                    out.push_back(std::make_pair(i->second.back(), i->first));
+                    i->second.pop_back();
+                    --stats.freeCount;
+                    stats.freeByteCount -= i->first;
+                    ++stats.releaseCount;
+                }
+                ++i;
+            }
+        }
+
+    } // namespace Image
+} // namespace djv
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <memory>
+
+namespace djv
+{
+    namespace Image
+    {
+        //! This struct provides data pool statistics.
+        struct DataPoolStats
+        {
+            size_t allocCount    = 0; //!< The number of buffers allocated from the system
+            size_t reuseCount    = 0; //!< The number of buffers reused from the pool
+            size_t releaseCount  = 0; //!< The number of buffers returned to the system
+            size_t hugePageCount = 0; //!< The number of buffers backed by explicit huge pages
+
+            size_t usedCount     = 0; //!< The number of buffers in use
+            size_t usedByteCount = 0; //!< The number of bytes in use
+            size_t freeCount     = 0; //!< The number of buffers waiting to be reused
+            size_t freeByteCount = 0; //!< The number of bytes waiting to be reused
+        };
+
+        //! This class provides a pool of image data buffers.
+        //!
+        //! Allocating and freeing large buffers goes to the operating system
+        //! each time, and the pages are faulted in again on first use. The
+        //! pool keeps released buffers in size classes so that frames of the
+        //! same size reuse the same memory. Buffers smaller than the minimum
+        //! pooled size use the regular heap.
+        //!
+        //! Pooled buffers are mapped directly from the operating system. On
+        //! Linux they are advised to use transparent huge pages, or explicit
+        //! huge pages (MAP_HUGETLB) can be enabled if the system has reserved
+        //! them.
+        //!
+        //! This class is thread safe.
+        class DataPool
+        {
+            DJV_NON_COPYABLE(DataPool);
+
+        protected:
+            DataPool();
+
+        public:
+            ~DataPool();
+
+            //! Create a new data pool.
+            static std::shared_ptr<DataPool> create();
+
+            //! Get the data pool that is used by Data::create().
+            static const std::shared_ptr<DataPool>& getGlobal();
+
+            //! \name Options
+            ///@{
+
+            //! Get the maximum number of bytes kept for reuse.
+            size_t getMaxFreeByteCount() const;
+
+            //! Set the maximum number of bytes kept for reuse. Buffers released
+            //! above this limit are returned to the system. This is usually
+            //! tied to the frame cache size.
+            void setMaxFreeByteCount(size_t);
+
+            //! Get whether explicit huge pages are used.
+            bool hasHugePages() const;
+
+            //! Set whether explicit huge pages are used. If the allocation fails
+            //! the buffer falls back to regular pages.
+            void setHugePages(bool);
+
+            ///@}
+
+            //! \name Allocation
+            ///@{
+
+            //! Allocate a buffer of at least the given size.
+            //! Throws:
+            //! - std::bad_alloc
+            uint8_t* allocate(size_t byteCount);
+
+            //! Release a buffer. The size must be the same as the size that
+            //! was given to allocate().
+            void release(uint8_t*, size_t byteCount);
+
+            //! Return all of the unused buffers to the system.
+            void trim();
+
+            DataPoolStats getStats() const;
+
+            //! Get the size class of an allocation, or zero if the allocation
+            //! is not pooled. Size classes are spaced four to each power of
+            //! two.
+            static size_t getSizeClass(size_t byteCount);
+
+            ///@}
+
+        private:
+            DJV_PRIVATE();
+        };
+
+    } // namespace Image
+} // namespace djv
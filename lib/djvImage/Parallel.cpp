@@ -0,0 +1,211 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvImage/Parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace djv
+{
+    namespace Image
+    {
+        namespace
+        {
+            //! \todo Should this be configurable?
+            const size_t parallelCount = 65536;
+
+            //! This class provides a range that is split into chunks. The
+            //! chunks are taken by the calling thread and the pool threads.
+            class Job
+            {
+            public:
+                Job(size_t count, size_t chunk, const std::function<void(size_t, size_t)>& function) :
+                    _count(count),
+                    _chunk(chunk),
+                    _chunkCount((count + chunk - 1) / chunk),
+                    _function(function),
+                    _next(0),
+                    _done(0)
+                {}
+
+                size_t getChunkCount() const
+                {
+                    return _chunkCount;
+                }
+
+                //! Run chunks until there are none left.
+                void run()
+                {
+                    size_t i = 0;
+                    while ((i = _next++) < _chunkCount)
+                    {
+                        const size_t begin = i * _chunk;
+                        try
+                        {
+                            _function(begin, std::min(begin + _chunk, _count));
+                        }
+                        catch (...)
+                        {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            if (!_exception)
+                            {
+                                _exception = std::current_exception();
+                            }
+                        }
+                        if (++_done == _chunkCount)
+                        {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            _cv.notify_all();
+                        }
+                    }
+                }
+
+                //! Wait for the chunks taken by other threads to finish.
+                void wait()
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _cv.wait(
+                        lock,
+                        [this]
+                        {
+                            return _done == _chunkCount;
+                        });
+                    if (_exception)
+                    {
+                        std::rethrow_exception(_exception);
+                    }
+                }
+
+            private:
+                const size_t _count;
+                const size_t _chunk;
+                const size_t _chunkCount;
+                const std::function<void(size_t, size_t)>& _function;
+                std::atomic<size_t> _next;
+                std::atomic<size_t> _done;
+                std::mutex _mutex;
+                std::condition_variable _cv;
+                std::exception_ptr _exception;
+            };
+
+            //! This class provides the threads shared by all of the parallel
+            //! functions. Calls from inside a parallel function add their
+            //! chunks to the same pool, so nested calls do not create more
+            //! threads than there are hardware threads. The calling thread
+            //! always runs chunks as well, so a nested call finishes even
+            //! when all of the pool threads are busy.
+            class Pool
+            {
+            public:
+                Pool()
+                {
+                    const size_t count = std::max(std::thread::hardware_concurrency(), 1U) - 1;
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        std::thread(&Pool::_work, this).detach();
+                    }
+                    _threadCount = count;
+                }
+
+                size_t getThreadCount() const
+                {
+                    return _threadCount;
+                }
+
+                void add(const std::shared_ptr<Job>& job, size_t count)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        for (size_t i = 0; i < count; ++i)
+                        {
+                            _jobs.push_back(job);
+                        }
+                    }
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        _cv.notify_one();
+                    }
+                }
+
+            private:
+                void _work()
+                {
+                    while (true)
+                    {
+                        std::shared_ptr<Job> job;
+                        {
+                            std::unique_lock<std::mutex> lock(_mutex);
+                            _cv.wait(
+                                lock,
+                                [this]
+                                {
+                                    return !_jobs.empty();
+                                });
+                            job = _jobs.front();
+                            _jobs.pop_front();
+                        }
+                        job->run();
+                    }
+                }
+
+                size_t _threadCount = 0;
+                std::deque<std::shared_ptr<Job> > _jobs;
+                std::mutex _mutex;
+                std::condition_variable _cv;
+            };
+
+            Pool& getPool()
+            {
+                // The pool is not destroyed so the threads do not need to be
+                // joined when the application exits.
+                static Pool* pool = new Pool;
+                return *pool;
+            }
+
+        } // namespace
+
+        void parallelRange(
+            size_t count,
+            size_t cost,
+            const std::function<void(size_t begin, size_t end)>& function)
+        {
+            size_t threadCount = 1;
+            if (cost >= parallelCount)
+            {
+                threadCount = std::min(getPool().getThreadCount() + 1, count);
+            }
+            if (threadCount <= 1)
+            {
+                function(0, count);
+                return;
+            }
+            auto job = std::make_shared<Job>(count, (count + threadCount - 1) / threadCount, function);
+            getPool().add(job, job->getChunkCount() - 1);
+            job->run();
+            job->wait();
+        }
+
+        void parallelScanlines(
+            uint16_t height,
+            size_t cost,
+            const std::function<void(uint16_t begin, uint16_t end)>& function)
+        {
+            parallelRange(
+                height,
+                cost,
+                [&function](size_t begin, size_t end)
+                {
+                    function(static_cast<uint16_t>(begin), static_cast<uint16_t>(end));
+                });
+        }
+
+    } // namespace Image
+} // namespace djv
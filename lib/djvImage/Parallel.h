@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace djv
+{
+    namespace Image
+    {
+        //! \name Threading
+        ///@{
+
+        //! Split a range into chunks and call the function with each chunk
+        //! range on a shared pool of threads. The calling thread also
+        //! processes chunks, so the function can be called from inside
+        //! another parallel function without creating more threads. The range
+        //! is processed on the calling thread when the cost (for example the
+        //! number of pixels) is small. Exceptions thrown by the function are
+        //! re-thrown on the calling thread.
+        void parallelRange(
+            size_t count,
+            size_t cost,
+            const std::function<void(size_t begin, size_t end)>&);
+
+        //! Split the scanlines of an image into tiles and call the function
+        //! with the tile range on separate threads.
+        void parallelScanlines(
+            uint16_t height,
+            size_t cost,
+            const std::function<void(uint16_t begin, uint16_t end)>&);
+
+        ///@}
+
+    } // namespace Image
+} // namespace djv
@@ -0,0 +1,350 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvImage/Statistics.h>
+
+#include <djvImage/Data.h>
+#include <djvImage/Parallel.h>
+#include <djvImage/TypeFunc.h>
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_IMAGE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace djv
+{
+    namespace Image
+    {
+        namespace
+        {
+            template<typename T>
+            void readRGBA(const T* p, uint8_t channels, uint16_t count, uint16_t step, float scale, float* out)
+            {
+                const size_t stride = channels * static_cast<size_t>(step);
+                switch (channels)
+                {
+                case 1:
+                    for (uint16_t i = 0; i < count; ++i, p += stride, out += 4)
+                    {
+                        const float l = static_cast<float>(p[0]) * scale;
+                        out[0] = l;
+                        out[1] = l;
+                        out[2] = l;
+                        out[3] = 1.F;
+                    }
+                    break;
+                case 2:
+                    for (uint16_t i = 0; i < count; ++i, p += stride, out += 4)
+                    {
+                        const float l = static_cast<float>(p[0]) * scale;
+                        out[0] = l;
+                        out[1] = l;
+                        out[2] = l;
+                        out[3] = static_cast<float>(p[1]) * scale;
+                    }
+                    break;
+                case 3:
+                    for (uint16_t i = 0; i < count; ++i, p += stride, out += 4)
+                    {
+                        out[0] = static_cast<float>(p[0]) * scale;
+                        out[1] = static_cast<float>(p[1]) * scale;
+                        out[2] = static_cast<float>(p[2]) * scale;
+                        out[3] = 1.F;
+                    }
+                    break;
+                case 4:
+                    for (uint16_t i = 0; i < count; ++i, p += stride, out += 4)
+                    {
+                        out[0] = static_cast<float>(p[0]) * scale;
+                        out[1] = static_cast<float>(p[1]) * scale;
+                        out[2] = static_cast<float>(p[2]) * scale;
+                        out[3] = static_cast<float>(p[3]) * scale;
+                    }
+                    break;
+                default: break;
+                }
+            }
+
+            void readRGBA_U10(const U10_S* p, uint16_t count, uint16_t step, float* out)
+            {
+                const float scale = 1.F / static_cast<float>(U10Range.getMax());
+                for (uint16_t i = 0; i < count; ++i, p += step, out += 4)
+                {
+                    out[0] = p->r * scale;
+                    out[1] = p->g * scale;
+                    out[2] = p->b * scale;
+                    out[3] = 1.F;
+                }
+            }
+
+            //! The statistics are accumulated for the four RGBA lanes and then
+            //! copied to the image channels.
+            struct Accumulator
+            {
+                Accumulator(const StatisticsOptions&, size_t binCount);
+
+                size_t                binCount        = 0;
+                uint16_t              waveformWidth   = 0;
+                uint16_t              waveformHeight  = 0;
+                uint16_t              vectorscopeSize = 0;
+                size_t                sampleCount     = 0;
+                std::vector<uint32_t> histogram;
+                float                 min[4];
+                float                 max[4];
+                std::vector<uint32_t> waveform;
+                std::vector<uint32_t> vectorscope;
+
+                void add(const float* rgba, uint16_t count, const uint16_t* columns);
+                void addVectorscope(const float* rgb);
+                void merge(const Accumulator&);
+            };
+
+            Accumulator::Accumulator(const StatisticsOptions& options, size_t binCount) :
+                binCount(binCount),
+                waveformWidth(options.waveformWidth),
+                waveformHeight(options.waveformWidth ? std::max(options.waveformHeight, static_cast<uint16_t>(1)) : 0),
+                vectorscopeSize(options.vectorscopeSize)
+            {
+                histogram.resize(4 * binCount, 0);
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    min[i] = std::numeric_limits<float>::max();
+                    max[i] = std::numeric_limits<float>::lowest();
+                }
+                waveform.resize(4 * static_cast<size_t>(waveformHeight) * waveformWidth, 0);
+                vectorscope.resize(static_cast<size_t>(vectorscopeSize) * vectorscopeSize, 0);
+            }
+
+            void Accumulator::addVectorscope(const float* rgb)
+            {
+                const float cb = -.1146F * rgb[0] - .3854F * rgb[1] + .5F * rgb[2];
+                const float cr = .5F * rgb[0] - .4542F * rgb[1] - .0458F * rgb[2];
+                const int size = vectorscopeSize;
+                const int x = std::min(std::max(static_cast<int>((cb + .5F) * size), 0), size - 1);
+                const int y = std::min(std::max(static_cast<int>((cr + .5F) * size), 0), size - 1);
+                ++vectorscope[y * size + x];
+            }
+
+            void Accumulator::add(const float* rgba, uint16_t count, const uint16_t* columns)
+            {
+                const size_t waveformPlane = static_cast<size_t>(waveformHeight) * waveformWidth;
+#if defined(DJV_IMAGE_SSE2)
+                const __m128 zero = _mm_setzero_ps();
+                const __m128 one = _mm_set1_ps(1.F);
+                const __m128 binScale = _mm_set1_ps(static_cast<float>(binCount));
+                const __m128 binMax = _mm_set1_ps(static_cast<float>(binCount - 1));
+                const __m128 waveformScale = _mm_set1_ps(static_cast<float>(waveformHeight));
+                const __m128 waveformMax = _mm_set1_ps(static_cast<float>(waveformHeight ? waveformHeight - 1 : 0));
+                __m128 vMin = _mm_loadu_ps(min);
+                __m128 vMax = _mm_loadu_ps(max);
+                alignas(16) int32_t bins[4];
+                alignas(16) float clamped[4];
+                for (uint16_t i = 0; i < count; ++i, rgba += 4)
+                {
+                    // The value is the first operand so NaNs are ignored.
+                    const __m128 v = _mm_loadu_ps(rgba);
+                    vMin = _mm_min_ps(v, vMin);
+                    vMax = _mm_max_ps(v, vMax);
+                    const __m128 c = _mm_min_ps(_mm_max_ps(v, zero), one);
+                    _mm_store_si128(
+                        reinterpret_cast<__m128i*>(bins),
+                        _mm_cvttps_epi32(_mm_min_ps(_mm_mul_ps(c, binScale), binMax)));
+                    ++histogram[bins[0]];
+                    ++histogram[binCount + bins[1]];
+                    ++histogram[binCount * 2 + bins[2]];
+                    ++histogram[binCount * 3 + bins[3]];
+                    if (waveformWidth)
+                    {
+                        _mm_store_si128(
+                            reinterpret_cast<__m128i*>(bins),
+                            _mm_cvttps_epi32(_mm_min_ps(_mm_mul_ps(c, waveformScale), waveformMax)));
+                        const size_t x = columns[i];
+                        for (size_t j = 0; j < 4; ++j)
+                        {
+                            ++waveform[waveformPlane * j + bins[j] * static_cast<size_t>(waveformWidth) + x];
+                        }
+                    }
+                    if (vectorscopeSize)
+                    {
+                        _mm_store_ps(clamped, c);
+                        addVectorscope(clamped);
+                    }
+                }
+                _mm_storeu_ps(min, vMin);
+                _mm_storeu_ps(max, vMax);
+#else // DJV_IMAGE_SSE2
+                float clamped[4];
+                for (uint16_t i = 0; i < count; ++i, rgba += 4)
+                {
+                    for (size_t j = 0; j < 4; ++j)
+                    {
+                        const float v = rgba[j];
+                        if (v < min[j]) min[j] = v;
+                        if (v > max[j]) max[j] = v;
+                        clamped[j] = v > 0.F ? (v < 1.F ? v : 1.F) : 0.F;
+                        const size_t bin = std::min(static_cast<size_t>(clamped[j] * binCount), binCount - 1);
+                        ++histogram[binCount * j + bin];
+                        if (waveformWidth)
+                        {
+                            const size_t waveformBin = std::min(
+                                static_cast<size_t>(clamped[j] * waveformHeight),
+                                static_cast<size_t>(waveformHeight - 1));
+                            ++waveform[waveformPlane * j + waveformBin * waveformWidth + columns[i]];
+                        }
+                    }
+                    if (vectorscopeSize)
+                    {
+                        addVectorscope(clamped);
+                    }
+                }
+#endif // DJV_IMAGE_SSE2
+                sampleCount += count;
+            }
+
+            void Accumulator::merge(const Accumulator& other)
+            {
+                for (size_t i = 0; i < histogram.size(); ++i)
+                {
+                    histogram[i] += other.histogram[i];
+                }
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    min[i] = std::min(min[i], other.min[i]);
+                    max[i] = std::max(max[i], other.max[i]);
+                }
+                for (size_t i = 0; i < waveform.size(); ++i)
+                {
+                    waveform[i] += other.waveform[i];
+                }
+                for (size_t i = 0; i < vectorscope.size(); ++i)
+                {
+                    vectorscope[i] += other.vectorscope[i];
+                }
+                sampleCount += other.sampleCount;
+            }
+
+        } // namespace
+
+        bool StatisticsOptions::operator == (const StatisticsOptions& other) const
+        {
+            return
+                binCount == other.binCount &&
+                step == other.step &&
+                waveformWidth == other.waveformWidth &&
+                waveformHeight == other.waveformHeight &&
+                vectorscopeSize == other.vectorscopeSize;
+        }
+
+        Statistics getStatistics(const Data& data, const StatisticsOptions& options)
+        {
+            Statistics out;
+            out.type = data.getType();
+            out.channelCount = getChannelCount(out.type);
+            out.binCount = std::max(options.binCount, static_cast<size_t>(1));
+            if (!data.isValid() || 0 == out.channelCount)
+                return out;
+
+            const uint16_t step = std::max(options.step, static_cast<uint16_t>(1));
+            const uint16_t w = data.getWidth();
+            const uint16_t h = data.getHeight();
+            const uint16_t sampleWidth = static_cast<uint16_t>((w + step - 1) / step);
+            const uint16_t sampleHeight = static_cast<uint16_t>((h + step - 1) / step);
+            StatisticsOptions accumulatorOptions = options;
+            if (out.channelCount < 3)
+            {
+                accumulatorOptions.vectorscopeSize = 0;
+            }
+            std::vector<uint16_t> columns(sampleWidth);
+            for (uint16_t i = 0; i < sampleWidth; ++i)
+            {
+                columns[i] = static_cast<uint16_t>(static_cast<size_t>(i) * step * options.waveformWidth / w);
+            }
+
+            Accumulator total(accumulatorOptions, out.binCount);
+            std::mutex mutex;
+            parallelScanlines(
+                sampleHeight,
+                static_cast<size_t>(sampleWidth) * sampleHeight,
+                [&data, &accumulatorOptions, &out, &columns, &total, &mutex, step, sampleWidth](uint16_t begin, uint16_t end)
+                {
+                    Accumulator accumulator(accumulatorOptions, out.binCount);
+                    std::vector<float> scanline(static_cast<size_t>(sampleWidth) * 4);
+                    for (uint16_t y = begin; y < end; ++y)
+                    {
+                        readRGBA_F32(data, 0, y * step, sampleWidth, step, scanline.data());
+                        accumulator.add(scanline.data(), sampleWidth, columns.data());
+                    }
+                    std::lock_guard<std::mutex> lock(mutex);
+                    total.merge(accumulator);
+                });
+
+            // Copy the RGBA lanes to the image channels.
+            std::vector<size_t> lanes;
+            switch (out.channelCount)
+            {
+            case 1: lanes = { 0 }; break;
+            case 2: lanes = { 0, 3 }; break;
+            case 3: lanes = { 0, 1, 2 }; break;
+            case 4: lanes = { 0, 1, 2, 3 }; break;
+            default: break;
+            }
+            out.sampleCount = total.sampleCount;
+            out.waveformWidth = total.waveformWidth;
+            out.waveformHeight = total.waveformHeight;
+            const size_t waveformPlane = static_cast<size_t>(total.waveformHeight) * total.waveformWidth;
+            for (const auto lane : lanes)
+            {
+                out.histogram.insert(
+                    out.histogram.end(),
+                    total.histogram.begin() + lane * out.binCount,
+                    total.histogram.begin() + (lane + 1) * out.binCount);
+                out.min.push_back(total.sampleCount ? total.min[lane] : 0.F);
+                out.max.push_back(total.sampleCount ? total.max[lane] : 0.F);
+                out.waveform.insert(
+                    out.waveform.end(),
+                    total.waveform.begin() + lane * waveformPlane,
+                    total.waveform.begin() + (lane + 1) * waveformPlane);
+            }
+            out.vectorscopeSize = total.vectorscopeSize;
+            out.vectorscope = std::move(total.vectorscope);
+            return out;
+        }
+
+        void readRGBA_F32(const Data& data, uint16_t x, uint16_t y, uint16_t count, uint16_t step, float* out)
+        {
+            const Type type = data.getType();
+            const uint8_t channels = getChannelCount(type);
+            const uint8_t* p = data.getData(x, y);
+            step = std::max(step, static_cast<uint16_t>(1));
+            switch (getDataType(type))
+            {
+            case DataType::U8:
+                readRGBA(p, channels, count, step, 1.F / U8Range.getMax(), out);
+                break;
+            case DataType::U10:
+                readRGBA_U10(reinterpret_cast<const U10_S*>(p), count, step, out);
+                break;
+            case DataType::U16:
+                readRGBA(reinterpret_cast<const U16_T*>(p), channels, count, step, 1.F / U16Range.getMax(), out);
+                break;
+            case DataType::U32:
+                readRGBA(reinterpret_cast<const U32_T*>(p), channels, count, step, 1.F / U32Range.getMax(), out);
+                break;
+            case DataType::F16:
+                readRGBA(reinterpret_cast<const F16_T*>(p), channels, count, step, 1.F, out);
+                break;
+            case DataType::F32:
+                readRGBA(reinterpret_cast<const F32_T*>(p), channels, count, step, 1.F, out);
+                break;
+            default: break;
+            }
+        }
+
+    } // namespace Image
+} // namespace djv
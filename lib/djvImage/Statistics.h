@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvImage/Type.h>
+
+#include <vector>
+
+namespace djv
+{
+    namespace Image
+    {
+        class Data;
+
+        //! This struct provides options for computing image statistics.
+        struct StatisticsOptions
+        {
+            //! The number of histogram bins.
+            size_t binCount = 256;
+
+            //! Sample every Nth pixel of every Nth scanline. This can be used
+            //! for a fast approximate pass, for example during playback.
+            uint16_t step = 1;
+
+            //! The size of the waveform, a width of zero disables it.
+            uint16_t waveformWidth  = 0;
+            uint16_t waveformHeight = 256;
+
+            //! The size of the vectorscope, zero disables it.
+            uint16_t vectorscopeSize = 0;
+
+            bool operator == (const StatisticsOptions&) const;
+        };
+
+        //! This struct provides image statistics. Floating point values are
+        //! normalized to the range [0, 1] for the histograms and scopes, values
+        //! outside of the range are counted in the first and last bins.
+        struct Statistics
+        {
+            Type     type         = Type::None;
+            uint8_t  channelCount = 0;
+            size_t   sampleCount  = 0;
+
+            //! The histograms, stored as channelCount * binCount counts.
+            size_t                binCount = 0;
+            std::vector<uint32_t> histogram;
+
+            //! The minimum and maximum values of each channel.
+            std::vector<float> min;
+            std::vector<float> max;
+
+            //! The waveforms, stored as channelCount * waveformHeight *
+            //! waveformWidth counts. Each row is a value bin and each column
+            //! is a horizontal range of the image.
+            uint16_t              waveformWidth  = 0;
+            uint16_t              waveformHeight = 0;
+            std::vector<uint32_t> waveform;
+
+            //! The vectorscope, stored as vectorscopeSize * vectorscopeSize
+            //! counts of the Rec. 709 chroma (Cb, Cr). This is only computed
+            //! for RGB and RGBA images.
+            uint16_t              vectorscopeSize = 0;
+            std::vector<uint32_t> vectorscope;
+        };
+
+        //! \name Statistics
+        ///@{
+
+        //! Compute image statistics. The image is split into tiles of
+        //! scanlines that are processed on separate threads.
+        Statistics getStatistics(const Data&, const StatisticsOptions& = StatisticsOptions());
+
+        //! Convert a span of pixels to RGBA floating point values, taking
+        //! every Nth pixel. Luminance images are copied to the RGB channels,
+        //! images without alpha have an alpha of one.
+        void readRGBA_F32(const Data&, uint16_t x, uint16_t y, uint16_t count, uint16_t step, float*);
+
+        ///@}
+
+    } // namespace Image
+} // namespace djv
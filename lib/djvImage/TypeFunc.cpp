@@ -4,11 +4,25 @@
 
 #include <djvImage/TypeFunc.h>
 
+#include <djvCore/MemoryFunc.h>
+
 #include <algorithm>
 #include <array>
 #include <functional>
 #include <map>
 
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define DJV_IMAGE_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#define DJV_IMAGE_SSSE3
+#define DJV_IMAGE_AVX2
+#else // _MSC_VER
+#define DJV_IMAGE_SSSE3 __attribute__((target("ssse3")))
+#define DJV_IMAGE_AVX2 __attribute__((target("avx2")))
+#endif // _MSC_VER
+#endif // DJV_IMAGE_X86
+
 #define CONVERT_L_L(A, B) \
     void convert_L_##A##_L_##B(const void * in, void * out, size_t size) \
     { \
@@ -380,7 +394,6 @@
     CONVERT_RGB_LA(A, F16); \
     CONVERT_RGB_LA(A, F32); \
     CONVERT_RGB_RGB(A, U8); \
-    CONVERT_RGB_RGB_U10(A); \
     CONVERT_RGB_RGB(A, U16); \
     CONVERT_RGB_RGB(A, U32); \
     CONVERT_RGB_RGB(A, F16); \
@@ -403,7 +416,6 @@
     CONVERT_RGB_U10_LA(F16); \
     CONVERT_RGB_U10_LA(F32); \
     CONVERT_RGB_U10_RGB(U8); \
-    CONVERT_RGB_U10_RGB(U16); \
     CONVERT_RGB_U10_RGB(U32); \
     CONVERT_RGB_U10_RGB(F16); \
     CONVERT_RGB_U10_RGB(F32); \
@@ -927,6 +939,20 @@ namespace djv
             CONVERT_RGB(U32);
             CONVERT_RGB(F16);
             CONVERT_RGB(F32);
+            CONVERT_RGB_RGB_U10(U8);
+            CONVERT_RGB_RGB_U10(U32);
+            CONVERT_RGB_RGB_U10(F16);
+            CONVERT_RGB_RGB_U10(F32);
+
+            void convert_RGB_U10_RGB_U16(const void * in, void * out, size_t size)
+            {
+                unpackU10(reinterpret_cast<const U10_S *>(in), reinterpret_cast<U16_T *>(out), size);
+            }
+
+            void convert_RGB_U16_RGB_U10(const void * in, void * out, size_t size)
+            {
+                packU10(reinterpret_cast<const U16_T *>(in), reinterpret_cast<U10_S *>(out), size);
+            }
             CONVERT_RGBA(U8);
             CONVERT_RGBA(U16);
             CONVERT_RGBA(U32);
@@ -935,6 +961,213 @@ namespace djv
 
         } // namespace
 
+        namespace
+        {
+#if defined(DJV_IMAGE_X86)
+            // The 10-bit pixels are 32-bit words with red in the upper bits:
+            // RRRRRRRRRRGGGGGGGGGGBBBBBBBBBB00. The kernels expand four pixels
+            // per 128-bit lane into 32-bit lanes that hold the 16-bit red and
+            // green values, and the blue values, then shuffle them into
+            // RGB order.
+            const int8_t unpackU10RG0[16] = { 0, 1, 2, 3, -1, -1, 4, 5, 6, 7, -1, -1, 8, 9, 10, 11 };
+            const int8_t unpackU10B0[16]  = { -1, -1, -1, -1, 0, 1, -1, -1, -1, -1, 4, 5, -1, -1, -1, -1 };
+            const int8_t unpackU10RG1[16] = { -1, -1, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+            const int8_t unpackU10B1[16]  = { 8, 9, -1, -1, -1, -1, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1 };
+
+            // Gather the red, green, and blue values of four 16-bit RGB pixels
+            // into 32-bit lanes, from the first 16 bytes and the last 8 bytes.
+            const int8_t packU10R0[16] = { 0, 1, -1, -1, 6, 7, -1, -1, 12, 13, -1, -1, -1, -1, -1, -1 };
+            const int8_t packU10R1[16] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 3, -1, -1 };
+            const int8_t packU10G0[16] = { 2, 3, -1, -1, 8, 9, -1, -1, 14, 15, -1, -1, -1, -1, -1, -1 };
+            const int8_t packU10G1[16] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 4, 5, -1, -1 };
+            const int8_t packU10B0[16] = { 4, 5, -1, -1, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+            const int8_t packU10B1[16] = { -1, -1, -1, -1, -1, -1, -1, -1, 0, 1, -1, -1, 6, 7, -1, -1 };
+
+            template<typename T>
+            T loadShuffle(const int8_t*);
+
+            template<>
+            DJV_IMAGE_SSSE3 inline __m128i loadShuffle<__m128i>(const int8_t* value)
+            {
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(value));
+            }
+
+            template<>
+            DJV_IMAGE_AVX2 inline __m256i loadShuffle<__m256i>(const int8_t* value)
+            {
+                return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(value)));
+            }
+
+            DJV_IMAGE_SSSE3 size_t unpackU10SSSE3(const uint32_t* in, U16_T* out, size_t size)
+            {
+                const __m128i mask = _mm_set1_epi32(0xffc0);
+                const __m128i rg0 = loadShuffle<__m128i>(unpackU10RG0);
+                const __m128i b0 = loadShuffle<__m128i>(unpackU10B0);
+                const __m128i rg1 = loadShuffle<__m128i>(unpackU10RG1);
+                const __m128i b1 = loadShuffle<__m128i>(unpackU10B1);
+                size_t i = 0;
+                for (; i + 4 <= size; i += 4, in += 4, out += 12)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                    const __m128i r = _mm_and_si128(_mm_srli_epi32(v, 16), mask);
+                    const __m128i g = _mm_and_si128(_mm_srli_epi32(v, 6), mask);
+                    const __m128i b = _mm_and_si128(_mm_slli_epi32(v, 4), mask);
+                    const __m128i rg = _mm_or_si128(r, _mm_slli_epi32(g, 16));
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i*>(out),
+                        _mm_or_si128(_mm_shuffle_epi8(rg, rg0), _mm_shuffle_epi8(b, b0)));
+                    _mm_storel_epi64(
+                        reinterpret_cast<__m128i*>(out + 8),
+                        _mm_or_si128(_mm_shuffle_epi8(rg, rg1), _mm_shuffle_epi8(b, b1)));
+                }
+                return i;
+            }
+
+            DJV_IMAGE_AVX2 size_t unpackU10AVX2(const uint32_t* in, U16_T* out, size_t size)
+            {
+                const __m256i mask = _mm256_set1_epi32(0xffc0);
+                const __m256i rg0 = loadShuffle<__m256i>(unpackU10RG0);
+                const __m256i b0 = loadShuffle<__m256i>(unpackU10B0);
+                const __m256i rg1 = loadShuffle<__m256i>(unpackU10RG1);
+                const __m256i b1 = loadShuffle<__m256i>(unpackU10B1);
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8, in += 8, out += 24)
+                {
+                    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+                    const __m256i r = _mm256_and_si256(_mm256_srli_epi32(v, 16), mask);
+                    const __m256i g = _mm256_and_si256(_mm256_srli_epi32(v, 6), mask);
+                    const __m256i b = _mm256_and_si256(_mm256_slli_epi32(v, 4), mask);
+                    const __m256i rg = _mm256_or_si256(r, _mm256_slli_epi32(g, 16));
+                    const __m256i out0 = _mm256_or_si256(_mm256_shuffle_epi8(rg, rg0), _mm256_shuffle_epi8(b, b0));
+                    const __m256i out1 = _mm256_or_si256(_mm256_shuffle_epi8(rg, rg1), _mm256_shuffle_epi8(b, b1));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(out0));
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 8), _mm256_castsi256_si128(out1));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm256_extracti128_si256(out0, 1));
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 20), _mm256_extracti128_si256(out1, 1));
+                }
+                return i;
+            }
+
+            DJV_IMAGE_SSSE3 size_t packU10SSSE3(const U16_T* in, uint32_t* out, size_t size)
+            {
+                const __m128i mask = _mm_set1_epi32(0xffc0);
+                const __m128i r0 = loadShuffle<__m128i>(packU10R0);
+                const __m128i r1 = loadShuffle<__m128i>(packU10R1);
+                const __m128i g0 = loadShuffle<__m128i>(packU10G0);
+                const __m128i g1 = loadShuffle<__m128i>(packU10G1);
+                const __m128i b0 = loadShuffle<__m128i>(packU10B0);
+                const __m128i b1 = loadShuffle<__m128i>(packU10B1);
+                size_t i = 0;
+                for (; i + 4 <= size; i += 4, in += 12, out += 4)
+                {
+                    const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                    const __m128i v1 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + 8));
+                    const __m128i r = _mm_and_si128(_mm_or_si128(_mm_shuffle_epi8(v0, r0), _mm_shuffle_epi8(v1, r1)), mask);
+                    const __m128i g = _mm_and_si128(_mm_or_si128(_mm_shuffle_epi8(v0, g0), _mm_shuffle_epi8(v1, g1)), mask);
+                    const __m128i b = _mm_and_si128(_mm_or_si128(_mm_shuffle_epi8(v0, b0), _mm_shuffle_epi8(v1, b1)), mask);
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i*>(out),
+                        _mm_or_si128(
+                            _mm_or_si128(_mm_slli_epi32(r, 16), _mm_slli_epi32(g, 6)),
+                            _mm_srli_epi32(b, 4)));
+                }
+                return i;
+            }
+
+            DJV_IMAGE_AVX2 size_t packU10AVX2(const U16_T* in, uint32_t* out, size_t size)
+            {
+                const __m256i mask = _mm256_set1_epi32(0xffc0);
+                const __m256i r0 = loadShuffle<__m256i>(packU10R0);
+                const __m256i r1 = loadShuffle<__m256i>(packU10R1);
+                const __m256i g0 = loadShuffle<__m256i>(packU10G0);
+                const __m256i g1 = loadShuffle<__m256i>(packU10G1);
+                const __m256i b0 = loadShuffle<__m256i>(packU10B0);
+                const __m256i b1 = loadShuffle<__m256i>(packU10B1);
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8, in += 24, out += 8)
+                {
+                    const __m256i v0 = _mm256_inserti128_si256(
+                        _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in))),
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 12)),
+                        1);
+                    const __m256i v1 = _mm256_inserti128_si256(
+                        _mm256_castsi128_si256(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + 8))),
+                        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + 20)),
+                        1);
+                    const __m256i r = _mm256_and_si256(_mm256_or_si256(_mm256_shuffle_epi8(v0, r0), _mm256_shuffle_epi8(v1, r1)), mask);
+                    const __m256i g = _mm256_and_si256(_mm256_or_si256(_mm256_shuffle_epi8(v0, g0), _mm256_shuffle_epi8(v1, g1)), mask);
+                    const __m256i b = _mm256_and_si256(_mm256_or_si256(_mm256_shuffle_epi8(v0, b0), _mm256_shuffle_epi8(v1, b1)), mask);
+                    _mm256_storeu_si256(
+                        reinterpret_cast<__m256i*>(out),
+                        _mm256_or_si256(
+                            _mm256_or_si256(_mm256_slli_epi32(r, 16), _mm256_slli_epi32(g, 6)),
+                            _mm256_srli_epi32(b, 4)));
+                }
+                return i;
+            }
+#endif // DJV_IMAGE_X86
+
+        } // namespace
+
+        void unpackU10(const U10_S * in, U16_T * out, size_t size)
+        {
+            size_t i = 0;
+#if defined(DJV_IMAGE_X86)
+            const uint32_t* inP = reinterpret_cast<const uint32_t*>(in);
+            switch (Core::Memory::getSIMD())
+            {
+            case Core::Memory::SIMD::AVX2:
+                i = unpackU10AVX2(inP, out, size);
+                i += unpackU10SSSE3(inP + i, out + i * 3, size - i);
+                break;
+            case Core::Memory::SIMD::SSSE3:
+                i = unpackU10SSSE3(inP, out, size);
+                break;
+            default: break;
+            }
+#endif // DJV_IMAGE_X86
+            in += i;
+            out += i * 3;
+            for (; i < size; ++i, ++in, out += 3)
+            {
+                convert_U10_U16(in->r, out[0]);
+                convert_U10_U16(in->g, out[1]);
+                convert_U10_U16(in->b, out[2]);
+            }
+        }
+
+        void packU10(const U16_T * in, U10_S * out, size_t size)
+        {
+            size_t i = 0;
+#if defined(DJV_IMAGE_X86)
+            uint32_t* outP = reinterpret_cast<uint32_t*>(out);
+            switch (Core::Memory::getSIMD())
+            {
+            case Core::Memory::SIMD::AVX2:
+                i = packU10AVX2(in, outP, size);
+                i += packU10SSSE3(in + i * 3, outP + i, size - i);
+                break;
+            case Core::Memory::SIMD::SSSE3:
+                i = packU10SSSE3(in, outP, size);
+                break;
+            default: break;
+            }
+#endif // DJV_IMAGE_X86
+            in += i * 3;
+            out += i;
+            for (; i < size; ++i, in += 3, ++out)
+            {
+                U10_T tmp = 0;
+                convert_U16_U10(in[0], tmp);
+                out->r = tmp;
+                convert_U16_U10(in[1], tmp);
+                out->g = tmp;
+                convert_U16_U10(in[2], tmp);
+                out->b = tmp;
+                out->pad = 0;
+            }
+        }
+
         void convert(const void * in, Type inType, void * out, Type outType, size_t size)
         {
             typedef std::function<void(const void *, void *, size_t)> Function;
@@ -94,6 +94,20 @@ namespace djv
 
         ///@}
 
+        //! \name 10-bit Packing
+        ///@{
+
+        //! Unpack 10-bit RGB pixels to 16-bit RGB pixels. This uses the SIMD
+        //! instruction set from Core::Memory::getSIMD().
+        void unpackU10(const U10_S *, U16_T *, size_t);
+
+        //! Pack 16-bit RGB pixels to 10-bit RGB pixels. The padding bits are
+        //! set to zero. This uses the SIMD instruction set from
+        //! Core::Memory::getSIMD().
+        void packU10(const U16_T *, U10_S *, size_t);
+
+        ///@}
+
         DJV_ENUM_HELPERS(Type);
         DJV_ENUM_HELPERS(Channels);
         DJV_ENUM_HELPERS(DataType);
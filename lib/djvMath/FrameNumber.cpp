@@ -16,24 +16,43 @@ namespace djv
     {
         namespace Frame
         {
+            namespace
+            {
+                //! Get whether a range ends before another range starts, with a
+                //! gap between them so that they cannot be merged.
+                bool isBefore(const Range& a, const Range& b)
+                {
+                    return a.getMax() < b.getMin() && b.getMin() - a.getMax() > 1;
+                }
+
+                size_t getSize(const Range& value)
+                {
+                    return static_cast<size_t>(value.getMax() - value.getMin() + 1);
+                }
+
+            } // namespace
+
             Sequence::Sequence()
             {}
        
             Sequence::Sequence(Number number)
             {
                 _ranges.push_back(Range(number));
+                _offsetsUpdate(0);
             }
        
             Sequence::Sequence(Number min, Number max, size_t pad) :
                 _pad(pad)
             {
                 _ranges.push_back(Range(min, max));
+                _offsetsUpdate(0);
             }
 
             Sequence::Sequence(const Range& range, size_t pad) :
                 _pad(pad)
             {
                 _ranges.push_back(range);
+                _offsetsUpdate(0);
             }
 
             Sequence::Sequence(const std::vector<Range>& ranges, size_t pad) :
@@ -47,72 +66,93 @@ namespace djv
             
             void Sequence::add(const Range& value)
             {
-                Range newRange(value);
-                auto i = _ranges.begin();
-                while (i != _ranges.end())
-                {
-                    if (newRange.intersects(*i))
-                    {
-                        newRange.expand(*i);
-                        i = _ranges.erase(i);
-                    }
-                    else if (newRange.getMin() == i->getMax() + 1)
+                // Find the ranges that overlap or are adjacent to the new range.
+                const auto first = std::lower_bound(
+                    _ranges.begin(),
+                    _ranges.end(),
+                    value,
+                    [](const Range& a, const Range& b)
                     {
-                        newRange = Range(i->getMin(), newRange.getMax());
-                        i = _ranges.erase(i);
-                    }
-                    else if (newRange.getMax() == i->getMin() - 1)
+                        return isBefore(a, b);
+                    });
+                const auto last = std::upper_bound(
+                    first,
+                    _ranges.end(),
+                    value,
+                    [](const Range& a, const Range& b)
                     {
-                        newRange = Range(newRange.getMin(), i->getMax());
-                        i = _ranges.erase(i);
-                    }
-                    else
-                    {
-                        ++i;
-                    }
+                        return isBefore(a, b);
+                    });
+                const size_t index = first - _ranges.begin();
+                if (first == last)
+                {
+                    _ranges.insert(first, value);
                 }
-                i = _ranges.begin();
-                for (; i != _ranges.end() && *i < newRange; ++i)
-                    ;
-                _ranges.insert(i, newRange);
+                else
+                {
+                    *first = Range(
+                        std::min(value.getMin(), first->getMin()),
+                        std::max(value.getMax(), (last - 1)->getMax()));
+                    _ranges.erase(first + 1, last);
+                }
+                _offsetsUpdate(index);
             }
 
-            bool Sequence::contains(Index value) const noexcept
+            void Sequence::remove(const Range& value)
             {
-                bool out = false;
-                for (const auto& i : _ranges)
-                {
-                    if (i.contains(value))
+                // Find the ranges that intersect the frames.
+                const auto first = std::lower_bound(
+                    _ranges.begin(),
+                    _ranges.end(),
+                    value,
+                    [](const Range& a, const Range& b)
+                    {
+                        return a.getMax() < b.getMin();
+                    });
+                const auto last = std::upper_bound(
+                    first,
+                    _ranges.end(),
+                    value,
+                    [](const Range& a, const Range& b)
                     {
-                        out = true;
-                        break;
-                    }
+                        return a.getMax() < b.getMin();
+                    });
+                if (first == last)
+                    return;
+                const size_t index = first - _ranges.begin();
+                std::vector<Range> split;
+                if (first->getMin() < value.getMin())
+                {
+                    split.push_back(Range(first->getMin(), value.getMin() - 1));
                 }
-                return out;
+                if ((last - 1)->getMax() > value.getMax())
+                {
+                    split.push_back(Range(value.getMax() + 1, (last - 1)->getMax()));
+                }
+                _ranges.insert(_ranges.erase(first, last), split.begin(), split.end());
+                _offsetsUpdate(index);
             }
 
-            size_t Sequence::getFrameCount() const noexcept
+            bool Sequence::contains(Index value) const noexcept
             {
-                size_t out = 0;
-                for (const auto& i : _ranges)
-                {
-                    out += i.getMax() - i.getMin() + 1;
-                }
-                return out;
+                const auto i = std::upper_bound(
+                    _ranges.begin(),
+                    _ranges.end(),
+                    value,
+                    [](Number a, const Range& b)
+                    {
+                        return a < b.getMin();
+                    });
+                return i != _ranges.begin() && (i - 1)->contains(value);
             }
 
             Number Sequence::getFrame(Index value) const noexcept
             {
                 Number out = invalid;
-                for (const auto& j : _ranges)
+                if (value >= 0 && value < static_cast<Index>(_frameCount))
                 {
-                    const size_t size = j.getMax() - j.getMin() + 1;
-                    if (value < size)
-                    {
-                        out = j.getMin() + value;
-                        break;
-                    }
-                    value -= size;
+                    const size_t i = std::upper_bound(_offsets.begin(), _offsets.end(), value) - _offsets.begin() - 1;
+                    out = _ranges[i].getMin() + value - _offsets[i];
                 }
                 return out;
             }
@@ -120,27 +160,33 @@ namespace djv
             Index Sequence::getIndex(Number value) const noexcept
             {
                 Index out = invalidIndex;
-                Index tmp = 0;
-                for (const auto& j : _ranges)
-                {
-                    if (j.contains(value))
+                const auto i = std::upper_bound(
+                    _ranges.begin(),
+                    _ranges.end(),
+                    value,
+                    [](Number a, const Range& b)
                     {
-                        out = tmp + value - j.getMin();
-                        break;
-                    }
-                    tmp += j.getMax() - j.getMin() + 1;
+                        return a < b.getMin();
+                    });
+                if (i != _ranges.begin() && (i - 1)->contains(value))
+                {
+                    const size_t j = i - 1 - _ranges.begin();
+                    out = _offsets[j] + value - _ranges[j].getMin();
                 }
                 return out;
             }
 
-            Index Sequence::getLastIndex() const noexcept
+            void Sequence::_offsetsUpdate(size_t index)
             {
-                Index tmp = 0;
-                for (const auto& i : _ranges)
+                const size_t size = _ranges.size();
+                _offsets.resize(size);
+                Index offset = index > 0 ? (_offsets[index - 1] + getSize(_ranges[index - 1])) : 0;
+                for (size_t i = index; i < size; ++i)
                 {
-                    tmp += i.getMax() - i.getMin() + 1;
+                    _offsets[i] = offset;
+                    offset += getSize(_ranges[i]);
                 }
-                return _ranges.size() ? (tmp - 1) : invalidIndex;
+                _frameCount = static_cast<size_t>(offset);
             }
             
         } // namespace Frame
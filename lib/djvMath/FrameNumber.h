@@ -32,6 +32,11 @@ namespace djv
             
             //! This class provides a sequence of frame numbers. A sequence is
             //! composed of multiple frame number ranges (e.g., 1-10,20-30).
+            //!
+            //! The ranges are kept sorted and merged, along with the index of
+            //! the first frame of each range, so that converting between frame
+            //! numbers and indices is a binary search. Frames can be added and
+            //! removed without rebuilding the sequence.
             class Sequence
             {
             public:
@@ -46,8 +51,14 @@ namespace djv
 
                 const std::vector<Range>& getRanges() const noexcept;
                 
+                //! Add frames to the sequence. Ranges that overlap or are
+                //! adjacent to the new frames are merged.
                 void add(const Range&);
 
+                //! Remove frames from the sequence. Ranges that contain the
+                //! frames are split.
+                void remove(const Range&);
+
                 bool isValid() const noexcept;
 
                 ///@}
@@ -78,8 +89,12 @@ namespace djv
                 bool operator != (const Sequence&) const;
 
             private:
+                void _offsetsUpdate(size_t);
+
                 std::vector<Range>  _ranges;
-                size_t              _pad    = 0;
+                std::vector<Index>  _offsets;
+                size_t              _frameCount = 0;
+                size_t              _pad        = 0;
             };
 
         } // namespace Frame
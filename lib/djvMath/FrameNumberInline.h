@@ -28,6 +28,16 @@ namespace djv
                 _pad = value;
             }
 
+            inline size_t Sequence::getFrameCount() const noexcept
+            {
+                return _frameCount;
+            }
+
+            inline Index Sequence::getLastIndex() const noexcept
+            {
+                return _frameCount > 0 ? static_cast<Index>(_frameCount - 1) : invalidIndex;
+            }
+
             inline bool Sequence::operator == (const Sequence& value) const
             {
                 return _ranges == value._ranges && _pad == value._pad;
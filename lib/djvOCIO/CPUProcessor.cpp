@@ -0,0 +1,429 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvOCIO/CPUProcessor.h>
+
+#include <djvImage/Data.h>
+#include <djvImage/Parallel.h>
+#include <djvImage/TypeFunc.h>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_OCIO_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace _OCIO = OCIO_NAMESPACE;
+
+namespace djv
+{
+    namespace OCIO
+    {
+        namespace
+        {
+            //! This struct provides the mapping from input values to LUT
+            //! coordinates. It matches the allocation of the input color space
+            //! that the GPU path applies before the LUT lookup, so that linear
+            //! and HDR input is spread over the LUT instead of being clipped.
+            struct Shaper
+            {
+                bool  lg2    = false;
+                float min    = 0.F;
+                float max    = 1.F;
+                float offset = 0.F;
+
+                float toLUT(float value) const
+                {
+                    if (lg2)
+                    {
+                        value = std::log2(value + offset);
+                    }
+                    return (value - min) / (max - min);
+                }
+
+                float fromLUT(float value) const
+                {
+                    value = value * (max - min) + min;
+                    if (lg2)
+                    {
+                        value = std::exp2(value) - offset;
+                    }
+                    return value;
+                }
+            };
+
+            Shaper getShaper(const _OCIO::ConstColorSpaceRcPtr& colorSpace)
+            {
+                // These defaults match the OCIO allocation transform.
+                Shaper out;
+                std::vector<float> vars;
+                if (colorSpace)
+                {
+                    vars.resize(colorSpace->getAllocationNumVars());
+                    if (!vars.empty())
+                    {
+                        colorSpace->getAllocationVars(vars.data());
+                    }
+                    if (_OCIO::ALLOCATION_LG2 == colorSpace->getAllocation())
+                    {
+                        out.lg2 = true;
+                        out.min = -10.F;
+                        out.max = 6.F;
+                    }
+                }
+                if (vars.size() >= 2 && vars[0] != vars[1])
+                {
+                    out.min = vars[0];
+                    out.max = vars[1];
+                }
+                if (out.lg2 && vars.size() >= 3)
+                {
+                    out.offset = vars[2];
+                }
+                return out;
+            }
+
+            //! The LUT entries are padded to four floats so they can be
+            //! loaded into SIMD registers.
+            struct LUT3D
+            {
+                Shaper shaper;
+                size_t edgeLen = 0;
+                std::vector<float> data;
+            };
+
+            struct LUT3DCache
+            {
+                std::mutex mutex;
+                std::map<std::string, std::shared_ptr<LUT3D> > luts;
+            };
+
+            LUT3DCache& getLUT3DCache()
+            {
+                static LUT3DCache cache;
+                return cache;
+            }
+
+            std::shared_ptr<LUT3D> bakeLUT3D(
+                const _OCIO::ConstProcessorRcPtr& processor,
+                const Shaper& shaper,
+                size_t edgeLen)
+            {
+                auto out = std::make_shared<LUT3D>();
+                out->shaper = shaper;
+                out->edgeLen = edgeLen;
+                const size_t count = edgeLen * edgeLen * edgeLen;
+                out->data.resize(count * 4);
+                const float scale = 1.F / static_cast<float>(edgeLen - 1);
+                std::vector<float> values(edgeLen);
+                for (size_t i = 0; i < edgeLen; ++i)
+                {
+                    values[i] = shaper.fromLUT(i * scale);
+                }
+                float* p = out->data.data();
+                for (size_t b = 0; b < edgeLen; ++b)
+                {
+                    for (size_t g = 0; g < edgeLen; ++g)
+                    {
+                        for (size_t r = 0; r < edgeLen; ++r, p += 4)
+                        {
+                            p[0] = values[r];
+                            p[1] = values[g];
+                            p[2] = values[b];
+                            p[3] = 1.F;
+                        }
+                    }
+                }
+                _OCIO::PackedImageDesc desc(out->data.data(), static_cast<long>(count), 1, 4);
+                processor->apply(desc);
+                return out;
+            }
+
+            //! Look up a pixel in the LUT with tetrahedral interpolation. The
+            //! input and output may be the same. Returns false without changing
+            //! the output if the pixel is outside of the LUT domain.
+            inline bool lookup(const LUT3D& lut, const float* in, float* out)
+            {
+                const size_t edgeLen = lut.edgeLen;
+                const float max = static_cast<float>(edgeLen - 1);
+                float t[3];
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    t[i] = lut.shaper.toLUT(in[i]);
+                    if (!(t[i] >= 0.F && t[i] <= 1.F))
+                    {
+                        return false;
+                    }
+                }
+                const float fr = t[0] * max;
+                const float fg = t[1] * max;
+                const float fb = t[2] * max;
+                const size_t ir = std::min(static_cast<size_t>(fr), edgeLen - 2);
+                const size_t ig = std::min(static_cast<size_t>(fg), edgeLen - 2);
+                const size_t ib = std::min(static_cast<size_t>(fb), edgeLen - 2);
+                const float dr = fr - ir;
+                const float dg = fg - ig;
+                const float db = fb - ib;
+
+                const size_t sr = 4;
+                const size_t sg = 4 * edgeLen;
+                const size_t sb = 4 * edgeLen * edgeLen;
+                const float* c000 = lut.data.data() + ir * sr + ig * sg + ib * sb;
+                const float* c111 = c000 + sr + sg + sb;
+
+                // Pick the tetrahedron that contains the point, each one has
+                // the corners c000 and c111 and two corners in between.
+                const float* c1 = nullptr;
+                const float* c2 = nullptr;
+                float w0 = 0.F;
+                float w1 = 0.F;
+                float w2 = 0.F;
+                float w3 = 0.F;
+                if (dr >= dg)
+                {
+                    if (dg >= db)
+                    {
+                        c1 = c000 + sr;
+                        c2 = c000 + sr + sg;
+                        w0 = 1.F - dr; w1 = dr - dg; w2 = dg - db; w3 = db;
+                    }
+                    else if (dr >= db)
+                    {
+                        c1 = c000 + sr;
+                        c2 = c000 + sr + sb;
+                        w0 = 1.F - dr; w1 = dr - db; w2 = db - dg; w3 = dg;
+                    }
+                    else
+                    {
+                        c1 = c000 + sb;
+                        c2 = c000 + sr + sb;
+                        w0 = 1.F - db; w1 = db - dr; w2 = dr - dg; w3 = dg;
+                    }
+                }
+                else
+                {
+                    if (db >= dg)
+                    {
+                        c1 = c000 + sb;
+                        c2 = c000 + sg + sb;
+                        w0 = 1.F - db; w1 = db - dg; w2 = dg - dr; w3 = dr;
+                    }
+                    else if (db >= dr)
+                    {
+                        c1 = c000 + sg;
+                        c2 = c000 + sg + sb;
+                        w0 = 1.F - dg; w1 = dg - db; w2 = db - dr; w3 = dr;
+                    }
+                    else
+                    {
+                        c1 = c000 + sg;
+                        c2 = c000 + sr + sg;
+                        w0 = 1.F - dg; w1 = dg - dr; w2 = dr - db; w3 = db;
+                    }
+                }
+
+#if defined(DJV_OCIO_SSE2)
+                __m128 v = _mm_mul_ps(_mm_set1_ps(w0), _mm_loadu_ps(c000));
+                v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(w1), _mm_loadu_ps(c1)));
+                v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(w2), _mm_loadu_ps(c2)));
+                v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(w3), _mm_loadu_ps(c111)));
+                float tmp[4];
+                _mm_storeu_ps(tmp, v);
+                out[0] = tmp[0];
+                out[1] = tmp[1];
+                out[2] = tmp[2];
+#else // DJV_OCIO_SSE2
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    out[i] = w0 * c000[i] + w1 * c1[i] + w2 * c2[i] + w3 * c111[i];
+                }
+#endif // DJV_OCIO_SSE2
+                return true;
+            }
+
+        } // namespace
+
+        struct CPUProcessor::Private
+        {
+            Convert convert;
+            CPUProcessorMode mode = CPUProcessorMode::LUT3D;
+            _OCIO::ConstProcessorRcPtr processor;
+            std::shared_ptr<LUT3D> lut3D;
+
+            void apply(float*, size_t pixelCount, size_t channelCount) const;
+        };
+
+        void CPUProcessor::Private::apply(float* data, size_t pixelCount, size_t channelCount) const
+        {
+            switch (mode)
+            {
+            case CPUProcessorMode::LUT3D:
+            {
+                // Pixels outside of the LUT domain are processed exactly.
+                std::vector<size_t> exact;
+                float* p = data;
+                for (size_t i = 0; i < pixelCount; ++i, p += channelCount)
+                {
+                    if (!lookup(*lut3D, p, p))
+                    {
+                        exact.push_back(i);
+                    }
+                }
+                if (!exact.empty())
+                {
+                    std::vector<float> tmp(exact.size() * 3);
+                    for (size_t i = 0; i < exact.size(); ++i)
+                    {
+                        memcpy(tmp.data() + i * 3, data + exact[i] * channelCount, 3 * sizeof(float));
+                    }
+                    _OCIO::PackedImageDesc desc(tmp.data(), static_cast<long>(exact.size()), 1, 3);
+                    processor->apply(desc);
+                    for (size_t i = 0; i < exact.size(); ++i)
+                    {
+                        memcpy(data + exact[i] * channelCount, tmp.data() + i * 3, 3 * sizeof(float));
+                    }
+                }
+                break;
+            }
+            case CPUProcessorMode::Exact:
+            {
+                _OCIO::PackedImageDesc desc(
+                    data,
+                    static_cast<long>(pixelCount),
+                    1,
+                    static_cast<long>(channelCount));
+                processor->apply(desc);
+                break;
+            }
+            default: break;
+            }
+        }
+
+        void CPUProcessor::_init(const Convert& convert, CPUProcessorMode mode, size_t lut3DEdgeLen)
+        {
+            DJV_PRIVATE_PTR();
+            p.convert = convert;
+            p.mode = mode;
+            auto config = _OCIO::GetCurrentConfig();
+            p.processor = config->getProcessor(convert.input.c_str(), convert.output.c_str());
+            if (CPUProcessorMode::LUT3D == mode)
+            {
+                lut3DEdgeLen = std::max(lut3DEdgeLen, static_cast<size_t>(2));
+                std::stringstream ss;
+                ss << config->getCacheID() << '\n' << convert.input << '\n' << convert.output << '\n' << lut3DEdgeLen;
+                const std::string key = ss.str();
+                auto& cache = getLUT3DCache();
+                std::lock_guard<std::mutex> lock(cache.mutex);
+                const auto i = cache.luts.find(key);
+                if (i != cache.luts.end())
+                {
+                    p.lut3D = i->second;
+                }
+                else
+                {
+                    p.lut3D = bakeLUT3D(
+                        p.processor,
+                        getShaper(config->getColorSpace(convert.input.c_str())),
+                        lut3DEdgeLen);
+                    cache.luts[key] = p.lut3D;
+                }
+            }
+        }
+
+        CPUProcessor::CPUProcessor() :
+            _p(new Private)
+        {}
+
+        CPUProcessor::~CPUProcessor()
+        {}
+
+        std::shared_ptr<CPUProcessor> CPUProcessor::create(
+            const Convert& convert,
+            CPUProcessorMode mode,
+            size_t lut3DEdgeLen)
+        {
+            auto out = std::shared_ptr<CPUProcessor>(new CPUProcessor);
+            out->_init(convert, mode, lut3DEdgeLen);
+            return out;
+        }
+
+        const Convert& CPUProcessor::getConvert() const
+        {
+            return _p->convert;
+        }
+
+        CPUProcessorMode CPUProcessor::getMode() const
+        {
+            return _p->mode;
+        }
+
+        void CPUProcessor::apply(float* data, size_t pixelCount, size_t channelCount) const
+        {
+            DJV_PRIVATE_PTR();
+            if (channelCount < 3 || channelCount > 4)
+                return;
+            Image::parallelRange(
+                pixelCount,
+                pixelCount,
+                [&p, data, channelCount](size_t begin, size_t end)
+                {
+                    p.apply(data + begin * channelCount, end - begin, channelCount);
+                });
+        }
+
+        void CPUProcessor::apply(Image::Data& data) const
+        {
+            DJV_PRIVATE_PTR();
+            const Image::Type type = data.getType();
+            const uint8_t channelCount = Image::getChannelCount(type);
+            const Image::Type floatType = 2 == channelCount || 4 == channelCount ?
+                Image::Type::RGBA_F32 :
+                Image::Type::RGB_F32;
+            const size_t floatChannelCount = Image::getChannelCount(floatType);
+            const size_t w = data.getWidth();
+            const size_t h = data.getHeight();
+            Image::parallelRange(
+                h,
+                w * h,
+                [&p, &data, type, floatType, floatChannelCount, w](size_t begin, size_t end)
+                {
+                    std::vector<float> scanline;
+                    if (type != floatType)
+                    {
+                        scanline.resize(w * floatChannelCount);
+                    }
+                    for (size_t y = begin; y < end; ++y)
+                    {
+                        uint8_t* row = data.getData(static_cast<uint16_t>(y));
+                        if (type == floatType)
+                        {
+                            p.apply(reinterpret_cast<float*>(row), w, floatChannelCount);
+                        }
+                        else
+                        {
+                            Image::convert(row, type, scanline.data(), floatType, w);
+                            p.apply(scanline.data(), w, floatChannelCount);
+                            Image::convert(scanline.data(), floatType, row, type, w);
+                        }
+                    }
+                });
+        }
+
+        void CPUProcessor::clearCache()
+        {
+            auto& cache = getLUT3DCache();
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            cache.luts.clear();
+        }
+
+    } // namespace OCIO
+} // namespace djv
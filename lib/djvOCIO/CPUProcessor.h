@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvOCIO/OCIO.h>
+
+#include <memory>
+
+namespace djv
+{
+    namespace Image
+    {
+        class Data;
+
+    } // namespace Image
+
+    namespace OCIO
+    {
+        //! This enumeration provides the CPU processor modes.
+        enum class CPUProcessorMode
+        {
+            LUT3D, //!< Apply a baked 3D LUT
+            Exact  //!< Apply the OCIO processor directly
+        };
+
+        //! This class provides color space conversions on the CPU for
+        //! contexts without a GPU, like writing files and generating
+        //! thumbnails.
+        //!
+        //! In the LUT3D mode the transform is baked into a 3D LUT that is
+        //! shared between processors with the same configuration and
+        //! conversion. The LUT is applied with tetrahedral interpolation.
+        //! The LUT domain is given by the allocation of the input color
+        //! space, like the GPU path, so linear input with a log allocation
+        //! keeps its shadow precision. Pixels outside of the allocation are
+        //! processed exactly instead of being clamped. The exact mode is
+        //! slower but does not approximate the transform.
+        class CPUProcessor
+        {
+            DJV_NON_COPYABLE(CPUProcessor);
+
+        protected:
+            void _init(const Convert&, CPUProcessorMode, size_t lut3DEdgeLen);
+            CPUProcessor();
+
+        public:
+            ~CPUProcessor();
+
+            //! Create a new CPU processor using the current OCIO configuration.
+            //! Throws:
+            //! - std::exception
+            static std::shared_ptr<CPUProcessor> create(
+                const Convert&,
+                CPUProcessorMode = CPUProcessorMode::LUT3D,
+                size_t lut3DEdgeLen = 33);
+
+            const Convert& getConvert() const;
+            CPUProcessorMode getMode() const;
+
+            //! Apply the conversion to packed RGB or RGBA float pixels. The
+            //! alpha channel is not modified.
+            void apply(float*, size_t pixelCount, size_t channelCount) const;
+
+            //! Apply the conversion to an image. Images that are not floating
+            //! point are converted a scanline at a time.
+            void apply(Image::Data&) const;
+
+            //! Clear the baked 3D LUT cache.
+            static void clearCache();
+
+        private:
+            DJV_PRIVATE();
+        };
+
+    } // namespace OCIO
+} // namespace djv
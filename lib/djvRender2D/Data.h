@@ -37,6 +37,8 @@ namespace djv
         {
             Atlas,
             Dynamic,
+            Tiled,      //!< Split the image into tiles with mipmaps, only the
+                        //!< visible tiles are uploaded
 
             Count,
             First = Atlas
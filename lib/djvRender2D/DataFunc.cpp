@@ -32,7 +32,8 @@ namespace djv
         Render2D,
         ImageCache,
         DJV_TEXT("render2d_image_cache_atlas"),
-        DJV_TEXT("render2d_image_cache_dynamic"));
+        DJV_TEXT("render2d_image_cache_dynamic"),
+        DJV_TEXT("render2d_image_cache_tiled"));
 
     DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
         Render2D,
@@ -0,0 +1,435 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvRender2D/FontCache.h>
+
+#include <djvSystem/File.h>
+#include <djvSystem/FileIO.h>
+#include <djvSystem/FileInfo.h>
+
+#include <djvImage/Data.h>
+
+#include <djvCore/MemoryFunc.h>
+#include <djvCore/StringFormat.h>
+
+#include <cstdio>
+#include <cstring>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace Render2D
+    {
+        namespace Font
+        {
+            namespace Cache
+            {
+                namespace
+                {
+                    const char     magic[]      = "djvFontCache";
+                    const uint32_t endianMarker = 0x01020304;
+                    const uint16_t invalidIndex = static_cast<uint16_t>(-1);
+
+                    //! This struct provides the cache file header.
+                    struct Header
+                    {
+                        char     magic[16];
+                        uint32_t version      = 0;
+                        uint32_t endian       = 0;
+                        uint32_t lcdRendering = 0;
+                    };
+
+                    Header getHeader(bool lcdRendering)
+                    {
+                        Header out;
+                        memset(out.magic, 0, sizeof(out.magic));
+                        memcpy(out.magic, magic, sizeof(magic));
+                        out.version      = version;
+                        out.endian       = endianMarker;
+                        out.lcdRendering = lcdRendering ? 1 : 0;
+                        return out;
+                    }
+
+                    bool compare(const Header& a, const Header& b)
+                    {
+                        return
+                            0 == memcmp(a.magic, b.magic, sizeof(a.magic)) &&
+                            a.version == b.version &&
+                            a.endian  == b.endian;
+                    }
+
+                    //! This struct provides a reference to a font in the cache.
+                    struct FontRef
+                    {
+                        uint16_t index = invalidIndex;
+                        uint16_t size  = 0;
+                        uint16_t dpi   = 0;
+                    };
+
+                    //! This class provides a cache file writer.
+                    class Writer
+                    {
+                    public:
+                        Writer(const std::shared_ptr<System::File::IO>& io, const FontHashes& fontHashes) :
+                            _io(io)
+                        {
+                            uint16_t index = 0;
+                            for (const auto& i : fontHashes)
+                            {
+                                _fontIndices[i.first] = index++;
+                            }
+                        }
+
+                        template<typename T>
+                        void value(const T& in)
+                        {
+                            _io->write(&in, sizeof(T));
+                        }
+
+                        void string(const std::string& in)
+                        {
+                            value(static_cast<uint32_t>(in.size()));
+                            if (in.size())
+                            {
+                                _io->write(in.data(), in.size());
+                            }
+                        }
+
+                        void font(const FontInfo& in)
+                        {
+                            FontRef ref;
+                            const auto i = _fontIndices.find(std::make_pair(in.getFamily(), in.getFace()));
+                            if (i != _fontIndices.end())
+                            {
+                                ref.index = i->second;
+                            }
+                            ref.size = in.getSize();
+                            ref.dpi = in.getDPI();
+                            value(ref);
+                        }
+
+                        void glyph(const std::shared_ptr<Glyph>& in)
+                        {
+                            value(static_cast<uint8_t>(in ? 1 : 0));
+                            if (in)
+                            {
+                                value(in->glyphInfo.code);
+                                font(in->glyphInfo.fontInfo);
+                            }
+                        }
+
+                        void image(const std::shared_ptr<Image::Data>& in)
+                        {
+                            if (in && in->isValid())
+                            {
+                                const auto& info = in->getInfo();
+                                value(static_cast<uint8_t>(info.type));
+                                value(info.size.w);
+                                value(info.size.h);
+                                _io->write(in->getData(), in->getDataByteCount());
+                            }
+                            else
+                            {
+                                value(static_cast<uint8_t>(Image::Type::None));
+                            }
+                        }
+
+                    private:
+                        std::shared_ptr<System::File::IO> _io;
+                        std::map<std::pair<FamilyID, FaceID>, uint16_t> _fontIndices;
+                    };
+
+                    //! This class provides a cache file reader.
+                    class Reader
+                    {
+                    public:
+                        explicit Reader(const std::shared_ptr<System::File::IO>& io) :
+                            _io(io)
+                        {}
+
+                        template<typename T>
+                        T value()
+                        {
+                            T out;
+                            _io->read(&out, sizeof(T));
+                            return out;
+                        }
+
+                        //! Read a count of items that each take at least the
+                        //! given number of bytes in the file.
+                        uint32_t count(size_t itemSize)
+                        {
+                            const uint32_t out = value<uint32_t>();
+                            _check(static_cast<uint64_t>(out) * itemSize);
+                            return out;
+                        }
+
+                        std::string string()
+                        {
+                            const uint32_t size = value<uint32_t>();
+                            _check(size);
+                            std::string out(size, 0);
+                            if (size)
+                            {
+                                _io->read(&out[0], size);
+                            }
+                            return out;
+                        }
+
+                        //! Read a font reference, returns false if the font is
+                        //! not available.
+                        bool font(FontInfo& out)
+                        {
+                            const FontRef ref = value<FontRef>();
+                            if (ref.index >= fonts.size() || !fonts[ref.index].first)
+                                return false;
+                            out = FontInfo(fonts[ref.index].first, fonts[ref.index].second, ref.size, ref.dpi);
+                            return true;
+                        }
+
+                        //! Read a glyph reference, returns false if the glyph is
+                        //! not available.
+                        bool glyph(std::shared_ptr<Glyph>& out)
+                        {
+                            if (!value<uint8_t>())
+                            {
+                                out.reset();
+                                return true;
+                            }
+                            const uint32_t code = value<uint32_t>();
+                            const FontRef ref = value<FontRef>();
+                            if (ref.index >= fonts.size() || !fonts[ref.index].first)
+                                return false;
+                            const auto i = glyphs.find(GlyphInfo(
+                                code,
+                                FontInfo(fonts[ref.index].first, fonts[ref.index].second, ref.size, ref.dpi)));
+                            if (i == glyphs.end())
+                                return false;
+                            out = i->second;
+                            return true;
+                        }
+
+                        std::shared_ptr<Image::Data> image()
+                        {
+                            std::shared_ptr<Image::Data> out;
+                            const auto type = static_cast<Image::Type>(value<uint8_t>());
+                            if (type >= Image::Type::Count)
+                            {
+                                throw System::File::Error(String::Format("{0}: {1}").
+                                    arg(_io->getFileName()).
+                                    arg("The cache has an invalid image."));
+                            }
+                            if (type != Image::Type::None)
+                            {
+                                const uint16_t w = value<uint16_t>();
+                                const uint16_t h = value<uint16_t>();
+                                const Image::Info info(w, h, type);
+                                _check(info.getDataByteCount());
+                                out = Image::Data::create(info);
+                                _io->read(out->getData(), out->getDataByteCount());
+                            }
+                            return out;
+                        }
+
+                        //! The current font family and face for each font in
+                        //! the cache. Fonts that are not available have a
+                        //! family of zero.
+                        std::vector<std::pair<FamilyID, FaceID> > fonts;
+
+                        std::map<GlyphInfo, std::shared_ptr<Glyph> > glyphs;
+
+                    private:
+                        void _check(uint64_t size)
+                        {
+                            if (size > _io->getSize() - _io->getPos())
+                            {
+                                throw System::File::Error(String::Format("{0}: {1}").
+                                    arg(_io->getFileName()).
+                                    arg("The cache is truncated."));
+                            }
+                        }
+
+                        std::shared_ptr<System::File::IO> _io;
+                    };
+
+                } // namespace
+
+                uint64_t getFontHash(const System::File::Info& value)
+                {
+                    size_t out = 0;
+                    Memory::hashCombine(out, value.getFileName(Math::Frame::invalid, false));
+                    Memory::hashCombine(out, value.getSize());
+                    Memory::hashCombine(out, static_cast<int64_t>(value.getTime()));
+                    return static_cast<uint64_t>(out);
+                }
+
+                void write(const System::File::Path& path, const FontHashes& fontHashes, const Data& data)
+                {
+                    // Write to a temporary file and then rename it so that a
+                    // partially written cache is never read.
+                    const std::string fileName = path.get();
+                    const std::string tmpFileName = fileName + ".tmp";
+                    {
+                        auto io = System::File::IO::create();
+                        io->open(tmpFileName, System::File::Mode::Write);
+                        Writer writer(io, fontHashes);
+                        writer.value(getHeader(data.lcdRendering));
+
+                        writer.value(static_cast<uint32_t>(fontHashes.size()));
+                        for (const auto& i : fontHashes)
+                        {
+                            writer.value(i.second);
+                        }
+
+                        writer.value(static_cast<uint32_t>(data.glyphs.size()));
+                        for (const auto& i : data.glyphs)
+                        {
+                            writer.value(i->glyphInfo.code);
+                            writer.font(i->glyphInfo.fontInfo);
+                            writer.value(i->offset);
+                            writer.value(i->advance);
+                            writer.value(i->lsbDelta);
+                            writer.value(i->rsbDelta);
+                            writer.image(i->imageData);
+                        }
+
+                        writer.value(static_cast<uint32_t>(data.measure.size()));
+                        for (const auto& i : data.measure)
+                        {
+                            writer.string(std::get<0>(i.first));
+                            writer.font(std::get<1>(i.first));
+                            writer.value(std::get<2>(i.first));
+                            writer.value(i.second);
+                        }
+
+                        writer.value(static_cast<uint32_t>(data.textLines.size()));
+                        for (const auto& i : data.textLines)
+                        {
+                            writer.string(std::get<0>(i.first));
+                            writer.font(std::get<1>(i.first));
+                            writer.value(std::get<2>(i.first));
+                            writer.value(static_cast<uint32_t>(i.second.size()));
+                            for (const auto& j : i.second)
+                            {
+                                writer.string(j.text);
+                                writer.value(j.size);
+                                writer.value(static_cast<uint32_t>(j.glyphs.size()));
+                                for (const auto& k : j.glyphs)
+                                {
+                                    writer.glyph(k);
+                                }
+                            }
+                        }
+
+                        std::string error;
+                        if (!io->close(&error))
+                        {
+                            throw System::File::Error(error);
+                        }
+                    }
+                    std::remove(fileName.c_str());
+                    if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+                    {
+                        std::remove(tmpFileName.c_str());
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg("Cannot rename the cache."));
+                    }
+                }
+
+                Data read(const System::File::Path& path, const FontHashes& fontHashes, bool lcdRendering)
+                {
+                    Data out;
+                    out.lcdRendering = lcdRendering;
+
+                    auto io = System::File::IO::create();
+                    io->open(path.get(), System::File::Mode::Read);
+                    Reader reader(io);
+                    const Header header = reader.value<Header>();
+                    if (!compare(header, getHeader(lcdRendering)))
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(path.get()).
+                            arg("The cache is out of date."));
+                    }
+                    const bool lcdRenderingMatches = (header.lcdRendering != 0) == lcdRendering;
+
+                    std::map<uint64_t, std::pair<FamilyID, FaceID> > hashToFont;
+                    for (const auto& i : fontHashes)
+                    {
+                        hashToFont[i.second] = i.first;
+                    }
+                    const uint32_t fontCount = reader.count(sizeof(uint64_t));
+                    for (uint32_t i = 0; i < fontCount; ++i)
+                    {
+                        const auto j = hashToFont.find(reader.value<uint64_t>());
+                        reader.fonts.push_back(j != hashToFont.end() ? j->second : std::make_pair(FamilyID(0), FaceID(0)));
+                    }
+
+                    const uint32_t glyphCount = reader.count(sizeof(uint32_t) + sizeof(FontRef));
+                    for (uint32_t i = 0; i < glyphCount; ++i)
+                    {
+                        const uint32_t code = reader.value<uint32_t>();
+                        FontInfo fontInfo;
+                        const bool valid = reader.font(fontInfo);
+                        auto glyph = Glyph::create();
+                        glyph->glyphInfo = GlyphInfo(code, fontInfo);
+                        glyph->offset = reader.value<glm::vec2>();
+                        glyph->advance = reader.value<uint16_t>();
+                        glyph->lsbDelta = reader.value<int32_t>();
+                        glyph->rsbDelta = reader.value<int32_t>();
+                        glyph->imageData = reader.image();
+                        if (valid && lcdRenderingMatches)
+                        {
+                            reader.glyphs[glyph->glyphInfo] = glyph;
+                            out.glyphs.push_back(glyph);
+                        }
+                    }
+
+                    const uint32_t measureCount = reader.count(sizeof(uint32_t) + sizeof(FontRef));
+                    for (uint32_t i = 0; i < measureCount; ++i)
+                    {
+                        const std::string text = reader.string();
+                        FontInfo fontInfo;
+                        const bool valid = reader.font(fontInfo);
+                        const uint16_t elide = reader.value<uint16_t>();
+                        const glm::vec2 size = reader.value<glm::vec2>();
+                        if (valid)
+                        {
+                            out.measure.push_back(std::make_pair(MeasureKey(text, fontInfo, elide), size));
+                        }
+                    }
+
+                    const uint32_t textLinesCount = reader.count(sizeof(uint32_t) + sizeof(FontRef));
+                    for (uint32_t i = 0; i < textLinesCount; ++i)
+                    {
+                        const std::string text = reader.string();
+                        FontInfo fontInfo;
+                        bool valid = reader.font(fontInfo);
+                        const uint16_t maxLineWidth = reader.value<uint16_t>();
+                        std::vector<TextLine> lines(reader.count(sizeof(uint32_t) + sizeof(glm::vec2)));
+                        for (auto& j : lines)
+                        {
+                            j.text = reader.string();
+                            j.size = reader.value<glm::vec2>();
+                            j.glyphs.resize(reader.count(sizeof(uint8_t)));
+                            for (auto& k : j.glyphs)
+                            {
+                                valid &= reader.glyph(k);
+                            }
+                        }
+                        if (valid && lcdRenderingMatches)
+                        {
+                            out.textLines.push_back(std::make_pair(MeasureKey(text, fontInfo, maxLineWidth), lines));
+                        }
+                    }
+
+                    return out;
+                }
+
+            } // namespace Cache
+        } // namespace Font
+    } // namespace Render2D
+} // namespace djv
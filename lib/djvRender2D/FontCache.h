@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvRender2D/FontSystem.h>
+
+#include <djvSystem/Path.h>
+
+#include <tuple>
+
+namespace djv
+{
+    namespace System
+    {
+        namespace File
+        {
+            class Info;
+
+        } // namespace File
+    } // namespace System
+
+    namespace Render2D
+    {
+        namespace Font
+        {
+            //! This namespace provides a binary cache of rendered glyphs and
+            //! measured text that persists across launches.
+            //!
+            //! Fonts are identified in the cache by a hash of the font file
+            //! name, size, and modification time, so the cache stays valid when
+            //! the font IDs change between launches. Entries for fonts that
+            //! are no longer available are skipped when the cache is read.
+            namespace Cache
+            {
+                //! The cache file format version. This should be incremented
+                //! whenever the format changes.
+                const uint32_t version = 1;
+
+                //! The cache file name.
+                static const std::string fileName = "FontCache.djvfont";
+
+                //! This typedef provides the key for measured text: the text,
+                //! the font, and the elide or maximum line width.
+                typedef std::tuple<std::string, FontInfo, uint16_t> MeasureKey;
+
+                //! This typedef provides the font hashes for font families and
+                //! faces.
+                typedef std::map<std::pair<FamilyID, FaceID>, uint64_t> FontHashes;
+
+                //! This struct provides the contents of the cache.
+                struct Data
+                {
+                    bool                                                    lcdRendering = true;
+                    std::vector<std::shared_ptr<Glyph> >                    glyphs;
+                    std::vector<std::pair<MeasureKey, glm::vec2> >          measure;
+                    std::vector<std::pair<MeasureKey, std::vector<TextLine> > > textLines;
+                };
+
+                //! Get the hash of a font file.
+                uint64_t getFontHash(const System::File::Info&);
+
+                //! Write the cache.
+                //! Throws:
+                //! - System::File::Error
+                void write(const System::File::Path&, const FontHashes&, const Data&);
+
+                //! Read the cache. Glyphs and text lines are only read if the
+                //! LCD rendering matches, text lines are skipped if any of their
+                //! glyphs are missing.
+                //! Throws:
+                //! - System::File::Error
+                Data read(const System::File::Path&, const FontHashes&, bool lcdRendering);
+
+            } // namespace Cache
+        } // namespace Font
+    } // namespace Render2D
+} // namespace djv
@@ -4,6 +4,8 @@
 
 #include <djvRender2D/FontSystem.h>
 
+#include <djvRender2D/FontCache.h>
+
 #include <djvSystem/Context.h>
 #include <djvSystem/CoreSystem.h>
 #include <djvSystem/FileInfoFunc.h>
@@ -13,6 +15,7 @@
 #include <djvImage/Data.h>
 
 #include <djvCore/Cache.h>
+#include <djvCore/MemoryFunc.h>
 #include <djvCore/StringFunc.h>
 
 #include <freetype2/ft2build.h>
@@ -26,6 +29,7 @@
 #include <locale>
 #include <mutex>
 #include <thread>
+#include <tuple>
 
 using namespace djv::Core;
 
@@ -77,6 +81,15 @@ namespace djv
             {
                 //! \todo Should this be configurable?
                 const size_t glyphCacheMax = 10000;
+                const size_t glyphMetricsCacheMax = 10000;
+                const size_t glyphCacheShardCount = 16;
+                const size_t measureCacheMax = 10000;
+                const size_t textLinesCacheMax = 1000;
+                const size_t threadCountMax = 4;
+
+                //! This typedef provides the key for the measure and text lines
+                //! caches: the text, the font, and the elide or maximum line width.
+                typedef std::tuple<std::string, FontInfo, uint16_t> MeasureCacheKey;
 
                 class MetricsRequest
                 {
@@ -101,6 +114,18 @@ namespace djv
                     std::promise<glm::vec2> promise;
                 };
 
+                class MeasureBatchRequest
+                {
+                public:
+                    MeasureBatchRequest() {}
+                    MeasureBatchRequest(MeasureBatchRequest&&) = default;
+
+                    std::vector<std::string> text;
+                    FontInfo fontInfo;
+                    uint16_t elide = 0;
+                    std::promise<std::vector<glm::vec2> > promise;
+                };
+
                 class MeasureGlyphsRequest
                 {
                 public:
@@ -127,6 +152,18 @@ namespace djv
                     std::promise<std::vector<std::shared_ptr<Glyph> > > promise;
                 };
 
+                class GlyphsBatchRequest
+                {
+                public:
+                    GlyphsBatchRequest() {}
+                    GlyphsBatchRequest(GlyphsBatchRequest&&) = default;
+
+                    std::vector<std::string> text;
+                    FontInfo fontInfo;
+                    uint16_t elide = 0;
+                    std::promise<std::vector<std::vector<std::shared_ptr<Glyph> > > > promise;
+                };
+
                 class TextLinesRequest
                 {
                 public:
@@ -200,6 +237,170 @@ namespace djv
                     return out;
                 }
 
+                //! This struct provides the glyph metrics that are needed for
+                //! measuring text without rendering the glyph.
+                struct GlyphMetrics
+                {
+                    uint16_t advance  = 0;
+                    int32_t  lsbDelta = 0;
+                    int32_t  rsbDelta = 0;
+                };
+
+                size_t getHash(const GlyphInfo& value)
+                {
+                    size_t out = 0;
+                    Memory::hashCombine(out, value.code);
+                    Memory::hashCombine(out, value.fontInfo.getFamily());
+                    Memory::hashCombine(out, value.fontInfo.getFace());
+                    Memory::hashCombine(out, value.fontInfo.getSize());
+                    Memory::hashCombine(out, value.fontInfo.getDPI());
+                    return out;
+                }
+
+                //! This class provides a cache that is split into shards with
+                //! their own locks, so the rendering threads only contend when
+                //! they access glyphs in the same shard.
+                //!
+                //! Values are added with the generation that was current when
+                //! they were created, values from an older generation than the
+                //! last clear() are discarded.
+                template<typename T, typename U>
+                class ShardedCache
+                {
+                public:
+                    ShardedCache() :
+                        _shards(glyphCacheShardCount)
+                    {
+                        _size = 0;
+                    }
+
+                    void setMax(size_t value)
+                    {
+                        _max = value;
+                        for (auto& i : _shards)
+                        {
+                            std::unique_lock<std::mutex> lock(i.mutex);
+                            i.cache.setMax(std::max(value / _shards.size(), static_cast<size_t>(1)));
+                        }
+                    }
+
+                    size_t getSize() const
+                    {
+                        return _size;
+                    }
+
+                    float getPercentageUsed() const
+                    {
+                        return _size / static_cast<float>(_max) * 100.F;
+                    }
+
+                    bool get(const T& key, U& value)
+                    {
+                        auto& shard = _getShard(key);
+                        std::unique_lock<std::mutex> lock(shard.mutex);
+                        return shard.cache.get(key, value);
+                    }
+
+                    void add(const T& key, const U& value, size_t generation)
+                    {
+                        auto& shard = _getShard(key);
+                        std::unique_lock<std::mutex> lock(shard.mutex);
+                        if (generation == shard.generation)
+                        {
+                            const size_t size = shard.cache.getSize();
+                            shard.cache.add(key, value);
+                            _size += shard.cache.getSize();
+                            _size -= size;
+                        }
+                    }
+
+                    std::vector<U> getValues()
+                    {
+                        std::vector<U> out;
+                        for (auto& i : _shards)
+                        {
+                            std::unique_lock<std::mutex> lock(i.mutex);
+                            const auto values = i.cache.getValues();
+                            out.insert(out.end(), values.begin(), values.end());
+                        }
+                        return out;
+                    }
+
+                    void clear(size_t generation)
+                    {
+                        for (auto& i : _shards)
+                        {
+                            std::unique_lock<std::mutex> lock(i.mutex);
+                            _size -= i.cache.getSize();
+                            i.cache.clear();
+                            i.generation = generation;
+                        }
+                    }
+
+                private:
+                    struct Shard
+                    {
+                        std::mutex mutex;
+                        Memory::Cache<T, U> cache;
+                        size_t generation = 0;
+                    };
+
+                    Shard& _getShard(const T& key)
+                    {
+                        return _shards[getHash(key) % _shards.size()];
+                    }
+
+                    std::vector<Shard> _shards;
+                    size_t _max = 0;
+                    std::atomic<size_t> _size;
+                };
+
+                //! This struct provides the data for a rendering thread. Each
+                //! thread has its own FreeType library and faces since they
+                //! cannot be shared between threads.
+                struct Worker
+                {
+                    FT_Library ftLibrary = nullptr;
+                    std::map<FamilyID, std::map<FaceID, FT_Face> > fontFaces;
+                    std::wstring_convert<std::codecvt_utf8<djv_char_t>, djv_char_t> utf32Convert;
+                    bool lcdRendering = true;
+                    size_t generation = 0;
+
+                    std::list<MetricsRequest> metricsRequests;
+                    std::list<MeasureRequest> measureRequests;
+                    std::list<MeasureBatchRequest> measureBatchRequests;
+                    std::list<MeasureGlyphsRequest> measureGlyphsRequests;
+                    std::list<GlyphsRequest> glyphsRequests;
+                    std::list<GlyphsBatchRequest> glyphsBatchRequests;
+                    std::list<TextLinesRequest> textLinesRequests;
+
+                    std::thread thread;
+
+                    FT_Face getFace(FamilyID family, FaceID face) const
+                    {
+                        FT_Face out = nullptr;
+                        const auto i = fontFaces.find(family);
+                        if (i != fontFaces.end())
+                        {
+                            const auto j = i->second.find(face);
+                            if (j != i->second.end())
+                            {
+                                out = j->second;
+                            }
+                        }
+                        return out;
+                    }
+                };
+
+                //! This struct provides a font file that is opened by each of
+                //! the rendering threads.
+                struct FontFile
+                {
+                    FamilyID    family = 0;
+                    FaceID      face   = 0;
+                    std::string fileName;
+                };
+
             } // namespace
 
             std::shared_ptr<Glyph> Glyph::create()
@@ -214,56 +415,69 @@ namespace djv
             struct FontSystem::Private
             {
                 bool lcdRendering = true;
-                bool lcdRenderingThread = lcdRendering;
+                std::atomic<size_t> generation;
 
-                FT_Library ftLibrary = nullptr;
                 System::File::Path fontPath;
-                std::map<FamilyID, std::string> fontFileNames;
                 std::map<FamilyID, std::string> fontNames;
                 std::shared_ptr<Observer::MapSubject<FamilyID, std::string> > fontNamesSubject;
                 std::mutex fontNamesMutex;
                 std::shared_ptr<System::Timer> fontNamesTimer;
                 std::map<FamilyID, std::map<FaceID, std::string> > fontFaceNames;
                 std::shared_ptr<Observer::MapSubject<FamilyID, std::map<FaceID, std::string> > > fontFaceNamesSubject;
-                std::map<FamilyID, std::map<FaceID, FT_Face> > fontFaces;
-                std::map<std::string, FamilyID> fontNameToID;
-                std::map<std::pair<FamilyID, std::string>, FamilyID> fontFaceNameToID;
+                std::vector<FontFile> fontFiles;
                 std::vector< std::pair<FamilyID, FaceID> > symbolFonts;
+                bool fontFilesInit = false;
+                std::condition_variable fontFilesCV;
+                std::mutex fontFilesMutex;
 
                 std::list<MetricsRequest> metricsQueue;
                 std::list<MeasureRequest> measureQueue;
+                std::list<MeasureBatchRequest> measureBatchQueue;
                 std::list<MeasureGlyphsRequest> measureGlyphsQueue;
                 std::list<GlyphsRequest> glyphsQueue;
+                std::list<GlyphsBatchRequest> glyphsBatchQueue;
                 std::list<TextLinesRequest> textLinesQueue;
                 std::condition_variable requestCV;
                 std::mutex requestMutex;
-                std::list<MetricsRequest> metricsRequests;
-                std::list<MeasureRequest> measureRequests;
-                std::list<MeasureGlyphsRequest> measureGlyphsRequests;
-                std::list<GlyphsRequest> glyphsRequests;
-                std::list<TextLinesRequest> textLinesRequests;
 
-                std::wstring_convert<std::codecvt_utf8<djv_char_t>, djv_char_t> utf32Convert;
-                Memory::Cache<GlyphInfo, std::shared_ptr<Glyph> > glyphCache;
-                std::atomic<size_t> glyphCacheSize;
-                std::atomic<float> glyphCachePercentageUsed;
+                ShardedCache<GlyphInfo, std::shared_ptr<Glyph> > glyphCache;
+                ShardedCache<GlyphInfo, GlyphMetrics> glyphMetricsCache;
+                std::mutex measureCacheMutex;
+                size_t measureCacheGeneration = 0;
+                Memory::Cache<MeasureCacheKey, glm::vec2> measureCache;
+                Memory::Cache<MeasureCacheKey, std::vector<TextLine> > textLinesCache;
+
+                System::File::Path diskCachePath;
+                Cache::FontHashes fontHashes;
+                std::atomic<bool> diskCacheChanged;
+                std::vector<std::shared_ptr<Glyph> > diskCacheGlyphs;
+                std::mutex diskCacheGlyphsMutex;
 
                 std::shared_ptr<System::Timer> statsTimer;
-                std::thread thread;
+                System::Context* context = nullptr;
+                std::vector<std::unique_ptr<Worker> > workers;
                 std::atomic<bool> running;
 
-                std::vector<FontInfo> getFontInfoList(const FontInfo&) const;
+                bool hasLayoutRequests() const;
+                bool hasGlyphRequests() const;
 
-                FT_Face getFace(FamilyID, FaceID) const;
+                std::vector<FontInfo> getFontInfoList(const FontInfo&) const;
 
-                std::shared_ptr<Glyph> getGlyph(uint32_t, const std::vector<FontInfo>&);
+                std::shared_ptr<Glyph> getGlyph(Worker&, uint32_t, const std::vector<FontInfo>&);
+                bool getGlyphMetrics(Worker&, uint32_t, const std::vector<FontInfo>&, GlyphMetrics&);
                 
                 void measure(
+                    Worker&,
                     const std::basic_string<djv_char_t>& utf32,
                     const std::vector<FontInfo>&,
                     uint16_t maxLineWidth,
                     glm::vec2&,
                     std::vector<Math::BBox2f>* = nullptr);
+                std::vector<std::shared_ptr<Glyph> > getGlyphs(
+                    Worker&,
+                    const std::basic_string<djv_char_t>& utf32,
+                    const std::vector<FontInfo>&,
+                    uint16_t elide);
             };
 
             void FontSystem::_init(const std::shared_ptr<System::Context>& context)
@@ -275,11 +489,17 @@ namespace djv
                 addDependency(context->getSystemT<System::CoreSystem>());
 
                 p.fontPath = _getResourceSystem()->getPath(System::File::ResourcePath::Fonts);
+                p.diskCachePath = System::File::Path(
+                    _getResourceSystem()->getPath(System::File::ResourcePath::Documents),
+                    Cache::fileName);
+                p.diskCacheChanged = false;
                 p.fontNamesSubject = Observer::MapSubject<FamilyID, std::string>::create();
                 p.fontFaceNamesSubject = Observer::MapSubject<FamilyID, std::map<FaceID, std::string> >::create();
+                p.generation = 0;
                 p.glyphCache.setMax(glyphCacheMax);
-                p.glyphCacheSize = 0;
-                p.glyphCachePercentageUsed = 0.F;
+                p.glyphMetricsCache.setMax(glyphMetricsCacheMax);
+                p.measureCache.setMax(measureCacheMax);
+                p.textLinesCache.setMax(textLinesCacheMax);
 
                 p.fontNamesTimer = System::Timer::create(context);
                 p.fontNamesTimer->setRepeating(true);
@@ -307,75 +527,34 @@ namespace djv
                 {
                     DJV_PRIVATE_PTR();
                     std::stringstream ss;
-                    ss << "Glyph cache: " << p.glyphCacheSize << ", " << p.glyphCachePercentageUsed << "%";
+                    ss << "Glyph cache: " << p.glyphCache.getSize() << ", " << p.glyphCache.getPercentageUsed() << "%\n";
+                    ss << "Glyph metrics cache: " << p.glyphMetricsCache.getSize() << ", " << p.glyphMetricsCache.getPercentageUsed() << "%\n";
+                    {
+                        std::unique_lock<std::mutex> lock(p.measureCacheMutex);
+                        ss << "Measure cache: " << p.measureCache.getSize() << ", " << p.measureCache.getPercentageUsed() << "%\n";
+                        ss << "Text lines cache: " << p.textLinesCache.getSize() << ", " << p.textLinesCache.getPercentageUsed() << "%";
+                    }
                     _log(ss.str());
                 });
 
+                // The context owns the systems so it outlives the threads.
+                p.context = context.get();
                 p.running = true;
-                p.thread = std::thread(
-                    [this]
+                const size_t threadCount = std::min(
+                    static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1U)),
+                    threadCountMax);
+                for (size_t i = 0; i < threadCount; ++i)
                 {
-                    DJV_PRIVATE_PTR();
-                    _initFreeType();
-                    bool lcdRenderingChanged = false;
-                    const Time::Duration threadTimerDuration = System::getTimerDuration(System::TimerValue::Fast);
-                    while (p.running)
-                    {
-                        {
-                            std::unique_lock<std::mutex> lock(p.requestMutex);
-                            p.requestCV.wait_for(
-                                lock,
-                                threadTimerDuration,
-                                [this]
-                            {
-                                DJV_PRIVATE_PTR();
-                                return
-                                    p.lcdRendering != p.lcdRenderingThread ||
-                                    p.metricsQueue.size() ||
-                                    p.measureQueue.size() ||
-                                    p.glyphsQueue.size() ||
-                                    p.textLinesQueue.size();
-                            });
-                            if (p.lcdRendering != p.lcdRenderingThread)
-                            {
-                                p.lcdRenderingThread = p.lcdRendering;
-                                lcdRenderingChanged = true;
-                            }
-                            p.metricsRequests = std::move(p.metricsQueue);
-                            p.measureRequests = std::move(p.measureQueue);
-                            p.measureGlyphsRequests = std::move(p.measureGlyphsQueue);
-                            p.glyphsRequests = std::move(p.glyphsQueue);
-                            p.textLinesRequests = std::move(p.textLinesQueue);
-                        }
-                        if (lcdRenderingChanged)
-                        {
-                            p.glyphCache.clear();
-                            p.glyphCacheSize = 0;
-                            p.glyphCachePercentageUsed = 0.F;
-                        }
-                        if (p.metricsRequests.size())
-                        {
-                            _handleMetricsRequests();
-                        }
-                        if (p.measureRequests.size())
-                        {
-                            _handleMeasureRequests();
-                        }
-                        if (p.measureGlyphsRequests.size())
-                        {
-                            _handleMeasureGlyphsRequests();
-                        }
-                        if (p.glyphsRequests.size())
-                        {
-                            _handleGlyphsRequests();
-                        }
-                        if (p.textLinesRequests.size())
+                    p.workers.emplace_back(new Worker);
+                }
+                for (size_t i = 0; i < threadCount; ++i)
+                {
+                    p.workers[i]->thread = std::thread(
+                        [this, i]
                         {
-                            _handleTextLinesRequests();
-                        }
-                    }
-                    _delFreeType();
-                });
+                            _run(i);
+                        });
+                }
             }
 
             FontSystem::FontSystem() :
@@ -386,9 +565,18 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.running = false;
-                if (p.thread.joinable())
+                p.requestCV.notify_all();
+                p.fontFilesCV.notify_all();
+                for (const auto& i : p.workers)
                 {
-                    p.thread.join();
+                    if (i->thread.joinable())
+                    {
+                        i->thread.join();
+                    }
+                }
+                if (p.diskCacheChanged)
+                {
+                    _writeDiskCache();
                 }
             }
 
@@ -415,21 +603,40 @@ namespace djv
 
             size_t FontSystem::getGlyphCacheSize() const
             {
-                return _p->glyphCacheSize;
+                return _p->glyphCache.getSize();
             }
 
             float FontSystem::getGlyphCachePercentage() const
             {
-                return _p->glyphCachePercentageUsed;
+                return _p->glyphCache.getPercentageUsed();
+            }
+
+            size_t FontSystem::getThreadCount() const
+            {
+                return _p->workers.size();
             }
 
             void FontSystem::setLCDRendering(bool value)
             {
                 DJV_PRIVATE_PTR();
-                if (value == p.lcdRendering)
-                    return;
-                std::unique_lock<std::mutex> lock(p.requestMutex);
-                p.lcdRendering = value;
+                size_t generation = 0;
+                {
+                    std::unique_lock<std::mutex> lock(p.requestMutex);
+                    if (value == p.lcdRendering)
+                        return;
+                    p.lcdRendering = value;
+                    generation = ++p.generation;
+                }
+
+                // Glyphs that are rendered with the previous setting are
+                // discarded when the threads try to add them to the caches.
+                p.glyphCache.clear(generation);
+                {
+                    std::unique_lock<std::mutex> lock(p.measureCacheMutex);
+                    p.measureCache.clear();
+                    p.textLinesCache.clear();
+                    p.measureCacheGeneration = generation;
+                }
             }
 
             std::future<Metrics> FontSystem::getMetrics(const FontInfo& fontInfo)
@@ -457,6 +664,17 @@ namespace djv
                 request.fontInfo = fontInfo;
                 request.elide = elide;
                 auto future = request.promise.get_future();
+                glm::vec2 size = glm::vec2(0.F, 0.F);
+                bool cached = false;
+                {
+                    std::unique_lock<std::mutex> lock(p.measureCacheMutex);
+                    cached = p.measureCache.get(MeasureCacheKey(text, fontInfo, elide), size);
+                }
+                if (cached)
+                {
+                    request.promise.set_value(size);
+                    return future;
+                }
                 {
                     std::unique_lock<std::mutex> lock(p.requestMutex);
                     p.measureQueue.push_back(std::move(request));
@@ -465,6 +683,39 @@ namespace djv
                 return future;
             }
 
+            std::future<std::vector<glm::vec2> > FontSystem::measure(
+                const std::vector<std::string>& text,
+                const FontInfo& fontInfo,
+                uint16_t elide)
+            {
+                DJV_PRIVATE_PTR();
+                MeasureBatchRequest request;
+                request.text = text;
+                request.fontInfo = fontInfo;
+                request.elide = elide;
+                auto future = request.promise.get_future();
+                std::vector<glm::vec2> sizes(text.size());
+                bool cached = true;
+                {
+                    std::unique_lock<std::mutex> lock(p.measureCacheMutex);
+                    for (size_t i = 0; i < text.size() && cached; ++i)
+                    {
+                        cached = p.measureCache.get(MeasureCacheKey(text[i], fontInfo, elide), sizes[i]);
+                    }
+                }
+                if (cached)
+                {
+                    request.promise.set_value(std::move(sizes));
+                    return future;
+                }
+                {
+                    std::unique_lock<std::mutex> lock(p.requestMutex);
+                    p.measureBatchQueue.push_back(std::move(request));
+                }
+                p.requestCV.notify_one();
+                return future;
+            }
+
             std::future<std::vector<Math::BBox2f> > FontSystem::measureGlyphs(
                 const std::string& text,
                 const FontInfo& fontInfo,
@@ -503,6 +754,25 @@ namespace djv
                 return future;
             }
 
+            std::future<std::vector<std::vector<std::shared_ptr<Glyph> > > > FontSystem::getGlyphs(
+                const std::vector<std::string>& text,
+                const FontInfo& fontInfo,
+                uint16_t elide)
+            {
+                DJV_PRIVATE_PTR();
+                GlyphsBatchRequest request;
+                request.text = text;
+                request.fontInfo = fontInfo;
+                request.elide = elide;
+                auto future = request.promise.get_future();
+                {
+                    std::unique_lock<std::mutex> lock(p.requestMutex);
+                    p.glyphsBatchQueue.push_back(std::move(request));
+                }
+                p.requestCV.notify_one();
+                return future;
+            }
+
             std::future<std::vector<TextLine> > FontSystem::textLines(
                 const std::string& text,
                 uint16_t maxLineWidth,
@@ -514,6 +784,17 @@ namespace djv
                 request.fontInfo = fontInfo;
                 request.maxLineWidth = maxLineWidth;
                 auto future = request.promise.get_future();
+                std::vector<TextLine> lines;
+                bool cached = false;
+                {
+                    std::unique_lock<std::mutex> lock(p.measureCacheMutex);
+                    cached = p.textLinesCache.get(MeasureCacheKey(text, fontInfo, maxLineWidth), lines);
+                }
+                if (cached)
+                {
+                    request.promise.set_value(std::move(lines));
+                    return future;
+                }
                 {
                     std::unique_lock<std::mutex> lock(p.requestMutex);
                     p.textLinesQueue.push_back(std::move(request));
@@ -536,133 +817,400 @@ namespace djv
                 p.requestCV.notify_one();
             }
 
-            void FontSystem::_initFreeType()
+            void FontSystem::cacheGlyphs(const std::vector<std::string>& text, const FontInfo& fontInfo)
+            {
+                DJV_PRIVATE_PTR();
+                // Each string is a separate request so they are spread across
+                // the threads.
+                {
+                    std::unique_lock<std::mutex> lock(p.requestMutex);
+                    for (const auto& i : text)
+                    {
+                        GlyphsRequest request;
+                        request.text = i;
+                        request.fontInfo = fontInfo;
+                        request.cacheOnly = true;
+                        p.glyphsQueue.push_back(std::move(request));
+                    }
+                }
+                p.requestCV.notify_all();
+            }
+
+            std::vector<std::shared_ptr<Glyph> > FontSystem::takeDiskCacheGlyphs()
             {
                 DJV_PRIVATE_PTR();
+                std::vector<std::shared_ptr<Glyph> > out;
+                std::unique_lock<std::mutex> lock(p.diskCacheGlyphsMutex);
+                std::swap(out, p.diskCacheGlyphs);
+                return out;
+            }
+
+            void FontSystem::_run(size_t index)
+            {
+                DJV_PRIVATE_PTR();
+                auto& worker = *p.workers[index];
+                _initFreeType(index);
+                const Time::Duration timeout = System::getTimerDuration(System::TimerValue::Fast);
+                while (p.running)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(p.requestMutex);
+                        p.requestCV.wait_for(
+                            lock,
+                            timeout,
+                            [this]
+                            {
+                                DJV_PRIVATE_PTR();
+                                return p.hasLayoutRequests() || p.hasGlyphRequests() || !p.running;
+                            });
+                        worker.lcdRendering = p.lcdRendering;
+                        worker.generation = p.generation;
+                        if (p.hasLayoutRequests())
+                        {
+                            // Layout requests only need the glyph metrics, so they
+                            // are handled first and are not queued behind glyphs
+                            // that are being rendered.
+                            worker.metricsRequests = std::move(p.metricsQueue);
+                            worker.measureRequests = std::move(p.measureQueue);
+                            worker.measureBatchRequests = std::move(p.measureBatchQueue);
+                            worker.measureGlyphsRequests = std::move(p.measureGlyphsQueue);
+                        }
+                        else if (p.textLinesQueue.size())
+                        {
+                            // Glyph requests are taken one at a time so they are
+                            // spread across the threads.
+                            worker.textLinesRequests.push_back(std::move(p.textLinesQueue.front()));
+                            p.textLinesQueue.pop_front();
+                        }
+                        else if (p.glyphsQueue.size())
+                        {
+                            worker.glyphsRequests.push_back(std::move(p.glyphsQueue.front()));
+                            p.glyphsQueue.pop_front();
+                        }
+                        else if (p.glyphsBatchQueue.size())
+                        {
+                            worker.glyphsBatchRequests.push_back(std::move(p.glyphsBatchQueue.front()));
+                            p.glyphsBatchQueue.pop_front();
+                        }
+                    }
+                    const bool requests =
+                        worker.metricsRequests.size() ||
+                        worker.measureRequests.size() ||
+                        worker.measureBatchRequests.size() ||
+                        worker.measureGlyphsRequests.size() ||
+                        worker.glyphsRequests.size() ||
+                        worker.glyphsBatchRequests.size() ||
+                        worker.textLinesRequests.size();
+                    if (worker.metricsRequests.size())
+                    {
+                        _handleMetricsRequests(index);
+                    }
+                    if (worker.measureRequests.size() || worker.measureBatchRequests.size())
+                    {
+                        _handleMeasureRequests(index);
+                    }
+                    if (worker.measureGlyphsRequests.size())
+                    {
+                        _handleMeasureGlyphsRequests(index);
+                    }
+                    if (worker.glyphsRequests.size() || worker.glyphsBatchRequests.size())
+                    {
+                        _handleGlyphsRequests(index);
+                    }
+                    if (worker.textLinesRequests.size())
+                    {
+                        _handleTextLinesRequests(index);
+                    }
+                    if (requests)
+                    {
+                        // Wake up the main loop so the results are used.
+                        p.context->wake();
+                    }
+                }
+                _delFreeType(index);
+            }
+
+            void FontSystem::_initFreeType(size_t index)
+            {
+                DJV_PRIVATE_PTR();
+                auto& worker = *p.workers[index];
                 try
                 {
-                    FT_Error ftError = FT_Init_FreeType(&p.ftLibrary);
+                    FT_Error ftError = FT_Init_FreeType(&worker.ftLibrary);
                     if (ftError)
                     {
                         throw Error("FreeType cannot be initialized.");
                     }
-                    int versionMajor = 0;
-                    int versionMinor = 0;
-                    int versionPatch = 0;
-                    FT_Library_Version(p.ftLibrary, &versionMajor, &versionMinor, &versionPatch);
-                    {
-                        std::stringstream ss;
-                        ss << "FreeType version: " << versionMajor << "." << versionMinor << "." << versionPatch;
-                        _log(ss.str());
-                    }
-                    for (const auto& i : System::File::directoryList(p.fontPath))
+                    if (0 == index)
                     {
-                        const std::string& fileName = i.getFileName();
+                        // The first thread finds the fonts and the other threads
+                        // open the same files.
+                        int versionMajor = 0;
+                        int versionMinor = 0;
+                        int versionPatch = 0;
+                        FT_Library_Version(worker.ftLibrary, &versionMajor, &versionMinor, &versionPatch);
                         {
                             std::stringstream ss;
-                            ss << "Loading font: " << fileName;
+                            ss << "FreeType version: " << versionMajor << "." << versionMinor << "." << versionPatch;
                             _log(ss.str());
                         }
-
-                        FT_Face ftFace;
-                        ftError = FT_New_Face(p.ftLibrary, fileName.c_str(), 0, &ftFace);
-                        if (ftError)
-                        {
-                            std::stringstream ss;
-                            ss << "Cannot load font: " << fileName;
-                            _log(ss.str(), System::LogLevel::Error);
-                        }
-                        else
+                        std::map<std::string, FamilyID> fontNameToID;
+                        std::map<std::pair<FamilyID, std::string>, FamilyID> fontFaceNameToID;
+                        std::vector<FontFile> fontFiles;
+                        std::vector< std::pair<FamilyID, FaceID> > symbolFonts;
+                        Cache::FontHashes fontHashes;
+                        for (const auto& i : System::File::directoryList(p.fontPath))
                         {
-                            std::stringstream ss;
-                            ss << "    Family: " << ftFace->family_name << '\n';
-                            ss << "    Style: " << ftFace->style_name << '\n';
-                            ss << "    Number of glyphs: " << static_cast<int>(ftFace->num_glyphs) << '\n';
-                            ss << "    Scalable: " << (FT_IS_SCALABLE(ftFace) ? "true" : "false") << '\n';
-                            ss << "    Kerning: " << (FT_HAS_KERNING(ftFace) ? "true" : "false");
-                            _log(ss.str());
+                            const std::string& fileName = i.getFileName();
+                            {
+                                std::stringstream ss;
+                                ss << "Loading font: " << fileName;
+                                _log(ss.str());
+                            }
 
-                            FamilyID familyID = 0;
-                            auto j = p.fontNameToID.find(ftFace->family_name);
-                            if (j != p.fontNameToID.end())
+                            FT_Face ftFace;
+                            ftError = FT_New_Face(worker.ftLibrary, fileName.c_str(), 0, &ftFace);
+                            if (ftError)
                             {
-                                familyID = j->second;
+                                std::stringstream ss;
+                                ss << "Cannot load font: " << fileName;
+                                _log(ss.str(), System::LogLevel::Error);
                             }
                             else
                             {
-                                for (auto k : p.fontNameToID)
+                                std::stringstream ss;
+                                ss << "    Family: " << ftFace->family_name << '\n';
+                                ss << "    Style: " << ftFace->style_name << '\n';
+                                ss << "    Number of glyphs: " << static_cast<int>(ftFace->num_glyphs) << '\n';
+                                ss << "    Scalable: " << (FT_IS_SCALABLE(ftFace) ? "true" : "false") << '\n';
+                                ss << "    Kerning: " << (FT_HAS_KERNING(ftFace) ? "true" : "false");
+                                _log(ss.str());
+
+                                FamilyID familyID = 0;
+                                auto j = fontNameToID.find(ftFace->family_name);
+                                if (j != fontNameToID.end())
                                 {
-                                    familyID = std::max(familyID, k.second);
+                                    familyID = j->second;
+                                }
+                                else
+                                {
+                                    for (auto k : fontNameToID)
+                                    {
+                                        familyID = std::max(familyID, k.second);
+                                    }
+                                    ++familyID;
+                                    fontNameToID[ftFace->family_name] = familyID;
                                 }
-                                ++familyID;
-                                p.fontNameToID[ftFace->family_name] = familyID;
-                            }
 
-                            FaceID faceID = 0;
-                            auto k = p.fontFaceNameToID.find(std::make_pair(familyID, ftFace->style_name));
-                            if (k != p.fontFaceNameToID.end())
-                            {
-                                faceID = k->second;
-                            }
-                            else
-                            {
-                                for (auto l : p.fontFaceNameToID)
+                                FaceID faceID = 0;
+                                auto k = fontFaceNameToID.find(std::make_pair(familyID, ftFace->style_name));
+                                if (k != fontFaceNameToID.end())
                                 {
-                                    faceID = std::max(faceID, l.second);
+                                    faceID = k->second;
                                 }
-                                ++faceID;
-                                p.fontFaceNameToID[std::make_pair(familyID, ftFace->style_name)] = faceID;
+                                else
+                                {
+                                    for (auto l : fontFaceNameToID)
+                                    {
+                                        faceID = std::max(faceID, l.second);
+                                    }
+                                    ++faceID;
+                                    fontFaceNameToID[std::make_pair(familyID, ftFace->style_name)] = faceID;
+                                }
+
+                                FontFile fontFile;
+                                fontFile.family = familyID;
+                                fontFile.face = faceID;
+                                fontFile.fileName = fileName;
+                                fontFiles.push_back(fontFile);
+                                fontHashes[std::make_pair(familyID, faceID)] = Cache::getFontHash(i);
+                                //! \bug Probably not the best way to do this...
+                                if (String::match(ftFace->family_name, "Symbols"))
+                                {
+                                    symbolFonts.push_back(std::make_pair(familyID, faceID));
+                                }
+                                else
+                                {
+                                    std::unique_lock<std::mutex> lock(p.fontNamesMutex);
+                                    p.fontNames[familyID] = ftFace->family_name;
+                                    p.fontFaceNames[familyID][faceID] = ftFace->style_name;
+                                }
+                                worker.fontFaces[familyID][faceID] = ftFace;
                             }
+                        }
+                        {
+                            std::unique_lock<std::mutex> lock(p.fontFilesMutex);
+                            p.fontFiles = fontFiles;
+                            p.symbolFonts = symbolFonts;
+                            p.fontHashes = fontHashes;
+                            p.fontFilesInit = true;
+                        }
+                        p.fontFilesCV.notify_all();
+                        if (!worker.fontFaces.size())
+                        {
+                            throw Error("No fonts were found.");
+                        }
 
-                            p.fontFileNames[familyID] = fileName;
-                            //! \bug Probably not the best way to do this...
-                            if (String::match(ftFace->family_name, "Symbols"))
+                        // Read the disk cache while the other threads are opening
+                        // the fonts.
+                        _readDiskCache();
+                    }
+                    else
+                    {
+                        std::vector<FontFile> fontFiles;
+                        {
+                            std::unique_lock<std::mutex> lock(p.fontFilesMutex);
+                            p.fontFilesCV.wait(
+                                lock,
+                                [this]
+                                {
+                                    DJV_PRIVATE_PTR();
+                                    return p.fontFilesInit || !p.running;
+                                });
+                            fontFiles = p.fontFiles;
+                        }
+                        for (const auto& i : fontFiles)
+                        {
+                            FT_Face ftFace;
+                            ftError = FT_New_Face(worker.ftLibrary, i.fileName.c_str(), 0, &ftFace);
+                            if (ftError)
                             {
-                                p.symbolFonts.push_back(std::make_pair(familyID, faceID));
+                                std::stringstream ss;
+                                ss << "Cannot load font: " << i.fileName;
+                                _log(ss.str(), System::LogLevel::Error);
                             }
                             else
                             {
-                                std::unique_lock<std::mutex> lock(p.fontNamesMutex);
-                                p.fontNames[familyID] = ftFace->family_name;
-                                p.fontFaceNames[familyID][faceID] = ftFace->style_name;
+                                worker.fontFaces[i.family][i.face] = ftFace;
                             }
-                            p.fontFaces[familyID][faceID] = ftFace;
                         }
                     }
-                    if (!p.fontFaces.size())
-                    {
-                        throw Error("No fonts were found.");
-                    }
                 }
                 catch (const std::exception& e)
                 {
                     _log(e.what());
                 }
+                if (0 == index)
+                {
+                    // Don't leave the other threads waiting if there was an error.
+                    {
+                        std::unique_lock<std::mutex> lock(p.fontFilesMutex);
+                        p.fontFilesInit = true;
+                    }
+                    p.fontFilesCV.notify_all();
+                }
             }
 
-            void FontSystem::_delFreeType()
+            void FontSystem::_delFreeType(size_t index)
             {
                 DJV_PRIVATE_PTR();
-                if (p.ftLibrary)
+                auto& worker = *p.workers[index];
+                if (worker.ftLibrary)
                 {
-                    for (const auto& i : p.fontFaces)
+                    for (const auto& i : worker.fontFaces)
                     {
                         for (const auto& j : i.second)
                         {
                             FT_Done_Face(j.second);
                         }
                     }
-                    FT_Done_FreeType(p.ftLibrary);
+                    FT_Done_FreeType(worker.ftLibrary);
                 }
             }
 
-            void FontSystem::_handleMetricsRequests()
+            void FontSystem::_readDiskCache()
             {
                 DJV_PRIVATE_PTR();
-                for (auto& request : p.metricsRequests)
+                if (!System::File::Info(p.diskCachePath).doesExist())
+                    return;
+                bool lcdRendering = true;
+                size_t generation = 0;
+                {
+                    std::unique_lock<std::mutex> lock(p.requestMutex);
+                    lcdRendering = p.lcdRendering;
+                    generation = p.generation;
+                }
+                try
+                {
+                    const auto data = Cache::read(p.diskCachePath, p.fontHashes, lcdRendering);
+                    for (const auto& i : data.glyphs)
+                    {
+                        p.glyphCache.add(i->glyphInfo, i, generation);
+                    }
+                    {
+                        std::unique_lock<std::mutex> lock(p.measureCacheMutex);
+                        if (generation == p.measureCacheGeneration)
+                        {
+                            for (const auto& i : data.measure)
+                            {
+                                p.measureCache.add(i.first, i.second);
+                            }
+                            for (const auto& i : data.textLines)
+                            {
+                                p.textLinesCache.add(i.first, i.second);
+                            }
+                        }
+                    }
+                    if (generation == p.generation)
+                    {
+                        std::unique_lock<std::mutex> lock(p.diskCacheGlyphsMutex);
+                        p.diskCacheGlyphs = data.glyphs;
+                    }
+                    std::stringstream ss;
+                    ss << "Read the disk cache: " << p.diskCachePath.get() << '\n';
+                    ss << "    Glyphs: " << data.glyphs.size() << '\n';
+                    ss << "    Measure: " << data.measure.size() << '\n';
+                    ss << "    Text lines: " << data.textLines.size();
+                    _log(ss.str());
+                }
+                catch (const std::exception& e)
+                {
+                    _log(e.what(), System::LogLevel::Warning);
+                }
+            }
+
+            void FontSystem::_writeDiskCache()
+            {
+                DJV_PRIVATE_PTR();
+                Cache::Data data;
+                data.lcdRendering = p.lcdRendering;
+                data.glyphs = p.glyphCache.getValues();
+                {
+                    std::unique_lock<std::mutex> lock(p.measureCacheMutex);
+                    const auto measureKeys = p.measureCache.getKeys();
+                    const auto measureValues = p.measureCache.getValues();
+                    for (size_t i = 0; i < measureKeys.size(); ++i)
+                    {
+                        data.measure.push_back(std::make_pair(measureKeys[i], measureValues[i]));
+                    }
+                    const auto textLinesKeys = p.textLinesCache.getKeys();
+                    const auto textLinesValues = p.textLinesCache.getValues();
+                    for (size_t i = 0; i < textLinesKeys.size(); ++i)
+                    {
+                        data.textLines.push_back(std::make_pair(textLinesKeys[i], textLinesValues[i]));
+                    }
+                }
+                try
+                {
+                    Cache::write(p.diskCachePath, p.fontHashes, data);
+                    std::stringstream ss;
+                    ss << "Wrote the disk cache: " << p.diskCachePath.get();
+                    _log(ss.str());
+                }
+                catch (const std::exception& e)
+                {
+                    _log(e.what(), System::LogLevel::Warning);
+                }
+            }
+
+            void FontSystem::_handleMetricsRequests(size_t index)
+            {
+                DJV_PRIVATE_PTR();
+                auto& worker = *p.workers[index];
+                for (auto& request : worker.metricsRequests)
                 {
                     Metrics metrics;
-                    if (auto ftFace = p.getFace(request.fontInfo.getFamily(), request.fontInfo.getFace()))
+                    if (auto ftFace = worker.getFace(request.fontInfo.getFamily(), request.fontInfo.getFace()))
                     {
                         /*FT_Error ftError = FT_Set_Char_Size(
                             ftFace->second,
@@ -683,53 +1231,80 @@ namespace djv
                     }
                     request.promise.set_value(std::move(metrics));
                 }
-                p.metricsRequests.clear();
+                worker.metricsRequests.clear();
             }
 
-            void FontSystem::_handleMeasureRequests()
+            glm::vec2 FontSystem::_measure(size_t index, const std::string& text, const FontInfo& fontInfo, uint16_t elide)
             {
                 DJV_PRIVATE_PTR();
-                for (auto& request : p.measureRequests)
+                auto& worker = *p.workers[index];
+                glm::vec2 size = glm::vec2(0.F, 0.F);
+                try
                 {
-                    glm::vec2 size = glm::vec2(0.F, 0.F);
-                    try
+                    auto utf32 = worker.utf32Convert.from_bytes(text);
+                    const size_t inSize = utf32.size();
+                    const size_t outSize = elide > 0 ? std::min(inSize, static_cast<size_t>(elide)) : inSize;
+                    while (utf32.size() > outSize)
                     {
-                        auto utf32 = p.utf32Convert.from_bytes(request.text);
-                        const size_t inSize = utf32.size();
-                        const size_t outSize = request.elide > 0 ? std::min(inSize, static_cast<size_t>(request.elide)) : inSize;
-                        while (utf32.size() > outSize)
-                        {
-                            utf32.pop_back();
-                        }
-                        if (outSize < inSize)
-                        {
-                            utf32.push_back('.');
-                            utf32.push_back('.');
-                            utf32.push_back('.');
-                        }
-                        p.measure(utf32, p.getFontInfoList(request.fontInfo), request.maxLineWidth, size);
+                        utf32.pop_back();
                     }
-                    catch (const std::exception& e)
+                    if (outSize < inSize)
                     {
-                        std::stringstream ss;
-                        ss << "Error converting string" << " '" << request.text << "': " << e.what();
-                        _log(ss.str(), System::LogLevel::Error);
+                        utf32.push_back('.');
+                        utf32.push_back('.');
+                        utf32.push_back('.');
                     }
-                    request.promise.set_value(size);
+                    p.measure(worker, utf32, p.getFontInfoList(fontInfo), std::numeric_limits<uint16_t>::max(), size);
                 }
-                p.measureRequests.clear();
+                catch (const std::exception& e)
+                {
+                    std::stringstream ss;
+                    ss << "Error converting string" << " '" << text << "': " << e.what();
+                    _log(ss.str(), System::LogLevel::Error);
+                }
+                {
+                    std::unique_lock<std::mutex> lock(p.measureCacheMutex);
+                    if (worker.generation == p.measureCacheGeneration)
+                    {
+                        p.measureCache.add(MeasureCacheKey(text, fontInfo, elide), size);
+                        p.diskCacheChanged = true;
+                    }
+                }
+                return size;
             }
 
-            void FontSystem::_handleMeasureGlyphsRequests()
+            void FontSystem::_handleMeasureRequests(size_t index)
             {
                 DJV_PRIVATE_PTR();
-                for (auto& request : p.measureGlyphsRequests)
+                auto& worker = *p.workers[index];
+                for (auto& request : worker.measureRequests)
+                {
+                    request.promise.set_value(_measure(index, request.text, request.fontInfo, request.elide));
+                }
+                worker.measureRequests.clear();
+                for (auto& request : worker.measureBatchRequests)
+                {
+                    std::vector<glm::vec2> sizes;
+                    for (const auto& i : request.text)
+                    {
+                        sizes.push_back(_measure(index, i, request.fontInfo, request.elide));
+                    }
+                    request.promise.set_value(std::move(sizes));
+                }
+                worker.measureBatchRequests.clear();
+            }
+
+            void FontSystem::_handleMeasureGlyphsRequests(size_t index)
+            {
+                DJV_PRIVATE_PTR();
+                auto& worker = *p.workers[index];
+                for (auto& request : worker.measureGlyphsRequests)
                 {
                     glm::vec2 size = glm::vec2(0.F, 0.F);
                     std::vector<Math::BBox2f> glyphGeom;
                     try
                     {
-                        auto utf32 = p.utf32Convert.from_bytes(request.text);
+                        auto utf32 = worker.utf32Convert.from_bytes(request.text);
                         const size_t inSize = utf32.size();
                         const size_t outSize = request.elide > 0 ? std::min(inSize, static_cast<size_t>(request.elide)) : inSize;
                         while (utf32.size() > outSize)
@@ -742,7 +1317,7 @@ namespace djv
                             utf32.push_back('.');
                             utf32.push_back('.');
                         }
-                        p.measure(utf32, p.getFontInfoList(request.fontInfo), request.maxLineWidth, size, &glyphGeom);
+                        p.measure(worker, utf32, p.getFontInfoList(request.fontInfo), request.maxLineWidth, size, &glyphGeom);
                     }
                     catch (const std::exception& e)
                     {
@@ -752,59 +1327,65 @@ namespace djv
                     }
                     request.promise.set_value(glyphGeom);
                 }
-                p.measureGlyphsRequests.clear();
+                worker.measureGlyphsRequests.clear();
             }
 
-            void FontSystem::_handleGlyphsRequests()
+            std::basic_string<djv_char_t> FontSystem::_toUTF32(size_t index, const std::string& text)
             {
                 DJV_PRIVATE_PTR();
-                for (auto& request : p.glyphsRequests)
+                auto& worker = *p.workers[index];
+                std::basic_string<djv_char_t> out;
+                try
                 {
-                    std::basic_string<djv_char_t> utf32;
-                    try
-                    {
-                        utf32 = p.utf32Convert.from_bytes(request.text);
-                    }
-                    catch (const std::exception& e)
-                    {
-                        std::stringstream ss;
-                        ss << "Error converting string" << " '" << request.text << "': " << e.what();
-                        _log(ss.str(), System::LogLevel::Error);
-                    }
-                    const size_t inSize = utf32.size();
-                    const size_t outSize = request.elide > 0 ? std::min(inSize, static_cast<size_t>(request.elide)) : inSize;
-                    const bool elided = outSize < inSize;
+                    out = worker.utf32Convert.from_bytes(text);
+                }
+                catch (const std::exception& e)
+                {
+                    std::stringstream ss;
+                    ss << "Error converting string" << " '" << text << "': " << e.what();
+                    _log(ss.str(), System::LogLevel::Error);
+                }
+                return out;
+            }
+
+            void FontSystem::_handleGlyphsRequests(size_t index)
+            {
+                DJV_PRIVATE_PTR();
+                auto& worker = *p.workers[index];
+                for (auto& request : worker.glyphsRequests)
+                {
+                    const auto utf32 = _toUTF32(index, request.text);
                     const auto fontInfoList = p.getFontInfoList(request.fontInfo);
                     if (request.cacheOnly)
                     {
-                        for (size_t i = 0; i < inSize; ++i)
+                        for (const auto i : utf32)
                         {
-                            p.getGlyph(utf32[i], fontInfoList);
+                            p.getGlyph(worker, i, fontInfoList);
                         }
                     }
                     else
                     {
-                        std::vector<std::shared_ptr<Glyph> > glyphs(outSize + (elided ? 3 : 0));
-                        size_t i = 0;
-                        for (; i < outSize; ++i)
-                        {
-                            glyphs[i] = p.getGlyph(utf32[i], fontInfoList);
-                        }
-                        if (elided)
-                        {
-                            glyphs[i] = p.getGlyph('.', fontInfoList);
-                            glyphs[i + 1] = p.getGlyph('.', fontInfoList);
-                            glyphs[i + 2] = p.getGlyph('.', fontInfoList);
-                        }
-                        request.promise.set_value(std::move(glyphs));
+                        request.promise.set_value(p.getGlyphs(worker, utf32, fontInfoList, request.elide));
                     }
                 }
-                p.glyphsRequests.clear();
+                worker.glyphsRequests.clear();
+                for (auto& request : worker.glyphsBatchRequests)
+                {
+                    const auto fontInfoList = p.getFontInfoList(request.fontInfo);
+                    std::vector<std::vector<std::shared_ptr<Glyph> > > glyphs;
+                    for (const auto& i : request.text)
+                    {
+                        glyphs.push_back(p.getGlyphs(worker, _toUTF32(index, i), fontInfoList, request.elide));
+                    }
+                    request.promise.set_value(std::move(glyphs));
+                }
+                worker.glyphsBatchRequests.clear();
             }
 
-            void FontSystem::_handleTextLinesRequests()
+            void FontSystem::_handleTextLinesRequests(size_t index)
             {
                 DJV_PRIVATE_PTR();
+                auto& worker = *p.workers[index];
 
                 // Input:
                 //   Speckled Dace are capable of |living in an array of habitats
@@ -821,10 +1402,10 @@ namespace djv
                 //   "living in an array of"
                 //   "habitats"
 
-                for (auto& request : p.textLinesRequests)
+                for (auto& request : worker.textLinesRequests)
                 {
                     std::vector<TextLine> lines;
-                    if (FT_Face ftFace = p.getFace(request.fontInfo.getFamily(), request.fontInfo.getFace()))
+                    if (FT_Face ftFace = worker.getFace(request.fontInfo.getFamily(), request.fontInfo.getFace()))
                     {
                         /*FT_Error ftError = FT_Set_Char_Size(
                             ftFace->second,
@@ -844,23 +1425,13 @@ namespace djv
                         }
 
                         // Get the glyphs.
-                        std::basic_string<djv_char_t> utf32;
-                        try
-                        {
-                            utf32 = p.utf32Convert.from_bytes(request.text);
-                        }
-                        catch (const std::exception& e)
-                        {
-                            std::stringstream ss;
-                            ss << "Error converting string" << " '" << request.text << "': " << e.what();
-                            _log(ss.str(), System::LogLevel::Error);
-                        }
+                        const auto utf32 = _toUTF32(index, request.text);
                         const auto utf32Begin = utf32.begin();
                         std::vector<std::shared_ptr<Glyph> > glyphs(utf32.size());
                         const auto fontInfoList = p.getFontInfoList(request.fontInfo);
                         for (auto i = utf32Begin; i != utf32.end(); ++i)
                         {
-                            glyphs[i - utf32Begin] = p.getGlyph(*i, fontInfoList);
+                            glyphs[i - utf32Begin] = p.getGlyph(worker, *i, fontInfoList);
                         }
 
                         glm::vec2 pos = glm::vec2(0.F, static_cast<float>(ftFace->size->metrics.height) / 64.F);
@@ -899,7 +1470,7 @@ namespace djv
                                     const size_t offset = lineBegin - utf32.begin();
                                     const size_t size = i - lineBegin;
                                     TextLine line;
-                                    line.text = p.utf32Convert.to_bytes(utf32.substr(offset, size));
+                                    line.text = worker.utf32Convert.to_bytes(utf32.substr(offset, size));
                                     line.size = glm::vec2(pos.x, static_cast<float>(ftFace->size->metrics.height) / 64.F);
                                     line.glyphs = std::vector<std::shared_ptr<Glyph> >(glyphs.begin() + offset, glyphs.begin() + offset + size);
                                     lines.push_back(line);
@@ -931,7 +1502,7 @@ namespace djv
                                         const size_t offset = lineBegin - utf32.begin();
                                         const size_t size = i - lineBegin;
                                         TextLine line;
-                                        line.text = p.utf32Convert.to_bytes(utf32.substr(offset, size));
+                                        line.text = worker.utf32Convert.to_bytes(utf32.substr(offset, size));
                                         line.size = glm::vec2(lineBreakPos, static_cast<float>(ftFace->size->metrics.height) / 64.F);
                                         line.glyphs = std::vector<std::shared_ptr<Glyph> >(glyphs.begin() + offset, glyphs.begin() + offset + size);
                                         lines.push_back(line);
@@ -954,7 +1525,7 @@ namespace djv
                                         const size_t offset = lineBegin - utf32.begin();
                                         const size_t size = i - lineBegin;
                                         TextLine line;
-                                        line.text = p.utf32Convert.to_bytes(utf32.substr(offset, size));
+                                        line.text = worker.utf32Convert.to_bytes(utf32.substr(offset, size));
                                         line.size = glm::vec2(pos.x, static_cast<float>(ftFace->size->metrics.height) / 64.F);
                                         line.glyphs = std::vector<std::shared_ptr<Glyph> >(glyphs.begin() + offset, glyphs.begin() + offset + size);
                                         lines.push_back(line);
@@ -991,7 +1562,7 @@ namespace djv
                                 const size_t offset = lineBegin - utf32.begin();
                                 const size_t size = i - lineBegin;
                                 TextLine textLine;
-                                textLine.text = p.utf32Convert.to_bytes(utf32.substr(offset, size));
+                                textLine.text = worker.utf32Convert.to_bytes(utf32.substr(offset, size));
                                 textLine.size = glm::vec2(pos.x, static_cast<float>(ftFace->size->metrics.height) / 64.F);
                                 textLine.glyphs = std::vector<std::shared_ptr<Glyph> >(glyphs.begin() + offset, glyphs.begin() + offset + size);
                                 lines.push_back(textLine);
@@ -1004,9 +1575,34 @@ namespace djv
                             }
                         }
                     }
+                    {
+                        std::unique_lock<std::mutex> lock(p.measureCacheMutex);
+                        if (worker.generation == p.measureCacheGeneration)
+                        {
+                            p.textLinesCache.add(MeasureCacheKey(request.text, request.fontInfo, request.maxLineWidth), lines);
+                            p.diskCacheChanged = true;
+                        }
+                    }
                     request.promise.set_value(lines);
                 }
-                p.textLinesRequests.clear();
+                worker.textLinesRequests.clear();
+            }
+
+            bool FontSystem::Private::hasLayoutRequests() const
+            {
+                return
+                    metricsQueue.size() ||
+                    measureQueue.size() ||
+                    measureBatchQueue.size() ||
+                    measureGlyphsQueue.size();
+            }
+
+            bool FontSystem::Private::hasGlyphRequests() const
+            {
+                return
+                    glyphsQueue.size() ||
+                    glyphsBatchQueue.size() ||
+                    textLinesQueue.size();
             }
 
             std::vector<FontInfo> FontSystem::Private::getFontInfoList(const FontInfo& fontInfo) const
@@ -1020,22 +1616,10 @@ namespace djv
                 return out;
             }
 
-            FT_Face FontSystem::Private::getFace(FamilyID family, FaceID face) const
-            {
-                FT_Face out = nullptr;
-                const auto i = fontFaces.find(family);
-                if (i != fontFaces.end())
-                {
-                    const auto j = i->second.find(face);
-                    if (j != i->second.end())
-                    {
-                        out = j->second;
-                    }
-                }
-                return out;
-            }
-
-            std::shared_ptr<Glyph> FontSystem::Private::getGlyph(uint32_t code, const std::vector<FontInfo>& fontInfoList)
+            std::shared_ptr<Glyph> FontSystem::Private::getGlyph(
+                Worker& worker,
+                uint32_t code,
+                const std::vector<FontInfo>& fontInfoList)
             {
                 std::shared_ptr<Glyph> out;
                 for (const auto& fontInfo : fontInfoList)
@@ -1044,7 +1628,7 @@ namespace djv
                     {
                         break;
                     }
-                    else if (auto ftFace = getFace(fontInfo.getFamily(), fontInfo.getFace()))
+                    else if (auto ftFace = worker.getFace(fontInfo.getFamily(), fontInfo.getFace()))
                     {
                         if (auto ftGlyphIndex = FT_Get_Char_Index(ftFace, code))
                         {
@@ -1066,7 +1650,7 @@ namespace djv
                             }
                             FT_Render_Mode renderMode = FT_RENDER_MODE_NORMAL;
                             uint8_t renderModeChannels = 1;
-                            if (lcdRenderingThread)
+                            if (worker.lcdRendering)
                             {
                                 renderMode = FT_RENDER_MODE_LCD;
                                 renderModeChannels = 3;
@@ -1104,9 +1688,10 @@ namespace djv
                             out->rsbDelta = ftFace->glyph->rsb_delta;
                             FT_Done_Glyph(ftGlyph);
 
-                            glyphCache.add(out->glyphInfo, out);
-                            glyphCacheSize = glyphCache.getSize();
-                            glyphCachePercentageUsed = glyphCache.getPercentageUsed();
+                            // Another thread may have rendered the same glyph in the
+                            // meantime, in which case this one replaces it.
+                            glyphCache.add(out->glyphInfo, out, worker.generation);
+                            diskCacheChanged = true;
 
                             break;
                         }
@@ -1115,7 +1700,59 @@ namespace djv
                 return out;
             }
 
+            bool FontSystem::Private::getGlyphMetrics(
+                Worker& worker,
+                uint32_t code,
+                const std::vector<FontInfo>& fontInfoList,
+                GlyphMetrics& out)
+            {
+                for (const auto& fontInfo : fontInfoList)
+                {
+                    const GlyphInfo glyphInfo(code, fontInfo);
+                    std::shared_ptr<Glyph> glyph;
+                    if (glyphMetricsCache.get(glyphInfo, out))
+                    {
+                        return true;
+                    }
+                    else if (glyphCache.get(glyphInfo, glyph))
+                    {
+                        out.advance = glyph->advance;
+                        out.lsbDelta = glyph->lsbDelta;
+                        out.rsbDelta = glyph->rsbDelta;
+                        return true;
+                    }
+                    else if (auto ftFace = worker.getFace(fontInfo.getFamily(), fontInfo.getFace()))
+                    {
+                        if (auto ftGlyphIndex = FT_Get_Char_Index(ftFace, code))
+                        {
+                            // Load the glyph without rendering it, this is enough
+                            // for the advance and hinting deltas.
+                            FT_Error ftError = FT_Set_Pixel_Sizes(
+                                ftFace,
+                                0,
+                                static_cast<int>(fontInfo.getSize()));
+                            if (ftError)
+                            {
+                                return false;
+                            }
+                            ftError = FT_Load_Glyph(ftFace, ftGlyphIndex, FT_LOAD_FORCE_AUTOHINT);
+                            if (ftError)
+                            {
+                                return false;
+                            }
+                            out.advance = static_cast<float>(ftFace->glyph->advance.x / 64.F);
+                            out.lsbDelta = ftFace->glyph->lsb_delta;
+                            out.rsbDelta = ftFace->glyph->rsb_delta;
+                            glyphMetricsCache.add(glyphInfo, out, 0);
+                            return true;
+                        }
+                    }
+                }
+                return false;
+            }
+
             void FontSystem::Private::measure(
+                Worker& worker,
                 const std::basic_string<djv_char_t>& utf32,
                 const std::vector<FontInfo>& fontInfoList,
                 uint16_t maxLineWidth,
@@ -1125,7 +1762,7 @@ namespace djv
                 glm::vec2 pos(0.F, 0.F);
                 for (const auto& fontInfo : fontInfoList)
                 {
-                    if (auto ftFace = getFace(fontInfo.getFamily(), fontInfo.getFace()))
+                    if (auto ftFace = worker.getFace(fontInfo.getFamily(), fontInfo.getFace()))
                     {
                         /*FT_Error ftError = FT_Set_Char_Size(
                             ftFace->second,
@@ -1149,30 +1786,31 @@ namespace djv
                         int32_t rsbDeltaPrev = 0;
                         for (auto i = utf32.begin(); i != utf32.end(); ++i)
                         {
-                            const auto glyph = getGlyph(*i, fontInfoList);
-                            if (glyph && glyphGeom)
+                            GlyphMetrics glyph;
+                            const bool hasGlyph = getGlyphMetrics(worker, *i, fontInfoList, glyph);
+                            if (hasGlyph && glyphGeom)
                             {
                                 glyphGeom->push_back(Math::BBox2f(
                                     pos.x,
-                                    glyph->advance,
-                                    glyph->advance,
+                                    glyph.advance,
+                                    glyph.advance,
                                     static_cast<float>(ftFace->size->metrics.height) / 64.F));
                             }
 
                             int32_t x = 0;
                             glm::vec2 posAndSize(0.F, 0.F);
-                            if (glyph && glyph->imageData)
+                            if (hasGlyph)
                             {
-                                x = glyph->advance;
-                                if (rsbDeltaPrev - glyph->lsbDelta > 32)
+                                x = glyph.advance;
+                                if (rsbDeltaPrev - glyph.lsbDelta > 32)
                                 {
                                     x -= 1;
                                 }
-                                else if (rsbDeltaPrev - glyph->lsbDelta < -31)
+                                else if (rsbDeltaPrev - glyph.lsbDelta < -31)
                                 {
                                     x += 1;
                                 }
-                                rsbDeltaPrev = glyph->rsbDelta;
+                                rsbDeltaPrev = glyph.rsbDelta;
                             }
                             else
                             {
@@ -1223,6 +1861,30 @@ namespace djv
                 size.y = pos.y;
             }
 
+            std::vector<std::shared_ptr<Glyph> > FontSystem::Private::getGlyphs(
+                Worker& worker,
+                const std::basic_string<djv_char_t>& utf32,
+                const std::vector<FontInfo>& fontInfoList,
+                uint16_t elide)
+            {
+                const size_t inSize = utf32.size();
+                const size_t outSize = elide > 0 ? std::min(inSize, static_cast<size_t>(elide)) : inSize;
+                const bool elided = outSize < inSize;
+                std::vector<std::shared_ptr<Glyph> > out(outSize + (elided ? 3 : 0));
+                size_t i = 0;
+                for (; i < outSize; ++i)
+                {
+                    out[i] = getGlyph(worker, utf32[i], fontInfoList);
+                }
+                if (elided)
+                {
+                    out[i] = getGlyph(worker, '.', fontInfoList);
+                    out[i + 1] = getGlyph(worker, '.', fontInfoList);
+                    out[i + 2] = getGlyph(worker, '.', fontInfoList);
+                }
+                return out;
+            }
+
         } // namespace Font
     } // namespace Render2D
 } // namespace djv
@@ -131,6 +131,15 @@ namespace djv
 
             //! This class provides a font system.
             //!
+            //! Requests are handled by a pool of threads that each have their own
+            //! FreeType faces and share the glyph cache. Layout requests (metrics
+            //! and measuring) only load the glyph metrics and are handled before
+            //! requests that render glyphs.
+            //!
+            //! The rendered glyphs and measured text are written to a disk cache
+            //! when the system is destroyed and read back at startup, so the
+            //! user interface does not need to render them again.
+            //!
             //! \todo Add support for gamma correction?
             //! - https://www.freetype.org/freetype2/docs/text-rendering-general.html
             class FontSystem : public System::ISystem
@@ -165,6 +174,9 @@ namespace djv
                 //! Get the glyph cache percentage used.
                 float getGlyphCachePercentage() const;
 
+                //! Get the number of threads that handle requests.
+                size_t getThreadCount() const;
+
                 ///@}
 
                 //! \name Options
@@ -187,6 +199,12 @@ namespace djv
                     const FontInfo&    fontInfo,
                     uint16_t           elide    = 0);
 
+                //! Measure the size of multiple strings with one request.
+                std::future<std::vector<glm::vec2> > measure(
+                    const std::vector<std::string>& text,
+                    const FontInfo&                 fontInfo,
+                    uint16_t                        elide    = 0);
+
                 //! Measure the size of glyphs.
                 std::future<std::vector<Math::BBox2f> > measureGlyphs(
                     const std::string& text,
@@ -204,6 +222,12 @@ namespace djv
                     const FontInfo&    fontInfo,
                     uint16_t           elide    = 0);
 
+                //! Get font glyphs for multiple strings with one request.
+                std::future<std::vector<std::vector<std::shared_ptr<Glyph> > > > getGlyphs(
+                    const std::vector<std::string>& text,
+                    const FontInfo&                 fontInfo,
+                    uint16_t                        elide    = 0);
+
                 //! Break text into lines for wrapping.
                 std::future<std::vector<TextLine> > textLines(
                     const std::string& text,
@@ -213,16 +237,31 @@ namespace djv
                 //! Request font glyphs to be cached.
                 void cacheGlyphs(const std::string& text, const FontInfo&);
 
+                //! Request font glyphs for multiple strings to be cached. The
+                //! strings are spread across the threads.
+                void cacheGlyphs(const std::vector<std::string>& text, const FontInfo&);
+
+                //! Get the glyphs that were read from the disk cache at startup,
+                //! so they can be added to the texture atlas before they are
+                //! drawn. The glyphs are only returned once, the list is empty
+                //! if the cache has not been read yet.
+                std::vector<std::shared_ptr<Glyph> > takeDiskCacheGlyphs();
+
                 ///@}
             
             private:
-                void _initFreeType();
-                void _delFreeType();
-                void _handleMetricsRequests();
-                void _handleMeasureRequests();
-                void _handleTextLinesRequests();
-                void _handleMeasureGlyphsRequests();
-                void _handleGlyphsRequests();
+                void _run(size_t);
+                void _initFreeType(size_t);
+                void _delFreeType(size_t);
+                void _readDiskCache();
+                void _writeDiskCache();
+                void _handleMetricsRequests(size_t);
+                void _handleMeasureRequests(size_t);
+                void _handleTextLinesRequests(size_t);
+                void _handleMeasureGlyphsRequests(size_t);
+                void _handleGlyphsRequests(size_t);
+                glm::vec2 _measure(size_t, const std::string&, const FontInfo&, uint16_t elide);
+                std::basic_string<djv_char_t> _toUTF32(size_t, const std::string&);
 
                 DJV_PRIVATE();
             };
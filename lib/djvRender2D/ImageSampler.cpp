@@ -0,0 +1,283 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvRender2D/ImageSampler.h>
+
+#include <djvRender2D/RenderPrivate.h>
+
+#include <djvOCIO/CPUProcessor.h>
+
+#include <djvImage/Color.h>
+#include <djvImage/Data.h>
+#include <djvImage/Parallel.h>
+#include <djvImage/Statistics.h>
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+namespace djv
+{
+    namespace Render2D
+    {
+        struct ImageSampler::Private
+        {
+            ImageOptions options;
+            bool colorMatrixEnabled = false;
+            glm::mat4x4 colorMatrix = glm::mat4x4(1.F);
+            bool colorInvert = false;
+            bool levelsEnabled = false;
+            float levelsGamma = 1.F;
+            bool exposureEnabled = false;
+            float exposureV = 0.F;
+            float exposureD = 0.F;
+            float exposureK = 0.F;
+            float exposureF = 0.F;
+            float softClip = 0.F;
+            std::shared_ptr<OCIO::CPUProcessor> colorSpaceProcessor;
+
+            void readScanline(const Image::Data&, const Math::BBox2i&, int y, float*) const;
+        };
+
+        void ImageSampler::Private::readScanline(
+            const Image::Data& data,
+            const Math::BBox2i& bbox,
+            int y,
+            float* out) const
+        {
+            const auto& info = data.getInfo();
+            const bool mirrorX = info.layout.mirror.x != options.mirror.x;
+            const bool mirrorY = info.layout.mirror.y != options.mirror.y;
+            const int w = data.getWidth();
+            const int h = data.getHeight();
+            const uint16_t count = static_cast<uint16_t>(bbox.w());
+            Image::readRGBA_F32(
+                data,
+                static_cast<uint16_t>(mirrorX ? (w - 1 - bbox.max.x) : bbox.min.x),
+                static_cast<uint16_t>(mirrorY ? (h - 1 - y) : y),
+                count,
+                1,
+                out);
+            if (mirrorX)
+            {
+                for (size_t i = 0, j = count - 1; i < j; ++i, --j)
+                {
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        std::swap(out[i * 4 + c], out[j * 4 + c]);
+                    }
+                }
+            }
+        }
+
+        void ImageSampler::_init(const ImageOptions& options)
+        {
+            DJV_PRIVATE_PTR();
+            p.options = options;
+
+            // These are the same values that are passed to the image shader.
+            p.colorMatrixEnabled = options.colorEnabled && options.color != ImageColor();
+            if (p.colorMatrixEnabled)
+            {
+                p.colorMatrix = Render2D::colorMatrix(options.color);
+            }
+            p.colorInvert = options.colorEnabled && options.color.invert;
+            p.levelsEnabled = options.levelsEnabled && options.levels != ImageLevels();
+            p.levelsGamma = 1.F / options.levels.gamma;
+            p.exposureEnabled = options.exposureEnabled;
+            if (p.exposureEnabled)
+            {
+                p.exposureV = powf(2.F, options.exposure.exposure + 2.47393F);
+                p.exposureD = options.exposure.defog;
+                p.exposureK = powf(2.F, options.exposure.kneeLow);
+                p.exposureF = knee2(
+                    powf(2.F, options.exposure.kneeHigh) - p.exposureK,
+                    powf(2.F, 3.5F) - p.exposureK);
+            }
+            p.softClip = options.softClipEnabled ? options.softClip : 0.F;
+            if (options.colorSpace.isValid())
+            {
+                p.colorSpaceProcessor = OCIO::CPUProcessor::create(options.colorSpace);
+            }
+        }
+
+        ImageSampler::ImageSampler() :
+            _p(new Private)
+        {}
+
+        ImageSampler::~ImageSampler()
+        {}
+
+        std::shared_ptr<ImageSampler> ImageSampler::create(const ImageOptions& options)
+        {
+            auto out = std::shared_ptr<ImageSampler>(new ImageSampler);
+            out->_init(options);
+            return out;
+        }
+
+        const ImageOptions& ImageSampler::getOptions() const
+        {
+            return _p->options;
+        }
+
+        void ImageSampler::process(float* data, size_t pixelCount) const
+        {
+            DJV_PRIVATE_PTR();
+            if (p.colorMatrixEnabled || p.colorInvert || p.levelsEnabled || p.exposureEnabled || p.softClip > 0.F)
+            {
+                float* d = data;
+                for (size_t i = 0; i < pixelCount; ++i, d += 4)
+                {
+                    if (p.colorMatrixEnabled)
+                    {
+                        const glm::vec4 tmp = glm::vec4(d[0], d[1], d[2], 1.F) * p.colorMatrix;
+                        d[0] = tmp[0];
+                        d[1] = tmp[1];
+                        d[2] = tmp[2];
+                    }
+                    for (size_t c = 0; c < 3; ++c)
+                    {
+                        float v = d[c];
+                        if (p.colorInvert)
+                        {
+                            v = 1.F - v;
+                        }
+                        if (p.levelsEnabled)
+                        {
+                            const auto& levels = p.options.levels;
+                            v = (v - levels.inLow) / levels.inHigh;
+                            if (v >= 0.F)
+                            {
+                                v = powf(v, p.levelsGamma);
+                            }
+                            v = v * levels.outHigh + levels.outLow;
+                        }
+                        if (p.exposureEnabled)
+                        {
+                            v = std::max(0.F, v - p.exposureD) * p.exposureV;
+                            if (v > p.exposureK)
+                            {
+                                v = p.exposureK + knee(v - p.exposureK, p.exposureF);
+                            }
+                            v *= .332F;
+                        }
+                        if (p.softClip > 0.F)
+                        {
+                            const float tmp = 1.F - p.softClip;
+                            if (v > tmp)
+                            {
+                                v = tmp + (1.F - expf(-(v - tmp) / p.softClip)) * p.softClip;
+                            }
+                        }
+                        d[c] = v;
+                    }
+                }
+            }
+
+            if (p.colorSpaceProcessor)
+            {
+                p.colorSpaceProcessor->apply(data, pixelCount, 4);
+            }
+
+            size_t channel = 0;
+            switch (p.options.channelDisplay)
+            {
+            case ImageChannelDisplay::Red:   channel = 0; break;
+            case ImageChannelDisplay::Green: channel = 1; break;
+            case ImageChannelDisplay::Blue:  channel = 2; break;
+            case ImageChannelDisplay::Alpha: channel = 3; break;
+            default: return;
+            }
+            float* d = data;
+            for (size_t i = 0; i < pixelCount; ++i, d += 4)
+            {
+                const float v = d[channel];
+                d[0] = v;
+                d[1] = v;
+                d[2] = v;
+            }
+        }
+
+        Image::Color ImageSampler::average(const Image::Data& data, const Math::BBox2i& value) const
+        {
+            DJV_PRIVATE_PTR();
+            const Math::BBox2i bbox = getCropBBox(data, value);
+            const int w = bbox.w();
+            const int h = bbox.h();
+            if (w < 1 || h < 1)
+                return Image::Color(0.F, 0.F, 0.F, 0.F);
+
+            double sum[4] = { 0.0, 0.0, 0.0, 0.0 };
+            std::mutex mutex;
+            Image::parallelScanlines(
+                static_cast<uint16_t>(h),
+                static_cast<size_t>(w) * static_cast<size_t>(h),
+                [this, &p, &data, &bbox, w, &sum, &mutex](uint16_t begin, uint16_t end)
+                {
+                    std::vector<float> scanline(static_cast<size_t>(w) * 4);
+                    double tmp[4] = { 0.0, 0.0, 0.0, 0.0 };
+                    for (uint16_t y = begin; y < end; ++y)
+                    {
+                        p.readScanline(data, bbox, bbox.min.y + y, scanline.data());
+                        process(scanline.data(), w);
+                        const float* d = scanline.data();
+                        for (int x = 0; x < w; ++x, d += 4)
+                        {
+                            for (size_t c = 0; c < 4; ++c)
+                            {
+                                tmp[c] += d[c];
+                            }
+                        }
+                    }
+                    std::lock_guard<std::mutex> lock(mutex);
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        sum[c] += tmp[c];
+                    }
+                });
+            const double count = static_cast<double>(w) * static_cast<double>(h);
+            return Image::Color(
+                static_cast<Image::F32_T>(sum[0] / count),
+                static_cast<Image::F32_T>(sum[1] / count),
+                static_cast<Image::F32_T>(sum[2] / count),
+                static_cast<Image::F32_T>(sum[3] / count));
+        }
+
+        std::shared_ptr<Image::Data> ImageSampler::crop(const Image::Data& data, const Math::BBox2i& value) const
+        {
+            DJV_PRIVATE_PTR();
+            std::shared_ptr<Image::Data> out;
+            const Math::BBox2i bbox = getCropBBox(data, value);
+            const int w = bbox.w();
+            const int h = bbox.h();
+            if (w < 1 || h < 1)
+                return out;
+
+            out = Image::Data::create(Image::Info(
+                static_cast<uint16_t>(w),
+                static_cast<uint16_t>(h),
+                Image::Type::RGBA_F32));
+            auto outP = out.get();
+            Image::parallelScanlines(
+                static_cast<uint16_t>(h),
+                static_cast<size_t>(w) * static_cast<size_t>(h),
+                [this, &p, &data, &bbox, w, outP](uint16_t begin, uint16_t end)
+                {
+                    for (uint16_t y = begin; y < end; ++y)
+                    {
+                        float* scanline = reinterpret_cast<float*>(outP->getData(y));
+                        p.readScanline(data, bbox, bbox.min.y + y, scanline);
+                        process(scanline, w);
+                    }
+                });
+            return out;
+        }
+
+        Math::BBox2i ImageSampler::getCropBBox(const Image::Data& data, const Math::BBox2i& value)
+        {
+            return value.intersect(Math::BBox2i(0, 0, data.getWidth(), data.getHeight()));
+        }
+
+    } // namespace Render2D
+} // namespace djv
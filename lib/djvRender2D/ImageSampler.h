@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvRender2D/Data.h>
+
+#include <djvMath/BBox.h>
+
+#include <memory>
+
+namespace djv
+{
+    namespace Image
+    {
+        class Color;
+        class Data;
+
+    } // namespace Image
+
+    namespace Render2D
+    {
+        //! This class provides sampling of image regions with the image options
+        //! applied on the CPU.
+        //!
+        //! The operations are applied in the same order as the image shader
+        //! (color matrix, invert, levels, exposure, soft clip, color space,
+        //! and channel display) so the sampled values match the displayed
+        //! values without rendering the image and reading it back from the
+        //! GPU. The color space conversion uses a baked 3D LUT.
+        //!
+        //! Regions are given in display pixel coordinates, that is after the
+        //! image layout and the options have been mirrored.
+        class ImageSampler
+        {
+            DJV_NON_COPYABLE(ImageSampler);
+
+        protected:
+            void _init(const ImageOptions&);
+            ImageSampler();
+
+        public:
+            ~ImageSampler();
+
+            //! Create a new image sampler.
+            //! Throws:
+            //! - std::exception
+            static std::shared_ptr<ImageSampler> create(const ImageOptions& = ImageOptions());
+
+            const ImageOptions& getOptions() const;
+
+            //! \name Processing
+            ///@{
+
+            //! Apply the image options to packed RGBA floating point pixels.
+            void process(float*, size_t pixelCount) const;
+
+            ///@}
+
+            //! \name Sampling
+            ///@{
+
+            //! Get the average color of an image region. Pixels outside of the
+            //! image are ignored. The color is returned as RGBA_F32.
+            Image::Color average(const Image::Data&, const Math::BBox2i&) const;
+
+            //! Get a copy of an image region as RGBA_F32. The region is clipped
+            //! to the image, use getCropBBox() to find the result area. A null
+            //! pointer is returned when the region does not intersect the image.
+            std::shared_ptr<Image::Data> crop(const Image::Data&, const Math::BBox2i&) const;
+
+            //! Get the area of an image region that can be sampled. The result
+            //! has a width or height less than one when the region does not
+            //! intersect the image.
+            static Math::BBox2i getCropBBox(const Image::Data&, const Math::BBox2i&);
+
+            ///@}
+
+        private:
+            DJV_PRIVATE();
+        };
+
+    } // namespace Render2D
+} // namespace djv
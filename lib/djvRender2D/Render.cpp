@@ -5,6 +5,7 @@
 #include <djvRender2D/Render.h>
 
 #include <djvRender2D/RenderPrivate.h>
+#include <djvRender2D/TextureUploader.h>
 
 #include <djvGL/GLFWSystem.h>
 #include <djvGL/MeshFunc.h>
@@ -26,9 +27,11 @@
 #include <djvSystem/ResourceSystem.h>
 #include <djvSystem/TimerFunc.h>
 
+#include <djvMath/MathFunc.h>
 #include <djvMath/Range.h>
 
 #include <djvCore/Cache.h>
+#include <djvCore/Memory.h>
 
 #include <OpenColorIO/OpenColorIO.h>
 
@@ -36,6 +39,8 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/perpendicular.hpp>
 
+#include <cstring>
+
 using namespace djv::Core;
 namespace _OCIO = OCIO_NAMESPACE;
 
@@ -43,6 +48,57 @@ namespace djv
 {
     namespace Render2D
     {
+        namespace
+        {
+            const GL::VBOType vboType = GL::VBOType::Pos2_F32_UV_U16_Color_U8;
+
+            Math::BBox2f getBBox(const glm::vec3 pts[4])
+            {
+                Math::BBox2f out;
+                out.min = pts[0];
+                out.max = pts[0];
+                for (size_t i = 1; i < 4; ++i)
+                {
+                    out.min.x = std::min(out.min.x, pts[i].x);
+                    out.max.x = std::max(out.max.x, pts[i].x);
+                    out.min.y = std::min(out.min.y, pts[i].y);
+                    out.max.y = std::max(out.max.y, pts[i].y);
+                }
+                return out;
+            }
+
+            //! Copy a tile from an image with a border of one pixel on each
+            //! side. The border pixels are repeated at the edges of the image.
+            std::shared_ptr<Image::Data> getTileData(
+                const Image::Data& data,
+                uint16_t x,
+                uint16_t y,
+                uint16_t w,
+                uint16_t h)
+            {
+                Image::Layout layout;
+                layout.endian = data.getLayout().endian;
+                auto out = Image::Data::create(Image::Info(w + 2, h + 2, data.getType(), layout));
+                const size_t pixelByteCount = data.getPixelByteCount();
+                const int dataW = data.getWidth();
+                const int dataH = data.getHeight();
+                const uint16_t left = static_cast<uint16_t>(std::max(x - 1, 0));
+                const uint16_t right = static_cast<uint16_t>(std::min(x + w, dataW - 1));
+                for (int j = 0; j < h + 2; ++j)
+                {
+                    const uint16_t dataY = static_cast<uint16_t>(Math::clamp(y + j - 1, 0, dataH - 1));
+                    uint8_t* p = out->getData(j);
+                    memcpy(p, data.getData(left, dataY), pixelByteCount);
+                    p += pixelByteCount;
+                    memcpy(p, data.getData(x, dataY), w * pixelByteCount);
+                    p += w * pixelByteCount;
+                    memcpy(p, data.getData(right, dataY), pixelByteCount);
+                }
+                return out;
+            }
+
+        } // namespace
+
         struct Render::Private
         {
             Render* system = nullptr;
@@ -51,15 +107,28 @@ namespace djv
             bool                                         textLCDRendering    = true;
 
             Math::BBox2f                                 viewport;
-            std::vector<std::shared_ptr<Primitive> >     primitives;
+            Math::BBox2f                                 region;
+            PrimitivePool<Primitive>                     primitivePool;
+            PrimitivePool<TextPrimitive>                 textPrimitivePool;
+            PrimitivePool<ImagePrimitive>                imagePrimitivePool;
+            PrimitivePool<ShadowPrimitive>               shadowPrimitivePool;
+            PrimitivePool<TexturePrimitive>              texturePrimitivePool;
+            std::vector<Primitive*>                      primitives;
             size_t                                       primitivesCount     = 0;
+            size_t                                       drawCallCount       = 0;
             PrimitiveData                                primitiveData;
+            std::weak_ptr<Font::FontSystem>              fontSystem;
             std::shared_ptr<GL::TextureAtlas>            textureAtlas;
             std::map<UID, uint64_t>                      textureIDs;
             std::map<UID, uint64_t>                      glyphTextureIDs;
             std::vector<std::shared_ptr<GL::Texture> >   dynamicTextures;
-            std::map<UID, std::shared_ptr<GL::Texture> > dynamicTextureCache;
+            TextureCache<UID>                            dynamicTextureCache;
+            GLint                                        maxTextureSize      = 0;
+            std::map<UID, TiledImage>                    tiledImages;
+            TextureCache<TileKey>                        tileCache;
+            size_t                                       frame               = 0;
 #if !defined(DJV_GL_ES2)
+            std::unique_ptr<TextureUploader>             textureUploader;
             std::map<OCIO::Convert, ColorSpaceData>      colorSpaceCache;
             size_t                                       colorSpaceID        = 1;
 #endif // DJV_GL_ES2
@@ -76,8 +145,19 @@ namespace djv
 
             std::shared_ptr<System::Timer>               statsTimer;
 
-            void vboDataSizeUpdate(size_t);
+            void vboDataSizeUpdate(size_t, const float color[4]);
 
+            ImagePrimitive* createImagePrimitive(
+                const Image::Info&,
+                const ImageOptions&,
+                ColorMode,
+                const Math::BBox2f& currentClipRect);
+            void addImageVertices(
+                ImagePrimitive*,
+                const glm::vec3 pts[4],
+                const float textureU[2],
+                const float textureV[2],
+                const float finalColor[4]);
             void drawImage(
                 const std::shared_ptr<Image::Data>&,
                 const glm::vec2& pos,
@@ -86,6 +166,15 @@ namespace djv
                 const glm::mat3x3& currentTransform,
                 const Math::BBox2f& currentClipRect,
                 const float finalColor[4]);
+            void drawTiledImage(
+                const std::shared_ptr<Image::Data>&,
+                const glm::vec2& pos,
+                const ImageOptions&,
+                ColorMode,
+                const glm::mat3x3& currentTransform,
+                const Math::BBox2f& currentClipRect,
+                const float finalColor[4]);
+            size_t getTiledImageByteCount() const;
 
             std::string getFragmentSource() const;
         };
@@ -96,7 +185,8 @@ namespace djv
             DJV_PRIVATE_PTR();
             p.system = this;
 
-            addDependency(GL::GLFW::GLFWSystem::create(context));
+            auto glfwSystem = GL::GLFW::GLFWSystem::create(context);
+            addDependency(glfwSystem);
 
             GLint maxTextureUnits = 0;
             GLint maxTextureSize = 0;
@@ -109,6 +199,20 @@ namespace djv
                 ss << "Maximum OpenGL texture size: " << maxTextureSize;
                 logSystem->log("djv::Render2D::Render", ss.str());
             }
+            p.maxTextureSize = maxTextureSize;
+            p.dynamicTextureCache.setMaxByteCount(dynamicTextureCacheMaxByteCount);
+            p.tileCache.setMaxByteCount(tileCacheMaxByteCount);
+#if !defined(DJV_GL_ES2)
+            try
+            {
+                p.textureUploader.reset(new TextureUploader(glfwSystem->getWindow()));
+            }
+            catch (const std::exception& e)
+            {
+                auto logSystem = context->getSystemT<System::LogSystem>();
+                logSystem->log("djv::Render2D::Render", e.what(), System::LogLevel::Error);
+            }
+#endif // DJV_GL_ES2
             const uint8_t _textureAtlasCount = std::min(maxTextureUnits, static_cast<GLint>(textureAtlasCount));
             const uint16_t _textureAtlasSize = std::min(maxTextureSize, static_cast<GLint>(textureAtlasSize));
             {
@@ -125,6 +229,7 @@ namespace djv
                 GL_NEAREST,
                 0));
             p.primitiveData.textureAtlasCount = _textureAtlasCount;
+            p.fontSystem = context->getSystemT<Font::FontSystem>();
 
             _imageFilterUpdate();
 
@@ -155,11 +260,29 @@ namespace djv
                     DJV_PRIVATE_PTR();
                     std::stringstream ss;
                     ss << "Primitives: " << p.primitivesCount << "\n";
+                    ss << "Draw calls: " << p.drawCallCount << "\n";
                     ss << "Texture atlas: " << std::fixed << p.textureAtlas->getPercentageUsed() << "%\n";
+                    const auto textureAtlasStats = p.textureAtlas->getStats();
+                    ss << "Texture atlas items: " << textureAtlasStats.itemCount << ", " <<
+                        textureAtlasStats.addCount << " added, " <<
+                        textureAtlasStats.evictCount << " evicted, " <<
+                        textureAtlasStats.compactCount << " compacted, " <<
+                        textureAtlasStats.uploadByteCount / Memory::megabyte << "MB uploaded\n";
                     ss << "Texture IDs: " << p.textureIDs.size() << "%\n";
                     ss << "Glyph texture IDs: " << p.glyphTextureIDs.size() << "\n";
                     ss << "Dynamic textures: " << p.dynamicTextures.size() << "\n";
-                    ss << "Dynamic texture cache: " << p.dynamicTextureCache.size() << "\n";
+                    ss << "Dynamic texture cache: " << p.dynamicTextureCache.getCount() << " textures, " <<
+                        p.dynamicTextureCache.getByteCount() / Memory::megabyte << "MB\n";
+#if !defined(DJV_GL_ES2)
+                    if (p.textureUploader)
+                    {
+                        ss << "Texture uploads: " << p.textureUploader->getCount() << "\n";
+                    }
+#endif // DJV_GL_ES2
+                    ss << "Tile cache: " << p.tileCache.getCount() << " tiles, " <<
+                        p.tileCache.getByteCount() / Memory::megabyte << "MB\n";
+                    ss << "Tiled images: " << p.tiledImages.size() << " images, " <<
+                        p.getTiledImageByteCount() / Memory::megabyte << "MB\n";
 #if !defined(DJV_GL_ES2)
                     ss << "Color space cache: " << p.colorSpaceCache.size() << "\n";
 #endif // DJV_GL_ES2
@@ -183,11 +306,17 @@ namespace djv
         }
 
         void Render::beginFrame(const Image::Size& size)
+        {
+            beginFrame(size, Math::BBox2f(0.F, 0.F, static_cast<float>(size.w), static_cast<float>(size.h)));
+        }
+
+        void Render::beginFrame(const Image::Size& size, const Math::BBox2f& region)
         {
             DJV_PRIVATE_PTR();
             _size = size;
-            _currentClipRect = Math::BBox2f(0.F, 0.F, static_cast<float>(size.w), static_cast<float>(size.h));
             p.viewport = Math::BBox2f(0.F, 0.F, static_cast<float>(size.w), static_cast<float>(size.h));
+            p.region = region.intersect(p.viewport);
+            _currentClipRect = p.region;
         }
 
         void Render::endFrame()
@@ -196,6 +325,37 @@ namespace djv
             
             p.primitivesCount = p.primitives.size();
 
+            if (auto fontSystem = p.fontSystem.lock())
+            {
+                // Add the glyphs from the font disk cache to the texture atlas
+                // so they are not uploaded one at a time as the user interface
+                // is first drawn. Leave room in the atlas for new glyphs and
+                // images.
+                const auto glyphs = fontSystem->takeDiskCacheGlyphs();
+                if (glyphs.size())
+                {
+                    const size_t textureSize = p.textureAtlas->getTextureSize();
+                    const float area = static_cast<float>(p.textureAtlas->getTextureCount() * textureSize * textureSize);
+                    float used = p.textureAtlas->getPercentageUsed() / 100.F * area;
+                    for (const auto& glyph : glyphs)
+                    {
+                        if (glyph->imageData && glyph->imageData->isValid())
+                        {
+                            const auto& size = glyph->imageData->getSize();
+                            used += static_cast<float>(size.w * size.h);
+                            if (used > area * textureAtlasPreloadMax)
+                                break;
+                            const auto uid = glyph->imageData->getUID();
+                            if (p.glyphTextureIDs.find(uid) == p.glyphTextureIDs.end())
+                            {
+                                GL::TextureAtlasItem item;
+                                p.glyphTextureIDs[uid] = p.textureAtlas->addItem(glyph->imageData, item);
+                            }
+                        }
+                    }
+                }
+            }
+
             if (!p.shader)
             {
                 p.shader = GL::Shader::create(p.vertexSource, p.getFragmentSource());
@@ -205,7 +365,6 @@ namespace djv
                 p.mvpLoc = glGetUniformLocation(program, "transform.mvp");
                 p.primitiveData.imageChannelsLoc = glGetUniformLocation(program, "imageChannels");
                 p.primitiveData.colorModeLoc = glGetUniformLocation(program, "colorMode");
-                p.primitiveData.colorLoc = glGetUniformLocation(program, "color");
 #if !defined(DJV_GL_ES2)
                 p.primitiveData.colorSpaceLoc = glGetUniformLocation(program, "colorSpace");
                 p.primitiveData.colorSpaceSamplerLoc = glGetUniformLocation(program, "colorSpaceSampler");
@@ -242,11 +401,12 @@ namespace djv
                 static_cast<GLint>(p.viewport.min.y),
                 static_cast<GLsizei>(p.viewport.w()),
                 static_cast<GLsizei>(p.viewport.h()));
+            const Math::BBox2f region = flip(p.region, _size);
             glScissor(
-                static_cast<GLint>(p.viewport.min.x),
-                static_cast<GLint>(p.viewport.min.y),
-                static_cast<GLsizei>(p.viewport.w()),
-                static_cast<GLsizei>(p.viewport.h()));
+                static_cast<GLint>(region.min.x),
+                static_cast<GLint>(region.min.y),
+                static_cast<GLsizei>(region.w()),
+                static_cast<GLsizei>(region.h()));
             glClearColor(0.F, 0.F, 0.F, 0.F);
             glClear(GL_COLOR_BUFFER_BIT);
 
@@ -265,22 +425,48 @@ namespace djv
                 glBindTexture(GL_TEXTURE_2D, atlasTextures[i]);
             }
 
-            const size_t vertexByteCount = GL::getVertexByteCount(GL::VBOType::Pos2_F32_UV_U16);
+            const size_t vertexByteCount = GL::getVertexByteCount(vboType);
             if (!p.vbo || p.vboDataSize / vertexByteCount > p.vbo->getSize())
             {
-                p.vbo = GL::VBO::create(p.vboDataSize / vertexByteCount, GL::VBOType::Pos2_F32_UV_U16);
+                p.vbo = GL::VBO::create(p.vboDataSize / vertexByteCount, vboType);
                 p.vao = GL::VAO::create(p.vbo->getType(), p.vbo->getID());
             }
             p.vbo->copy(p.vboData, 0, p.vboDataSize);
             p.vao->bind();
 
+            // Consecutive primitives that share the same state are merged
+            // into a single draw call. Primitives are not re-ordered since
+            // that would change the results of blending.
+            p.primitiveData.colorMode = -1;
+            p.primitiveData.textureSampler = -1;
+            p.drawCallCount = 0;
             Math::BBox2f currentClipRect(0.F, 0.F, 0.F, 0.F);
             AlphaBlend currentAlphaBlend = AlphaBlend::Straight;
             bool currentTextLCDRendering = false;
             glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
             glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-            for (const auto& primitive : p.primitives)
+            const size_t primitivesSize = p.primitives.size();
+            size_t i = 0;
+            while (i < primitivesSize)
             {
+                Primitive* primitive = p.primitives[i];
+                size_t vaoSize = primitive->vaoSize;
+                const Primitive* prev = primitive;
+                for (++i; i < primitivesSize; ++i)
+                {
+                    const Primitive* next = p.primitives[i];
+                    if (!prev->canBatch(*next) || !next->canBatch(*prev))
+                    {
+                        break;
+                    }
+                    vaoSize += next->vaoSize;
+                    prev = next;
+                }
+                if (!vaoSize)
+                {
+                    continue;
+                }
+
                 const Math::BBox2f clipRect = flip(primitive->clipRect, _size);
                 if (clipRect != currentClipRect)
                 {
@@ -319,36 +505,62 @@ namespace djv
                 primitive->bind(p.primitiveData, p.shader);
                 if (currentTextLCDRendering)
                 {
-                    p.shader->setUniform(p.primitiveData.colorModeLoc, static_cast<int>(ColorMode::ColorWithTextureAlphaR));
+                    setColorMode(p.primitiveData, p.shader, ColorMode::ColorWithTextureAlphaR);
                     glColorMask(GL_TRUE, GL_FALSE, GL_FALSE, GL_TRUE);
-                    p.vao->draw(primitive->type, primitive->vaoOffset, primitive->vaoSize);
-                    p.shader->setUniform(p.primitiveData.colorModeLoc, static_cast<int>(ColorMode::ColorWithTextureAlphaG));
+                    p.vao->draw(primitive->type, primitive->vaoOffset, vaoSize);
+                    setColorMode(p.primitiveData, p.shader, ColorMode::ColorWithTextureAlphaG);
                     glColorMask(GL_FALSE, GL_TRUE, GL_FALSE, GL_FALSE);
-                    p.vao->draw(primitive->type, primitive->vaoOffset, primitive->vaoSize);
-                    p.shader->setUniform(p.primitiveData.colorModeLoc, static_cast<int>(ColorMode::ColorWithTextureAlphaB));
+                    p.vao->draw(primitive->type, primitive->vaoOffset, vaoSize);
+                    setColorMode(p.primitiveData, p.shader, ColorMode::ColorWithTextureAlphaB);
                     glColorMask(GL_FALSE, GL_FALSE, GL_TRUE, GL_FALSE);
-                    p.vao->draw(primitive->type, primitive->vaoOffset, primitive->vaoSize);
+                    p.vao->draw(primitive->type, primitive->vaoOffset, vaoSize);
+                    p.drawCallCount += 3;
                 }
                 else
                 {
-                    p.vao->draw(primitive->type, primitive->vaoOffset, primitive->vaoSize);
+                    p.vao->draw(primitive->type, primitive->vaoOffset, vaoSize);
+                    ++p.drawCallCount;
                 }
             }
             glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 
             _clipRects.clear();
             p.primitives.clear();
+            p.primitivePool.reset();
+            p.textPrimitivePool.reset();
+            p.imagePrimitivePool.reset();
+            p.shadowPrimitivePool.reset();
+            p.texturePrimitivePool.reset();
             p.vboDataSize = 0;
-            while (p.dynamicTextureCache.size() > dynamicTextureCacheMax)
-            {
-                auto texture = p.dynamicTextureCache.begin();
-                p.dynamicTextures.emplace_back(texture->second);
-                p.dynamicTextureCache.erase(texture);
-            }
             while (p.dynamicTextures.size() > dynamicTextureCount)
             {
                 p.dynamicTextures.pop_back();
             }
+            // Remove the least recently used tiled images that are over the
+            // budget, the images drawn in this frame are kept.
+            size_t tiledImageByteCount = p.getTiledImageByteCount();
+            while (tiledImageByteCount > tiledImageCacheMaxByteCount)
+            {
+                auto oldest = p.tiledImages.end();
+                for (auto i = p.tiledImages.begin(); i != p.tiledImages.end(); ++i)
+                {
+                    if (i->second.getFrame() != p.frame &&
+                        (oldest == p.tiledImages.end() || i->second.getFrame() < oldest->second.getFrame()))
+                    {
+                        oldest = i;
+                    }
+                }
+                if (oldest == p.tiledImages.end())
+                    break;
+                tiledImageByteCount -= oldest->second.getByteCount();
+                p.tiledImages.erase(oldest);
+            }
+            ++p.frame;
+
+            // Compact the texture atlas between frames, the items are looked
+            // up again when the next frame is drawn. Only a limited number of
+            // items are copied each frame so a large texture does not stall.
+            p.textureAtlas->compact();
 #if !defined(DJV_GL_ES2)
             while (p.colorSpaceCache.size() > colorSpaceCacheMax)
             {
@@ -437,21 +649,18 @@ namespace djv
                 }
                 if (bbox.intersects(_currentClipRect))
                 {
-                    auto primitive = std::make_shared<Primitive>();
+                    // Draw the line segments as triangles instead of a triangle
+                    // strip so they can be batched with other primitives.
+                    auto primitive = p.primitivePool.get();
                     primitive->clipRect = _currentClipRect;
-                    primitive->color[0] = _finalColor[0];
-                    primitive->color[1] = _finalColor[1];
-                    primitive->color[2] = _finalColor[2];
-                    primitive->color[3] = _finalColor[3];
-                    primitive->type = GL_TRIANGLE_STRIP;
-                    primitive->vaoOffset = p.vboDataSize / GL::getVertexByteCount(GL::VBOType::Pos2_F32_UV_U16);
-                    primitive->vaoSize = ptsSize;
+                    primitive->vaoOffset = p.vboDataSize / GL::getVertexByteCount(vboType);
+                    primitive->vaoSize = (size - 1) * 6;
 
                     const size_t vboDataOffset = p.vboDataSize;
-                    p.vboDataSizeUpdate(ptsSize);
+                    p.vboDataSizeUpdate(primitive->vaoSize, _finalColor);
                     const glm::vec2* pPts = pts.data();
                     VBOVertex* pData = reinterpret_cast<VBOVertex*>(&p.vboData[vboDataOffset]);
-                    for (size_t i = 0; i < size; ++i, pPts += 2)
+                    for (size_t i = 0; i < size - 1; ++i, pPts += 2)
                     {
                         pData->vx = pPts[0].x;
                         pData->vy = pPts[0].y;
@@ -459,6 +668,18 @@ namespace djv
                         pData->vx = pPts[1].x;
                         pData->vy = pPts[1].y;
                         ++pData;
+                        pData->vx = pPts[2].x;
+                        pData->vy = pPts[2].y;
+                        ++pData;
+                        pData->vx = pPts[2].x;
+                        pData->vy = pPts[2].y;
+                        ++pData;
+                        pData->vx = pPts[1].x;
+                        pData->vy = pPts[1].y;
+                        ++pData;
+                        pData->vx = pPts[3].x;
+                        pData->vy = pPts[3].y;
+                        ++pData;
                     }
 
                     p.primitives.emplace_back(primitive);
@@ -474,13 +695,9 @@ namespace djv
         void Render::drawRects(const std::vector<Math::BBox2f>& value)
         {
             DJV_PRIVATE_PTR();
-            auto primitive = std::make_shared<Primitive>();
+            auto primitive = p.primitivePool.get();
             primitive->clipRect = _currentClipRect;
-            primitive->color[0] = _finalColor[0];
-            primitive->color[1] = _finalColor[1];
-            primitive->color[2] = _finalColor[2];
-            primitive->color[3] = _finalColor[3];
-            primitive->vaoOffset = p.vboDataSize / GL::getVertexByteCount(GL::VBOType::Pos2_F32_UV_U16);
+            primitive->vaoOffset = p.vboDataSize / GL::getVertexByteCount(vboType);
             primitive->vaoSize = 0;
 
             for (const auto& i : value)
@@ -490,7 +707,7 @@ namespace djv
                     primitive->vaoSize += 6;
 
                     const size_t vboDataOffset = p.vboDataSize;
-                    p.vboDataSizeUpdate(6);
+                    p.vboDataSizeUpdate(6, _finalColor);
                     VBOVertex* pData = reinterpret_cast<VBOVertex*>(&p.vboData[vboDataOffset]);
                     pData->vx = i.min.x;
                     pData->vy = i.min.y;
@@ -521,17 +738,13 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (rect.intersects(_currentClipRect))
             {
-                auto primitive = std::make_shared<Primitive>();
+                auto primitive = p.primitivePool.get();
                 primitive->clipRect = _currentClipRect;
-                primitive->color[0] = _finalColor[0];
-                primitive->color[1] = _finalColor[1];
-                primitive->color[2] = _finalColor[2];
-                primitive->color[3] = _finalColor[3];
-                primitive->vaoOffset = p.vboDataSize / GL::getVertexByteCount(GL::VBOType::Pos2_F32_UV_U16);
+                primitive->vaoOffset = p.vboDataSize / GL::getVertexByteCount(vboType);
                 primitive->vaoSize = 3 * 2 + facets * 2 * 3;
 
                 const size_t vboDataOffset = p.vboDataSize;
-                p.vboDataSizeUpdate(primitive->vaoSize);
+                p.vboDataSizeUpdate(primitive->vaoSize, _finalColor);
                 const float h = rect.h();
                 const float radius = h / 2.F;
                 VBOVertex* pData = reinterpret_cast<VBOVertex*>(&p.vboData[vboDataOffset]);
@@ -598,19 +811,15 @@ namespace djv
             const Math::BBox2f rect(pos.x - radius, pos.y - radius, radius * 2.F, radius * 2.F);
             if (rect.intersects(_currentClipRect))
             {
-                auto primitive = std::make_shared<Primitive>();
+                auto primitive = p.primitivePool.get();
                 primitive->clipRect = _currentClipRect;
-                primitive->color[0] = _finalColor[0];
-                primitive->color[1] = _finalColor[1];
-                primitive->color[2] = _finalColor[2];
-                primitive->color[3] = _finalColor[3];
                 //! \todo Implement me!
                 //primitive->type = GL_TRIANGLE_FAN;
-                primitive->vaoOffset = p.vboDataSize / GL::getVertexByteCount(GL::VBOType::Pos2_F32_UV_U16);
+                primitive->vaoOffset = p.vboDataSize / GL::getVertexByteCount(vboType);
                 primitive->vaoSize = 3 * facets;
 
                 const size_t vboDataOffset = p.vboDataSize;
-                p.vboDataSizeUpdate(3 * facets);
+                p.vboDataSizeUpdate(3 * facets, _finalColor);
                 VBOVertex* pData = reinterpret_cast<VBOVertex*>(&p.vboData[vboDataOffset]);
                 for (size_t i = 0; i < facets * 3; i += 3)
                 {
@@ -663,6 +872,24 @@ namespace djv
             p.drawImage(image, pos, options, ColorMode::ColorWithTextureAlpha, _getCurrentTransform(), _currentClipRect, _finalColor);
         }
 
+        void Render::uploadImage(const std::shared_ptr<Image::Data>& image)
+        {
+#if !defined(DJV_GL_ES2)
+            DJV_PRIVATE_PTR();
+            if (p.textureUploader &&
+                image &&
+                image->getWidth() <= p.maxTextureSize &&
+                image->getHeight() <= p.maxTextureSize &&
+                !p.dynamicTextureCache.contains(image->getUID()))
+            {
+                p.textureUploader->add(
+                    image,
+                    toGL(p.imageFilterOptions.min),
+                    toGL(p.imageFilterOptions.mag));
+            }
+#endif // DJV_GL_ES2
+        }
+
         void Render::setTextLCDRendering(bool value)
         {
             _p->textLCDRendering = value;
@@ -672,7 +899,7 @@ namespace djv
         {
             DJV_PRIVATE_PTR();
 
-            std::shared_ptr<TextPrimitive> primitive;
+            TextPrimitive* primitive = nullptr;
             float x = 0.F;
             int32_t rsbDeltaPrev = 0;
             uint8_t textureIndex = 0;
@@ -714,14 +941,10 @@ namespace djv
 
                             if (!primitive || item.textureIndex != textureIndex)
                             {
-                                primitive = std::make_shared<TextPrimitive>();
+                                primitive = p.textPrimitivePool.get();
                                 primitive->clipRect = _currentClipRect;
-                                primitive->color[0] = _finalColor[0];
-                                primitive->color[1] = _finalColor[1];
-                                primitive->color[2] = _finalColor[2];
-                                primitive->color[3] = _finalColor[3];
                                 primitive->atlasIndex = item.textureIndex;
-                                primitive->vaoOffset = p.vboDataSize / GL::getVertexByteCount(GL::VBOType::Pos2_F32_UV_U16);
+                                primitive->vaoOffset = p.vboDataSize / GL::getVertexByteCount(vboType);
                                 primitive->vaoSize = 0;
                                 primitive->textLCDRendering = p.textLCDRendering;
                                 p.primitives.push_back(primitive);
@@ -730,7 +953,7 @@ namespace djv
 
                             primitive->vaoSize += 6;
                             const size_t vboDataOffset = p.vboDataSize;
-                            p.vboDataSizeUpdate(6);
+                            p.vboDataSizeUpdate(6, _finalColor);
                             VBOVertex* pData = reinterpret_cast<VBOVertex*>(&p.vboData[vboDataOffset]);
                             pData->vx = bbox.min.x;
                             pData->vy = bbox.min.y;
@@ -774,14 +997,10 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (value.intersects(_currentClipRect))
             {
-                auto primitive = std::make_shared<ShadowPrimitive>();
+                auto primitive = p.shadowPrimitivePool.get();
                 primitive->clipRect = _currentClipRect;
-                primitive->color[0] = _finalColor[0];
-                primitive->color[1] = _finalColor[1];
-                primitive->color[2] = _finalColor[2];
-                primitive->color[3] = _finalColor[3];
                 primitive->type = GL_TRIANGLE_STRIP;
-                primitive->vaoOffset = p.vboDataSize / GL::getVertexByteCount(GL::VBOType::Pos2_F32_UV_U16);
+                primitive->vaoOffset = p.vboDataSize / GL::getVertexByteCount(vboType);
                 primitive->vaoSize = 4;
 
                 static const uint16_t u[][4] =
@@ -794,7 +1013,7 @@ namespace djv
                 };
 
                 const size_t vboDataOffset = p.vboDataSize;
-                p.vboDataSizeUpdate(4);
+                p.vboDataSizeUpdate(4, _finalColor);
                 VBOVertex* pData = reinterpret_cast<VBOVertex*>(&p.vboData[vboDataOffset]);
                 pData->vx = value.min.x;
                 pData->vy = value.min.y;
@@ -821,17 +1040,13 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (value.intersects(_currentClipRect))
             {
-                auto primitive = std::make_shared<ShadowPrimitive>();
+                auto primitive = p.shadowPrimitivePool.get();
                 primitive->clipRect = _currentClipRect;
-                primitive->color[0] = _finalColor[0];
-                primitive->color[1] = _finalColor[1];
-                primitive->color[2] = _finalColor[2];
-                primitive->color[3] = _finalColor[3];
-                primitive->vaoOffset = p.vboDataSize / GL::getVertexByteCount(GL::VBOType::Pos2_F32_UV_U16);
+                primitive->vaoOffset = p.vboDataSize / GL::getVertexByteCount(vboType);
                 primitive->vaoSize = 5 * 2 * 3 + 4 * facets * 3;
 
                 const size_t vboDataOffset = p.vboDataSize;
-                p.vboDataSizeUpdate(primitive->vaoSize);
+                p.vboDataSizeUpdate(primitive->vaoSize, _finalColor);
                 VBOVertex* pData = reinterpret_cast<VBOVertex*>(&p.vboData[vboDataOffset]);
 
                 // Center.
@@ -1057,20 +1272,16 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (value.intersects(_currentClipRect))
             {
-                auto primitive = std::make_shared<TexturePrimitive>();
+                auto primitive = p.texturePrimitivePool.get();
                 primitive->clipRect = _currentClipRect;
-                primitive->color[0] = _finalColor[0];
-                primitive->color[1] = _finalColor[1];
-                primitive->color[2] = _finalColor[2];
-                primitive->color[3] = _finalColor[3];
                 primitive->type = GL_TRIANGLE_STRIP;
-                primitive->vaoOffset = p.vboDataSize / GL::getVertexByteCount(GL::VBOType::Pos2_F32_UV_U16);
+                primitive->vaoOffset = p.vboDataSize / GL::getVertexByteCount(vboType);
                 primitive->vaoSize = 4;
                 primitive->textureID = textureID;
                 primitive->target = target;
 
                 const size_t vboDataOffset = p.vboDataSize;
-                p.vboDataSizeUpdate(4);
+                p.vboDataSizeUpdate(4, _finalColor);
                 VBOVertex* pData = reinterpret_cast<VBOVertex*>(&p.vboData[vboDataOffset]);
                 pData->vx = value.min.x;
                 pData->vy = value.min.y;
@@ -1101,6 +1312,11 @@ namespace djv
             return _p->primitivesCount;
         }
 
+        size_t Render::getDrawCallCount() const
+        {
+            return _p->drawCallCount;
+        }
+
         float Render::getTextureAtlasPercentage() const
         {
             return _p->textureAtlas->getPercentageUsed();
@@ -1108,7 +1324,7 @@ namespace djv
 
         size_t Render::getDynamicTextureCount() const
         {
-            return _p->dynamicTextureCache.size();
+            return _p->dynamicTextureCache.getCount();
         }
 
         size_t Render::getVBOSize() const
@@ -1121,6 +1337,13 @@ namespace djv
             DJV_PRIVATE_PTR();
             p.dynamicTextures.clear();
             p.dynamicTextureCache.clear();
+            p.tileCache.clear();
+#if !defined(DJV_GL_ES2)
+            if (p.textureUploader)
+            {
+                p.textureUploader->clear();
+            }
+#endif // DJV_GL_ES2
             for (size_t i = 0; i < dynamicTextureCount; ++i)
             {
                 p.dynamicTextures.emplace_back(
@@ -1131,14 +1354,151 @@ namespace djv
             }
         }
 
-        void Render::Private::vboDataSizeUpdate(size_t value)
+        void Render::Private::vboDataSizeUpdate(size_t value, const float color[4])
         {
-            const size_t vertexByteCount = GL::getVertexByteCount(GL::VBOType::Pos2_F32_UV_U16);
+            const size_t vertexByteCount = GL::getVertexByteCount(vboType);
+            const size_t vboDataOffset = vboDataSize;
             vboDataSize += value * vertexByteCount;
             if (vboDataSize > vboData.size())
             {
                 vboData.resize(vboDataSize);
             }
+            const uint8_t c[4] =
+            {
+                static_cast<uint8_t>(Math::clamp(static_cast<int>(color[0] * 255.F), 0, 255)),
+                static_cast<uint8_t>(Math::clamp(static_cast<int>(color[1] * 255.F), 0, 255)),
+                static_cast<uint8_t>(Math::clamp(static_cast<int>(color[2] * 255.F), 0, 255)),
+                static_cast<uint8_t>(Math::clamp(static_cast<int>(color[3] * 255.F), 0, 255))
+            };
+            VBOVertex* pData = reinterpret_cast<VBOVertex*>(&vboData[vboDataOffset]);
+            for (size_t i = 0; i < value; ++i, ++pData)
+            {
+                pData->cr = c[0];
+                pData->cg = c[1];
+                pData->cb = c[2];
+                pData->ca = c[3];
+            }
+        }
+
+        ImagePrimitive* Render::Private::createImagePrimitive(
+            const Image::Info& info,
+            const ImageOptions& options,
+            ColorMode colorMode,
+            const Math::BBox2f& currentClipRect)
+        {
+            auto primitive = imagePrimitivePool.get();
+            primitive->clipRect = currentClipRect;
+            primitive->imageChannels = Image::getChannels(info.type);
+            primitive->colorMode = colorMode;
+            primitive->imageChannelDisplay = options.channelDisplay;
+            primitive->alphaBlend = options.alphaBlend;
+            primitive->colorMatrixEnabled = options.colorEnabled && options.color != ImageColor();
+            if (primitive->colorMatrixEnabled)
+            {
+                primitive->colorMatrix = colorMatrix(options.color);
+            }
+            primitive->colorInvert = options.colorEnabled && options.color.invert;
+            primitive->levels = options.levels;
+            primitive->levelsEnabled = options.levelsEnabled && options.levels != ImageLevels();
+            primitive->exposureEnabled = options.exposureEnabled;
+            if (primitive->exposureEnabled)
+            {
+                primitive->exposureV = powf(
+                    2.F,
+                    options.exposure.exposure + 2.47393F);
+                primitive->exposureD = options.exposure.defog;
+                primitive->exposureK = powf(
+                    2.F,
+                    options.exposure.kneeLow);
+                primitive->exposureF = knee2(
+                    powf(2.F, options.exposure.kneeHigh) -
+                    primitive->exposureK,
+                    powf(2.F, 3.5F) - primitive->exposureK);
+            }
+            primitive->softClip = options.softClipEnabled ? options.softClip : 0.F;
+            primitive->imageCache = options.cache;
+#if !defined(DJV_GL_ES2)
+            if (options.colorSpace.isValid())
+            {
+                ColorSpaceData colorSpaceData;
+                const auto i = colorSpaceCache.find(options.colorSpace);
+                if (i != colorSpaceCache.end())
+                {
+                    colorSpaceData = i->second;
+                }
+                else
+                {
+                    try
+                    {
+                        colorSpaceData.id = colorSpaceID++;
+                        colorSpaceData.lut3D.reset(new LUT3D);
+                        auto config = _OCIO::GetCurrentConfig();
+                        auto processor = config->getProcessor(options.colorSpace.input.c_str(), options.colorSpace.output.c_str());
+                        _OCIO::GpuShaderDesc shaderDesc;
+                        shaderDesc.setLanguage(_OCIO::GPU_LANGUAGE_GLSL_1_3);
+                        std::stringstream ss;
+                        ss << "colorSpace" << colorSpaceData.id;
+                        shaderDesc.setFunctionName(ss.str().c_str());
+                        shaderDesc.setLut3DEdgeLen(colorSpaceData.lut3D->getEdgeLen());
+                        colorSpaceData.shaderSource = processor->getGpuShaderText(shaderDesc);
+                        size_t index = colorSpaceData.shaderSource.find("texture3D");
+                        if (index != std::string::npos)
+                        {
+                            colorSpaceData.shaderSource.replace(index, std::string("texture3D").size(), "texture");
+                        }
+                        auto data = colorSpaceData.lut3D->getData();
+                        processor->getGpuLut3D(data, shaderDesc);
+                        colorSpaceData.lut3D->copy();
+                        colorSpaceCache[options.colorSpace] = colorSpaceData;
+                        shader.reset();
+                    }
+                    catch (const std::exception& e)
+                    {
+                        system->_log(e.what());
+                    }
+                }
+                primitive->colorSpace = colorSpaceData.id;
+                primitive->colorSpaceTextureID = colorSpaceData.lut3D ? colorSpaceData.lut3D->getID() : 0;
+            }
+#endif // DJV_GL_ES2
+            return primitive;
+        }
+
+        void Render::Private::addImageVertices(
+            ImagePrimitive* primitive,
+            const glm::vec3 pts[4],
+            const float textureU[2],
+            const float textureV[2],
+            const float finalColor[4])
+        {
+            primitive->type = GL_TRIANGLE_STRIP;
+            primitive->vaoOffset = vboDataSize / GL::getVertexByteCount(vboType);
+            primitive->vaoSize = 4;
+
+            const size_t vboDataOffset = vboDataSize;
+            vboDataSizeUpdate(4, finalColor);
+            VBOVertex* pData = reinterpret_cast<VBOVertex*>(&vboData[vboDataOffset]);
+            pData->vx = pts[0].x;
+            pData->vy = pts[0].y;
+            pData->tx = static_cast<uint16_t>(textureU[0] * 65535.F);
+            pData->ty = static_cast<uint16_t>(textureV[0] * 65535.F);
+            ++pData;
+            pData->vx = pts[1].x;
+            pData->vy = pts[1].y;
+            pData->tx = static_cast<uint16_t>(textureU[1] * 65535.F);
+            pData->ty = static_cast<uint16_t>(textureV[0] * 65535.F);
+            ++pData;
+            pData->vx = pts[3].x;
+            pData->vy = pts[3].y;
+            pData->tx = static_cast<uint16_t>(textureU[0] * 65535.F);
+            pData->ty = static_cast<uint16_t>(textureV[1] * 65535.F);
+            ++pData;
+            pData->vx = pts[2].x;
+            pData->vy = pts[2].y;
+            pData->tx = static_cast<uint16_t>(textureU[1] * 65535.F);
+            pData->ty = static_cast<uint16_t>(textureV[1] * 65535.F);
+
+            primitives.push_back(primitive);
         }
 
         void Render::Private::drawImage(
@@ -1152,6 +1512,15 @@ namespace djv
         {
             const auto& info = image->getInfo();
 
+            // Images that are too large for a single texture are drawn with tiles.
+            if (ImageCache::Tiled == options.cache ||
+                (ImageCache::Dynamic == options.cache &&
+                    (info.size.w > maxTextureSize || info.size.h > maxTextureSize)))
+            {
+                drawTiledImage(image, pos, options, colorMode, currentTransform, currentClipRect, finalColor);
+                return;
+            }
+
             glm::vec3 pts[4];
             pts[0].x = pos.x;
             pts[0].y = pos.y;
@@ -1170,54 +1539,9 @@ namespace djv
                 i = currentTransform * i;
             }
 
-            Math::BBox2f bbox;
-            bbox.min = pts[0];
-            bbox.max = pts[0];
-            for (size_t i = 1; i < 4; ++i)
-            {
-                bbox.min.x = std::min(bbox.min.x, pts[i].x);
-                bbox.max.x = std::max(bbox.max.x, pts[i].x);
-                bbox.min.y = std::min(bbox.min.y, pts[i].y);
-                bbox.max.y = std::max(bbox.max.y, pts[i].y);
-            }
-
-            if (bbox.intersects(currentClipRect))
+            if (getBBox(pts).intersects(currentClipRect))
             {
-                auto primitive = std::make_shared<ImagePrimitive>();
-                primitive->clipRect = currentClipRect;
-                primitive->imageChannels = Image::getChannels(info.type);
-                primitive->colorMode = colorMode;
-                primitive->color[0] = finalColor[0];
-                primitive->color[1] = finalColor[1];
-                primitive->color[2] = finalColor[2];
-                primitive->color[3] = finalColor[3];
-                primitive->imageChannelDisplay = options.channelDisplay;
-                primitive->alphaBlend = options.alphaBlend;
-                primitive->colorMatrixEnabled = options.colorEnabled && options.color != ImageColor();
-                if (primitive->colorMatrixEnabled)
-                {
-                    primitive->colorMatrix = colorMatrix(options.color);
-                }
-                primitive->colorInvert = options.colorEnabled && options.color.invert;
-                primitive->levels = options.levels;
-                primitive->levelsEnabled = options.levelsEnabled && options.levels != ImageLevels();
-                primitive->exposureEnabled = options.exposureEnabled;
-                if (primitive->exposureEnabled)
-                {
-                    primitive->exposureV = powf(
-                        2.F,
-                        options.exposure.exposure + 2.47393F);
-                    primitive->exposureD = options.exposure.defog;
-                    primitive->exposureK = powf(
-                        2.F,
-                        options.exposure.kneeLow);
-                    primitive->exposureF = knee2(
-                        powf(2.F, options.exposure.kneeHigh) -
-                        primitive->exposureK,
-                        powf(2.F, 3.5F) - primitive->exposureK);
-                }
-                primitive->softClip = options.softClipEnabled ? options.softClip : 0.F;
-                primitive->imageCache = options.cache;
+                auto primitive = createImagePrimitive(info, options, colorMode, currentClipRect);
                 float textureU[2] = { 0.F, 0.F };
                 float textureV[2] = { 0.F, 0.F };
                 const UID uid = image->getUID();
@@ -1261,14 +1585,22 @@ namespace djv
                 }
                 case ImageCache::Dynamic:
                 {
-                    const auto i = dynamicTextureCache.find(uid);
-                    if (i != dynamicTextureCache.end())
+                    auto texture = dynamicTextureCache.get(uid, frame);
+#if !defined(DJV_GL_ES2)
+                    if (!texture && textureUploader)
                     {
-                        primitive->textureID = i->second->getID();
+                        texture = textureUploader->get(uid);
+                        if (texture)
+                        {
+                            for (const auto& i : dynamicTextureCache.add(uid, texture, frame))
+                            {
+                                dynamicTextures.push_back(i);
+                            }
+                        }
                     }
-                    else
+#endif // DJV_GL_ES2
+                    if (!texture)
                     {
-                        std::shared_ptr<GL::Texture> texture;
                         if (dynamicTextures.size())
                         {
                             texture = dynamicTextures.back();
@@ -1280,9 +1612,12 @@ namespace djv
                             texture = GL::Texture::create(image->getInfo(), GL_LINEAR, GL_NEAREST);
                         }
                         texture->copy(*image);
-                        dynamicTextureCache[uid] = texture;
-                        primitive->textureID = texture->getID();
+                        for (const auto& i : dynamicTextureCache.add(uid, texture, frame))
+                        {
+                            dynamicTextures.push_back(i);
+                        }
                     }
+                    primitive->textureID = texture->getID();
                     if (info.layout.mirror.x)
                     {
                         textureU[0] = 1.F;
@@ -1317,79 +1652,133 @@ namespace djv
                     textureV[0] = 1.F - textureV[0];
                     textureV[1] = 1.F - textureV[1];
                 }
-#if !defined(DJV_GL_ES2)
-                if (options.colorSpace.isValid())
+                addImageVertices(primitive, pts, textureU, textureV, finalColor);
+            }
+        }
+
+        void Render::Private::drawTiledImage(
+            const std::shared_ptr<Image::Data>& image,
+            const glm::vec2& pos,
+            const ImageOptions& options,
+            ColorMode colorMode,
+            const glm::mat3x3& currentTransform,
+            const Math::BBox2f& currentClipRect,
+            const float finalColor[4])
+        {
+            const auto& info = image->getInfo();
+            const UID uid = image->getUID();
+            auto i = tiledImages.find(uid);
+            if (i == tiledImages.end())
+            {
+                i = tiledImages.insert(std::make_pair(uid, TiledImage(image))).first;
+            }
+            auto& tiledImage = i->second;
+            tiledImage.setFrame(frame);
+
+            // Use the smallest mipmap level that still has at least one
+            // pixel for each pixel on the screen.
+            const float scale = sqrtf(fabsf(
+                currentTransform[0][0] * currentTransform[1][1] -
+                currentTransform[1][0] * currentTransform[0][1]));
+            size_t level = 0;
+            while (level + 1 < tiledImage.getLevelCount() &&
+                scale * static_cast<float>(1 << (level + 1)) <= 1.F)
+            {
+                ++level;
+            }
+            const auto& levelData = tiledImage.getLevel(level);
+            const uint16_t levelW = levelData->getWidth();
+            const uint16_t levelH = levelData->getHeight();
+            const float levelScale = static_cast<float>(1 << level);
+
+            const bool mirrorX = info.layout.mirror.x != options.mirror.x;
+            const bool mirrorY = info.layout.mirror.y != options.mirror.y;
+            for (size_t y = 0; y < levelH; y += tileSize)
+            {
+                const uint16_t tileH = static_cast<uint16_t>(std::min(static_cast<size_t>(tileSize), levelH - y));
+                const float y0 = y * levelScale;
+                const float y1 = std::min((y + tileH) * levelScale, static_cast<float>(info.size.h));
+                for (size_t x = 0; x < levelW; x += tileSize)
                 {
-                    ColorSpaceData colorSpaceData;
-                    const auto i = colorSpaceCache.find(options.colorSpace);
-                    if (i != colorSpaceCache.end())
+                    const uint16_t tileW = static_cast<uint16_t>(std::min(static_cast<size_t>(tileSize), levelW - x));
+                    const float x0 = x * levelScale;
+                    const float x1 = std::min((x + tileW) * levelScale, static_cast<float>(info.size.w));
+
+                    // Find the position of the tile on the screen.
+                    const float dx0 = pos.x + (mirrorX ? (info.size.w - x1) : x0);
+                    const float dx1 = pos.x + (mirrorX ? (info.size.w - x0) : x1);
+                    const float dy0 = pos.y + (mirrorY ? (info.size.h - y1) : y0);
+                    const float dy1 = pos.y + (mirrorY ? (info.size.h - y0) : y1);
+                    glm::vec3 pts[4];
+                    pts[0] = currentTransform * glm::vec3(dx0, dy0, 1.F);
+                    pts[1] = currentTransform * glm::vec3(dx1, dy0, 1.F);
+                    pts[2] = currentTransform * glm::vec3(dx1, dy1, 1.F);
+                    pts[3] = currentTransform * glm::vec3(dx0, dy1, 1.F);
+                    if (!getBBox(pts).intersects(currentClipRect))
+                        continue;
+
+                    // Get the tile texture, uploading it if it is not in the cache.
+                    TileKey key;
+                    key.uid = uid;
+                    key.level = static_cast<uint8_t>(level);
+                    key.x = static_cast<uint16_t>(x / tileSize);
+                    key.y = static_cast<uint16_t>(y / tileSize);
+                    auto texture = tileCache.get(key, frame);
+                    if (!texture)
                     {
-                        colorSpaceData = i->second;
+                        const auto tileData = getTileData(
+                            *levelData,
+                            static_cast<uint16_t>(x),
+                            static_cast<uint16_t>(y),
+                            tileW,
+                            tileH);
+                        texture = GL::Texture::create(
+                            tileData->getInfo(),
+                            toGL(imageFilterOptions.min),
+                            toGL(imageFilterOptions.mag));
+                        texture->copy(*tileData);
+                        tileCache.add(key, texture, frame);
                     }
-                    else
+
+                    auto primitive = createImagePrimitive(info, options, colorMode, currentClipRect);
+                    primitive->imageCache = ImageCache::Tiled;
+                    primitive->textureID = texture->getID();
+
+                    // The tile textures have a border of one pixel so that
+                    // filtering is continuous across the tiles.
+                    const float textureW = static_cast<float>(tileW + 2);
+                    const float textureH = static_cast<float>(tileH + 2);
+                    float textureU[2] =
                     {
-                        try
-                        {
-                            colorSpaceData.id = colorSpaceID++;
-                            colorSpaceData.lut3D.reset(new LUT3D);
-                            auto config = _OCIO::GetCurrentConfig();
-                            auto processor = config->getProcessor(options.colorSpace.input.c_str(), options.colorSpace.output.c_str());
-                            _OCIO::GpuShaderDesc shaderDesc;
-                            shaderDesc.setLanguage(_OCIO::GPU_LANGUAGE_GLSL_1_3);
-                            std::stringstream ss;
-                            ss << "colorSpace" << colorSpaceData.id;
-                            shaderDesc.setFunctionName(ss.str().c_str());
-                            shaderDesc.setLut3DEdgeLen(colorSpaceData.lut3D->getEdgeLen());
-                            colorSpaceData.shaderSource = processor->getGpuShaderText(shaderDesc);
-                            size_t index = colorSpaceData.shaderSource.find("texture3D");
-                            if (index != std::string::npos)
-                            {
-                                colorSpaceData.shaderSource.replace(index, std::string("texture3D").size(), "texture");
-                            }
-                            auto data = colorSpaceData.lut3D->getData();
-                            processor->getGpuLut3D(data, shaderDesc);
-                            colorSpaceData.lut3D->copy();
-                            colorSpaceCache[options.colorSpace] = colorSpaceData;
-                            shader.reset();
-                        }
-                        catch (const std::exception& e)
-                        {
-                            system->_log(e.what());
-                        }
+                        1.F / textureW,
+                        (1.F + x1 / levelScale - x) / textureW
+                    };
+                    float textureV[2] =
+                    {
+                        1.F / textureH,
+                        (1.F + y1 / levelScale - y) / textureH
+                    };
+                    if (mirrorX)
+                    {
+                        std::swap(textureU[0], textureU[1]);
+                    }
+                    if (mirrorY)
+                    {
+                        std::swap(textureV[0], textureV[1]);
                     }
-                    primitive->colorSpace = colorSpaceData.id;
-                    primitive->colorSpaceTextureID = colorSpaceData.lut3D ? colorSpaceData.lut3D->getID() : 0;
+                    addImageVertices(primitive, pts, textureU, textureV, finalColor);
                 }
-#endif // DJV_GL_ES2
-                primitive->type = GL_TRIANGLE_STRIP;
-                primitive->vaoOffset = vboDataSize / GL::getVertexByteCount(GL::VBOType::Pos2_F32_UV_U16);
-                primitive->vaoSize = 4;
-
-                const size_t vboDataOffset = vboDataSize;
-                vboDataSizeUpdate(4);
-                VBOVertex* pData = reinterpret_cast<VBOVertex*>(&vboData[vboDataOffset]);
-                pData->vx = pts[0].x;
-                pData->vy = pts[0].y;
-                pData->tx = static_cast<uint16_t>(textureU[0] * 65535.F);
-                pData->ty = static_cast<uint16_t>(textureV[0] * 65535.F);
-                ++pData;
-                pData->vx = pts[1].x;
-                pData->vy = pts[1].y;
-                pData->tx = static_cast<uint16_t>(textureU[1] * 65535.F);
-                pData->ty = static_cast<uint16_t>(textureV[0] * 65535.F);
-                ++pData;
-                pData->vx = pts[3].x;
-                pData->vy = pts[3].y;
-                pData->tx = static_cast<uint16_t>(textureU[0] * 65535.F);
-                pData->ty = static_cast<uint16_t>(textureV[1] * 65535.F);
-                ++pData;
-                pData->vx = pts[2].x;
-                pData->vy = pts[2].y;
-                pData->tx = static_cast<uint16_t>(textureU[1] * 65535.F);
-                pData->ty = static_cast<uint16_t>(textureV[1] * 65535.F);
+            }
+        }
 
-                primitives.push_back(primitive);
+        size_t Render::Private::getTiledImageByteCount() const
+        {
+            size_t out = 0;
+            for (const auto& i : tiledImages)
+            {
+                out += i.second.getByteCount();
             }
+            return out;
         }
 
         std::string Render::Private::getFragmentSource() const
@@ -49,6 +49,11 @@ namespace djv
             ///@{
 
             void beginFrame(const Image::Size&);
+
+            //! Begin a frame that only updates the given region. The contents
+            //! of the frame buffer outside of the region are preserved.
+            void beginFrame(const Image::Size&, const Math::BBox2f& region);
+
             void endFrame();
 
             ///@}
@@ -114,6 +119,12 @@ namespace djv
                 const glm::vec2& pos,
                 const ImageOptions& = ImageOptions());
 
+            //! Start uploading an image to a texture in the background, so
+            //! that it is already resident when it is drawn with
+            //! ImageCache::Dynamic. This is used for upcoming playback frames.
+            //! The call is ignored if background uploads are not available.
+            void uploadImage(const std::shared_ptr<Image::Data>&);
+
             ///@}
 
             //! \name Text
@@ -144,6 +155,7 @@ namespace djv
             ///@{
 
             size_t getPrimitivesCount() const;
+            size_t getDrawCallCount() const;
             float getTextureAtlasPercentage() const;
             size_t getDynamicTextureCount() const;
             size_t getVBOSize() const;
@@ -4,35 +4,84 @@
 
 #include <djvRender2D/RenderPrivate.h>
 
+#include <djvImage/DataFunc.h>
+
+#include <algorithm>
+#include <tuple>
+
 using namespace djv::Core;
 
 namespace djv
 {
     namespace Render2D
     {
+        void setColorMode(PrimitiveData& data, const std::shared_ptr<GL::Shader>& shader, ColorMode value)
+        {
+            const int i = static_cast<int>(value);
+            if (i != data.colorMode)
+            {
+                data.colorMode = i;
+                shader->setUniform(data.colorModeLoc, i);
+            }
+        }
+
+        void setTextureSampler(PrimitiveData& data, const std::shared_ptr<GL::Shader>& shader, int value)
+        {
+            if (value != data.textureSampler)
+            {
+                data.textureSampler = value;
+                shader->setUniform(data.textureSamplerLoc, value);
+            }
+        }
+
         Primitive::~Primitive()
         {}
 
-        void Primitive::bind(const PrimitiveData& data, const std::shared_ptr<GL::Shader>& shader)
+        bool Primitive::canBatch(const Primitive& value) const
+        {
+            return
+                GL_TRIANGLES == type &&
+                type == value.type &&
+                colorMode == value.colorMode &&
+                alphaBlend == value.alphaBlend &&
+                textLCDRendering == value.textLCDRendering &&
+                atlasIndex == value.atlasIndex &&
+                clipRect == value.clipRect &&
+                vaoOffset + vaoSize == value.vaoOffset;
+        }
+
+        void Primitive::bind(PrimitiveData& data, const std::shared_ptr<GL::Shader>& shader)
+        {
+            setColorMode(data, shader, colorMode);
+        }
+
+        TextPrimitive::TextPrimitive()
         {
-            shader->setUniform(data.colorModeLoc, static_cast<int>(ColorMode::SolidColor));
-            shader->setUniform(data.colorLoc, reinterpret_cast<const GLfloat*>(color));
+            colorMode = ColorMode::ColorWithTextureAlpha;
         }
 
-        void TextPrimitive::bind(const PrimitiveData& data, const std::shared_ptr<GL::Shader>& shader)
+        void TextPrimitive::bind(PrimitiveData& data, const std::shared_ptr<GL::Shader>& shader)
         {
             if (!textLCDRendering)
             {
-                shader->setUniform(data.colorModeLoc, static_cast<int>(ColorMode::ColorWithTextureAlpha));
+                setColorMode(data, shader, colorMode);
             }
-            shader->setUniform(data.colorLoc, reinterpret_cast<const GLfloat*>(color));
-            shader->setUniform(data.textureSamplerLoc, static_cast<int>(atlasIndex));
+            setTextureSampler(data, shader, static_cast<int>(atlasIndex));
         }
 
-        void ImagePrimitive::bind(const PrimitiveData& data, const std::shared_ptr<GL::Shader>& shader)
+        ImagePrimitive::ImagePrimitive()
         {
-            shader->setUniform(data.colorModeLoc, static_cast<int>(colorMode));
-            shader->setUniform(data.colorLoc, reinterpret_cast<const GLfloat*>(color));
+            colorMode = ColorMode::ColorAndTexture;
+        }
+
+        bool ImagePrimitive::canBatch(const Primitive&) const
+        {
+            return false;
+        }
+
+        void ImagePrimitive::bind(PrimitiveData& data, const std::shared_ptr<GL::Shader>& shader)
+        {
+            setColorMode(data, shader, colorMode);
             shader->setUniform(data.imageChannelsLoc, static_cast<int>(imageChannels));
             if (colorMatrixEnabled)
             {
@@ -71,30 +120,92 @@ namespace djv
             switch (imageCache)
             {
             case ImageCache::Atlas:
-                shader->setUniform(data.textureSamplerLoc, static_cast<int>(atlasIndex));
+                setTextureSampler(data, shader, static_cast<int>(atlasIndex));
                 break;
             case ImageCache::Dynamic:
+            case ImageCache::Tiled:
                 glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + data.textureAtlasCount));
                 glBindTexture(GL_TEXTURE_2D, textureID);
-                shader->setUniform(data.textureSamplerLoc, static_cast<int>(data.textureAtlasCount));
+                setTextureSampler(data, shader, static_cast<int>(data.textureAtlasCount));
                 break;
             default: break;
             }
         }
 
-        void ShadowPrimitive::bind(const PrimitiveData& data, const std::shared_ptr<GL::Shader>& shader)
+        ShadowPrimitive::ShadowPrimitive()
         {
-            shader->setUniform(data.colorModeLoc, static_cast<int>(ColorMode::Shadow));
-            shader->setUniform(data.colorLoc, reinterpret_cast<const GLfloat*>(color));
+            colorMode = ColorMode::Shadow;
         }
 
-        void TexturePrimitive::bind(const PrimitiveData& data, const std::shared_ptr<GL::Shader>& shader)
+        TexturePrimitive::TexturePrimitive()
         {
-            shader->setUniform(data.colorModeLoc, static_cast<int>(ColorMode::ColorAndTexture));
-            shader->setUniform(data.colorLoc, reinterpret_cast<const GLfloat*>(color));
+            colorMode = ColorMode::ColorAndTexture;
+        }
+
+        bool TexturePrimitive::canBatch(const Primitive&) const
+        {
+            return false;
+        }
+
+        void TexturePrimitive::bind(PrimitiveData& data, const std::shared_ptr<GL::Shader>& shader)
+        {
+            setColorMode(data, shader, colorMode);
             glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + data.textureAtlasCount));
             glBindTexture(target, textureID);
-            shader->setUniform(data.textureSamplerLoc, static_cast<int>(data.textureAtlasCount));
+            setTextureSampler(data, shader, static_cast<int>(data.textureAtlasCount));
+        }
+
+        TiledImage::TiledImage()
+        {}
+
+        TiledImage::TiledImage(const std::shared_ptr<Image::Data>& data)
+        {
+            _levels.push_back(data);
+            _levelCount = 1;
+            _byteCount = data->getDataByteCount();
+            size_t size = std::max(data->getWidth(), data->getHeight());
+            while (size > tileSize)
+            {
+                size = (size + 1) / 2;
+                ++_levelCount;
+            }
+        }
+
+        size_t TiledImage::getLevelCount() const
+        {
+            return _levelCount;
+        }
+
+        const std::shared_ptr<Image::Data>& TiledImage::getLevel(size_t value)
+        {
+            while (_levels.size() <= value)
+            {
+                _levels.push_back(Image::createMipmap(_levels.back()));
+                _byteCount += _levels.back()->getDataByteCount();
+            }
+            return _levels[value];
+        }
+
+        size_t TiledImage::getByteCount() const
+        {
+            return _byteCount;
+        }
+
+        size_t TiledImage::getFrame() const
+        {
+            return _frame;
+        }
+
+        void TiledImage::setFrame(size_t value)
+        {
+            _frame = value;
+        }
+
+        bool TileKey::operator < (const TileKey& value) const
+        {
+            return
+                std::tie(uid, level, x, y) <
+                std::tie(value.uid, value.level, value.x, value.y);
         }
 
 #if !defined(DJV_GL_ES2)
@@ -8,11 +8,19 @@
 #include <djvRender2D/Enum.h>
 
 #include <djvGL/Shader.h>
+#include <djvGL/Texture.h>
 
-#include <djvImage/Info.h>
+#include <djvImage/Data.h>
 
 #include <djvMath/BBox.h>
 
+#include <djvCore/UID.h>
+
+#include <deque>
+#include <list>
+#include <map>
+#include <vector>
+
 namespace djv
 {
     namespace Render2D
@@ -20,11 +28,15 @@ namespace djv
         //! \todo Should this be configurable?
         const uint8_t  textureAtlasCount      = 4;
         const uint16_t textureAtlasSize       = 8192;
-        const size_t   dynamicTextureCount    = 16;
-        const size_t   dynamicTextureCacheMax = 16;
+        const float    textureAtlasPreloadMax = .5F;
+        const size_t   dynamicTextureCount              = 16;
+        const size_t   dynamicTextureCacheMaxByteCount  = 1024 * 1024 * 1024;
+        const uint16_t tileSize                         = 512;
+        const size_t   tileCacheMaxByteCount            = 512 * 1024 * 1024;
+        const size_t   tiledImageCacheMaxByteCount      = 512 * 1024 * 1024;
 #if !defined(DJV_GL_ES2)
-        const size_t   lut3DSize              = 32;
-        const size_t   colorSpaceCacheMax     = 32;
+        const size_t   lut3DSize                        = 32;
+        const size_t   colorSpaceCacheMax               = 32;
 #endif // DJV_GL_ES2
 
         // This enumeration provides how the color is used to draw the render primitive.
@@ -50,7 +62,6 @@ namespace djv
             // Shader uniform variable locations.
             GLint imageChannelsLoc          = 0;
             GLint colorModeLoc              = 0;
-            GLint colorLoc                  = 0;
 #if !defined(DJV_GL_ES2)
             GLint colorSpaceLoc             = 0;
             GLint colorSpaceSamplerLoc      = 0;
@@ -72,39 +83,58 @@ namespace djv
             GLint softClipLoc               = 0;
             GLint imageChannelDisplayLoc    = 0;
             GLint textureSamplerLoc         = 0;
+
+            // The current shader state, used to skip redundant uniform updates.
+            int   colorMode                 = -1;
+            int   textureSampler            = -1;
         };
 
+        //! Set the color mode uniform if it has changed.
+        void setColorMode(PrimitiveData&, const std::shared_ptr<GL::Shader>&, ColorMode);
+
+        //! Set the texture sampler uniform if it has changed.
+        void setTextureSampler(PrimitiveData&, const std::shared_ptr<GL::Shader>&, int);
+
         //! This class provides the base functionality for render primitives.
+        //!
+        //! The primitive color is stored in the vertex data so that consecutive
+        //! primitives that share the same shader state can be drawn together.
         class Primitive
         {
         public:
             virtual ~Primitive();
 
             Math::BBox2f clipRect;
-            float        color[4]           = { 0.F, 0.F, 0.F, 0.F };
+            ColorMode    colorMode          = ColorMode::SolidColor;
             GLenum       type               = GL_TRIANGLES;
             size_t       vaoOffset          = 0;
             size_t       vaoSize            = 0;
             AlphaBlend   alphaBlend         = AlphaBlend::Straight;
             bool         textLCDRendering   = false;
+            uint8_t      atlasIndex         = 0;
+
+            //! Get whether the given primitive can be drawn in the same batch
+            //! (i.e., it has the same state and follows this one in the VBO).
+            virtual bool canBatch(const Primitive&) const;
 
-            virtual void bind(const PrimitiveData&, const std::shared_ptr<GL::Shader>&);
+            virtual void bind(PrimitiveData&, const std::shared_ptr<GL::Shader>&);
         };
 
         //! This class provides a text render primitive.
         class TextPrimitive : public Primitive
         {
         public:
-            uint8_t atlasIndex = 0;
+            TextPrimitive();
 
-            void bind(const PrimitiveData&, const std::shared_ptr<GL::Shader>&) override;
+            void bind(PrimitiveData&, const std::shared_ptr<GL::Shader>&) override;
         };
 
         //! This class provides an image render primitive.
         class ImagePrimitive : public Primitive
         {
         public:
-            ColorMode           colorMode           = ColorMode::ColorAndTexture;
+            ImagePrimitive();
+
             Image::Channels     imageChannels       = Image::Channels::RGBA;
 #if !defined(DJV_GL_ES2)
             uint8_t             colorSpace          = 0;
@@ -123,27 +153,51 @@ namespace djv
             float               softClip            = 0.F;
             ImageChannelDisplay imageChannelDisplay = ImageChannelDisplay::Color;
             ImageCache          imageCache          = ImageCache::Atlas;
-            uint8_t             atlasIndex          = 0;
             GLuint              textureID           = 0;
 
-            void bind(const PrimitiveData&, const std::shared_ptr<GL::Shader>&) override;
+            bool canBatch(const Primitive&) const override;
+            void bind(PrimitiveData&, const std::shared_ptr<GL::Shader>&) override;
         };
 
         //! This class provides a shadow render primitive.
         class ShadowPrimitive : public Primitive
         {
         public:
-            void bind(const PrimitiveData&, const std::shared_ptr<GL::Shader>&) override;
+            ShadowPrimitive();
         };
 
         //! This class provides a texture render primitive.
         class TexturePrimitive : public Primitive
         {
         public:
+            TexturePrimitive();
+
             GLuint textureID    = 0;
             GLenum target       = GL_TEXTURE_2D;
 
-            void bind(const PrimitiveData&, const std::shared_ptr<GL::Shader>&) override;
+            bool canBatch(const Primitive&) const override;
+            void bind(PrimitiveData&, const std::shared_ptr<GL::Shader>&) override;
+        };
+
+        //! This class provides a pool of render primitives that is reused
+        //! every frame to avoid allocating each primitive separately.
+        template<typename T>
+        class PrimitivePool
+        {
+        public:
+            //! Get a primitive from the pool. The pointer is valid until reset()
+            //! is called.
+            T* get();
+
+            //! Return all of the primitives to the pool.
+            void reset();
+
+            size_t getSize() const;
+            size_t getCapacity() const;
+
+        private:
+            std::deque<T> _primitives;
+            size_t        _size = 0;
         };
 
         //! This struct provides the layout for a VBO vertex.
@@ -153,6 +207,95 @@ namespace djv
             float    vy;
             uint16_t tx;
             uint16_t ty;
+            uint8_t  cr;
+            uint8_t  cg;
+            uint8_t  cb;
+            uint8_t  ca;
+        };
+
+        //! This class provides the mipmap levels of an image that is drawn
+        //! with tiles. The levels are created on the CPU when they are first
+        //! used, the last level fits in a single tile.
+        class TiledImage
+        {
+        public:
+            TiledImage();
+            explicit TiledImage(const std::shared_ptr<Image::Data>&);
+
+            size_t getLevelCount() const;
+            const std::shared_ptr<Image::Data>& getLevel(size_t);
+
+            //! Get the size of the image and the mipmap levels that have
+            //! been created.
+            size_t getByteCount() const;
+
+            //! Get the frame the image was last drawn in.
+            size_t getFrame() const;
+
+            void setFrame(size_t);
+
+        private:
+            std::vector<std::shared_ptr<Image::Data> > _levels;
+            size_t _levelCount = 0;
+            size_t _byteCount = 0;
+            size_t _frame = 0;
+        };
+
+        //! This struct provides the key for a texture tile.
+        struct TileKey
+        {
+            Core::UID uid   = 0;
+            uint8_t   level = 0;
+            uint16_t  x     = 0;
+            uint16_t  y     = 0;
+
+            bool operator < (const TileKey&) const;
+        };
+
+        //! This class provides a least recently used cache of textures with a
+        //! GPU memory budget. Textures that are used in the current frame are
+        //! not removed, so the budget may be exceeded until the next frame.
+        template<typename T>
+        class TextureCache
+        {
+            DJV_NON_COPYABLE(TextureCache);
+
+        public:
+            TextureCache();
+
+            size_t getCount() const;
+            size_t getByteCount() const;
+            size_t getMaxByteCount() const;
+
+            void setMaxByteCount(size_t);
+
+            bool contains(const T&) const;
+
+            //! Get a texture and mark it as used in the given frame.
+            std::shared_ptr<GL::Texture> get(const T&, size_t frame);
+
+            //! Add a texture and remove the least recently used textures that
+            //! are over the budget. The removed textures are returned so that
+            //! they can be reused.
+            std::vector<std::shared_ptr<GL::Texture> > add(
+                const T&,
+                const std::shared_ptr<GL::Texture>&,
+                size_t frame);
+
+            void clear();
+
+        private:
+            struct Item
+            {
+                T                            key;
+                std::shared_ptr<GL::Texture> texture;
+                size_t                       byteCount = 0;
+                size_t                       frame     = 0;
+            };
+            std::list<Item> _items;
+            std::map<T, typename std::list<Item>::iterator> _map;
+            size_t _byteCount = 0;
+            size_t _maxByteCount = 0;
         };
 
 #if !defined(DJV_GL_ES2)
@@ -206,3 +349,4 @@ namespace djv
     } // namespace Render2D
 } // namespace djv
 
+#include <djvRender2D/RenderPrivateInline.h>
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+namespace djv
+{
+    namespace Render2D
+    {
+        template<typename T>
+        inline T* PrimitivePool<T>::get()
+        {
+            T* out = nullptr;
+            if (_size < _primitives.size())
+            {
+                out = &_primitives[_size];
+                *out = T();
+            }
+            else
+            {
+                _primitives.emplace_back();
+                out = &_primitives.back();
+            }
+            ++_size;
+            return out;
+        }
+
+        template<typename T>
+        inline void PrimitivePool<T>::reset()
+        {
+            _size = 0;
+        }
+
+        template<typename T>
+        inline size_t PrimitivePool<T>::getSize() const
+        {
+            return _size;
+        }
+
+        template<typename T>
+        inline size_t PrimitivePool<T>::getCapacity() const
+        {
+            return _primitives.size();
+        }
+
+        template<typename T>
+        inline TextureCache<T>::TextureCache()
+        {}
+
+        template<typename T>
+        inline size_t TextureCache<T>::getCount() const
+        {
+            return _items.size();
+        }
+
+        template<typename T>
+        inline size_t TextureCache<T>::getByteCount() const
+        {
+            return _byteCount;
+        }
+
+        template<typename T>
+        inline size_t TextureCache<T>::getMaxByteCount() const
+        {
+            return _maxByteCount;
+        }
+
+        template<typename T>
+        inline void TextureCache<T>::setMaxByteCount(size_t value)
+        {
+            _maxByteCount = value;
+        }
+
+        template<typename T>
+        inline bool TextureCache<T>::contains(const T& key) const
+        {
+            return _map.find(key) != _map.end();
+        }
+
+        template<typename T>
+        inline std::shared_ptr<GL::Texture> TextureCache<T>::get(const T& key, size_t frame)
+        {
+            std::shared_ptr<GL::Texture> out;
+            const auto i = _map.find(key);
+            if (i != _map.end())
+            {
+                i->second->frame = frame;
+                _items.splice(_items.begin(), _items, i->second);
+                out = i->second->texture;
+            }
+            return out;
+        }
+
+        template<typename T>
+        inline std::vector<std::shared_ptr<GL::Texture> > TextureCache<T>::add(
+            const T& key,
+            const std::shared_ptr<GL::Texture>& texture,
+            size_t frame)
+        {
+            std::vector<std::shared_ptr<GL::Texture> > out;
+            const auto i = _map.find(key);
+            if (i != _map.end())
+            {
+                _byteCount -= i->second->byteCount;
+                _items.erase(i->second);
+                _map.erase(i);
+            }
+            Item item;
+            item.key = key;
+            item.texture = texture;
+            item.byteCount = texture->getInfo().getDataByteCount();
+            item.frame = frame;
+            _items.push_front(item);
+            _map[key] = _items.begin();
+            _byteCount += item.byteCount;
+            while (_byteCount > _maxByteCount && _items.back().frame != frame)
+            {
+                out.push_back(_items.back().texture);
+                _byteCount -= _items.back().byteCount;
+                _map.erase(_items.back().key);
+                _items.pop_back();
+            }
+            return out;
+        }
+
+        template<typename T>
+        inline void TextureCache<T>::clear()
+        {
+            _items.clear();
+            _map.clear();
+            _byteCount = 0;
+        }
+
+    } // namespace Render2D
+} // namespace djv
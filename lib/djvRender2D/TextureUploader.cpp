@@ -0,0 +1,342 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvRender2D/TextureUploader.h>
+
+#include <djvGL/Texture.h>
+
+#include <djvImage/Data.h>
+
+#include <djvSystem/TimerFunc.h>
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <list>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace Render2D
+    {
+#if !defined(DJV_GL_ES2)
+
+        namespace
+        {
+            //! \todo Should this be configurable?
+            const size_t   pixelBufferCount = 4;
+            const size_t   uploadMax        = 16;
+            const GLuint64 fenceTimeout     = 1000000000;
+
+            struct Request
+            {
+                std::shared_ptr<Image::Data> image;
+                GLenum                       filterMin = GL_LINEAR;
+                GLenum                       filterMag = GL_LINEAR;
+            };
+
+            struct Upload
+            {
+                std::shared_ptr<GL::Texture> texture;
+                GLsync                       fence = nullptr;
+            };
+
+            struct PixelBuffer
+            {
+                GLuint id        = 0;
+                size_t byteCount = 0;
+                GLsync fence     = nullptr;
+            };
+
+        } // namespace
+
+        struct TextureUploader::Private
+        {
+            GLFWwindow* window = nullptr;
+
+            std::list<Request> requests;
+            UID inProgress = 0;
+            bool cancelInProgress = false;
+            std::map<UID, Upload> uploads;
+            std::list<UID> uploadOrder;
+            std::mutex mutex;
+            std::condition_variable requestCV;
+            std::condition_variable uploadCV;
+
+            std::thread thread;
+            std::atomic<bool> running;
+
+            void run();
+            Upload upload(const Request&, PixelBuffer&);
+        };
+
+        TextureUploader::TextureUploader(GLFWwindow* share) :
+            _p(new Private)
+        {
+            DJV_PRIVATE_PTR();
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+            glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+            glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+            p.window = glfwCreateWindow(1, 1, "TextureUploader", NULL, share);
+            if (!p.window)
+            {
+                throw std::runtime_error("Cannot create the texture upload window.");
+            }
+            p.running = true;
+            p.thread = std::thread(
+                [this]
+                {
+                    _p->run();
+                });
+        }
+
+        TextureUploader::~TextureUploader()
+        {
+            DJV_PRIVATE_PTR();
+            p.running = false;
+            p.requestCV.notify_one();
+            if (p.thread.joinable())
+            {
+                p.thread.join();
+            }
+            if (p.window)
+            {
+                glfwDestroyWindow(p.window);
+            }
+        }
+
+        size_t TextureUploader::getCount() const
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            return p.requests.size() + p.uploads.size();
+        }
+
+        void TextureUploader::add(const std::shared_ptr<Image::Data>& image, GLenum filterMin, GLenum filterMag)
+        {
+            DJV_PRIVATE_PTR();
+            if (!p.running || !image)
+                return;
+            const UID uid = image->getUID();
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                if (uid == p.inProgress ||
+                    p.uploads.find(uid) != p.uploads.end() ||
+                    std::find_if(
+                        p.requests.begin(),
+                        p.requests.end(),
+                        [uid](const Request& value)
+                        {
+                            return value.image->getUID() == uid;
+                        }) != p.requests.end())
+                    return;
+                Request request;
+                request.image = image;
+                request.filterMin = filterMin;
+                request.filterMag = filterMag;
+                p.requests.push_back(request);
+                while (p.requests.size() > uploadMax)
+                {
+                    p.requests.pop_front();
+                }
+            }
+            p.requestCV.notify_one();
+        }
+
+        std::shared_ptr<GL::Texture> TextureUploader::get(UID uid)
+        {
+            DJV_PRIVATE_PTR();
+            Upload upload;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.requests.remove_if(
+                    [uid](const Request& value)
+                    {
+                        return value.image->getUID() == uid;
+                    });
+                p.uploadCV.wait(
+                    lock,
+                    [&p, uid]
+                    {
+                        return p.inProgress != uid;
+                    });
+                const auto i = p.uploads.find(uid);
+                if (i != p.uploads.end())
+                {
+                    upload = i->second;
+                    p.uploads.erase(i);
+                    p.uploadOrder.remove(uid);
+                }
+            }
+            if (upload.fence)
+            {
+                glWaitSync(upload.fence, 0, GL_TIMEOUT_IGNORED);
+                glDeleteSync(upload.fence);
+            }
+            return upload.texture;
+        }
+
+        void TextureUploader::clear()
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            p.requests.clear();
+            p.cancelInProgress = p.inProgress != 0;
+            for (const auto& i : p.uploads)
+            {
+                glDeleteSync(i.second.fence);
+            }
+            p.uploads.clear();
+            p.uploadOrder.clear();
+        }
+
+        void TextureUploader::Private::run()
+        {
+            glfwMakeContextCurrent(window);
+            if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+            {
+                running = false;
+                return;
+            }
+
+            std::vector<PixelBuffer> pixelBuffers(pixelBufferCount);
+            for (auto& i : pixelBuffers)
+            {
+                glGenBuffers(1, &i.id);
+            }
+            size_t pixelBufferIndex = 0;
+
+            const auto timeout = System::getTimerValue(System::TimerValue::Medium);
+            while (running)
+            {
+                Request request;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    if (requestCV.wait_for(
+                        lock,
+                        std::chrono::milliseconds(timeout),
+                        [this]
+                        {
+                            return requests.size() || !running;
+                        }) && requests.size())
+                    {
+                        request = requests.front();
+                        requests.pop_front();
+                        inProgress = request.image->getUID();
+                        cancelInProgress = false;
+                    }
+                }
+                if (!request.image)
+                    continue;
+
+                Upload upload = this->upload(request, pixelBuffers[pixelBufferIndex]);
+                pixelBufferIndex = (pixelBufferIndex + 1) % pixelBuffers.size();
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (upload.texture && !cancelInProgress)
+                    {
+                        uploads[inProgress] = upload;
+                        uploadOrder.push_back(inProgress);
+                        while (uploadOrder.size() > uploadMax)
+                        {
+                            const auto i = uploads.find(uploadOrder.front());
+                            glDeleteSync(i->second.fence);
+                            uploads.erase(i);
+                            uploadOrder.pop_front();
+                        }
+                    }
+                    else if (upload.fence)
+                    {
+                        glDeleteSync(upload.fence);
+                    }
+                    inProgress = 0;
+                    cancelInProgress = false;
+                }
+                uploadCV.notify_all();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (const auto& i : uploads)
+                {
+                    glDeleteSync(i.second.fence);
+                }
+                uploads.clear();
+                uploadOrder.clear();
+            }
+            for (auto& i : pixelBuffers)
+            {
+                if (i.fence)
+                {
+                    glClientWaitSync(i.fence, GL_SYNC_FLUSH_COMMANDS_BIT, fenceTimeout);
+                    glDeleteSync(i.fence);
+                }
+                glDeleteBuffers(1, &i.id);
+            }
+            glFinish();
+        }
+
+        Upload TextureUploader::Private::upload(const Request& request, PixelBuffer& pixelBuffer)
+        {
+            Upload out;
+
+            // Wait for the previous transfer from this buffer to finish.
+            if (pixelBuffer.fence)
+            {
+                glClientWaitSync(pixelBuffer.fence, GL_SYNC_FLUSH_COMMANDS_BIT, fenceTimeout);
+                glDeleteSync(pixelBuffer.fence);
+                pixelBuffer.fence = nullptr;
+            }
+
+            // Create the texture before binding the pixel buffer so that the
+            // texture storage is not initialized from the buffer.
+            const auto& info = request.image->getInfo();
+            auto texture = GL::Texture::create(info, request.filterMin, request.filterMag);
+
+            const size_t byteCount = info.getDataByteCount();
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer.id);
+            if (byteCount > pixelBuffer.byteCount)
+            {
+                glBufferData(GL_PIXEL_UNPACK_BUFFER, byteCount, nullptr, GL_STREAM_DRAW);
+                pixelBuffer.byteCount = byteCount;
+            }
+            if (void* data = glMapBufferRange(
+                GL_PIXEL_UNPACK_BUFFER,
+                0,
+                byteCount,
+                GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT))
+            {
+                memcpy(data, request.image->getData(), byteCount);
+                if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER))
+                {
+                    texture->copyFromPixelBuffer(info);
+                    pixelBuffer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                    out.texture = texture;
+                    out.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                }
+            }
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+            // Flush so that the fences are visible to the main context.
+            glFlush();
+
+            return out;
+        }
+
+#endif // DJV_GL_ES2
+
+    } // namespace Render2D
+} // namespace djv
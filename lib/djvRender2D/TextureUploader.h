@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvGL/GL.h>
+
+#include <djvCore/UID.h>
+
+#include <memory>
+
+struct GLFWwindow;
+
+namespace djv
+{
+    namespace GL
+    {
+        class Texture;
+
+    } // namespace GL
+
+    namespace Image
+    {
+        class Data;
+
+    } // namespace Image
+
+    namespace Render2D
+    {
+#if !defined(DJV_GL_ES2)
+
+        //! This class provides asynchronous texture uploads.
+        //!
+        //! Images are uploaded on a separate thread with a hidden window whose
+        //! OpenGL context shares objects with the main context. The pixels are
+        //! copied into a ring of pixel buffer objects and transferred to new
+        //! textures, a fence is inserted after each transfer so that the
+        //! texture is only used once it is resident.
+        class TextureUploader
+        {
+            DJV_NON_COPYABLE(TextureUploader);
+
+        public:
+            //! Throws:
+            //! - std::exception
+            explicit TextureUploader(GLFWwindow* share);
+
+            ~TextureUploader();
+
+            //! Get the number of uploads that are waiting to be used.
+            size_t getCount() const;
+
+            //! Add an image to be uploaded. Images that have already been
+            //! added are ignored.
+            void add(const std::shared_ptr<Image::Data>&, GLenum filterMin, GLenum filterMag);
+
+            //! Get the texture for an image. If the image is still waiting to
+            //! be uploaded the request is cancelled and a null pointer is
+            //! returned. If the transfer has not finished the main context
+            //! waits for the fence on the GPU. This function must be called
+            //! from the thread of the main context.
+            std::shared_ptr<GL::Texture> get(Core::UID);
+
+            //! Cancel all of the uploads.
+            void clear();
+
+        private:
+            DJV_PRIVATE();
+        };
+
+#endif // DJV_GL_ES2
+
+    } // namespace Render2D
+} // namespace djv
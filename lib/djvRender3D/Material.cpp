@@ -47,8 +47,12 @@ namespace djv
         {
             IMaterial::_init("djvRender3DSolidColorVertex.glsl", "djvRender3DSolidColorFragment.glsl", context);
             auto program = _shader->getProgram();
+#if defined(DJV_GL_ES2)
             _locations["transform.m"] = glGetUniformLocation(program, "transform.m");
             _locations["transform.mvp"] = glGetUniformLocation(program, "transform.mvp");
+#else // DJV_GL_ES2
+            _locations["transform.vp"] = glGetUniformLocation(program, "transform.vp");
+#endif // DJV_GL_ES2
             _locations["color"] = glGetUniformLocation(program, "color");
         }
 
@@ -67,8 +71,12 @@ namespace djv
 
         void SolidColorMaterial::primitiveBind(const PrimitiveBindData& data)
         {
+#if defined(DJV_GL_ES2)
             _shader->setUniform(_locations["transform.m"], data.model);
             _shader->setUniform(_locations["transform.mvp"], data.camera * data.model);
+#else // DJV_GL_ES2
+            _shader->setUniform(_locations["transform.vp"], data.camera);
+#endif // DJV_GL_ES2
             _shader->setUniform(_locations["color"], data.color);
         }
 
@@ -77,9 +85,13 @@ namespace djv
             IMaterial::_init("djvRender3DDefaultVertex.glsl", "djvRender3DDefaultFragment.glsl", context);
 
             auto program = _shader->getProgram();
+#if defined(DJV_GL_ES2)
             _locations["transform.m"] = glGetUniformLocation(program, "transform.m");
             _locations["transform.mvp"] = glGetUniformLocation(program, "transform.mvp");
             _locations["transform.normals"] = glGetUniformLocation(program, "transform.normals");
+#else // DJV_GL_ES2
+            _locations["transform.vp"] = glGetUniformLocation(program, "transform.vp");
+#endif // DJV_GL_ES2
 
             _locations["hemisphereLight.intensity"] = glGetUniformLocation(program, "hemisphereLight.intensity");
             _locations["hemisphereLight.up"] = glGetUniformLocation(program, "hemisphereLight.up");
@@ -211,9 +223,13 @@ namespace djv
 
         void DefaultMaterial::primitiveBind(const PrimitiveBindData& data)
         {
+#if defined(DJV_GL_ES2)
             _shader->setUniform(_locations["transform.m"], data.model);
             _shader->setUniform(_locations["transform.mvp"], data.camera * data.model);
             _shader->setUniform(_locations["transform.normals"], glm::transpose(glm::inverse(glm::mat3x3(data.model))));
+#else // DJV_GL_ES2
+            _shader->setUniform(_locations["transform.vp"], data.camera);
+#endif // DJV_GL_ES2
         }
 
         DJV_ENUM_HELPERS_IMPLEMENTATION(DefaultMaterialMode);
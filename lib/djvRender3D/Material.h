@@ -36,6 +36,8 @@ namespace djv
         };
 
         //! This struct provides per-primitive binding data.
+        //! The model transform is only used with OpenGL ES 2, otherwise the
+        //! transforms are provided per-instance by the renderer.
         struct PrimitiveBindData
         {
             glm::mat4x4 model;
@@ -18,7 +18,12 @@
 #include <djvSystem/LogSystem.h>
 #include <djvSystem/TimerFunc.h>
 
+#include <djvMath/BBoxFunc.h>
+
+#include <glm/gtc/matrix_inverse.hpp>
+
 #include <array>
+#include <limits>
 
 using namespace djv::Core;
 
@@ -33,6 +38,7 @@ namespace djv
             const uint16_t        textureAtlasSize        = 8192;
             const size_t          shadedMeshCacheSize     = 50000000;
             const size_t          solidColorMeshCacheSize = 10000000;
+            const float           lodProjectedSize        = 512.F;
 #if defined(DJV_GL_ES2)
             const GL::VBOType shadedMeshType     = GL::VBOType::Pos3_F32_UV_F32_Normal_F32;
             const GL::VBOType solidColorMeshType = GL::VBOType::Pos3_F32;
@@ -48,8 +54,146 @@ namespace djv
                 std::vector<Math::SizeTRange> vaoRange;
                 Image::Color                  color;
                 std::shared_ptr<IMaterial>    material;
+                Math::BBox3f                  bbox     = Math::BBox3f(0.F, 0.F, 0.F, 0.F, 0.F, 0.F);
+                bool                          bboxInit = true;
+                bool                          cull     = true;
+                size_t                        triangleCount = 0;
+            };
+
+            //! Add the bounding-box of a piece of geometry to a primitive.
+            //! Geometry without a computed bounding-box is never culled.
+            void addBBox(Primitive& primitive, const Math::BBox3f& value)
+            {
+                if (value.min == value.max)
+                {
+                    primitive.cull = false;
+                }
+                else if (primitive.bboxInit)
+                {
+                    primitive.bboxInit = false;
+                    primitive.bbox = value;
+                }
+                else
+                {
+                    primitive.bbox.expand(value);
+                }
+            }
+
+            //! Get the size of a bounding-box projected to the screen in pixels.
+            float getProjectedSize(const Math::BBox3f& bbox, const glm::mat4x4& m, const Image::Size& size)
+            {
+                glm::vec2 min(std::numeric_limits<float>::max());
+                glm::vec2 max(-std::numeric_limits<float>::max());
+                for (size_t i = 0; i < 8; ++i)
+                {
+                    const glm::vec4 p = m * glm::vec4(
+                        i & 1 ? bbox.max.x : bbox.min.x,
+                        i & 2 ? bbox.max.y : bbox.min.y,
+                        i & 4 ? bbox.max.z : bbox.min.z,
+                        1.F);
+                    if (p.w <= 0.F)
+                    {
+                        // The bounding-box crosses the camera plane.
+                        return std::numeric_limits<float>::max();
+                    }
+                    const glm::vec2 ndc(p.x / p.w, p.y / p.w);
+                    min = glm::min(min, ndc);
+                    max = glm::max(max, ndc);
+                }
+                return std::max(
+                    (max.x - min.x) * .5F * size.w,
+                    (max.y - min.y) * .5F * size.h);
+            }
+
+            //! Get the level of detail for a projected size. Each level has
+            //! about a quarter of the triangles of the previous level, so the
+            //! level changes each time the projected size is halved.
+            size_t getLOD(float projectedSize, size_t count)
+            {
+                size_t out = 0;
+                float size = lodProjectedSize;
+                while (out + 1 < count && projectedSize < size)
+                {
+                    ++out;
+                    size *= .5F;
+                }
+                return out;
+            }
+
+            //! This struct provides the planes of a view frustum.
+            struct Frustum
+            {
+                std::array<glm::vec4, 6> planes;
+            };
+
+            Frustum getFrustum(const glm::mat4x4& m)
+            {
+                Frustum out;
+                const glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+                const glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+                const glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+                const glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+                out.planes[0] = row3 + row0;
+                out.planes[1] = row3 - row0;
+                out.planes[2] = row3 + row1;
+                out.planes[3] = row3 - row1;
+                out.planes[4] = row3 + row2;
+                out.planes[5] = row3 - row2;
+                return out;
+            }
+
+            bool intersects(const Frustum& frustum, const Math::BBox3f& bbox)
+            {
+                for (const auto& plane : frustum.planes)
+                {
+                    const glm::vec3 p(
+                        plane.x >= 0.F ? bbox.max.x : bbox.min.x,
+                        plane.y >= 0.F ? bbox.max.y : bbox.min.y,
+                        plane.z >= 0.F ? bbox.max.z : bbox.min.z);
+                    if (plane.x * p.x + plane.y * p.y + plane.z * p.z + plane.w < 0.F)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+#if !defined(DJV_GL_ES2)
+            //! The per-instance transforms start at this vertex attribute.
+            const GLuint instanceAttribute = 4;
+
+            struct InstanceData
+            {
+                glm::mat4x4 m;
+                glm::mat4x4 normals;
+            };
+
+            //! This struct provides primitives that share the same geometry and
+            //! color, they are drawn with a single instanced draw call.
+            struct Batch
+            {
+                std::vector<std::shared_ptr<Primitive> > primitives;
+                size_t offset = 0;
             };
 
+            void setInstanceAttributes(size_t offset)
+            {
+                const GLsizei stride = static_cast<GLsizei>(sizeof(InstanceData));
+                for (GLuint i = 0; i < 8; ++i)
+                {
+                    glVertexAttribPointer(
+                        instanceAttribute + i,
+                        4,
+                        GL_FLOAT,
+                        GL_FALSE,
+                        stride,
+                        (GLvoid*)(offset + i * sizeof(glm::vec4)));
+                    glEnableVertexAttribArray(instanceAttribute + i);
+                    glVertexAttribDivisor(instanceAttribute + i, 1);
+                }
+            }
+#endif // DJV_GL_ES2
+
         } // namespace
 
         struct Render::Private
@@ -67,7 +211,12 @@ namespace djv
             std::map<GL::VBOType, std::map<UID, UID> > meshCacheUIDs;
 
             std::map<GL::VBOType, std::map<std::shared_ptr<IMaterial>, std::vector<std::shared_ptr<Primitive> > > > primitives;
+#if !defined(DJV_GL_ES2)
+            GLuint                                  instanceVBO       = 0;
+            std::vector<InstanceData>               instanceData;
+#endif // DJV_GL_ES2
 
+            RenderStats                             stats;
             std::shared_ptr<System::Timer> statsTimer;
         };
 
@@ -111,6 +260,9 @@ namespace djv
             p.meshCache[solidColorMeshType].reset(new GL::MeshCache(
                 solidColorMeshCacheSize,
                 solidColorMeshType));
+#if !defined(DJV_GL_ES2)
+            glGenBuffers(1, &p.instanceVBO);
+#endif // DJV_GL_ES2
 
             p.statsTimer = System::Timer::create(context);
             p.statsTimer->setRepeating(true);
@@ -125,6 +277,9 @@ namespace djv
                     {
                         ss << "Mesh cache " << i.first << ": " << i.second->getPercentageUsed() << "%\n";
                     }
+                    ss << "Primitives: " << p.stats.primitivesVisible << "/" << p.stats.primitives << "\n";
+                    ss << "Triangles: " << p.stats.trianglesVisible << "/" << p.stats.triangles << "\n";
+                    ss << "Draw calls: " << p.stats.drawCalls;
                     _log(ss.str());
                 });
         }
@@ -134,7 +289,16 @@ namespace djv
         {}
 
         Render::~Render()
-        {}
+        {
+#if !defined(DJV_GL_ES2)
+            DJV_PRIVATE_PTR();
+            if (p.instanceVBO)
+            {
+                glDeleteBuffers(1, &p.instanceVBO);
+                p.instanceVBO = 0;
+            }
+#endif // DJV_GL_ES2
+        }
 
         std::shared_ptr<Render> Render::create(const std::shared_ptr<System::Context>& context)
         {
@@ -201,15 +365,34 @@ namespace djv
             bindData.lights = p.lights;
             PrimitiveBindData primitiveBindData;
             primitiveBindData.camera = p.options.camera->getP() * p.options.camera->getV();
+            const Frustum frustum = getFrustum(primitiveBindData.camera);
+            p.stats = RenderStats();
             for (const auto& i : p.primitives)
             {
                 auto vao = p.meshCache[i.first]->getVAO();
                 vao->bind();
                 for (const auto& j : i.second)
                 {
+                    // Cull the primitives against the camera frustum.
+                    std::vector<std::shared_ptr<Primitive> > visible;
+                    for (const auto& k : j.second)
+                    {
+                        ++p.stats.primitives;
+                        p.stats.triangles += k->triangleCount;
+                        if (!k->cull || k->bboxInit || intersects(frustum, k->bbox * k->xform))
+                        {
+                            visible.push_back(k);
+                            ++p.stats.primitivesVisible;
+                            p.stats.trianglesVisible += k->triangleCount;
+                        }
+                    }
+                    if (visible.empty())
+                        continue;
+
                     j.first->getShader()->bind();
                     j.first->bind(bindData);
-                    for (const auto& k : j.second)
+#if defined(DJV_GL_ES2)
+                    for (const auto& k : visible)
                     {
                         primitiveBindData.model = k->xform;
                         primitiveBindData.color = k->color;
@@ -217,8 +400,70 @@ namespace djv
                         for (const auto& vaoIt : k->vaoRange)
                         {
                             vao->draw(k->type, vaoIt.getMin(), vaoIt.getMax() - vaoIt.getMin() + 1);
+                            ++p.stats.drawCalls;
                         }
                     }
+#else // DJV_GL_ES2
+                    // Batch the primitives that share the same geometry and color.
+                    std::vector<Batch> batches;
+                    std::map<std::pair<GLenum, std::vector<Math::SizeTRange> >, std::vector<size_t> > batchIndexes;
+                    for (const auto& k : visible)
+                    {
+                        auto& indexes = batchIndexes[std::make_pair(k->type, k->vaoRange)];
+                        size_t index = batches.size();
+                        for (const auto l : indexes)
+                        {
+                            if (batches[l].primitives[0]->color == k->color)
+                            {
+                                index = l;
+                                break;
+                            }
+                        }
+                        if (index == batches.size())
+                        {
+                            batches.push_back(Batch());
+                            indexes.push_back(index);
+                        }
+                        batches[index].primitives.push_back(k);
+                    }
+
+                    // Upload the per-instance transforms.
+                    p.instanceData.clear();
+                    for (auto& k : batches)
+                    {
+                        k.offset = p.instanceData.size();
+                        for (const auto& l : k.primitives)
+                        {
+                            InstanceData data;
+                            data.m = l->xform;
+                            data.normals = glm::mat4x4(glm::inverseTranspose(glm::mat3x3(l->xform)));
+                            p.instanceData.push_back(data);
+                        }
+                    }
+                    glBindBuffer(GL_ARRAY_BUFFER, p.instanceVBO);
+                    glBufferData(
+                        GL_ARRAY_BUFFER,
+                        p.instanceData.size() * sizeof(InstanceData),
+                        p.instanceData.data(),
+                        GL_STREAM_DRAW);
+
+                    for (const auto& k : batches)
+                    {
+                        const auto& primitive = k.primitives[0];
+                        primitiveBindData.color = primitive->color;
+                        j.first->primitiveBind(primitiveBindData);
+                        setInstanceAttributes(k.offset * sizeof(InstanceData));
+                        for (const auto& vaoIt : primitive->vaoRange)
+                        {
+                            glDrawArraysInstanced(
+                                primitive->type,
+                                static_cast<GLint>(vaoIt.getMin()),
+                                static_cast<GLsizei>(vaoIt.getMax() - vaoIt.getMin() + 1),
+                                static_cast<GLsizei>(k.primitives.size()));
+                            ++p.stats.drawCalls;
+                        }
+                    }
+#endif // DJV_GL_ES2
                 }
             }
 
@@ -310,6 +555,7 @@ namespace djv
                             meshCacheUIDs[uid] = meshCache->add(data, range);
                         }
                         primitive->vaoRange.push_back(range);
+                        addBBox(*primitive, i->bbox);
                     }
                 }
 
@@ -343,6 +589,7 @@ namespace djv
                     meshCacheUIDs[uid] = meshCache->add(data, range);
                 }
                 primitive->vaoRange.push_back(range);
+                addBBox(*primitive, value->bbox);
 
                 p.primitives[solidColorMeshType][primitive->material].push_back(primitive);
             }
@@ -378,6 +625,7 @@ namespace djv
                             meshCacheUIDs[uid] = meshCache->add(data, range);
                         }
                         primitive->vaoRange.push_back(range);
+                        addBBox(*primitive, i->bbox);
                     }
                 }
 
@@ -410,6 +658,8 @@ namespace djv
                     meshCacheUIDs[uid] = meshCache->add(data, range);
                 }
                 primitive->vaoRange.push_back(range);
+                addBBox(*primitive, value.bbox);
+                primitive->triangleCount += value.triangles.size();
 
                 p.primitives[shadedMeshType][primitive->material].push_back(primitive);
             }
@@ -444,6 +694,8 @@ namespace djv
                             meshCacheUIDs[uid] = meshCache->add(data, range);
                         }
                         primitive->vaoRange.push_back(range);
+                        addBBox(*primitive, i.bbox);
+                        primitive->triangleCount += i.triangles.size();
                     }
                 }
 
@@ -480,6 +732,8 @@ namespace djv
                             meshCacheUIDs[uid] = meshCache->add(data, range);
                         }
                         primitive->vaoRange.push_back(range);
+                        addBBox(*primitive, i->bbox);
+                        primitive->triangleCount += i->triangles.size();
                     }
                 }
 
@@ -487,6 +741,53 @@ namespace djv
             }
         }
 
+        void Render::drawTriangleMeshLODs(const std::vector<std::vector<std::shared_ptr<Geom::TriangleMesh> > >& value)
+        {
+            DJV_PRIVATE_PTR();
+            if (value.size())
+            {
+                auto primitive = std::shared_ptr<Primitive>(new Primitive);
+                primitive->xform = getCurrentTransform();
+                primitive->color = p.currentColor;
+                primitive->material = p.currentMaterial;
+
+                const glm::mat4x4 m = p.options.camera->getP() * p.options.camera->getV() * primitive->xform;
+                auto& meshCache = p.meshCache[shadedMeshType];
+                auto& meshCacheUIDs = p.meshCacheUIDs[shadedMeshType];
+                for (const auto& i : value)
+                {
+                    if (i.empty())
+                        continue;
+                    const auto& mesh = i[getLOD(getProjectedSize(i[0]->bbox, m, p.options.size), i.size())];
+                    if (mesh->triangles.size())
+                    {
+                        Math::SizeTRange range;
+                        const UID uid = mesh->getUID();
+                        const auto j = meshCacheUIDs.find(uid);
+                        if (j != meshCacheUIDs.end())
+                        {
+                            meshCache->get(j->second, range);
+                        }
+                        if (range.getMin() == range.getMax())
+                        {
+                            const auto data = GL::VBO::convert(*mesh, shadedMeshType);
+                            meshCacheUIDs[uid] = meshCache->add(data, range);
+                        }
+                        primitive->vaoRange.push_back(range);
+                        addBBox(*primitive, mesh->bbox);
+                        primitive->triangleCount += mesh->triangles.size();
+                    }
+                }
+
+                p.primitives[shadedMeshType][primitive->material].push_back(primitive);
+            }
+        }
+
+        const RenderStats& Render::getStats() const
+        {
+            return _p->stats;
+        }
+
         DJV_ENUM_HELPERS_IMPLEMENTATION(DepthBufferMode);
 
     } // namespace Render3D
@@ -52,6 +52,16 @@ namespace djv
             DepthBufferMode             depthBufferMode = DepthBufferMode::Reverse;
         };
 
+        //! This struct provides render statistics for the last frame.
+        struct RenderStats
+        {
+            size_t primitives        = 0;
+            size_t primitivesVisible = 0;
+            size_t triangles         = 0;
+            size_t trianglesVisible  = 0;
+            size_t drawCalls         = 0;
+        };
+
         //! This class provides a 3D render system.
         class Render : public System::ISystem
         {
@@ -112,6 +122,18 @@ namespace djv
             void drawTriangleMeshes(const std::vector<Geom::TriangleMesh>&);
             void drawTriangleMeshes(const std::vector<std::shared_ptr<Geom::TriangleMesh> >&);
 
+            //! Draw triangle meshes with levels of detail. Each list holds the
+            //! levels of a mesh from the highest resolution to the lowest, the
+            //! level is chosen from the projected size of the mesh.
+            void drawTriangleMeshLODs(const std::vector<std::vector<std::shared_ptr<Geom::TriangleMesh> > >&);
+
+            ///@}
+
+            //! \name Statistics
+            ///@{
+
+            const RenderStats& getStats() const;
+
             ///@}
 
         private:
@@ -0,0 +1,1014 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvScene3D/Cache.h>
+
+#include <djvScene3D/InstancePrimitive.h>
+#include <djvScene3D/Layer.h>
+#include <djvScene3D/Light.h>
+#include <djvScene3D/Material.h>
+#include <djvScene3D/MeshPrimitive.h>
+#include <djvScene3D/NullPrimitive.h>
+#include <djvScene3D/PointListPrimitive.h>
+#include <djvScene3D/PolyLinePrimitive.h>
+#include <djvScene3D/Scene.h>
+
+#include <djvSystem/File.h>
+#include <djvSystem/FileIO.h>
+#include <djvSystem/FileInfoFunc.h>
+#include <djvSystem/LogSystem.h>
+#include <djvSystem/TextSystem.h>
+
+#include <djvGeom/PointList.h>
+#include <djvGeom/TriangleMesh.h>
+
+#include <djvImage/TypeFunc.h>
+
+#include <djvCore/StringFormat.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace Scene3D
+    {
+        namespace IO
+        {
+            namespace Cache
+            {
+                namespace
+                {
+                    const char     magic[]      = "djvScene3DCache";
+                    const uint32_t endianMarker = 0x01020304;
+
+                    enum class PrimitiveType : uint8_t
+                    {
+                        Null,
+                        Mesh,
+                        PointList,
+                        PolyLine,
+                        Instance,
+                        HemisphereLight,
+                        DirectionalLight,
+                        PointLight,
+                        SpotLight
+                    };
+
+                    enum class LayerItemType : uint8_t
+                    {
+                        Layer,
+                        Primitive
+                    };
+
+                    const uint32_t invalidIndex = static_cast<uint32_t>(-1);
+
+                    //! This struct provides the cache file header.
+                    struct Header
+                    {
+                        char     magic[16];
+                        uint32_t version        = 0;
+                        uint32_t endian         = 0;
+                        uint32_t vertexSize     = 0;
+                        uint32_t triangleSize   = 0;
+                        uint64_t sourceSize     = 0;
+                        int64_t  sourceTime     = 0;
+                    };
+
+                    Header getHeader(const System::File::Info& fileInfo)
+                    {
+                        Header out;
+                        memcpy(out.magic, magic, sizeof(out.magic));
+                        out.version      = version;
+                        out.endian       = endianMarker;
+                        out.vertexSize   = static_cast<uint32_t>(sizeof(glm::vec3));
+                        out.triangleSize = static_cast<uint32_t>(sizeof(Geom::TriangleMesh::Triangle));
+                        out.sourceSize   = fileInfo.getSize();
+                        out.sourceTime   = static_cast<int64_t>(fileInfo.getTime());
+                        return out;
+                    }
+
+                    bool compare(const Header& a, const Header& b)
+                    {
+                        return
+                            0 == memcmp(a.magic, b.magic, sizeof(a.magic)) &&
+                            a.version      == b.version &&
+                            a.endian       == b.endian &&
+                            a.vertexSize   == b.vertexSize &&
+                            a.triangleSize == b.triangleSize &&
+                            a.sourceSize   == b.sourceSize &&
+                            a.sourceTime   == b.sourceTime;
+                    }
+
+                    //! This class provides a cache file writer.
+                    class Writer
+                    {
+                    public:
+                        explicit Writer(const std::shared_ptr<System::File::IO>& io) :
+                            _io(io)
+                        {}
+
+                        template<typename T>
+                        void value(const T& in)
+                        {
+                            _io->write(&in, sizeof(T));
+                        }
+
+                        template<typename T>
+                        void array(const std::vector<T>& in)
+                        {
+                            value(static_cast<uint64_t>(in.size()));
+                            if (in.size())
+                            {
+                                _io->write(in.data(), in.size() * sizeof(T));
+                            }
+                        }
+
+                        void string(const std::string& in)
+                        {
+                            value(static_cast<uint32_t>(in.size()));
+                            if (in.size())
+                            {
+                                _io->write(in.data(), in.size());
+                            }
+                        }
+
+                        void color(const Image::Color& in)
+                        {
+                            value(static_cast<uint8_t>(in.getType()));
+                            _io->write(in.getData(), Image::getByteCount(in.getType()));
+                        }
+
+                        void bbox(const Math::BBox3f& in)
+                        {
+                            value(in.min);
+                            value(in.max);
+                        }
+
+                    private:
+                        std::shared_ptr<System::File::IO> _io;
+                    };
+
+                    //! This class provides a cache file reader.
+                    class Reader
+                    {
+                    public:
+                        explicit Reader(const std::shared_ptr<System::File::IO>& io) :
+                            _io(io)
+                        {}
+
+                        template<typename T>
+                        T value()
+                        {
+                            T out;
+                            _io->read(&out, sizeof(T));
+                            return out;
+                        }
+
+                        template<typename T>
+                        void array(std::vector<T>& out)
+                        {
+                            const uint64_t size = value<uint64_t>();
+                            _check(size, sizeof(T));
+                            out.resize(size);
+                            if (size)
+                            {
+                                _io->read(out.data(), size * sizeof(T));
+                            }
+                        }
+
+                        //! Read a count of items that each take at least the
+                        //! given number of bytes in the file.
+                        uint32_t count(size_t itemSize)
+                        {
+                            const uint32_t out = value<uint32_t>();
+                            _check(out, itemSize);
+                            return out;
+                        }
+
+                        std::string string()
+                        {
+                            const uint32_t size = value<uint32_t>();
+                            _check(size, 1);
+                            std::string out(size, 0);
+                            if (size)
+                            {
+                                _io->read(&out[0], size);
+                            }
+                            return out;
+                        }
+
+                        Image::Color color()
+                        {
+                            const auto type = static_cast<Image::Type>(value<uint8_t>());
+                            if (type >= Image::Type::Count)
+                            {
+                                throw System::File::Error(String::Format("{0}: {1}").
+                                    arg(_io->getFileName()).
+                                    arg("The cache has an invalid color."));
+                            }
+                            Image::Color out(type);
+                            _io->read(out.getData(), Image::getByteCount(type));
+                            return out;
+                        }
+
+                        Math::BBox3f bbox()
+                        {
+                            Math::BBox3f out;
+                            out.min = value<glm::vec3>();
+                            out.max = value<glm::vec3>();
+                            return out;
+                        }
+
+                    private:
+                        void _check(uint64_t count, size_t itemSize)
+                        {
+                            if (count * itemSize > _io->getSize() - _io->getPos())
+                            {
+                                throw System::File::Error(String::Format("{0}: {1}").
+                                    arg(_io->getFileName()).
+                                    arg("The cache is truncated."));
+                            }
+                        }
+
+                        std::shared_ptr<System::File::IO> _io;
+                    };
+
+                    //! This struct provides the tables used to flatten the scene
+                    //! into indexed lists.
+                    struct WriteTables
+                    {
+                        std::vector<std::shared_ptr<IMaterial> > materials;
+                        std::map<std::shared_ptr<IMaterial>, uint32_t> materialIndices;
+                        std::vector<std::shared_ptr<IPrimitive> > primitives;
+                        std::map<std::shared_ptr<IPrimitive>, uint32_t> primitiveIndices;
+                        std::vector<std::shared_ptr<Layer> > layers;
+                        std::map<std::shared_ptr<Layer>, uint32_t> layerIndices;
+
+                        void add(const std::shared_ptr<IMaterial>& value)
+                        {
+                            if (value && materialIndices.find(value) == materialIndices.end())
+                            {
+                                if (!std::dynamic_pointer_cast<DefaultMaterial>(value))
+                                {
+                                    throw std::runtime_error("The scene has an unsupported material.");
+                                }
+                                materialIndices[value] = static_cast<uint32_t>(materials.size());
+                                materials.push_back(value);
+                            }
+                        }
+
+                        void add(const std::shared_ptr<IPrimitive>& value)
+                        {
+                            if (primitiveIndices.find(value) == primitiveIndices.end())
+                            {
+                                primitiveIndices[value] = static_cast<uint32_t>(primitives.size());
+                                primitives.push_back(value);
+                                add(value->getMaterial());
+                                for (const auto& i : value->getChildren())
+                                {
+                                    add(i);
+                                }
+                                if (auto instance = std::dynamic_pointer_cast<InstancePrimitive>(value))
+                                {
+                                    for (const auto& i : instance->getInstances())
+                                    {
+                                        add(i);
+                                    }
+                                }
+                            }
+                        }
+
+                        void add(const std::shared_ptr<Layer>& value)
+                        {
+                            if (layerIndices.find(value) == layerIndices.end())
+                            {
+                                layerIndices[value] = static_cast<uint32_t>(layers.size());
+                                layers.push_back(value);
+                                add(value->getMaterial());
+                                for (const auto& i : value->getItems())
+                                {
+                                    if (auto layer = std::dynamic_pointer_cast<Layer>(i))
+                                    {
+                                        add(layer);
+                                    }
+                                    else if (auto primitive = std::dynamic_pointer_cast<IPrimitive>(i))
+                                    {
+                                        add(primitive);
+                                    }
+                                }
+                            }
+                        }
+
+                        uint32_t getIndex(const std::shared_ptr<IMaterial>& value) const
+                        {
+                            const auto i = materialIndices.find(value);
+                            return i != materialIndices.end() ? i->second : invalidIndex;
+                        }
+                    };
+
+                    PrimitiveType getPrimitiveType(const std::shared_ptr<IPrimitive>& value)
+                    {
+                        if (std::dynamic_pointer_cast<MeshPrimitive>(value))
+                            return PrimitiveType::Mesh;
+                        if (std::dynamic_pointer_cast<PointListPrimitive>(value))
+                            return PrimitiveType::PointList;
+                        if (std::dynamic_pointer_cast<PolyLinePrimitive>(value))
+                            return PrimitiveType::PolyLine;
+                        if (std::dynamic_pointer_cast<InstancePrimitive>(value))
+                            return PrimitiveType::Instance;
+                        if (std::dynamic_pointer_cast<HemisphereLight>(value))
+                            return PrimitiveType::HemisphereLight;
+                        if (std::dynamic_pointer_cast<DirectionalLight>(value))
+                            return PrimitiveType::DirectionalLight;
+                        if (std::dynamic_pointer_cast<PointLight>(value))
+                            return PrimitiveType::PointLight;
+                        if (std::dynamic_pointer_cast<SpotLight>(value))
+                            return PrimitiveType::SpotLight;
+                        if (std::dynamic_pointer_cast<NullPrimitive>(value))
+                            return PrimitiveType::Null;
+                        throw std::runtime_error(String::Format("The scene has an unsupported primitive: {0}").
+                            arg(value->getClassName()));
+                    }
+
+                    void writeMesh(Writer& writer, const Geom::TriangleMesh& value)
+                    {
+                        writer.array(value.v);
+                        writer.array(value.c);
+                        writer.array(value.t);
+                        writer.array(value.n);
+                        writer.array(value.triangles);
+                        writer.bbox(value.bbox);
+                    }
+
+                    std::shared_ptr<Geom::TriangleMesh> readMesh(Reader& reader)
+                    {
+                        auto out = std::shared_ptr<Geom::TriangleMesh>(new Geom::TriangleMesh);
+                        reader.array(out->v);
+                        reader.array(out->c);
+                        reader.array(out->t);
+                        reader.array(out->n);
+                        reader.array(out->triangles);
+                        out->bbox = reader.bbox();
+                        return out;
+                    }
+
+                    void writePointList(Writer& writer, const Geom::PointList& value)
+                    {
+                        writer.array(value.v);
+                        writer.array(value.c);
+                        writer.bbox(value.bbox);
+                    }
+
+                    std::shared_ptr<Geom::PointList> readPointList(Reader& reader)
+                    {
+                        auto out = std::shared_ptr<Geom::PointList>(new Geom::PointList);
+                        reader.array(out->v);
+                        reader.array(out->c);
+                        out->bbox = reader.bbox();
+                        return out;
+                    }
+
+                    void writeLight(Writer& writer, const std::shared_ptr<ILight>& value)
+                    {
+                        writer.value(static_cast<uint8_t>(value->isEnabled()));
+                        writer.value(value->getIntensity());
+                    }
+
+                    void readLight(Reader& reader, const std::shared_ptr<ILight>& value)
+                    {
+                        value->setEnabled(reader.value<uint8_t>() != 0);
+                        value->setIntensity(reader.value<float>());
+                    }
+
+                    std::shared_ptr<IPrimitive> createPrimitive(PrimitiveType type)
+                    {
+                        std::shared_ptr<IPrimitive> out;
+                        switch (type)
+                        {
+                        case PrimitiveType::Null:             out = NullPrimitive::create(); break;
+                        case PrimitiveType::Mesh:             out = MeshPrimitive::create(); break;
+                        case PrimitiveType::PointList:        out = PointListPrimitive::create(); break;
+                        case PrimitiveType::PolyLine:         out = PolyLinePrimitive::create(); break;
+                        case PrimitiveType::Instance:         out = InstancePrimitive::create(); break;
+                        case PrimitiveType::HemisphereLight:  out = HemisphereLight::create(); break;
+                        case PrimitiveType::DirectionalLight: out = DirectionalLight::create(); break;
+                        case PrimitiveType::PointLight:       out = PointLight::create(); break;
+                        case PrimitiveType::SpotLight:        out = SpotLight::create(); break;
+                        default: break;
+                        }
+                        if (!out)
+                        {
+                            throw std::runtime_error("The cache has an invalid primitive.");
+                        }
+                        return out;
+                    }
+
+                    uint32_t checkIndex(uint32_t value, size_t size)
+                    {
+                        if (value != invalidIndex && value >= size)
+                        {
+                            throw std::runtime_error("The cache has an invalid index.");
+                        }
+                        return value;
+                    }
+
+                } // namespace
+
+                System::File::Path getFileName(const System::File::Path& cachePath, const System::File::Info& fileInfo)
+                {
+                    const std::string fileName = fileInfo.getFileName();
+                    std::stringstream ss;
+                    ss << std::hex << std::setw(16) << std::setfill('0') <<
+                        static_cast<uint64_t>(std::hash<std::string>()(fileName));
+                    ss << fileExtension;
+                    return System::File::Path(cachePath, ss.str());
+                }
+
+                bool isValid(const System::File::Path& path, const System::File::Info& fileInfo)
+                {
+                    bool out = false;
+                    try
+                    {
+                        auto io = System::File::IO::create();
+                        io->open(path.get(), System::File::Mode::Read);
+                        Reader reader(io);
+                        const Header header = reader.value<Header>();
+                        out =
+                            compare(header, getHeader(fileInfo)) &&
+                            reader.string() == fileInfo.getFileName();
+                    }
+                    catch (const std::exception&)
+                    {}
+                    return out;
+                }
+
+                void write(const System::File::Path& path, const System::File::Info& fileInfo, const std::shared_ptr<Scene>& scene)
+                {
+                    // Flatten the scene into indexed tables. This throws for
+                    // scenes the cache cannot represent, before any file is
+                    // created.
+                    WriteTables tables;
+                    for (const auto& i : scene->getPrimitives())
+                    {
+                        tables.add(i);
+                    }
+                    for (const auto& i : scene->getDefinitions())
+                    {
+                        tables.add(i);
+                    }
+                    for (const auto& i : scene->getLayers())
+                    {
+                        tables.add(i);
+                    }
+                    std::vector<PrimitiveType> primitiveTypes;
+                    for (const auto& i : tables.primitives)
+                    {
+                        primitiveTypes.push_back(getPrimitiveType(i));
+                    }
+
+                    // Write to a temporary file and then rename it so that a
+                    // partially written cache is never read.
+                    const std::string fileName = path.get();
+                    const std::string tmpFileName = fileName + ".tmp";
+                    {
+                        auto io = System::File::IO::create();
+                        io->open(tmpFileName, System::File::Mode::Write);
+                        Writer writer(io);
+                        writer.value(getHeader(fileInfo));
+                        writer.string(fileInfo.getFileName());
+
+                        writer.value(static_cast<uint8_t>(scene->getSceneOrient()));
+                        writer.value(scene->getSceneXForm());
+
+                        writer.value(static_cast<uint32_t>(tables.materials.size()));
+                        for (const auto& i : tables.materials)
+                        {
+                            const auto material = std::dynamic_pointer_cast<DefaultMaterial>(i);
+                            writer.color(material->getAmbient());
+                            writer.color(material->getDiffuse());
+                            writer.color(material->getEmission());
+                            writer.color(material->getSpecular());
+                            writer.value(material->getShine());
+                            writer.value(material->getTransparency());
+                            writer.value(material->getReflectivity());
+                            writer.value(static_cast<uint8_t>(material->hasDisableLighting()));
+                        }
+
+                        writer.value(static_cast<uint32_t>(tables.primitives.size()));
+                        for (size_t i = 0; i < tables.primitives.size(); ++i)
+                        {
+                            const auto& primitive = tables.primitives[i];
+                            writer.value(primitiveTypes[i]);
+                            writer.string(primitive->getName());
+                            writer.value(static_cast<uint8_t>(primitive->isVisible()));
+                            writer.bbox(primitive->getBBox());
+                            writer.value(primitive->getXForm());
+                            writer.value(static_cast<uint8_t>(primitive->getColorAssignment()));
+                            writer.color(primitive->getColor());
+                            writer.value(static_cast<uint8_t>(primitive->getMaterialAssignment()));
+                            writer.value(tables.getIndex(primitive->getMaterial()));
+                            const auto& children = primitive->getChildren();
+                            writer.value(static_cast<uint32_t>(children.size()));
+                            for (const auto& j : children)
+                            {
+                                writer.value(tables.primitiveIndices[j]);
+                            }
+                            switch (primitiveTypes[i])
+                            {
+                            case PrimitiveType::Mesh:
+                            {
+                                const auto& meshes = primitive->getMeshes();
+                                const auto& lods = primitive->getMeshLODs();
+                                writer.value(static_cast<uint32_t>(meshes.size()));
+                                for (size_t j = 0; j < meshes.size(); ++j)
+                                {
+                                    writeMesh(writer, *meshes[j]);
+                                    const size_t lodCount = j < lods.size() && lods[j].size() > 1 ? lods[j].size() - 1 : 0;
+                                    writer.value(static_cast<uint32_t>(lodCount));
+                                    for (size_t k = 0; k < lodCount; ++k)
+                                    {
+                                        writeMesh(writer, *lods[j][k + 1]);
+                                    }
+                                }
+                                break;
+                            }
+                            case PrimitiveType::PointList:
+                            {
+                                const auto& pointList = primitive->getPointList();
+                                writer.value(static_cast<uint8_t>(pointList ? 1 : 0));
+                                if (pointList)
+                                {
+                                    writePointList(writer, *pointList);
+                                }
+                                break;
+                            }
+                            case PrimitiveType::PolyLine:
+                            {
+                                const auto& polyLines = primitive->getPolyLines();
+                                writer.value(static_cast<uint32_t>(polyLines.size()));
+                                for (const auto& j : polyLines)
+                                {
+                                    writePointList(writer, *j);
+                                }
+                                break;
+                            }
+                            case PrimitiveType::Instance:
+                            {
+                                const auto& instances = std::dynamic_pointer_cast<InstancePrimitive>(primitive)->getInstances();
+                                writer.value(static_cast<uint32_t>(instances.size()));
+                                for (const auto& j : instances)
+                                {
+                                    writer.value(tables.primitiveIndices[j]);
+                                }
+                                break;
+                            }
+                            case PrimitiveType::HemisphereLight:
+                            {
+                                const auto light = std::dynamic_pointer_cast<HemisphereLight>(primitive);
+                                writeLight(writer, light);
+                                writer.value(light->getUp());
+                                writer.color(light->getTopColor());
+                                writer.color(light->getBottomColor());
+                                break;
+                            }
+                            case PrimitiveType::DirectionalLight:
+                            {
+                                const auto light = std::dynamic_pointer_cast<DirectionalLight>(primitive);
+                                writeLight(writer, light);
+                                writer.value(light->getDirection());
+                                break;
+                            }
+                            case PrimitiveType::PointLight:
+                                writeLight(writer, std::dynamic_pointer_cast<PointLight>(primitive));
+                                break;
+                            case PrimitiveType::SpotLight:
+                            {
+                                const auto light = std::dynamic_pointer_cast<SpotLight>(primitive);
+                                writeLight(writer, light);
+                                writer.value(light->getConeAngle());
+                                writer.value(light->getDirection());
+                                break;
+                            }
+                            default: break;
+                            }
+                        }
+
+                        writer.value(static_cast<uint32_t>(tables.layers.size()));
+                        for (const auto& i : tables.layers)
+                        {
+                            writer.string(i->getName());
+                            writer.value(static_cast<uint8_t>(i->isVisible()));
+                            writer.color(i->getColor());
+                            writer.value(tables.getIndex(i->getMaterial()));
+                            std::vector<std::pair<LayerItemType, uint32_t> > items;
+                            for (const auto& j : i->getItems())
+                            {
+                                if (auto layer = std::dynamic_pointer_cast<Layer>(j))
+                                {
+                                    items.push_back(std::make_pair(LayerItemType::Layer, tables.layerIndices[layer]));
+                                }
+                                else if (auto primitive = std::dynamic_pointer_cast<IPrimitive>(j))
+                                {
+                                    items.push_back(std::make_pair(LayerItemType::Primitive, tables.primitiveIndices[primitive]));
+                                }
+                            }
+                            writer.value(static_cast<uint32_t>(items.size()));
+                            for (const auto& j : items)
+                            {
+                                writer.value(j.first);
+                                writer.value(j.second);
+                            }
+                        }
+
+                        writer.value(static_cast<uint32_t>(scene->getPrimitives().size()));
+                        for (const auto& i : scene->getPrimitives())
+                        {
+                            writer.value(tables.primitiveIndices[i]);
+                        }
+                        writer.value(static_cast<uint32_t>(scene->getDefinitions().size()));
+                        for (const auto& i : scene->getDefinitions())
+                        {
+                            writer.value(tables.primitiveIndices[i]);
+                        }
+                        writer.value(static_cast<uint32_t>(scene->getLayers().size()));
+                        for (const auto& i : scene->getLayers())
+                        {
+                            writer.value(tables.layerIndices[i]);
+                        }
+
+                        std::string error;
+                        if (!io->close(&error))
+                        {
+                            throw System::File::Error(error);
+                        }
+                    }
+                    std::remove(fileName.c_str());
+                    if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+                    {
+                        std::remove(tmpFileName.c_str());
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg("Cannot rename the cache."));
+                    }
+                }
+
+                std::shared_ptr<Scene> read(const System::File::Path& path, const System::File::Info& fileInfo)
+                {
+                    auto io = System::File::IO::create();
+                    io->open(path.get(), System::File::Mode::Read);
+                    Reader reader(io);
+                    const Header header = reader.value<Header>();
+                    if (!compare(header, getHeader(fileInfo)) ||
+                        reader.string() != fileInfo.getFileName())
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(path.get()).
+                            arg("The cache is out of date."));
+                    }
+
+                    auto out = Scene::create();
+                    out->setSceneOrient(static_cast<SceneOrient>(reader.value<uint8_t>()));
+                    out->setSceneXForm(reader.value<glm::mat4x4>());
+
+                    std::vector<std::shared_ptr<IMaterial> > materials(reader.count(1));
+                    for (auto& i : materials)
+                    {
+                        auto material = DefaultMaterial::create();
+                        material->setAmbient(reader.color());
+                        material->setDiffuse(reader.color());
+                        material->setEmission(reader.color());
+                        material->setSpecular(reader.color());
+                        material->setShine(reader.value<float>());
+                        material->setTransparency(reader.value<float>());
+                        material->setReflectivity(reader.value<float>());
+                        material->setDisableLighting(reader.value<uint8_t>() != 0);
+                        i = material;
+                    }
+
+                    // The primitives are created first and linked together
+                    // afterwards since they may reference each other in any
+                    // order.
+                    const uint32_t primitiveCount = reader.count(1);
+                    std::vector<std::shared_ptr<IPrimitive> > primitives;
+                    std::vector<std::vector<uint32_t> > children(primitiveCount);
+                    std::vector<std::vector<uint32_t> > instances(primitiveCount);
+                    primitives.reserve(primitiveCount);
+                    for (uint32_t i = 0; i < primitiveCount; ++i)
+                    {
+                        const auto type = reader.value<PrimitiveType>();
+                        auto primitive = createPrimitive(type);
+                        primitive->setName(reader.string());
+                        primitive->setVisible(reader.value<uint8_t>() != 0);
+                        primitive->setBBox(reader.bbox());
+                        primitive->setXForm(reader.value<glm::mat4x4>());
+                        primitive->setColorAssignment(static_cast<ColorAssignment>(reader.value<uint8_t>()));
+                        primitive->setColor(reader.color());
+                        primitive->setMaterialAssignment(static_cast<MaterialAssignment>(reader.value<uint8_t>()));
+                        const uint32_t material = checkIndex(reader.value<uint32_t>(), materials.size());
+                        if (material != invalidIndex)
+                        {
+                            primitive->setMaterial(materials[material]);
+                        }
+                        children[i].resize(reader.count(sizeof(uint32_t)));
+                        for (auto& j : children[i])
+                        {
+                            j = checkIndex(reader.value<uint32_t>(), primitiveCount);
+                        }
+                        switch (type)
+                        {
+                        case PrimitiveType::Mesh:
+                        {
+                            auto mesh = std::dynamic_pointer_cast<MeshPrimitive>(primitive);
+                            const uint32_t count = reader.value<uint32_t>();
+                            for (uint32_t j = 0; j < count; ++j)
+                            {
+                                std::vector<std::shared_ptr<Geom::TriangleMesh> > lods;
+                                lods.push_back(readMesh(reader));
+                                mesh->addMesh(lods[0]);
+                                const uint32_t lodCount = reader.value<uint32_t>();
+                                for (uint32_t k = 0; k < lodCount; ++k)
+                                {
+                                    lods.push_back(readMesh(reader));
+                                }
+                                mesh->setMeshLODs(j, lods);
+                            }
+                            break;
+                        }
+                        case PrimitiveType::PointList:
+                            if (reader.value<uint8_t>())
+                            {
+                                std::dynamic_pointer_cast<PointListPrimitive>(primitive)->setPointList(readPointList(reader));
+                            }
+                            break;
+                        case PrimitiveType::PolyLine:
+                        {
+                            auto polyLine = std::dynamic_pointer_cast<PolyLinePrimitive>(primitive);
+                            const uint32_t count = reader.value<uint32_t>();
+                            for (uint32_t j = 0; j < count; ++j)
+                            {
+                                polyLine->addPointList(readPointList(reader));
+                            }
+                            break;
+                        }
+                        case PrimitiveType::Instance:
+                            instances[i].resize(reader.count(sizeof(uint32_t)));
+                            for (auto& j : instances[i])
+                            {
+                                j = checkIndex(reader.value<uint32_t>(), primitiveCount);
+                            }
+                            break;
+                        case PrimitiveType::HemisphereLight:
+                        {
+                            auto light = std::dynamic_pointer_cast<HemisphereLight>(primitive);
+                            readLight(reader, light);
+                            light->setUp(reader.value<glm::vec3>());
+                            light->setTopColor(reader.color());
+                            light->setBottomColor(reader.color());
+                            break;
+                        }
+                        case PrimitiveType::DirectionalLight:
+                        {
+                            auto light = std::dynamic_pointer_cast<DirectionalLight>(primitive);
+                            readLight(reader, light);
+                            light->setDirection(reader.value<glm::vec3>());
+                            break;
+                        }
+                        case PrimitiveType::PointLight:
+                            readLight(reader, std::dynamic_pointer_cast<PointLight>(primitive));
+                            break;
+                        case PrimitiveType::SpotLight:
+                        {
+                            auto light = std::dynamic_pointer_cast<SpotLight>(primitive);
+                            readLight(reader, light);
+                            light->setConeAngle(reader.value<float>());
+                            light->setDirection(reader.value<glm::vec3>());
+                            break;
+                        }
+                        default: break;
+                        }
+                        primitives.push_back(primitive);
+                    }
+                    for (uint32_t i = 0; i < primitiveCount; ++i)
+                    {
+                        for (const auto j : children[i])
+                        {
+                            primitives[i]->addChild(primitives[j]);
+                        }
+                        if (!instances[i].empty())
+                        {
+                            auto instance = std::dynamic_pointer_cast<InstancePrimitive>(primitives[i]);
+                            for (const auto j : instances[i])
+                            {
+                                instance->addInstance(primitives[j]);
+                            }
+                        }
+                    }
+
+                    const uint32_t layerCount = reader.count(1);
+                    std::vector<std::shared_ptr<Layer> > layers;
+                    std::vector<std::vector<std::pair<LayerItemType, uint32_t> > > layerItems(layerCount);
+                    layers.reserve(layerCount);
+                    for (uint32_t i = 0; i < layerCount; ++i)
+                    {
+                        auto layer = Layer::create();
+                        layer->setName(reader.string());
+                        layer->setVisible(reader.value<uint8_t>() != 0);
+                        layer->setColor(reader.color());
+                        const uint32_t material = checkIndex(reader.value<uint32_t>(), materials.size());
+                        if (material != invalidIndex)
+                        {
+                            layer->setMaterial(materials[material]);
+                        }
+                        layerItems[i].resize(reader.count(sizeof(LayerItemType) + sizeof(uint32_t)));
+                        for (auto& j : layerItems[i])
+                        {
+                            j.first = reader.value<LayerItemType>();
+                            j.second = reader.value<uint32_t>();
+                        }
+                        layers.push_back(layer);
+                    }
+                    for (uint32_t i = 0; i < layerCount; ++i)
+                    {
+                        for (const auto& j : layerItems[i])
+                        {
+                            switch (j.first)
+                            {
+                            case LayerItemType::Layer:
+                                layers[i]->addItem(layers[checkIndex(j.second, layerCount)]);
+                                break;
+                            case LayerItemType::Primitive:
+                                layers[i]->addItem(primitives[checkIndex(j.second, primitiveCount)]);
+                                break;
+                            default:
+                                throw std::runtime_error("The cache has an invalid layer item.");
+                            }
+                        }
+                    }
+
+                    uint32_t count = reader.value<uint32_t>();
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        out->addPrimitive(primitives[checkIndex(reader.value<uint32_t>(), primitiveCount)]);
+                    }
+                    count = reader.value<uint32_t>();
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        out->addDefinition(primitives[checkIndex(reader.value<uint32_t>(), primitiveCount)]);
+                    }
+                    count = reader.value<uint32_t>();
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        out->addLayer(layers[checkIndex(reader.value<uint32_t>(), layerCount)]);
+                    }
+                    return out;
+                }
+
+                size_t prune(const System::File::Path& cachePath, uint64_t byteMax, const System::File::Path& keep)
+                {
+                    // List the cache files with the oldest first.
+                    System::File::DirectoryListOptions options;
+                    options.extensions.insert(fileExtension);
+                    options.sort = System::File::DirectoryListSort::Time;
+                    const auto list = System::File::directoryList(cachePath, options);
+                    uint64_t byteCount = 0;
+                    for (const auto& i : list)
+                    {
+                        byteCount += i.getSize();
+                    }
+
+                    size_t out = 0;
+                    for (auto i = list.begin(); i != list.end() && byteCount > byteMax; ++i)
+                    {
+                        if (i->getPath() != keep &&
+                            0 == std::remove(i->getFileName().c_str()))
+                        {
+                            byteCount -= std::min(byteCount, i->getSize());
+                            ++out;
+                        }
+                    }
+                    return out;
+                }
+
+                struct Read::Private
+                {
+                    System::File::Path cacheFileName;
+                    std::shared_ptr<IRead> source;
+                    bool readCache = false;
+                    uint64_t cacheByteMax = byteMaxDefault;
+                };
+
+                Read::Read() :
+                    _p(new Private)
+                {}
+
+                Read::~Read()
+                {}
+
+                std::shared_ptr<Read> Read::create(
+                    const System::File::Info& fileInfo,
+                    const System::File::Path& cacheFileName,
+                    const std::shared_ptr<IRead>& source,
+                    bool readCache,
+                    uint64_t cacheByteMax,
+                    const std::shared_ptr<System::TextSystem>& textSystem,
+                    const std::shared_ptr<System::ResourceSystem>& resourceSystem,
+                    const std::shared_ptr<System::LogSystem>& logSystem)
+                {
+                    auto out = std::shared_ptr<Read>(new Read);
+                    out->_init(fileInfo, textSystem, resourceSystem, logSystem);
+                    out->_p->cacheFileName = cacheFileName;
+                    out->_p->source = source;
+                    out->_p->readCache = readCache;
+                    out->_p->cacheByteMax = cacheByteMax;
+                    return out;
+                }
+
+                std::future<Info> Read::getInfo()
+                {
+                    DJV_PRIVATE_PTR();
+                    if (p.source && !p.readCache)
+                    {
+                        return p.source->getInfo();
+                    }
+                    return std::async(
+                        std::launch::async,
+                        [this]
+                        {
+                            return Info();
+                        });
+                }
+
+                std::future<std::shared_ptr<Scene> > Read::getScene()
+                {
+                    return std::async(
+                        std::launch::async,
+                        [this]
+                        {
+                            DJV_PRIVATE_PTR();
+                            std::shared_ptr<Scene> out;
+                            if (p.readCache)
+                            {
+                                try
+                                {
+                                    out = read(p.cacheFileName, _fileInfo);
+                                }
+                                catch (const std::exception& e)
+                                {
+                                    _logSystem->log(
+                                        "djv::Scene3D::IO::Cache",
+                                        String::Format("{0}: {1}").
+                                            arg(_fileInfo.getFileName()).
+                                            arg(e.what()),
+                                        p.source ? System::LogLevel::Warning : System::LogLevel::Error);
+                                }
+                            }
+
+                            // Read the source file if the cache could not be
+                            // used and replace the cache.
+                            if (!out && p.source)
+                            {
+                                out = p.source->getScene().get();
+                                if (out)
+                                {
+                                    try
+                                    {
+                                        write(p.cacheFileName, _fileInfo, out);
+                                        const size_t count = prune(
+                                            System::File::Path(p.cacheFileName.getDirectoryName()),
+                                            p.cacheByteMax,
+                                            p.cacheFileName);
+                                        if (count > 0)
+                                        {
+                                            _logSystem->log(
+                                                "djv::Scene3D::IO::Cache",
+                                                String::Format("Removed {0} old cache files").arg(count));
+                                        }
+                                    }
+                                    catch (const std::exception& e)
+                                    {
+                                        _logSystem->log(
+                                            "djv::Scene3D::IO::Cache",
+                                            String::Format("{0}: {1}").
+                                                arg(_fileInfo.getFileName()).
+                                                arg(e.what()),
+                                            System::LogLevel::Warning);
+                                    }
+                                }
+                            }
+                            return out;
+                        });
+                }
+
+            } // namespace Cache
+        } // namespace IO
+    } // namespace Scene3D
+} // namespace djv
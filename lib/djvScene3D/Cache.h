@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvScene3D/IO.h>
+
+#include <djvSystem/Path.h>
+
+#include <djvCore/Memory.h>
+
+namespace djv
+{
+    namespace Scene3D
+    {
+        namespace IO
+        {
+            //! This namespace provides a binary cache of converted scenes.
+            //!
+            //! The cache stores the scene hierarchy, materials, layers, and the
+            //! raw triangle mesh (including levels of detail) and point list
+            //! buffers. The buffers are stored contiguously in their in-memory
+            //! layout so they can be copied directly from a memory-mapped file.
+            //! Cache files are keyed by the source file path, modification time,
+            //! and size.
+            namespace Cache
+            {
+                //! The cache file format version. This should be incremented
+                //! whenever the format or the in-memory layouts change.
+                const uint32_t version = 2;
+
+                //! The cache file extension.
+                static const std::string fileExtension = ".djvscene";
+
+                //! The default maximum size of the cache directory.
+                const uint64_t byteMaxDefault = Core::Memory::gigabyte;
+
+                //! Get the cache file name for a source file.
+                System::File::Path getFileName(const System::File::Path& cachePath, const System::File::Info&);
+
+                //! Get whether a cache file is valid for a source file.
+                bool isValid(const System::File::Path&, const System::File::Info&);
+
+                //! Write a cache file.
+                //! Throws:
+                //! - System::File::Error
+                //! - std::exception
+                void write(const System::File::Path&, const System::File::Info&, const std::shared_ptr<Scene>&);
+
+                //! Read a cache file.
+                //! Throws:
+                //! - System::File::Error
+                //! - std::exception
+                std::shared_ptr<Scene> read(const System::File::Path&, const System::File::Info&);
+
+                //! Remove the oldest cache files until the total size of the
+                //! cache directory is less than or equal to the given maximum.
+                //! The given cache file is kept so that the file that was just
+                //! written is not removed. Returns the number of files removed.
+                size_t prune(const System::File::Path& cachePath, uint64_t byteMax, const System::File::Path& keep = System::File::Path());
+
+                //! This class provides a reader that uses the cache. If the cache
+                //! is read and it cannot be loaded the reader falls back to the
+                //! source reader. Scenes read with the source reader are written
+                //! to the cache, and the cache directory is then pruned to the
+                //! given maximum size.
+                class Read : public IRead
+                {
+                    DJV_NON_COPYABLE(Read);
+
+                protected:
+                    Read();
+
+                public:
+                    ~Read() override;
+
+                    static std::shared_ptr<Read> create(
+                        const System::File::Info&,
+                        const System::File::Path& cacheFileName,
+                        const std::shared_ptr<IRead>& source,
+                        bool readCache,
+                        uint64_t cacheByteMax,
+                        const std::shared_ptr<System::TextSystem>&,
+                        const std::shared_ptr<System::ResourceSystem>&,
+                        const std::shared_ptr<System::LogSystem>&);
+
+                    std::future<Info> getInfo() override;
+                    std::future<std::shared_ptr<Scene> > getScene() override;
+
+                private:
+                    DJV_PRIVATE();
+                };
+
+            } // namespace Cache
+        } // namespace IO
+    } // namespace Scene3D
+} // namespace djv
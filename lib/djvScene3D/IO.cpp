@@ -4,6 +4,7 @@
 
 #include <djvScene3D/IO.h>
 
+#include <djvScene3D/Cache.h>
 #include <djvScene3D/OBJ.h>
 #if defined(OpenNURBS_FOUND)
 #include <djvScene3D/OpenNURBS.h>
@@ -12,6 +13,7 @@
 #include <djvSystem/Context.h>
 #include <djvSystem/File.h>
 #include <djvSystem/LogSystem.h>
+#include <djvSystem/PathFunc.h>
 #include <djvSystem/ResourceSystem.h>
 #include <djvSystem/TextSystem.h>
 
@@ -135,6 +137,9 @@ namespace djv
                 std::shared_ptr<Observer::ValueSubject<bool> > optionsChanged;
                 std::map<std::string, std::shared_ptr<IPlugin> > plugins;
                 std::set<std::string> sequenceExtensions;
+                bool cacheEnabled = true;
+                System::File::Path cachePath;
+                uint64_t cacheByteMax = Cache::byteMaxDefault;
             };
 
             void IOSystem::_init(const std::shared_ptr<System::Context>& context)
@@ -145,6 +150,8 @@ namespace djv
 
                 p.optionsChanged = Observer::ValueSubject<bool>::create();
 
+                p.cachePath = System::File::Path(_getResourceSystem()->getPath(System::File::ResourcePath::Documents), "SceneCache");
+
                 p.plugins[OBJ::pluginName] = OBJ::Plugin::create(context);
 #if defined(OpenNURBS_FOUND)
                 p.plugins[OpenNURBS::pluginName] = OpenNURBS::Plugin::create(context);
@@ -281,6 +288,41 @@ namespace djv
                             arg(textSystem->getText(DJV_TEXT("error_file_read"))));
                     }
                 }
+                auto context = getContext().lock();
+                if (out && p.cacheEnabled && context)
+                {
+                    try
+                    {
+                        // Get the current information for the file since the
+                        // cache is keyed by the modification time and size.
+                        const System::File::Info sourceInfo(fileInfo.getPath());
+                        if (!System::File::Info(p.cachePath).doesExist())
+                        {
+                            System::File::mkdir(p.cachePath);
+                        }
+                        const auto cacheFileName = Cache::getFileName(p.cachePath, sourceInfo);
+                        const bool cacheValid = Cache::isValid(cacheFileName, sourceInfo);
+                        if (cacheValid)
+                        {
+                            std::stringstream ss;
+                            ss << "Reading from the cache: " << fileInfo.getFileName();
+                            _log(ss.str());
+                        }
+                        out = Cache::Read::create(
+                            sourceInfo,
+                            cacheFileName,
+                            out,
+                            cacheValid,
+                            p.cacheByteMax,
+                            context->getSystemT<System::TextSystem>(),
+                            context->getSystemT<System::ResourceSystem>(),
+                            context->getSystemT<System::LogSystem>());
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _log(e.what(), System::LogLevel::Warning);
+                    }
+                }
                 return out;
             }
 
@@ -309,6 +351,36 @@ namespace djv
                 return out;
             }
 
+            bool IOSystem::isCacheEnabled() const
+            {
+                return _p->cacheEnabled;
+            }
+
+            const System::File::Path& IOSystem::getCachePath() const
+            {
+                return _p->cachePath;
+            }
+
+            uint64_t IOSystem::getCacheByteMax() const
+            {
+                return _p->cacheByteMax;
+            }
+
+            void IOSystem::setCacheEnabled(bool value)
+            {
+                _p->cacheEnabled = value;
+            }
+
+            void IOSystem::setCachePath(const System::File::Path& value)
+            {
+                _p->cachePath = value;
+            }
+
+            void IOSystem::setCacheByteMax(uint64_t value)
+            {
+                _p->cacheByteMax = value;
+            }
+
         } // namespace IO
     } // namespace Scene3D
 } // namespace djv
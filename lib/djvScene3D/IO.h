@@ -6,6 +6,7 @@
 
 #include <djvSystem/FileInfo.h>
 #include <djvSystem/ISystem.h>
+#include <djvSystem/Path.h>
 
 #include <djvCore/RapidJSONFunc.h>
 #include <djvCore/ValueObserver.h>
@@ -167,6 +168,23 @@ namespace djv
                 //! - System::File::Error
                 std::shared_ptr<IWrite> write(const System::File::Info&);
 
+                //! \name Cache
+                //! Scenes that are read are written to a binary cache so that
+                //! subsequent reads of the same file do not need to convert it
+                //! again. When a scene is written to the cache the oldest cache
+                //! files are removed to keep the cache under the maximum size.
+                ///@{
+
+                bool isCacheEnabled() const;
+                const System::File::Path& getCachePath() const;
+                uint64_t getCacheByteMax() const;
+
+                void setCacheEnabled(bool);
+                void setCachePath(const System::File::Path&);
+                void setCacheByteMax(uint64_t);
+
+                ///@}
+
             private:
                 DJV_PRIVATE();
             };
@@ -13,6 +13,7 @@ namespace djv
     namespace Scene3D
     {
         std::vector<std::shared_ptr<Geom::TriangleMesh> > IPrimitive::_meshesDummy;
+        std::vector<std::vector<std::shared_ptr<Geom::TriangleMesh> > > IPrimitive::_meshLODsDummy;
         std::vector<std::shared_ptr<Geom::PointList> > IPrimitive::_polyLinesDummy;
         std::shared_ptr<Geom::PointList> IPrimitive::_pointListDummy;
         
@@ -91,6 +91,11 @@ namespace djv
             virtual const std::vector<std::shared_ptr<IPrimitive> >& getPrimitives() const;
 
             virtual const std::vector<std::shared_ptr<Geom::TriangleMesh> >& getMeshes() const;
+
+            //! Get the levels of detail for each mesh. The first level of each
+            //! list is the full resolution mesh.
+            virtual const std::vector<std::vector<std::shared_ptr<Geom::TriangleMesh> > >& getMeshLODs() const;
+
             virtual const std::vector<std::shared_ptr<Geom::PointList> >& getPolyLines() const;
             virtual const std::shared_ptr<Geom::PointList>& getPointList() const;
 
@@ -110,6 +115,7 @@ namespace djv
             std::weak_ptr<IPrimitive> _parent;
             std::vector<std::shared_ptr<IPrimitive> > _children;
             static std::vector<std::shared_ptr<Geom::TriangleMesh> > _meshesDummy;
+            static std::vector<std::vector<std::shared_ptr<Geom::TriangleMesh> > > _meshLODsDummy;
             static std::vector<std::shared_ptr<Geom::PointList> > _polyLinesDummy;
             static std::shared_ptr<Geom::PointList> _pointListDummy;
         };
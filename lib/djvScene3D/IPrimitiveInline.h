@@ -122,6 +122,11 @@ namespace djv
             return _meshesDummy;
         }
 
+        inline const std::vector<std::vector<std::shared_ptr<Geom::TriangleMesh> > >& IPrimitive::getMeshLODs() const
+        {
+            return _meshLODsDummy;
+        }
+
         inline const std::vector<std::shared_ptr<Geom::PointList> >& IPrimitive::getPolyLines() const
         {
             return _polyLinesDummy;
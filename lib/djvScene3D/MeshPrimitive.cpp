@@ -23,6 +23,7 @@ namespace djv
         void MeshPrimitive::addMesh(const std::shared_ptr<Geom::TriangleMesh>& value)
         {
             _meshes.push_back(value);
+            _meshLODs.push_back({ value });
             Math::BBox3f bbox = getBBox();
             if (!bbox.isValid())
             {
@@ -36,6 +37,14 @@ namespace djv
             _pointCount += value->v.size();
         }
 
+        void MeshPrimitive::setMeshLODs(size_t index, const std::vector<std::shared_ptr<Geom::TriangleMesh> >& value)
+        {
+            if (index < _meshLODs.size() && value.size())
+            {
+                _meshLODs[index] = value;
+            }
+        }
+
     } // namespace Scene3D
 } // namespace djv
 
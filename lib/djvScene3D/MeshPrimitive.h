@@ -25,12 +25,18 @@ namespace djv
 
             void addMesh(const std::shared_ptr<Geom::TriangleMesh>&);
 
+            //! Set the levels of detail for a mesh. The first level should be
+            //! the mesh itself.
+            void setMeshLODs(size_t index, const std::vector<std::shared_ptr<Geom::TriangleMesh> >&);
+
             std::string getClassName() const override;
             const std::vector<std::shared_ptr<Geom::TriangleMesh> >& getMeshes() const override;
+            const std::vector<std::vector<std::shared_ptr<Geom::TriangleMesh> > >& getMeshLODs() const override;
             size_t getPointCount() const override;
 
         private:
             std::vector<std::shared_ptr<Geom::TriangleMesh> > _meshes;
+            std::vector<std::vector<std::shared_ptr<Geom::TriangleMesh> > > _meshLODs;
             size_t _pointCount = 0;
         };
 
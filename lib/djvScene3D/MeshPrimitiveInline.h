@@ -16,6 +16,11 @@ namespace djv
             return _meshes;
         }
 
+        inline const std::vector<std::vector<std::shared_ptr<Geom::TriangleMesh> > >& MeshPrimitive::getMeshLODs() const
+        {
+            return _meshLODs;
+        }
+
         inline size_t MeshPrimitive::getPointCount() const
         {
             return _pointCount;
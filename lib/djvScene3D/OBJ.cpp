@@ -366,6 +366,7 @@ namespace djv
                                 auto material = DefaultMaterial::create();
                                 primitive->setMaterial(material);
                                 out->addPrimitive(primitive);
+                                out->lodUpdate();
                             }
                             catch (const std::exception& e)
                             {
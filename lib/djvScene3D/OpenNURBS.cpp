@@ -595,6 +595,7 @@ namespace djv
                             scene->setSceneOrient(SceneOrient::ZUp);
                             data.scene = scene;
                             read(_fileInfo.getFileName(), data, _textSystem);
+                            scene->lodUpdate();
                             return scene;
                         });
                 }
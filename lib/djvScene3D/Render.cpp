@@ -57,7 +57,7 @@ namespace djv
                         material == other.material;
                 }
             };
-            typedef std::pair<Key, std::vector<std::shared_ptr<Geom::TriangleMesh> > > TriangleMeshesKeyValue;
+            typedef std::pair<Key, std::vector<std::vector<std::shared_ptr<Geom::TriangleMesh> > > > TriangleMeshesKeyValue;
             typedef std::pair<Key, std::vector<std::shared_ptr<Geom::PointList> > > PointListsKeyValue;
             std::vector<TriangleMeshesKeyValue> triangleMeshes;
             std::vector<PointListsKeyValue> polyLines;
@@ -170,7 +170,7 @@ namespace djv
                     render->setColor(i.first.color);
                     render->setMaterial(i.first.material);
                     render->pushTransform(i.first.transform);
-                    render->drawTriangleMeshes(i.second);
+                    render->drawTriangleMeshLODs(i.second);
                     render->popTransform();
                 }
                 for (const auto& i : p.polyLines)
@@ -337,12 +337,12 @@ namespace djv
                             });
                         if (j != p.triangleMeshes.end())
                         {
-                            const auto& meshes = primitive->getMeshes();
-                            j->second.insert(j->second.end(), meshes.begin(), meshes.end());
+                            const auto& meshLODs = primitive->getMeshLODs();
+                            j->second.insert(j->second.end(), meshLODs.begin(), meshLODs.end());
                         }
                         else
                         {
-                            p.triangleMeshes.push_back(std::make_pair(key, primitive->getMeshes()));
+                            p.triangleMeshes.push_back(std::make_pair(key, primitive->getMeshLODs()));
                         }
                     }
 
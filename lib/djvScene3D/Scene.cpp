@@ -6,12 +6,24 @@
 
 #include <djvScene3D/Camera.h>
 #include <djvScene3D/IPrimitive.h>
+#include <djvScene3D/MeshPrimitive.h>
+
+#include <djvGeom/BVH.h>
+#include <djvGeom/Simplify.h>
+#include <djvGeom/TriangleMeshFunc.h>
 
 #include <djvMath/BBoxFunc.h>
 #include <djvMath/MatrixFunc.h>
 
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <atomic>
+#include <future>
+#include <limits>
+#include <map>
+#include <set>
+#include <thread>
+
 using namespace djv::Core;
 
 namespace djv
@@ -42,11 +54,85 @@ namespace djv
             _layers.push_back(value);
         }
 
+        void Scene::lodUpdate(size_t count)
+        {
+            // Find the mesh primitives.
+            std::vector<std::shared_ptr<MeshPrimitive> > meshPrimitives;
+            std::set<std::shared_ptr<IPrimitive> > visited;
+            std::vector<std::shared_ptr<IPrimitive> > stack;
+            stack.insert(stack.end(), _primitives.begin(), _primitives.end());
+            stack.insert(stack.end(), _definitions.begin(), _definitions.end());
+            while (!stack.empty())
+            {
+                const auto primitive = stack.back();
+                stack.pop_back();
+                if (visited.insert(primitive).second)
+                {
+                    if (auto meshPrimitive = std::dynamic_pointer_cast<MeshPrimitive>(primitive))
+                    {
+                        meshPrimitives.push_back(meshPrimitive);
+                    }
+                    const auto& children = primitive->getPrimitives();
+                    stack.insert(stack.end(), children.begin(), children.end());
+                }
+            }
+
+            // Simplify each unique mesh.
+            std::map<std::shared_ptr<Geom::TriangleMesh>, std::vector<std::shared_ptr<Geom::TriangleMesh> > > lods;
+            for (const auto& i : meshPrimitives)
+            {
+                for (const auto& j : i->getMeshes())
+                {
+                    lods[j];
+                }
+            }
+            std::vector<decltype(lods)::value_type*> work;
+            for (auto& i : lods)
+            {
+                work.push_back(&i);
+            }
+            std::atomic<size_t> index(0);
+            const size_t threadCount = std::max(std::min(
+                static_cast<size_t>(std::thread::hardware_concurrency()),
+                work.size()),
+                size_t(1));
+            std::vector<std::future<void> > futures;
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                futures.push_back(std::async(
+                    std::launch::async,
+                    [&work, &index, count]
+                    {
+                        size_t j = index++;
+                        while (j < work.size())
+                        {
+                            work[j]->second = Geom::createLODs(work[j]->first, count);
+                            j = index++;
+                        }
+                    }));
+            }
+            for (auto& i : futures)
+            {
+                i.get();
+            }
+
+            for (const auto& i : meshPrimitives)
+            {
+                const auto& meshes = i->getMeshes();
+                for (size_t j = 0; j < meshes.size(); ++j)
+                {
+                    i->setMeshLODs(j, lods[meshes[j]]);
+                }
+            }
+        }
+
         void Scene::bboxUpdate()
         {
             _bbox = Math::BBox3f();
             _bboxInit = true;
             _xforms.clear();
+            _meshInstances.clear();
+            _bvh.reset();
             glm::mat4x4 m(1.F);
             switch (_orient)
             {
@@ -71,6 +157,54 @@ namespace djv
             return std::max(_bbox.w(), std::max(_bbox.h(), _bbox.d()));
         }
 
+        bool Scene::intersect(
+            const glm::vec3& pos,
+            const glm::vec3& dir,
+            glm::vec3& hit,
+            std::shared_ptr<IPrimitive>& primitive)
+        {
+            if (!_bvh)
+            {
+                std::vector<Math::BBox3f> bboxes;
+                bboxes.reserve(_meshInstances.size());
+                for (const auto& i : _meshInstances)
+                {
+                    bboxes.push_back(i.mesh->bbox * i.xform);
+                }
+                _bvh = Geom::BVH::create(bboxes);
+            }
+
+            // The line is transformed into the space of each mesh, the distance
+            // along the line is unchanged by the transform.
+            float t = std::numeric_limits<float>::max();
+            const bool out = _bvh->intersect(
+                pos,
+                dir,
+                t,
+                [this, &pos, &dir, &primitive](uint32_t index, float& closest)
+                {
+                    const auto& instance = _meshInstances[index];
+                    const glm::vec3 meshPos = instance.xformInverse * glm::vec4(pos, 1.F);
+                    const glm::vec3 meshDir = instance.xformInverse * glm::vec4(dir, 0.F);
+                    float meshT = 0.F;
+                    size_t triangle = 0;
+                    glm::vec3 barycentric;
+                    if (Geom::intersectTriangles(meshPos, meshDir, *instance.mesh, meshT, triangle, barycentric) &&
+                        meshT < closest)
+                    {
+                        closest = meshT;
+                        primitive = instance.primitive;
+                        return true;
+                    }
+                    return false;
+                });
+            if (out)
+            {
+                hit = pos + dir * t;
+            }
+            return out;
+        }
+
         void Scene::printPrimitives()
         {
             std::cout << "Primitives" << std::endl;
@@ -128,6 +262,15 @@ namespace djv
                     {
                         _bbox.expand(bbox * xform);
                     }
+                    for (const auto& i : primitive->getMeshes())
+                    {
+                        MeshInstance instance;
+                        instance.primitive = primitive;
+                        instance.mesh = i;
+                        instance.xform = xform;
+                        instance.xformInverse = glm::inverse(xform);
+                        _meshInstances.push_back(instance);
+                    }
                     for (const auto& i : primitive->getPrimitives())
                     {
                         _bboxUpdate(i);
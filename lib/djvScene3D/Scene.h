@@ -17,6 +17,13 @@
 
 namespace djv
 {
+    namespace Geom
+    {
+        class BVH;
+        class TriangleMesh;
+
+    } // namespace Geom
+
     namespace Scene3D
     {
         class IPrimitive;
@@ -45,10 +52,24 @@ namespace djv
             void setSceneOrient(SceneOrient);
             void setSceneXForm(const glm::mat4x4&);
 
+            //! Create the levels of detail for the meshes. Shared meshes are
+            //! only simplified once and separate meshes are simplified in
+            //! parallel.
+            void lodUpdate(size_t count = 4);
+
             void bboxUpdate();
             const Math::BBox3f& getBBox() const;
             float getBBoxMax() const;
 
+            //! Intersect a line with the visible meshes. The mesh instances are
+            //! collected by bboxUpdate() and a top-level hierarchy over them is
+            //! built on first use.
+            bool intersect(
+                const glm::vec3& pos,
+                const glm::vec3& dir,
+                glm::vec3& hit,
+                std::shared_ptr<IPrimitive>&);
+
             void printPrimitives();
             void printLayers();
 
@@ -70,6 +91,15 @@ namespace djv
             bool _bboxInit = true;
             std::list<glm::mat4x4> _xforms;
             const glm::mat4x4 _identity = glm::mat4x4(1.F);
+            struct MeshInstance
+            {
+                std::shared_ptr<IPrimitive> primitive;
+                std::shared_ptr<Geom::TriangleMesh> mesh;
+                glm::mat4x4 xform = glm::mat4x4(1.F);
+                glm::mat4x4 xformInverse = glm::mat4x4(1.F);
+            };
+            std::vector<MeshInstance> _meshInstances;
+            std::shared_ptr<Geom::BVH> _bvh;
         };
 
     } // namespace Scene3D
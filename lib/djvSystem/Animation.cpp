@@ -155,6 +155,25 @@ namespace djv
                 }
             }
 
+            Time::TimePoint AnimationSystem::getTickDeadline() const
+            {
+                DJV_PRIVATE_PTR();
+                for (const auto& animations : { &p.animations, &p.newAnimations })
+                {
+                    for (const auto& i : *animations)
+                    {
+                        if (auto animation = i.lock())
+                        {
+                            if (animation->isActive())
+                            {
+                                return std::chrono::steady_clock::now();
+                            }
+                        }
+                    }
+                }
+                return Time::TimePoint::max();
+            }
+
             void AnimationSystem::_addAnimation(const std::weak_ptr<Animation>& value)
             {
                 _p->newAnimations.push_back(value);
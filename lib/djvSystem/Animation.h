@@ -118,6 +118,9 @@ namespace djv
 
                 void tick() override;
 
+                //! Returns the current time while there are active animations.
+                Core::Time::TimePoint getTickDeadline() const override;
+
             private:
                 void _addAnimation(const std::weak_ptr<Animation>&);
 
@@ -15,9 +15,10 @@
 
 #include <djvCore/MemoryFunc.h>
 #include <djvCore/OSFunc.h>
+#include <djvCore/Observer.h>
 #include <djvCore/Time.h>
 
-#include <iostream>
+#include <algorithm>
 #include <thread>
 
 #if defined(DJV_PLATFORM_WINDOWS)
@@ -55,45 +56,6 @@ namespace djv
                 return out / static_cast<float>(list.size());
             }
 
-            struct TickTimes
-            {
-                Time::Duration total = Time::Duration::zero();
-                std::vector<std::pair<std::string, Time::Duration> > times;
-
-                void add(const std::string& name, const Time::Duration& diff)
-                {
-                    times.push_back(std::make_pair(name, diff));
-                    total += diff;
-                }
-
-                void sort()
-                {
-                    std::sort(
-                        times.begin(),
-                        times.end(),
-                        [](const std::pair<std::string, Time::Duration>& a,
-                            const std::pair<std::string, Time::Duration>& b)
-                        {
-                            return a.second > b.second;
-                        });
-                }
-
-                void print()
-                {
-                    if (times.size() > 0)
-                    {
-                        std::cout << "System tick time: " <<
-                            times[0].first << ", " <<
-                            times[0].second.count() << std::endl;
-                    }
-                    for (const auto& i : times)
-                    {
-                        std::cout << i.first << ": " << i.second.count() << std::endl;
-                    }
-                    std::cout << "total: " << total.count() << std::endl << std::endl;
-                }
-            };
-
         } // namespace
 
         void Context::_init(const std::string& argv0)
@@ -145,12 +107,13 @@ namespace djv
 
         void Context::removeSystem(const std::shared_ptr<ISystemBase>& value)
         {
-            auto i = _systems.begin();
-            while (i != _systems.end())
+            size_t i = 0;
+            while (i < _systems.size())
             {
-                if (value == *i)
+                if (value == _systems[i])
                 {
-                    i = _systems.erase(i);
+                    _systems.erase(_systems.begin() + i);
+                    _systemTickHistograms.erase(_systemTickHistograms.begin() + i);
                 }
                 else
                 {
@@ -173,35 +136,107 @@ namespace djv
 
             _calcFPS();
 
-            const bool doStats = 0 == _tickCount % statsRate;
-            TickTimes tickTimes;
+            // Systems may be added while ticking, so the list is indexed.
             auto start = std::chrono::steady_clock::now();
-            for (const auto& system : _systems)
+            for (size_t i = 0; i < _systems.size(); ++i)
             {
-                system->tick();
-                
-                if (doStats)
-                {
-                    const auto end = std::chrono::steady_clock::now();
-                    const auto diff = std::chrono::duration_cast<Time::Duration>(end - start);
-                    start = end;
-                    tickTimes.add(system->getSystemName(), diff);
-                }
+                // Dispatch the deferred notifications before each system so
+                // that changes made by the previous systems are seen once.
+                Observer::dispatchDeferred();
+
+                _systems[i]->tick();
+
+                const auto end = std::chrono::steady_clock::now();
+                _systemTickHistograms[i].add(std::chrono::duration_cast<Time::Duration>(end - start));
+                start = end;
             }
+            Observer::dispatchDeferred();
             
-            if (doStats)
+            if (0 == _tickCount % statsRate)
             {
-                tickTimes.sort();
-                //tickTimes.print();
-                _systemTickTimes = tickTimes.times;
+                _systemTickTimes.clear();
+                for (const auto& i : _systemTickHistograms)
+                {
+                    _systemTickTimes.push_back(std::make_pair(i.getName(), i.getAverage()));
+                }
+                std::sort(
+                    _systemTickTimes.begin(),
+                    _systemTickTimes.end(),
+                    [](const std::pair<std::string, Time::Duration>& a,
+                        const std::pair<std::string, Time::Duration>& b)
+                    {
+                        return a.second > b.second;
+                    });
             }
             
             ++_tickCount;
         }
 
+        Time::TimePoint Context::getTickDeadline() const
+        {
+            Time::TimePoint out = Time::TimePoint::max();
+            if (Observer::getDeferredCount() > 0)
+            {
+                out = std::chrono::steady_clock::now();
+            }
+            for (const auto& system : _systems)
+            {
+                out = std::min(out, system->getTickDeadline());
+            }
+            return out;
+        }
+
+        void Context::wake()
+        {
+            std::function<void()> callback;
+            {
+                std::lock_guard<std::mutex> lock(_wakeMutex);
+                _wakeRequest = true;
+                callback = _wakeCallback;
+            }
+            _wakeCV.notify_one();
+            if (callback)
+            {
+                callback();
+            }
+        }
+
+        void Context::setWakeCallback(const std::function<void()>& value)
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+            _wakeCallback = value;
+        }
+
+        void Context::clearSystemTickHistograms()
+        {
+            for (auto& i : _systemTickHistograms)
+            {
+                i.clear();
+            }
+        }
+
         void Context::_addSystem(const std::shared_ptr<ISystemBase>& system)
         {
             _systems.push_back(system);
+            _systemTickHistograms.push_back(TickHistogram(system->getSystemName()));
+        }
+
+        void Context::_wait(const Time::TimePoint& value)
+        {
+            std::unique_lock<std::mutex> lock(_wakeMutex);
+            const auto predicate = [this]
+            {
+                return _wakeRequest;
+            };
+            if (Time::TimePoint::max() == value)
+            {
+                _wakeCV.wait(lock, predicate);
+            }
+            else
+            {
+                _wakeCV.wait_until(lock, value, predicate);
+            }
+            _wakeRequest = false;
         }
 
         void Context::_logInfo(const std::string& argv0)
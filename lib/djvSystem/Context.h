@@ -4,11 +4,16 @@
 
 #pragma once
 
+#include <djvSystem/TickHistogram.h>
+
 #include <djvCore/Time.h>
 
 #include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -76,14 +81,43 @@ namespace djv
             //! Get the average tick FPS.
             float getFPSAverage() const;
 
-            //! Get the system tick times.
+            //! Get the average system tick times, sorted from the longest to
+            //! the shortest. This is updated periodically from the histograms.
             const std::vector<std::pair<std::string, Core::Time::Duration> >& getSystemTickTimes() const;
 
+            //! Get the histograms of the system tick times, in the same order
+            //! as the systems.
+            const std::vector<TickHistogram>& getSystemTickHistograms() const;
+
+            //! Reset the histograms of the system tick times.
+            void clearSystemTickHistograms();
+
+            //! Get the earliest time when one of the systems needs to be
+            //! ticked. The application event loop can wait until this time.
+            Core::Time::TimePoint getTickDeadline() const;
+
+            ///@}
+
+            //! \name Wake
+            ///@{
+
+            //! Wake the application event loop if it is waiting. This function
+            //! can be called from any thread, for example when a worker thread
+            //! has finished a request.
+            void wake();
+
+            //! Set a function that is called by wake(), for example to post an
+            //! event to the window system.
+            void setWakeCallback(const std::function<void()>&);
+
             ///@}
 
         protected:
             void _addSystem(const std::shared_ptr<ISystemBase> &);
 
+            //! Wait until the given time or until wake() is called.
+            void _wait(const Core::Time::TimePoint&);
+
         private:
             void _logInfo(const std::string& argv0);
             void _logSystemOrder();
@@ -91,6 +125,10 @@ namespace djv
             void _calcFPS();
 
             std::string _name;
+            std::mutex _wakeMutex;
+            std::condition_variable _wakeCV;
+            bool _wakeRequest = false;
+            std::function<void()> _wakeCallback;
             std::shared_ptr<TimerSystem> _timerSystem;
             std::shared_ptr<ResourceSystem> _resourceSystem;
             std::shared_ptr<LogSystem> _logSystem;
@@ -99,6 +137,7 @@ namespace djv
             bool _logSystemOrderInit = true;
             size_t _tickCount = 0;
             std::vector<std::pair<std::string, Core::Time::Duration> > _systemTickTimes;
+            std::vector<TickHistogram> _systemTickHistograms;
             Core::Time::TimePoint _fpsTime = std::chrono::steady_clock::now();
             std::list<float> _fpsSamples;
             float _fpsAverage = 0.F;
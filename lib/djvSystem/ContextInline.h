@@ -55,5 +55,10 @@ namespace djv
             return _systemTickTimes;
         }
 
+        inline const std::vector<TickHistogram>& Context::getSystemTickHistograms() const
+        {
+            return _systemTickHistograms;
+        }
+
     } // namespace System
 } // namespace djv
@@ -51,6 +51,11 @@ namespace djv
             // Default implementation does nothing.
         }
 
+        Core::Time::TimePoint ISystemBase::getTickDeadline() const
+        {
+            return Core::Time::TimePoint::max();
+        }
+
         void ISystem::_init(const std::string& name, const std::shared_ptr<Context>& context)
         {
             ISystemBase::_init(name, context);
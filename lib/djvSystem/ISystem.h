@@ -7,6 +7,7 @@
 #include <djvSystem/Enum.h>
 
 #include <djvCore/Core.h>
+#include <djvCore/Time.h>
 
 #include <chrono>
 #include <memory>
@@ -67,6 +68,12 @@ namespace djv
             //! Override this function to do work each frame.
             virtual void tick();
 
+            //! Get the time when the system next needs to be ticked. The
+            //! application event loop may wait until the earliest deadline of
+            //! all the systems. The default implementation returns the maximum
+            //! time point, so the system is only ticked with the others.
+            virtual Core::Time::TimePoint getTickDeadline() const;
+
             ///@}
 
         private:
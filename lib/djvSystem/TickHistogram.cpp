@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvSystem/TickHistogram.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace System
+    {
+        namespace
+        {
+            //! \todo Should this be configurable?
+            const size_t binCount = 22;
+
+        } // namespace
+
+        TickHistogram::TickHistogram() :
+            _bins(binCount, 0)
+        {}
+
+        TickHistogram::TickHistogram(const std::string& name) :
+            _name(name),
+            _bins(binCount, 0)
+        {}
+
+        Time::Duration TickHistogram::getPercentile(float value) const
+        {
+            Time::Duration out = Time::Duration::zero();
+            if (_count > 0)
+            {
+                const size_t count = std::max(
+                    static_cast<size_t>(1),
+                    static_cast<size_t>(std::ceil(std::max(0.F, std::min(value, 1.F)) * _count)));
+                size_t sum = 0;
+                for (size_t i = 0; i < binCount; ++i)
+                {
+                    sum += _bins[i];
+                    if (sum >= count)
+                    {
+                        out = std::min(getBinMax(i), _max);
+                        break;
+                    }
+                }
+            }
+            return out;
+        }
+
+        Time::Duration TickHistogram::getBinMax(size_t value)
+        {
+            return value < binCount - 1 ?
+                Time::Duration(static_cast<Time::Duration::rep>(1) << value) :
+                Time::Duration::max();
+        }
+
+        void TickHistogram::add(const Time::Duration& value)
+        {
+            size_t bin = 0;
+            for (auto count = value.count(); count > 0 && bin < binCount - 1; count >>= 1)
+            {
+                ++bin;
+            }
+            ++_bins[bin];
+            ++_count;
+            _total += value;
+            _max = std::max(_max, value);
+        }
+
+        void TickHistogram::clear()
+        {
+            std::fill(_bins.begin(), _bins.end(), 0);
+            _count = 0;
+            _total = Time::Duration::zero();
+            _max = Time::Duration::zero();
+        }
+
+    } // namespace System
+} // namespace djv
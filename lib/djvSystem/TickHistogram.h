@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/Time.h>
+
+#include <string>
+#include <vector>
+
+namespace djv
+{
+    namespace System
+    {
+        //! This class provides a histogram of tick times.
+        //!
+        //! The bins double in size: the first bin counts ticks shorter than
+        //! one microsecond, bin N counts ticks shorter than 2^N microseconds,
+        //! and the last bin counts everything longer.
+        class TickHistogram
+        {
+        public:
+            TickHistogram();
+            explicit TickHistogram(const std::string& name);
+
+            //! \name Information
+            ///@{
+
+            const std::string& getName() const;
+
+            ///@}
+
+            //! \name Samples
+            ///@{
+
+            size_t getCount() const;
+            Core::Time::Duration getTotal() const;
+            Core::Time::Duration getMax() const;
+            Core::Time::Duration getAverage() const;
+
+            //! Get the upper bound of the bin that contains the given
+            //! percentile (0-1) of the samples.
+            Core::Time::Duration getPercentile(float) const;
+
+            const std::vector<size_t>& getBins() const;
+
+            //! Get the upper bound of a bin.
+            static Core::Time::Duration getBinMax(size_t);
+
+            void add(const Core::Time::Duration&);
+            void clear();
+
+            ///@}
+
+        private:
+            std::string _name;
+            std::vector<size_t> _bins;
+            size_t _count = 0;
+            Core::Time::Duration _total = Core::Time::Duration::zero();
+            Core::Time::Duration _max = Core::Time::Duration::zero();
+        };
+
+    } // namespace System
+} // namespace djv
+
+#include <djvSystem/TickHistogramInline.h>
@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+namespace djv
+{
+    namespace System
+    {
+        inline const std::string& TickHistogram::getName() const
+        {
+            return _name;
+        }
+
+        inline size_t TickHistogram::getCount() const
+        {
+            return _count;
+        }
+
+        inline Core::Time::Duration TickHistogram::getTotal() const
+        {
+            return _total;
+        }
+
+        inline Core::Time::Duration TickHistogram::getMax() const
+        {
+            return _max;
+        }
+
+        inline Core::Time::Duration TickHistogram::getAverage() const
+        {
+            return _count > 0 ?
+                (_total / static_cast<Core::Time::Duration::rep>(_count)) :
+                Core::Time::Duration::zero();
+        }
+
+        inline const std::vector<size_t>& TickHistogram::getBins() const
+        {
+            return _bins;
+        }
+
+    } // namespace System
+} // namespace djv
@@ -92,7 +92,12 @@ namespace djv
             //! Create a new timer system.
             static std::shared_ptr<TimerSystem> create(const std::shared_ptr<Context>&);
 
+            //! Get the time when the next active timer is due. The maximum time
+            //! point is returned if there are no active timers.
+            Core::Time::TimePoint getNextDeadline() const;
+
             void tick() override;
+            Core::Time::TimePoint getTickDeadline() const override;
 
         private:
             void _addTimer(const std::weak_ptr<Timer>&);
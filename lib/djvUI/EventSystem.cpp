@@ -30,6 +30,8 @@ namespace djv
             std::vector<std::weak_ptr<Window> > newWindows;
             bool resizeRequest = false;
             bool redrawRequest = false;
+            bool redrawAll = false;
+            Math::BBox2f redrawRegion = Math::BBox2f(0.F, 0.F, 0.F, 0.F);
             bool textLCDRenderingDirty = false;
             bool tooltips = false;
             std::shared_ptr<Observer::Value<bool> > textLCDRenderingObserver;
@@ -126,7 +128,26 @@ namespace djv
 
         void EventSystem::redrawRequest()
         {
-            _p->redrawRequest = true;
+            DJV_PRIVATE_PTR();
+            p.redrawRequest = true;
+            p.redrawAll = true;
+        }
+
+        void EventSystem::redrawRequest(const Math::BBox2f& value)
+        {
+            DJV_PRIVATE_PTR();
+            if (!p.redrawAll)
+            {
+                if (p.redrawRegion.isValid())
+                {
+                    p.redrawRegion.expand(value);
+                }
+                else
+                {
+                    p.redrawRegion = value;
+                }
+            }
+            p.redrawRequest = true;
         }
 
         bool EventSystem::areTooltipsEnabled() const
@@ -208,6 +229,24 @@ namespace djv
             }
         }
 
+        Time::TimePoint EventSystem::getTickDeadline() const
+        {
+            DJV_PRIVATE_PTR();
+            Time::TimePoint out = IEventSystem::getTickDeadline();
+            const auto& style = p.uiSystem->getStyle();
+            if (p.resizeRequest ||
+                p.redrawRequest ||
+                p.textLCDRenderingDirty ||
+                !p.newWindows.empty() ||
+                style->isPaletteDirty() ||
+                style->isSizeDirty() ||
+                style->isFontDirty())
+            {
+                out = std::chrono::steady_clock::now();
+            }
+            return out;
+        }
+
         const std::vector<std::weak_ptr<Window> >& EventSystem::_getWindows() const
         {
             return _p->windows;
@@ -219,6 +258,7 @@ namespace djv
             _p->newWindows.push_back(value);
             _p->resizeRequest = true;
             _p->redrawRequest = true;
+            _p->redrawAll = true;
         }
 
         bool EventSystem::_resizeRequestReset()
@@ -230,8 +270,25 @@ namespace djv
 
         bool EventSystem::_redrawRequestReset()
         {
-            const bool out = _p->redrawRequest;
-            _p->redrawRequest = false;
+            Math::BBox2f region;
+            return _redrawRequestReset(region);
+        }
+
+        bool EventSystem::_redrawRequestReset(Math::BBox2f& region)
+        {
+            DJV_PRIVATE_PTR();
+            const bool out = p.redrawRequest;
+            if (p.redrawAll)
+            {
+                region.zero();
+            }
+            else
+            {
+                region = p.redrawRegion;
+            }
+            p.redrawRequest = false;
+            p.redrawAll = false;
+            p.redrawRegion.zero();
             return out;
         }
 
@@ -247,27 +304,42 @@ namespace djv
 
         void EventSystem::_initLayoutRecursive(const std::shared_ptr<Widget>& widget, System::Event::InitLayout& event)
         {
-            for (const auto& child : widget->getChildWidgets())
+            if (widget->_layoutDirty)
             {
-                _initLayoutRecursive(child, event);
+                for (const auto& child : widget->getChildWidgets())
+                {
+                    _initLayoutRecursive(child, event);
+                }
+                widget->event(event);
             }
-            widget->event(event);
         }
 
         void EventSystem::_preLayoutRecursive(const std::shared_ptr<Widget>& widget, System::Event::PreLayout& event)
         {
-            for (const auto& child : widget->getChildWidgets())
+            // Widgets that have not been invalidated keep their cached
+            // minimum size.
+            if (widget->_layoutDirty)
             {
-                _preLayoutRecursive(child, event);
+                for (const auto& child : widget->getChildWidgets())
+                {
+                    _preLayoutRecursive(child, event);
+                }
+                widget->event(event);
             }
-            widget->event(event);
         }
 
         void EventSystem::_layoutRecursive(const std::shared_ptr<Widget>& widget, System::Event::Layout& event)
         {
-            if (widget->isVisible())
+            // Reset the flag before the event so that any changes made while
+            // laying out the widget are picked up. Children whose geometry
+            // changes are invalidated by Widget::setGeometry() and laid out
+            // below in the same pass.
+            if (widget->isVisible() && widget->_layoutDirty)
             {
+                widget->_layoutDirty = false;
+                widget->_layoutActive = true;
                 widget->event(event);
+                widget->_layoutActive = false;
                 for (const auto& child : widget->getChildWidgets())
                 {
                     _layoutRecursive(child, event);
@@ -300,6 +372,11 @@ namespace djv
                 for (const auto& child : widget->getChildWidgets())
                 {
                     const Math::BBox2f childClipRect = clipRect.intersect(child->getGeometry());
+                    if (!childClipRect.isValid())
+                    {
+                        // The child is outside of the region being painted.
+                        continue;
+                    }
                     event.setClipRect(childClipRect);
                     overlayEvent.setClipRect(childClipRect);
                     _paintRecursive(child, event, overlayEvent);
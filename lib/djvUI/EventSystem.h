@@ -30,8 +30,14 @@ namespace djv
             ///@{
 
             void resizeRequest();
+
+            //! Request a redraw of the entire window.
             void redrawRequest();
 
+            //! Request a redraw of part of the window. The regions are
+            //! accumulated until the next redraw.
+            void redrawRequest(const Math::BBox2f&);
+
             ///@}
 
             //! \name Tooltips
@@ -43,6 +49,9 @@ namespace djv
 
             void tick() override;
 
+            //! Returns the current time while there are pending requests.
+            Core::Time::TimePoint getTickDeadline() const override;
+
         protected:
             const std::vector<std::weak_ptr<Window> >& _getWindows() const;
             void _addWindow(const std::shared_ptr<Window>&);
@@ -50,6 +59,11 @@ namespace djv
             bool _resizeRequestReset();
             bool _redrawRequestReset();
 
+            //! Reset the redraw request and get the region that needs to be
+            //! redrawn. The region is zero if the entire window needs to be
+            //! redrawn.
+            bool _redrawRequestReset(Math::BBox2f&);
+
             virtual void _pushClipRect(const Math::BBox2f&);
             virtual void _popClipRect();
 
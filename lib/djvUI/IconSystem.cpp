@@ -130,9 +130,11 @@ namespace djv
                 _log(ss.str());
             });
 
+            // The context owns the systems so it outlives the thread.
+            auto contextP = context.get();
             p.running = true;
             p.thread = std::thread(
-                [this]
+                [this, contextP]
             {
                 DJV_PRIVATE_PTR();
                 try
@@ -178,6 +180,7 @@ namespace djv
                         if (p.newImageRequests.size() || p.pendingImageRequests.size())
                         {
                             _handleImageRequests();
+                            contextP->wake();
                         }
                     }
                 }
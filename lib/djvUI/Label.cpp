@@ -473,13 +473,13 @@ namespace djv
             void LabelSizeGroup::calcMinimumSize()
             {
                 DJV_PRIVATE_PTR();
-                p.minimumSize = glm::vec2(0.F, 0.F);
+                glm::vec2 minimumSize = glm::vec2(0.F, 0.F);
                 auto i = p.labels.begin();
                 while (i != p.labels.end())
                 {
                     if (auto label = i->lock())
                     {
-                        p.minimumSize = glm::max(p.minimumSize, label->_labelMinimumSize);
+                        minimumSize = glm::max(minimumSize, label->_labelMinimumSize);
                         ++i;
                     }
                     else
@@ -487,6 +487,20 @@ namespace djv
                         i = p.labels.erase(i);
                     }
                 }
+                if (minimumSize != p.minimumSize)
+                {
+                    p.minimumSize = minimumSize;
+
+                    // The labels in the group may not have been invalidated, so
+                    // make sure they pick up the new size.
+                    for (const auto& j : p.labels)
+                    {
+                        if (auto label = j.lock())
+                        {
+                            label->_resize();
+                        }
+                    }
+                }
             }
 
         } // namespace Text
@@ -150,7 +150,30 @@ namespace djv
             if (value == _geometry)
                 return;
             _geometry = value;
-            _resize();
+
+            // While a parent is being laid out only the widgets below it need
+            // to be laid out again, they are visited after the parent in the
+            // same pass. Invalidating the parent would lay out the whole tree
+            // again on the next pass.
+            std::vector<std::shared_ptr<Widget> > widgets;
+            auto parent = std::dynamic_pointer_cast<Widget>(getParent().lock());
+            while (parent && !parent->_layoutActive)
+            {
+                widgets.push_back(parent);
+                parent = std::dynamic_pointer_cast<Widget>(parent->getParent().lock());
+            }
+            if (parent)
+            {
+                _layoutDirty = true;
+                for (const auto& i : widgets)
+                {
+                    i->_layoutDirty = true;
+                }
+            }
+            else
+            {
+                _resize();
+            }
         }
 
         void Widget::move(const glm::vec2& value)
@@ -846,6 +869,15 @@ namespace djv
 
         void Widget::_resize()
         {
+            // The minimum size of a widget depends on its children, so the
+            // parents also need to be laid out again.
+            _layoutDirty = true;
+            auto parent = std::dynamic_pointer_cast<Widget>(getParent().lock());
+            while (parent)
+            {
+                parent->_layoutDirty = true;
+                parent = std::dynamic_pointer_cast<Widget>(parent->getParent().lock());
+            }
             if (auto eventSystem = _eventSystem.lock())
             {
                 eventSystem->resizeRequest();
@@ -856,7 +888,18 @@ namespace djv
         {
             if (auto eventSystem = _eventSystem.lock())
             {
-                eventSystem->redrawRequest();
+                if (_clipRect.isValid())
+                {
+                    // Only the visible part of the widget needs to be redrawn.
+                    if (!_clipped)
+                    {
+                        eventSystem->redrawRequest(_clipRect);
+                    }
+                }
+                else
+                {
+                    eventSystem->redrawRequest();
+                }
             }
         }
 
@@ -196,10 +196,12 @@ namespace djv
 
             ///@}
 
-            //! Call this function when the widget needs resizing.
+            //! Call this function when the widget needs resizing. This
+            //! invalidates the cached layout of the widget and its parents.
             void _resize();
 
-            //! Call this function to redraw the widget.
+            //! Call this function to redraw the widget. Only the area covered by
+            //! the widget's clipping rectangle is redrawn.
             void _redraw();
 
             //! Set the minimum size. This is computed and set in the pre-layout event.
@@ -227,6 +229,8 @@ namespace djv
 
             Math::BBox2f        _geometry        = Math::BBox2f(0.F, 0.F, 0.F, 0.F);
             glm::vec2           _minimumSize     = glm::vec2(0.F, 0.F);
+            bool                _layoutDirty     = true;
+            bool                _layoutActive    = false;
             Layout::Margin      _margin;
             HAlign              _hAlign          = HAlign::Fill;
             VAlign              _vAlign          = VAlign::Fill;
@@ -43,13 +43,17 @@ namespace djv
 
                 const size_t invalid = static_cast<size_t>(-1);
 
+                //! The number of rows outside of the visible area that are
+                //! requested ahead of time.
+                //!
+                //! \todo Should this be configurable?
+                const size_t prefetchRows = 2;
+
                 struct Item
                 {
                     System::File::Info info;
                     std::string name;
 
-                    Math::BBox2f geometry;
-
                     bool nameLinesInit = true;
                     std::vector<Render2D::Font::TextLine> nameLines;
 
@@ -91,6 +95,14 @@ namespace djv
                 std::map<size_t, std::future<std::vector<std::shared_ptr<Render2D::Font::Glyph> > > > sizeGlyphsFutures;
                 std::map<size_t, std::future<std::vector<std::shared_ptr<Render2D::Font::Glyph> > > > timeGlyphsFutures;
                 std::vector<float> split = { .7F, .8F, 1.F };
+
+                // The items are laid out on a uniform grid, so the geometry of
+                // an item is computed from its index instead of being stored.
+                glm::vec2 itemsOrigin = glm::vec2(0.F, 0.F);
+                glm::vec2 itemSize = glm::vec2(0.F, 0.F);
+                float itemSpacing = 0.F;
+                size_t columns = 1;
+
                 OCIO::Config ocioConfig;
                 std::string outputColorSpace;
 
@@ -104,6 +116,10 @@ namespace djv
                 std::function<void(const std::set<size_t>&)> selectedCallback2;
                 std::function<void(const std::vector<System::File::Info>&)> activatedCallback;
                 std::function<void(const std::set<size_t>&)> activatedCallback2;
+
+                Math::BBox2f getItemGeometry(size_t) const;
+                void getItemRange(const Math::BBox2f&, size_t& first, size_t& last, size_t prefetch = 0) const;
+                size_t getItemAt(const glm::vec2&) const;
             };
 
             void ItemView::_init(UI::SelectionType selectionType, const std::shared_ptr<System::Context>& context)
@@ -304,36 +320,29 @@ namespace djv
                 const float m = style->getMetric(UI::MetricsRole::MarginSmall);
                 const float s = style->getMetric(UI::MetricsRole::Spacing);
                 const float sh = style->getMetric(UI::MetricsRole::Shadow);
-                glm::vec2 pos = g.min;
-                const size_t itemsSize = p.items.size();
                 switch (p.viewType)
                 {
                 case UI::ViewType::Tiles:
-                    pos += s;
-                    for (size_t i = 0; i < itemsSize; ++i)
+                {
+                    p.itemSize.x = p.thumbnailSize.w + sh * 2.F;
+                    p.itemSize.y = p.thumbnailSize.h + p.nameFontMetrics.lineHeight * 2.F + m * 2.F + sh * 2.F;
+                    p.itemsOrigin = g.min + s;
+                    p.itemSpacing = s;
+                    p.columns = 1;
+                    float x = p.itemsOrigin.x + p.itemSize.x;
+                    while (x <= g.max.x - p.itemSize.x)
                     {
-                        const float itemHeight = p.thumbnailSize.h + p.nameFontMetrics.lineHeight * 2.F + m * 2.F + sh * 2.F;
-                        const float itemWidth = p.thumbnailSize.w + sh * 2.F;
-                        p.items[i].geometry = Math::BBox2f(pos.x, pos.y, itemWidth, itemHeight);
-                        pos.x += itemWidth;
-                        if (pos.x > g.max.x - itemWidth)
-                        {
-                            pos.x = g.min.x + s;
-                            pos.y += itemHeight + s;
-                        }
-                        else
-                        {
-                            pos.x += s;
-                        }
+                        ++p.columns;
+                        x += s + p.itemSize.x;
                     }
                     break;
+                }
                 case UI::ViewType::List:
-                    for (size_t i = 0; i < itemsSize; ++i)
-                    {
-                        const float itemHeight = std::max(static_cast<float>(p.thumbnailSize.h), p.nameFontMetrics.lineHeight + m * 2.F);
-                        p.items[i].geometry = Math::BBox2f(pos.x, pos.y, g.w(), itemHeight);
-                        pos.y += itemHeight;
-                    }
+                    p.itemSize.x = g.w();
+                    p.itemSize.y = std::max(static_cast<float>(p.thumbnailSize.h), p.nameFontMetrics.lineHeight + m * 2.F);
+                    p.itemsOrigin = g.min;
+                    p.itemSpacing = 0.F;
+                    p.columns = 1;
                     break;
                 default: break;
                 }
@@ -348,109 +357,133 @@ namespace djv
                 {
                     const auto& style = _getStyle();
                     const auto& clipRect = event.getClipRect();
-                    const size_t itemsSize = p.items.size();
-                    for (size_t i = 0; i < itemsSize; ++i)
+
+                    // Cancel the requests for items that have been scrolled
+                    // out of view.
+                    size_t first = 0;
+                    size_t last = 0;
+                    p.getItemRange(clipRect, first, last, prefetchRows);
+                    size_t visibleFirst = 0;
+                    size_t visibleLast = 0;
+                    p.getItemRange(clipRect, visibleFirst, visibleLast);
+                    if (auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>())
                     {
-                        auto& item = p.items[i];
-                        if (item.geometry.intersects(clipRect))
+                        auto i = p.ioInfoFutures.begin();
+                        while (i != p.ioInfoFutures.end())
                         {
-                            if (item.nameLinesInit)
+                            if (i->first < first || i->first >= last)
                             {
-                                item.nameLinesInit = false;
-                                const auto k = p.nameLinesFutures.find(i);
-                                if (k == p.nameLinesFutures.end())
-                                {
-                                    const float m = style->getMetric(UI::MetricsRole::MarginSmall);
-                                    const auto fontInfo = style->getFontInfo(Render2D::Font::faceDefault, UI::MetricsRole::FontMedium);
-                                    item.name = item.info.getFileName(Math::Frame::invalid, false);
-                                    p.nameLinesFutures[i] = p.fontSystem->textLines(
-                                        item.name,
-                                        p.thumbnailSize.w - static_cast<uint16_t>(m * 2.F),
-                                        fontInfo);
-                                }
+                                auto& item = p.items[i->first];
+                                item.ioInfoInit = true;
+                                item.ioInfoValid = false;
+                                thumbnailSystem->cancelInfo(i->second.uid);
+                                i = p.ioInfoFutures.erase(i);
                             }
-                            if (item.ioInfoInit)
+                            else
                             {
-                                item.ioInfoInit = false;
-                                if (p.ioInfoFutures.find(i) == p.ioInfoFutures.end())
-                                {
-                                    auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>();
-                                    auto ioSystem = context->getSystemT<AV::IO::IOSystem>();
-                                    if (thumbnailSystem && ioSystem)
-                                    {
-                                        if (ioSystem->canRead(item.info))
-                                        {
-                                            p.ioInfoFutures[i] = thumbnailSystem->getInfo(item.info);
-                                        }
-                                    }
-                                }
+                                ++i;
                             }
-                            if (item.thumbnailInit)
+                        }
+                        auto j = p.thumbnailFutures.begin();
+                        while (j != p.thumbnailFutures.end())
+                        {
+                            if (j->first < first || j->first >= last)
                             {
-                                item.thumbnailInit = false;
-                                if (p.thumbnailFutures.find(i) == p.thumbnailFutures.end())
-                                {
-                                    auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>();
-                                    auto ioSystem = context->getSystemT<AV::IO::IOSystem>();
-                                    if (thumbnailSystem && ioSystem && ioSystem->canRead(item.info))
-                                    {
-                                        p.thumbnailFutures[i] = thumbnailSystem->getImage(item.info, p.thumbnailSize);
-                                    }
-                                }
+                                auto& item = p.items[j->first];
+                                item.thumbnailInit = true;
+                                item.thumbnail.reset();
+                                thumbnailSystem->cancelImage(j->second.uid);
+                                j = p.thumbnailFutures.erase(j);
                             }
-                            if (item.nameGlyphsInit)
+                            else
                             {
-                                item.nameGlyphsInit = false;
-                                if (p.nameGlyphsFutures.find(i) == p.nameGlyphsFutures.end())
-                                {
-                                    const std::string& label = item.info.getFileName(Math::Frame::invalid, false);
-                                    const auto fontInfo = style->getFontInfo(Render2D::Font::faceDefault, UI::MetricsRole::FontMedium);
-                                    p.nameGlyphsFutures[i] = p.fontSystem->getGlyphs(label, fontInfo);
-                                }
+                                ++j;
                             }
-                            if (item.sizeGlyphsInit)
+                        }
+                    }
+
+                    // Request the visible items and the prefetch margin.
+                    for (size_t i = first; i < last; ++i)
+                    {
+                        auto& item = p.items[i];
+                        const int priority = (i >= visibleFirst && i < visibleLast) ? 1 : 0;
+                        if (item.nameLinesInit)
+                        {
+                            item.nameLinesInit = false;
+                            const auto k = p.nameLinesFutures.find(i);
+                            if (k == p.nameLinesFutures.end())
+                            {
+                                const float m = style->getMetric(UI::MetricsRole::MarginSmall);
+                                const auto fontInfo = style->getFontInfo(Render2D::Font::faceDefault, UI::MetricsRole::FontMedium);
+                                item.name = item.info.getFileName(Math::Frame::invalid, false);
+                                p.nameLinesFutures[i] = p.fontSystem->textLines(
+                                    item.name,
+                                    p.thumbnailSize.w - static_cast<uint16_t>(m * 2.F),
+                                    fontInfo);
+                            }
+                        }
+                        if (item.ioInfoInit)
+                        {
+                            item.ioInfoInit = false;
+                            if (p.ioInfoFutures.find(i) == p.ioInfoFutures.end())
                             {
-                                item.sizeGlyphsInit = false;
-                                if (p.sizeGlyphsFutures.find(i) == p.sizeGlyphsFutures.end())
+                                auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>();
+                                auto ioSystem = context->getSystemT<AV::IO::IOSystem>();
+                                if (thumbnailSystem && ioSystem)
                                 {
-                                    std::stringstream ss;
-                                    const uint64_t size = item.info.getSize();
-                                    ss << Memory::getSizeLabel(size);
-                                    std::stringstream ss2;
-                                    ss2 << Memory::getUnitLabel(size);
-                                    ss << _getText(ss2.str());
-                                    const auto fontInfo = style->getFontInfo(Render2D::Font::faceDefault, UI::MetricsRole::FontMedium);
-                                    p.sizeGlyphsFutures[i] = p.fontSystem->getGlyphs(ss.str(), fontInfo);
+                                    if (ioSystem->canRead(item.info))
+                                    {
+                                        p.ioInfoFutures[i] = thumbnailSystem->getInfo(item.info, priority);
+                                    }
                                 }
                             }
-                            if (item.timeGlyphsInit)
+                        }
+                        if (item.thumbnailInit)
+                        {
+                            item.thumbnailInit = false;
+                            if (p.thumbnailFutures.find(i) == p.thumbnailFutures.end())
                             {
-                                item.timeGlyphsInit = false;
-                                if (p.timeGlyphsFutures.find(i) == p.timeGlyphsFutures.end())
+                                auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>();
+                                auto ioSystem = context->getSystemT<AV::IO::IOSystem>();
+                                if (thumbnailSystem && ioSystem && ioSystem->canRead(item.info))
                                 {
-                                    const std::string& label = AV::Time::getLabel(item.info.getTime());
-                                    const auto fontInfo = style->getFontInfo(Render2D::Font::faceDefault, UI::MetricsRole::FontMedium);
-                                    p.timeGlyphsFutures[i] = p.fontSystem->getGlyphs(label, fontInfo);
+                                    p.thumbnailFutures[i] = thumbnailSystem->getImage(item.info, p.thumbnailSize, Image::Type::None, priority);
                                 }
                             }
                         }
-                        else if (auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>())
+                        if (item.nameGlyphsInit)
                         {
-                            const auto j = p.ioInfoFutures.find(i);
-                            if (j != p.ioInfoFutures.end())
+                            item.nameGlyphsInit = false;
+                            if (p.nameGlyphsFutures.find(i) == p.nameGlyphsFutures.end())
                             {
-                                item.ioInfoInit = true;
-                                item.ioInfoValid = false;
-                                thumbnailSystem->cancelInfo(j->second.uid);
-                                p.ioInfoFutures.erase(j);
+                                const std::string& label = item.info.getFileName(Math::Frame::invalid, false);
+                                const auto fontInfo = style->getFontInfo(Render2D::Font::faceDefault, UI::MetricsRole::FontMedium);
+                                p.nameGlyphsFutures[i] = p.fontSystem->getGlyphs(label, fontInfo);
                             }
-                            const auto k = p.thumbnailFutures.find(i);
-                            if (k != p.thumbnailFutures.end())
+                        }
+                        if (item.sizeGlyphsInit)
+                        {
+                            item.sizeGlyphsInit = false;
+                            if (p.sizeGlyphsFutures.find(i) == p.sizeGlyphsFutures.end())
                             {
-                                item.thumbnailInit = true;
-                                item.thumbnail.reset();
-                                thumbnailSystem->cancelImage(k->second.uid);
-                                p.thumbnailFutures.erase(k);
+                                std::stringstream ss;
+                                const uint64_t size = item.info.getSize();
+                                ss << Memory::getSizeLabel(size);
+                                std::stringstream ss2;
+                                ss2 << Memory::getUnitLabel(size);
+                                ss << _getText(ss2.str());
+                                const auto fontInfo = style->getFontInfo(Render2D::Font::faceDefault, UI::MetricsRole::FontMedium);
+                                p.sizeGlyphsFutures[i] = p.fontSystem->getGlyphs(ss.str(), fontInfo);
+                            }
+                        }
+                        if (item.timeGlyphsInit)
+                        {
+                            item.timeGlyphsInit = false;
+                            if (p.timeGlyphsFutures.find(i) == p.timeGlyphsFutures.end())
+                            {
+                                const std::string& label = AV::Time::getLabel(item.info.getTime());
+                                const auto fontInfo = style->getFontInfo(Render2D::Font::faceDefault, UI::MetricsRole::FontMedium);
+                                p.timeGlyphsFutures[i] = p.fontSystem->getGlyphs(label, fontInfo);
                             }
                         }
                     }
@@ -467,11 +500,13 @@ namespace djv
 
                 const auto& render = _getRender();
                 const auto& ut = _getUpdateTime();
-                const size_t itemsSize = p.items.size();
-                for (size_t i = 0; i < itemsSize; ++i)
+                size_t first = 0;
+                size_t last = 0;
+                p.getItemRange(event.getClipRect(), first, last);
+                for (size_t i = first; i < last; ++i)
                 {
                     const auto& item = p.items[i];
-                    Math::BBox2f itemGeometry = item.geometry;
+                    Math::BBox2f itemGeometry = p.getItemGeometry(i);
 
                     const bool selected = p.selectionModel->isSelected(i);
                     switch (p.viewType)
@@ -674,15 +709,11 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 event.accept();
                 const auto& pointerInfo = event.getPointerInfo();
-                const size_t itemsSize = p.items.size();
-                for (size_t i = 0; i < itemsSize; ++i)
+                const size_t i = p.getItemAt(pointerInfo.pos);
+                if (i != invalid)
                 {
-                    if (p.items[i].geometry.contains(pointerInfo.pos))
-                    {
-                        p.hover = i;
-                        _redraw();
-                        break;
-                    }
+                    p.hover = i;
+                    _redraw();
                 }
             }
 
@@ -717,15 +748,11 @@ namespace djv
                 }
                 else
                 {
-                    const size_t itemsSize = p.items.size();
-                    for (size_t i = 0; i < itemsSize; ++i)
+                    const size_t i = p.getItemAt(pointerInfo.pos);
+                    if (i != invalid)
                     {
-                        if (p.items[i].geometry.contains(pointerInfo.pos))
-                        {
-                            p.hover = i;
-                            _redraw();
-                            break;
-                        }
+                        p.hover = i;
+                        _redraw();
                     }
                 }
             }
@@ -736,18 +763,14 @@ namespace djv
                 if (p.pressedId)
                     return;
                 const auto& pointerInfo = event.getPointerInfo();
-                const size_t itemsSize = p.items.size();
-                for (size_t i = 0; i < itemsSize; ++i)
+                const size_t i = p.getItemAt(pointerInfo.pos);
+                if (i != invalid)
                 {
-                    if (p.items[i].geometry.contains(pointerInfo.pos))
-                    {
-                        event.accept();
-                        p.grab = i;
-                        p.pressedId = pointerInfo.id;
-                        p.pressedPos = pointerInfo.pos;
-                        _redraw();
-                        break;
-                    }
+                    event.accept();
+                    p.grab = i;
+                    p.pressedId = pointerInfo.id;
+                    p.pressedPos = pointerInfo.pos;
+                    _redraw();
                 }
             }
 
@@ -764,29 +787,26 @@ namespace djv
                     const auto i = hover.find(pointerInfo.id);
                     if (i != hover.end())
                     {
-                        const size_t itemsSize = p.items.size();
-                        for (size_t j = 0; j < itemsSize; ++j)
+                        const size_t j = p.getItemAt(i->second);
+                        if (j != invalid)
                         {
                             const auto& item = p.items[j];
-                            if (item.geometry.contains(i->second))
+                            const int modifiers = event.getKeyModifiers();
+                            if (0 == modifiers)
                             {
-                                const int modifiers = event.getKeyModifiers();
-                                if (0 == modifiers)
+                                if (p.activatedCallback)
                                 {
-                                    if (p.activatedCallback)
-                                    {
-                                        p.activatedCallback({ item.info });
-                                    }
-                                    if (p.activatedCallback2)
-                                    {
-                                        p.activatedCallback2({ j });
-                                    }
+                                    p.activatedCallback({ item.info });
                                 }
-                                else
+                                if (p.activatedCallback2)
                                 {
-                                    p.selectionModel->select(j, modifiers);
+                                    p.activatedCallback2({ j });
                                 }
                             }
+                            else
+                            {
+                                p.selectionModel->select(j, modifiers);
+                            }
                         }
                     }
                     _redraw();
@@ -831,21 +851,17 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 std::shared_ptr<UI::ITooltipWidget> out;
                 std::string text;
-                const size_t itemsSize = p.items.size();
-                for (size_t i = 0; i < itemsSize; ++i)
+                const size_t i = p.getItemAt(pos);
+                if (i != invalid)
                 {
                     const auto& item = p.items[i];
-                    if (item.geometry.contains(pos))
+                    if (item.ioInfoValid)
                     {
-                        if (item.ioInfoValid)
-                        {
-                            text = _getTooltip(item.info, item.ioInfo);
-                        }
-                        else
-                        {
-                            text = _getTooltip(item.info);
-                        }
-                        break;
+                        text = _getTooltip(item.info, item.ioInfo);
+                    }
+                    else
+                    {
+                        text = _getTooltip(item.info);
                     }
                 }
                 if (!text.empty())
@@ -891,7 +907,7 @@ namespace djv
                             try
                             {
                                 p.items[i->first].nameLines = i->second.get();
-                                _resize();
+                                _redraw();
                             }
                             catch (const std::exception& e)
                             {
@@ -945,7 +961,7 @@ namespace djv
                                 {
                                     item.thumbnail = image;
                                     p.thumbnailTimers[i->first] = _getUpdateTime();
-                                    _resize();
+                                    _redraw();
                                 }
                             }
                             catch (const std::exception& e)
@@ -976,7 +992,7 @@ namespace djv
                             ++i;
                         }
                     }
-                    _resize();
+                    _redraw();
                 }
                 {
                     auto i = p.iconsFutures.begin();
@@ -988,7 +1004,7 @@ namespace djv
                             try
                             {
                                 p.icons[i->first] = i->second.get();
-                                _resize();
+                                _redraw();
                             }
                             catch (const std::exception& e)
                             {
@@ -1012,7 +1028,7 @@ namespace djv
                             try
                             {
                                 p.items[i->first].nameGlyphs = i->second.get();
-                                _resize();
+                                _redraw();
                             }
                             catch (const std::exception& e)
                             {
@@ -1036,7 +1052,7 @@ namespace djv
                             try
                             {
                                 p.items[i->first].sizeGlyphs = i->second.get();
-                                _resize();
+                                _redraw();
                             }
                             catch (const std::exception& e)
                             {
@@ -1060,7 +1076,7 @@ namespace djv
                             try
                             {
                                 p.items[i->first].timeGlyphs = i->second.get();
-                                _resize();
+                                _redraw();
                             }
                             catch (const std::exception& e)
                             {
@@ -1190,47 +1206,25 @@ namespace djv
                 if (auto context = getContext().lock())
                 {
                     auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>();
-                    const size_t itemsSize = p.items.size();
-                    for (size_t i = 0; i < itemsSize; ++i)
+                    for (const auto& i : p.thumbnailFutures)
+                    {
+                        thumbnailSystem->cancelImage(i.second.uid);
+                    }
+                    for (auto& item : p.items)
                     {
-                        auto& item = p.items[i];
                         item.name.clear();
                         item.nameLinesInit = true;
                         item.nameLines.clear();
                         item.thumbnailInit = true;
                         item.thumbnail.reset();
-                        const auto j = p.thumbnailFutures.find(i);
-                        if (j != p.thumbnailFutures.end())
-                        {
-                            thumbnailSystem->cancelImage(j->second.uid);
-                        }
                     }
 
                     p.nameLinesFutures.clear();
                     p.thumbnailFutures.clear();
 
-                    const auto& style = _getStyle();
-                    const auto& clipRect = getClipRect();
-                    for (size_t i = 0; i < itemsSize; ++i)
-                    {
-                        auto& item = p.items[i];
-                        if (item.geometry.intersects(clipRect))
-                        {
-                            const auto fontInfo = style->getFontInfo(Render2D::Font::faceDefault, UI::MetricsRole::FontMedium);
-                            item.name = item.info.getFileName(Math::Frame::invalid, false);
-                            const float m = style->getMetric(UI::MetricsRole::MarginSmall);
-                            p.nameLinesFutures[i] = p.fontSystem->textLines(
-                                item.name,
-                                p.thumbnailSize.w - static_cast<uint16_t>(m * 2.F),
-                                fontInfo);
-
-                            auto ioSystem = context->getSystemT<AV::IO::IOSystem>();
-                            if (ioSystem && ioSystem->canRead(item.info))
-                            {
-                                p.thumbnailFutures[i] = thumbnailSystem->getImage(item.info, p.thumbnailSize);
-                            }
-                        }
-                    }
+                    // The new requests are made by the clip event for the
+                    // visible items.
+
                 }
             }
 
@@ -1244,10 +1238,16 @@ namespace djv
                         style->getFontInfo(Render2D::Font::faceDefault, UI::MetricsRole::FontMedium));
 
                     auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>();
-                    const size_t itemsSize = p.items.size();
-                    for (size_t i = 0; i < itemsSize; ++i)
+                    for (const auto& i : p.ioInfoFutures)
+                    {
+                        thumbnailSystem->cancelInfo(i.second.uid);
+                    }
+                    for (const auto& i : p.thumbnailFutures)
+                    {
+                        thumbnailSystem->cancelImage(i.second.uid);
+                    }
+                    for (auto& item : p.items)
                     {
-                        auto& item = p.items[i];
                         item.name.clear();
                         item.nameLinesInit = true;
                         item.nameLines.clear();
@@ -1261,11 +1261,6 @@ namespace djv
                         item.sizeGlyphs.clear();
                         item.timeGlyphsInit = true;
                         item.timeGlyphs.clear();
-                        const auto j = p.thumbnailFutures.find(i);
-                        if (j != p.thumbnailFutures.end())
-                        {
-                            thumbnailSystem->cancelImage(j->second.uid);
-                        }
                     }
 
                     p.nameLinesFutures.clear();
@@ -1278,6 +1273,51 @@ namespace djv
                 }
             }
 
+            Math::BBox2f ItemView::Private::getItemGeometry(size_t index) const
+            {
+                const size_t row = index / columns;
+                const size_t column = index % columns;
+                return Math::BBox2f(
+                    itemsOrigin.x + column * (itemSize.x + itemSpacing),
+                    itemsOrigin.y + row * (itemSize.y + itemSpacing),
+                    itemSize.x,
+                    itemSize.y);
+            }
+
+            void ItemView::Private::getItemRange(const Math::BBox2f& value, size_t& first, size_t& last, size_t prefetch) const
+            {
+                first = 0;
+                last = 0;
+                const float rowHeight = itemSize.y + itemSpacing;
+                if (rowHeight > 0.F && value.isValid())
+                {
+                    const float y0 = std::max(value.min.y - itemsOrigin.y, 0.F);
+                    const float y1 = std::max(value.max.y - itemsOrigin.y, 0.F);
+                    size_t rowFirst = static_cast<size_t>(y0 / rowHeight);
+                    rowFirst = rowFirst > prefetch ? (rowFirst - prefetch) : 0;
+                    const size_t rowLast = static_cast<size_t>(y1 / rowHeight) + 1 + prefetch;
+                    first = std::min(rowFirst * columns, items.size());
+                    last = std::min(rowLast * columns, items.size());
+                }
+            }
+
+            size_t ItemView::Private::getItemAt(const glm::vec2& value) const
+            {
+                size_t out = invalid;
+                size_t first = 0;
+                size_t last = 0;
+                getItemRange(Math::BBox2f(value, value + 1.F), first, last);
+                for (size_t i = first; i < last; ++i)
+                {
+                    if (getItemGeometry(i).contains(value))
+                    {
+                        out = i;
+                        break;
+                    }
+                }
+                return out;
+            }
+
         } // namespace FileBrowser
     } // namespace UIComponents
 } // namespace djv
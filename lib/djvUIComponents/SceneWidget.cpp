@@ -4,6 +4,8 @@
 
 #include <djvUIComponents/SceneWidget.h>
 
+#include <djvUI/Style.h>
+
 #include <djvScene3D/Camera.h>
 #include <djvScene3D/Render.h>
 #include <djvScene3D/Scene.h>
@@ -70,6 +72,7 @@ namespace djv
             System::Event::PointerID pressedID = System::Event::invalidID;
             std::map<int, bool> buttons;
             glm::vec2 pointerPos = glm::vec2(0.F, 0.F);
+            glm::vec2 pressedPos = glm::vec2(0.F, 0.F);
             std::shared_ptr<Observer::ValueSubject<Math::BBox3f> > bbox;
             std::shared_ptr<Observer::ValueSubject<size_t> > primitivesCount;
             std::shared_ptr<Observer::ValueSubject<size_t> > pointCount;
@@ -190,6 +193,26 @@ namespace djv
             }
         }
 
+        bool SceneWidget::pick(const glm::vec2& pos, glm::vec3& hit, std::shared_ptr<Scene3D::IPrimitive>& primitive)
+        {
+            DJV_PRIVATE_PTR();
+            bool out = false;
+            const Math::BBox2f& g = getGeometry();
+            if (p.scene && g.w() > 0.F && g.h() > 0.F)
+            {
+                const glm::vec2 ndc(
+                    (pos.x - g.min.x) / g.w() * 2.F - 1.F,
+                    1.F - (pos.y - g.min.y) / g.h() * 2.F);
+                const glm::mat4x4 m = glm::inverse(p.camera->getP() * p.camera->getV());
+                const glm::vec4 nearPos = m * glm::vec4(ndc.x, ndc.y, -1.F, 1.F);
+                const glm::vec4 farPos = m * glm::vec4(ndc.x, ndc.y, 1.F, 1.F);
+                const glm::vec3 start = glm::vec3(nearPos) / nearPos.w;
+                const glm::vec3 end = glm::vec3(farPos) / farPos.w;
+                out = p.scene->intersect(start, end - start, hit, primitive);
+            }
+            return out;
+        }
+
         std::shared_ptr<Observer::IValueSubject<SceneRotate> > SceneWidget::observeSceneRotate() const
         {
             return _p->sceneRotate;
@@ -307,6 +330,7 @@ namespace djv
             p.pressedID = pointerInfo.id;
             p.buttons = pointerInfo.buttons;
             p.pointerPos = pointerInfo.projectedPos;
+            p.pressedPos = pointerInfo.projectedPos;
         }
 
         void SceneWidget::_buttonReleaseEvent(System::Event::ButtonRelease & event)
@@ -316,6 +340,23 @@ namespace djv
             if (pointerInfo.id == p.pressedID)
             {
                 event.accept();
+
+                // Clicking without dragging moves the camera target to the
+                // picked point.
+                const float distance = glm::length(pointerInfo.projectedPos - p.pressedPos);
+                if (p.buttons.find(1) != p.buttons.end() &&
+                    distance < _getStyle()->getMetric(UI::MetricsRole::Drag))
+                {
+                    glm::vec3 hit(0.F, 0.F, 0.F);
+                    std::shared_ptr<Scene3D::IPrimitive> primitive;
+                    if (pick(pointerInfo.projectedPos, hit, primitive))
+                    {
+                        auto cameraData = p.cameraData->get();
+                        cameraData.target = hit;
+                        setCameraData(cameraData);
+                    }
+                }
+
                 p.pressedID = System::Event::invalidID;
                 p.buttons.clear();
             }
@@ -19,6 +19,7 @@ namespace djv
 {
     namespace Scene3D
     {
+        class IPrimitive;
         class Scene;
 
     } // namespace Scene3D
@@ -90,6 +91,16 @@ namespace djv
 
             ///@}
 
+            //! \name Picking
+            ///@{
+
+            //! Intersect the scene with the line through the given position.
+            //! Clicking in the widget moves the camera target to the picked
+            //! point.
+            bool pick(const glm::vec2&, glm::vec3& hit, std::shared_ptr<Scene3D::IPrimitive>&);
+
+            ///@}
+
             //! \name Options
             ///@{
 
@@ -28,23 +28,15 @@
 #include <djvUI/SettingsSystem.h>
 #include <djvUI/ToolButton.h>
 
-#include <djvRender2D/Render.h>
+#include <djvRender2D/FontSystem.h>
+#include <djvRender2D/ImageSampler.h>
 
 #include <djvOCIO/OCIOSystem.h>
 
-#include <djvGL/OffscreenBuffer.h>
-#if defined(DJV_GL_ES2)
-#include <djvGL/Mesh.h>
-#include <djvGL/Shader.h>
-#endif // DJV_GL_ES2
-
 #include <djvImage/ColorFunc.h>
-#include <djvImage/DataFunc.h>
+#include <djvImage/Data.h>
 
 #include <djvSystem/Context.h>
-#if defined(DJV_GL_ES2)
-#include <djvSystem/ResourceSystem.h>
-#endif // DJV_GL_ES2
 
 #include <djvCore/StringFunc.h>
 
@@ -63,9 +55,6 @@ namespace djv
         {
             //! \todo Should this be configurable?
             const size_t sampleSizeMax = 100;
-
-            //! \todo What is this really?
-            const size_t bufferSizeMin = 100;
         
         } // namespace
 
@@ -95,10 +84,7 @@ namespace djv
             std::shared_ptr<UI::FormLayout> formLayout;
             std::shared_ptr<UI::VerticalLayout> layout;
 
-            std::shared_ptr<GL::OffscreenBuffer> offscreenBuffer;
-#if defined(DJV_GL_ES2)
-            std::shared_ptr<GL::Shader> shader;
-#endif // DJV_GL_ES2
+            std::shared_ptr<Render2D::ImageSampler> sampler;
 
             std::shared_ptr<Observer::Value<ColorPickerData> > dataObserver;
             std::shared_ptr<Observer::Value<ImageData> > imageDataObserver;
@@ -176,14 +162,6 @@ namespace djv
             p.layout->addChild(hLayout);
             addChild(p.layout);
 
-#if defined(DJV_GL_ES2)
-            auto resourceSystem = context->getSystemT<System::ResourceSystem>();
-            const System::File::Path shaderPath = resourceSystem->getPath(System::File::ResourcePath::Shaders);
-            p.shader = GL::Shader::create(
-                System::File::Path(shaderPath, "djvRender2DVertex.glsl"),
-                System::File::Path(shaderPath, "djvRender2DFragment.glsl"));
-#endif // DJV_GL_ES2
-
             _sampleUpdate();
             _widgetUpdate();
 
@@ -503,30 +481,17 @@ namespace djv
                         p.imageData.aspectRatio);
                     pixelPos = glm::inverse(glm::translate(m, glm::vec2(-.5F, -.5F))) * pixelPos;
 
-                    const size_t sampleSize = std::max(p.data.sampleSize, bufferSizeMin);
-                    const Image::Size size(sampleSize, sampleSize);
-                    const Image::Type type = p.data.lockType != Image::Type::None ? p.data.lockType : p.image->getType();
-                    
-                    bool create = !p.offscreenBuffer;
-                    create |= p.offscreenBuffer && size != p.offscreenBuffer->getSize();
-                    create |= p.offscreenBuffer && type != p.offscreenBuffer->getColorType();
-                    if (create)
-                    {
-                        p.offscreenBuffer = GL::OffscreenBuffer::create(
-                            size,
-                            type,
-                            _getTextSystem());
-                    }
+                    // Find the image pixels under the sample area.
+                    const glm::mat3x3 mInverse = glm::inverse(m);
+                    const float sampleSize = static_cast<float>(p.data.sampleSize);
+                    const glm::vec3 a = mInverse * glm::vec3(0.F, 0.F, 1.F);
+                    const glm::vec3 b = mInverse * glm::vec3(sampleSize, sampleSize, 1.F);
+                    const int x0 = static_cast<int>(floorf(std::min(a.x, b.x) + .5F));
+                    const int y0 = static_cast<int>(floorf(std::min(a.y, b.y) + .5F));
+                    const int x1 = static_cast<int>(floorf(std::max(a.x, b.x) + .5F));
+                    const int y1 = static_cast<int>(floorf(std::max(a.y, b.y) + .5F));
+                    const Math::BBox2i bbox(x0, y0, std::max(x1 - x0, 1), std::max(y1 - y0, 1));
 
-                    p.offscreenBuffer->bind();
-                    const auto& render = _getRender();
-                    const auto imageFilterOptions = render->getImageFilterOptions();
-                    render->setImageFilterOptions(Render2D::ImageFilterOptions(Render2D::ImageFilter::Nearest));
-                    render->beginFrame(size);
-                    render->setFillColor(Image::Color(0.F, 0.F, 0.F));
-                    render->drawRect(Math::BBox2f(0.F, 0.F, sampleSize, sampleSize));
-                    render->setFillColor(Image::Color(1.F, 1.F, 1.F));
-                    render->pushTransform(m);
                     Render2D::ImageOptions options;
                     options.channelDisplay = p.imageData.channelDisplay;
                     options.alphaBlend = p.imageData.alphaBlend;
@@ -548,42 +513,26 @@ namespace djv
                         }
                         options.colorSpace.output = p.outputColorSpace;
                     }
-                    options.colorEnabled = p.imageData.colorEnabled;
-                    options.color = p.imageData.color;
-                    options.levelsEnabled = p.imageData.levelsEnabled;
-                    options.levels = p.imageData.levels;
-                    options.exposureEnabled = p.imageData.exposureEnabled;
-                    options.exposure = p.imageData.exposure;
-                    options.softClipEnabled = p.imageData.softClipEnabled;
-                    options.softClip = p.imageData.softClip;
-                    if (!p.data.applyColorOperations)
+                    if (p.data.applyColorOperations)
+                    {
+                        options.colorEnabled = p.imageData.colorEnabled;
+                        options.color = p.imageData.color;
+                        options.levelsEnabled = p.imageData.levelsEnabled;
+                        options.levels = p.imageData.levels;
+                        options.exposureEnabled = p.imageData.exposureEnabled;
+                        options.exposure = p.imageData.exposure;
+                        options.softClipEnabled = p.imageData.softClipEnabled;
+                        options.softClip = p.imageData.softClip;
+                    }
+                    if (!p.sampler || p.sampler->getOptions() != options)
                     {
-                        options.colorEnabled    = false;
-                        options.levelsEnabled   = false;
-                        options.exposureEnabled = false;
-                        options.softClipEnabled = false;
+                        p.sampler = Render2D::ImageSampler::create(options);
                     }
-                    options.cache = Render2D::ImageCache::Dynamic;
-                    render->drawImage(p.image, glm::vec2(0.F, 0.F), options);
-                    render->popTransform();
-                    render->endFrame();
-                    render->setImageFilterOptions(imageFilterOptions);
-                    auto data = Image::Data::create(Image::Info(p.data.sampleSize, p.data.sampleSize, type));
-                    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-#if !defined(DJV_GL_ES2)  // \todo GL_READ_FRAMEBUFFER, glClampColor not in OpenGL ES 2
-                    glBindFramebuffer(GL_READ_FRAMEBUFFER, p.offscreenBuffer->getID());
-                    glClampColor(GL_CLAMP_READ_COLOR, GL_FALSE);
-#endif // DJV_GL_ES2
-                    glPixelStorei(GL_PACK_ALIGNMENT, 1);
-                    glReadPixels(
-                        0,
-                        static_cast<int>(sampleSize) - static_cast<int>(data->getHeight()),
-                        data->getWidth(),
-                        data->getHeight(),
-                        Image::getGLFormat(type),
-                        Image::getGLType(type),
-                        data->getData());
-                    p.color = Image::getAverageColor(data);
+
+                    // The sample is computed on the CPU so that picking does
+                    // not need to render the image and wait for the GPU.
+                    const Image::Type type = p.data.lockType != Image::Type::None ? p.data.lockType : p.image->getType();
+                    p.color = p.sampler->average(*p.image, bbox).convert(type);
                 }
                 catch (const std::exception& e)
                 {
@@ -593,9 +542,9 @@ namespace djv
                     _log(String::join(messages, ' '), System::LogLevel::Error);
                 }
             }
-            else if (p.offscreenBuffer)
+            else if (p.sampler)
             {
-                p.offscreenBuffer.reset();
+                p.sampler.reset();
             }
             switch (p.imageData.rotate)
             {
@@ -24,6 +24,8 @@
 #include <djvAV/IOSystem.h>
 #include <djvAV/TimeFunc.h>
 
+#include <djvImage/DataPool.h>
+
 #include <djvSystem/Context.h>
 #include <djvSystem/FileInfoFunc.h>
 #include <djvSystem/LogSystem.h>
@@ -667,6 +669,10 @@ namespace djv
                 i->setCacheEnabled(cacheEnabled);
                 i->setCacheMaxByteCount(mediaCacheSizeByteCount);
             }
+
+            // Keep enough unused image memory to turn over a part of the cache
+            // without going back to the system.
+            Image::DataPool::getGlobal()->setMaxFreeByteCount(cacheMaxByteCount / 4);
         }
 
         void FileSystem::_showFileBrowserDialog()
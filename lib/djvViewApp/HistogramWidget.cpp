@@ -4,21 +4,423 @@
 
 #include <djvViewApp/HistogramWidget.h>
 
+#include <djvViewApp/Media.h>
+#include <djvViewApp/MediaWidget.h>
+#include <djvViewApp/WindowSystem.h>
+
+#include <djvUI/ComboBox.h>
+#include <djvUI/Label.h>
+#include <djvUI/RowLayout.h>
+
+#include <djvRender2D/Render.h>
+
+#include <djvImage/Data.h>
+#include <djvImage/Statistics.h>
+
+#include <djvSystem/Context.h>
+#include <djvSystem/Timer.h>
+#include <djvSystem/TimerFunc.h>
+
+#include <djvCore/Cache.h>
+#include <djvCore/MemoryFunc.h>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/matrix_transform_2d.hpp>
+
+#include <cmath>
+#include <future>
+#include <iomanip>
+#include <sstream>
+
 using namespace djv::Core;
 
 namespace djv
 {
     namespace ViewApp
     {
+        namespace
+        {
+            //! \todo Should these be configurable?
+            const size_t   binCount           = 256;
+            const uint16_t scopeSize          = 256;
+            const uint16_t playbackStep       = 4;
+            const size_t   statisticsCacheMax = 100;
+
+            enum class ScopeMode
+            {
+                Histogram,
+                Waveform,
+                Vectorscope,
+
+                Count,
+                First = Histogram
+            };
+
+            const std::vector<Image::Color> channelColors =
+            {
+                Image::Color(1.F, 0.F, 0.F, .6F),
+                Image::Color(0.F, 1.F, 0.F, .6F),
+                Image::Color(0.F, 0.F, 1.F, .6F),
+                Image::Color(1.F, 1.F, 1.F, .6F)
+            };
+
+            //! Scale a count for display, the counts are displayed on a log
+            //! scale so sparse values are still visible.
+            uint8_t getScopeValue(uint32_t count, float scale)
+            {
+                return static_cast<uint8_t>(std::min(logf(1.F + count) * scale, 255.F));
+            }
+
+            class ScopeWidget : public UI::Widget
+            {
+                DJV_NON_COPYABLE(ScopeWidget);
+
+            protected:
+                void _init(const std::shared_ptr<System::Context>&);
+                ScopeWidget();
+
+            public:
+                ~ScopeWidget() override;
+
+                static std::shared_ptr<ScopeWidget> create(const std::shared_ptr<System::Context>&);
+
+                void setStatistics(const std::shared_ptr<Image::Statistics>&);
+                void setMode(ScopeMode);
+
+            protected:
+                void _preLayoutEvent(System::Event::PreLayout&) override;
+                void _paintEvent(System::Event::Paint&) override;
+
+            private:
+                void _scopeImageUpdate();
+
+                std::shared_ptr<Image::Statistics> _statistics;
+                ScopeMode _mode = ScopeMode::Histogram;
+                std::shared_ptr<Image::Data> _scopeImage;
+            };
+
+            void ScopeWidget::_init(const std::shared_ptr<System::Context>& context)
+            {
+                Widget::_init(context);
+                setClassName("djv::ViewApp::ScopeWidget");
+                setBackgroundRole(UI::ColorRole::Trough);
+            }
+
+            ScopeWidget::ScopeWidget()
+            {}
+
+            ScopeWidget::~ScopeWidget()
+            {}
+
+            std::shared_ptr<ScopeWidget> ScopeWidget::create(const std::shared_ptr<System::Context>& context)
+            {
+                auto out = std::shared_ptr<ScopeWidget>(new ScopeWidget);
+                out->_init(context);
+                return out;
+            }
+
+            void ScopeWidget::setStatistics(const std::shared_ptr<Image::Statistics>& value)
+            {
+                if (value == _statistics)
+                    return;
+                _statistics = value;
+                _scopeImageUpdate();
+                _redraw();
+            }
+
+            void ScopeWidget::setMode(ScopeMode value)
+            {
+                if (value == _mode)
+                    return;
+                _mode = value;
+                _scopeImageUpdate();
+                _redraw();
+            }
+
+            void ScopeWidget::_preLayoutEvent(System::Event::PreLayout&)
+            {
+                const auto& style = _getStyle();
+                const float sw = style->getMetric(UI::MetricsRole::Swatch);
+                _setMinimumSize(glm::vec2(sw, sw));
+            }
+
+            void ScopeWidget::_paintEvent(System::Event::Paint&)
+            {
+                const auto& style = _getStyle();
+                const Math::BBox2f& g = getMargin().bbox(getGeometry(), style);
+                if (!_statistics || !_statistics->sampleCount)
+                    return;
+
+                const auto& render = _getRender();
+                switch (_mode)
+                {
+                case ScopeMode::Histogram:
+                {
+                    const auto& s = *_statistics;
+                    uint32_t max = 0;
+                    for (const auto i : s.histogram)
+                    {
+                        max = std::max(max, i);
+                    }
+                    const float scale = max > 0 ? (g.h() / logf(1.F + max)) : 0.F;
+                    const float binWidth = g.w() / static_cast<float>(s.binCount);
+                    for (uint8_t c = 0; c < s.channelCount; ++c)
+                    {
+                        std::vector<Math::BBox2f> rects;
+                        rects.reserve(s.binCount);
+                        const uint32_t* p = s.histogram.data() + c * s.binCount;
+                        for (size_t i = 0; i < s.binCount; ++i)
+                        {
+                            if (p[i])
+                            {
+                                const float h = logf(1.F + p[i]) * scale;
+                                rects.push_back(Math::BBox2f(
+                                    g.min.x + i * binWidth,
+                                    g.max.y - h,
+                                    binWidth,
+                                    h));
+                            }
+                        }
+                        render->setFillColor(s.channelCount < 3 ?
+                            (0 == c ? channelColors[3] : Image::Color(.5F, .5F, .5F, .6F)) :
+                            channelColors[c]);
+                        render->drawRects(rects);
+                    }
+                    break;
+                }
+                case ScopeMode::Waveform:
+                case ScopeMode::Vectorscope:
+                    if (_scopeImage)
+                    {
+                        const Image::Size& size = _scopeImage->getSize();
+                        glm::mat3x3 m(1.F);
+                        m = glm::translate(m, g.min);
+                        m = glm::scale(m, glm::vec2(g.w() / size.w, g.h() / size.h));
+                        render->pushTransform(m);
+                        render->setFillColor(Image::Color(1.F, 1.F, 1.F));
+                        Render2D::ImageOptions options;
+                        options.cache = Render2D::ImageCache::Dynamic;
+                        render->drawImage(_scopeImage, glm::vec2(0.F, 0.F), options);
+                        render->popTransform();
+                    }
+                    break;
+                default: break;
+                }
+            }
+
+            void ScopeWidget::_scopeImageUpdate()
+            {
+                _scopeImage.reset();
+                if (!_statistics)
+                    return;
+                const auto& s = *_statistics;
+                const float scale = s.sampleCount ? (255.F / logf(1.F + s.sampleCount) * 4.F) : 0.F;
+                switch (_mode)
+                {
+                case ScopeMode::Waveform:
+                    if (s.waveformWidth && s.waveformHeight)
+                    {
+                        // The waveform rows are stored with the lowest value
+                        // first so they are flipped for display.
+                        const uint16_t w = s.waveformWidth;
+                        const uint16_t h = s.waveformHeight;
+                        const size_t plane = static_cast<size_t>(w) * h;
+                        const bool rgb = s.channelCount >= 3;
+                        _scopeImage = Image::Data::create(Image::Info(w, h, rgb ? Image::Type::RGB_U8 : Image::Type::L_U8));
+                        for (uint16_t y = 0; y < h; ++y)
+                        {
+                            uint8_t* p = _scopeImage->getData(y);
+                            const size_t row = static_cast<size_t>(h - 1 - y) * w;
+                            for (uint16_t x = 0; x < w; ++x)
+                            {
+                                if (rgb)
+                                {
+                                    for (size_t c = 0; c < 3; ++c)
+                                    {
+                                        *p++ = getScopeValue(s.waveform[plane * c + row + x], scale);
+                                    }
+                                }
+                                else
+                                {
+                                    *p++ = getScopeValue(s.waveform[row + x], scale);
+                                }
+                            }
+                        }
+                    }
+                    break;
+                case ScopeMode::Vectorscope:
+                    if (s.vectorscopeSize)
+                    {
+                        const uint16_t size = s.vectorscopeSize;
+                        _scopeImage = Image::Data::create(Image::Info(size, size, Image::Type::L_U8));
+                        for (uint16_t y = 0; y < size; ++y)
+                        {
+                            uint8_t* p = _scopeImage->getData(y);
+                            const uint32_t* row = s.vectorscope.data() + static_cast<size_t>(size - 1 - y) * size;
+                            for (uint16_t x = 0; x < size; ++x)
+                            {
+                                p[x] = getScopeValue(row[x], scale);
+                            }
+                        }
+                    }
+                    break;
+                default: break;
+                }
+            }
+
+        } // namespace
+
         struct HistogramWidget::Private
         {
+            std::shared_ptr<Image::Data> image;
+            Playback playback = Playback::Stop;
+            ScopeMode mode = ScopeMode::Histogram;
+            std::shared_ptr<Image::Statistics> statistics;
+            Memory::Cache<size_t, std::shared_ptr<Image::Statistics> > statisticsCache;
+            std::future<std::shared_ptr<Image::Statistics> > statisticsFuture;
+            size_t statisticsFutureKey = 0;
+
+            std::shared_ptr<UI::ComboBox> modeComboBox;
+            std::shared_ptr<ScopeWidget> scopeWidget;
+            std::shared_ptr<UI::Text::Label> minLabel;
+            std::shared_ptr<UI::Text::Label> maxLabel;
+            std::shared_ptr<UI::VerticalLayout> layout;
+
+            std::shared_ptr<System::Timer> statisticsTimer;
 
+            std::shared_ptr<Observer::Value<std::shared_ptr<MediaWidget> > > activeWidgetObserver;
+            std::shared_ptr<Observer::Value<std::shared_ptr<Image::Data> > > imageObserver;
+            std::shared_ptr<Observer::Value<Playback> > playbackObserver;
+
+            Image::StatisticsOptions getStatisticsOptions() const;
         };
 
+        Image::StatisticsOptions HistogramWidget::Private::getStatisticsOptions() const
+        {
+            Image::StatisticsOptions out;
+            out.binCount = binCount;
+            out.step = playback != Playback::Stop ? playbackStep : 1;
+            switch (mode)
+            {
+            case ScopeMode::Waveform:
+                out.waveformWidth = scopeSize;
+                out.waveformHeight = scopeSize;
+                break;
+            case ScopeMode::Vectorscope:
+                out.vectorscopeSize = scopeSize;
+                break;
+            default: break;
+            }
+            return out;
+        }
+
         void HistogramWidget::_init(const std::shared_ptr<System::Context>& context)
         {
             MDIWidget::_init(context);
+
+            DJV_PRIVATE_PTR();
             setClassName("djv::ViewApp::HistogramWidget");
+
+            p.statisticsCache.setMax(statisticsCacheMax);
+
+            p.modeComboBox = UI::ComboBox::create(context);
+
+            p.scopeWidget = ScopeWidget::create(context);
+            p.scopeWidget->setShadowOverlay({ UI::Side::Top });
+
+            p.minLabel = UI::Text::Label::create(context);
+            p.minLabel->setFontFamily(Render2D::Font::familyMono);
+            p.minLabel->setTextHAlign(UI::TextHAlign::Left);
+            p.minLabel->setMargin(UI::MetricsRole::MarginSmall);
+            p.maxLabel = UI::Text::Label::create(context);
+            p.maxLabel->setFontFamily(Render2D::Font::familyMono);
+            p.maxLabel->setTextHAlign(UI::TextHAlign::Left);
+            p.maxLabel->setMargin(UI::MetricsRole::MarginSmall);
+
+            p.layout = UI::VerticalLayout::create(context);
+            p.layout->setSpacing(UI::MetricsRole::None);
+            p.layout->setBackgroundRole(UI::ColorRole::Background);
+            p.layout->addChild(p.modeComboBox);
+            p.layout->addChild(p.scopeWidget);
+            p.layout->setStretch(p.scopeWidget, UI::RowStretch::Expand);
+            p.layout->addChild(p.minLabel);
+            p.layout->addChild(p.maxLabel);
+            addChild(p.layout);
+
+            auto weak = std::weak_ptr<HistogramWidget>(std::dynamic_pointer_cast<HistogramWidget>(shared_from_this()));
+            p.modeComboBox->setCallback(
+                [weak](int value)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_p->mode = static_cast<ScopeMode>(value);
+                        widget->_p->scopeWidget->setMode(widget->_p->mode);
+                        widget->_statisticsUpdate();
+                    }
+                });
+
+            // Poll for finished statistics so the UI never waits on them.
+            p.statisticsTimer = System::Timer::create(context);
+            p.statisticsTimer->setRepeating(true);
+            p.statisticsTimer->start(
+                System::getTimerDuration(System::TimerValue::VeryFast),
+                [weak](const std::chrono::steady_clock::time_point&, const Time::Duration&)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        auto& p = *widget->_p;
+                        if (p.statisticsFuture.valid() &&
+                            p.statisticsFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                        {
+                            auto statistics = p.statisticsFuture.get();
+                            p.statisticsCache.add(p.statisticsFutureKey, statistics);
+                            widget->_statisticsUpdate();
+                        }
+                    }
+                });
+
+            if (auto windowSystem = context->getSystemT<WindowSystem>())
+            {
+                p.activeWidgetObserver = Observer::Value<std::shared_ptr<MediaWidget> >::create(
+                    windowSystem->observeActiveWidget(),
+                    [weak](const std::shared_ptr<MediaWidget>& value)
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            if (value)
+                            {
+                                widget->_p->imageObserver = Observer::Value<std::shared_ptr<Image::Data> >::create(
+                                    value->getMedia()->observeCurrentImage(),
+                                    [weak](const std::shared_ptr<Image::Data>& value)
+                                    {
+                                        if (auto widget = weak.lock())
+                                        {
+                                            widget->_p->image = value;
+                                            widget->_statisticsUpdate();
+                                        }
+                                    });
+
+                                widget->_p->playbackObserver = Observer::Value<Playback>::create(
+                                    value->getMedia()->observePlayback(),
+                                    [weak](Playback value)
+                                    {
+                                        if (auto widget = weak.lock())
+                                        {
+                                            widget->_p->playback = value;
+                                            widget->_statisticsUpdate();
+                                        }
+                                    });
+                            }
+                            else
+                            {
+                                widget->_p->image.reset();
+                                widget->_p->imageObserver.reset();
+                                widget->_p->playbackObserver.reset();
+                                widget->_statisticsUpdate();
+                            }
+                        }
+                    });
+            }
         }
 
         HistogramWidget::HistogramWidget() :
@@ -38,12 +440,86 @@ namespace djv
         void HistogramWidget::_initEvent(System::Event::Init & event)
         {
             MDIWidget::_initEvent(event);
+            DJV_PRIVATE_PTR();
             if (event.getData().text)
             {
                 setTitle(_getText(DJV_TEXT("Histogram")));
+
+                p.modeComboBox->setItems({
+                    _getText(DJV_TEXT("widget_histogram_mode_histogram")),
+                    _getText(DJV_TEXT("widget_histogram_mode_waveform")),
+                    _getText(DJV_TEXT("widget_histogram_mode_vectorscope")) });
+                p.modeComboBox->setCurrentItem(static_cast<int>(p.mode));
+                p.modeComboBox->setTooltip(_getText(DJV_TEXT("widget_histogram_mode_tooltip")));
+
+                _widgetUpdate();
+            }
+        }
+
+        void HistogramWidget::_statisticsUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            std::shared_ptr<Image::Statistics> statistics;
+            if (p.image && p.image->isValid())
+            {
+                // The statistics are cached by the image UID, a full pass is
+                // used when playback is stopped.
+                const auto options = p.getStatisticsOptions();
+                size_t key = 0;
+                Memory::hashCombine(key, p.image->getUID());
+                Memory::hashCombine(key, options.step);
+                Memory::hashCombine(key, options.waveformWidth);
+                Memory::hashCombine(key, options.vectorscopeSize);
+                if (!p.statisticsCache.get(key, statistics))
+                {
+                    if (!p.statisticsFuture.valid())
+                    {
+                        auto image = p.image;
+                        p.statisticsFutureKey = key;
+                        p.statisticsFuture = std::async(
+                            std::launch::async,
+                            [image, options]
+                            {
+                                return std::make_shared<Image::Statistics>(Image::getStatistics(*image, options));
+                            });
+                    }
+
+                    // Keep showing the previous statistics until the new ones
+                    // are ready.
+                    statistics = p.statistics;
+                }
+            }
+            if (statistics != p.statistics)
+            {
+                p.statistics = statistics;
+                _widgetUpdate();
             }
         }
 
+        void HistogramWidget::_widgetUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            p.scopeWidget->setStatistics(p.statistics);
+            std::stringstream min;
+            std::stringstream max;
+            if (p.statistics && p.statistics->sampleCount)
+            {
+                min << std::fixed << std::setprecision(4);
+                min << _getText(DJV_TEXT("widget_histogram_min")) << ":";
+                for (const auto i : p.statistics->min)
+                {
+                    min << " " << i;
+                }
+                max << std::fixed << std::setprecision(4);
+                max << _getText(DJV_TEXT("widget_histogram_max")) << ":";
+                for (const auto i : p.statistics->max)
+                {
+                    max << " " << i;
+                }
+            }
+            p.minLabel->setText(min.str());
+            p.maxLabel->setText(max.str());
+        }
+
     } // namespace ViewApp
 } // namespace djv
-
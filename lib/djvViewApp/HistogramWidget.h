@@ -10,7 +10,8 @@ namespace djv
 {
     namespace ViewApp
     {
-        //! This class provides the histogram widget.
+        //! This class provides the histogram widget. The statistics are computed
+        //! on a separate thread, with a decimated pass during playback.
         class HistogramWidget : public MDIWidget
         {
             DJV_NON_COPYABLE(HistogramWidget);
@@ -28,6 +29,9 @@ namespace djv
             void _initEvent(System::Event::Init &) override;
 
         private:
+            void _statisticsUpdate();
+            void _widgetUpdate();
+
             DJV_PRIVATE();
         };
 
@@ -21,6 +21,7 @@
 #include <djvUI/RowLayout.h>
 #include <djvUI/SettingsSystem.h>
 
+#include <djvRender2D/ImageSampler.h>
 #include <djvRender2D/Render.h>
 
 #include <djvOCIO/OCIOSystem.h>
@@ -28,10 +29,14 @@
 #include <djvImage/Data.h>
 
 #include <djvSystem/Context.h>
+#include <djvSystem/Timer.h>
+#include <djvSystem/TimerFunc.h>
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/matrix_transform_2d.hpp>
 
+#include <future>
+
 using namespace djv::Core;
 
 namespace djv
@@ -40,6 +45,13 @@ namespace djv
     {
         namespace
         {
+            struct CropResult
+            {
+                std::shared_ptr<Render2D::ImageSampler> sampler;
+                std::shared_ptr<Image::Data> crop;
+                Math::BBox2i bbox;
+            };
+
             class ImageWidget : public UI::Widget
             {
                 DJV_NON_COPYABLE(ImageWidget);
@@ -64,6 +76,8 @@ namespace djv
                 void _paintEvent(System::Event::Paint&) override;
 
             private:
+                void _cropUpdate(const Math::BBox2i&, const Render2D::ImageOptions&);
+
                 bool _currentTool = false;
                 std::shared_ptr<Image::Data> _image;
                 glm::vec2 _imagePos = glm::vec2(0.F, 0.F);
@@ -74,6 +88,14 @@ namespace djv
                 ViewBackgroundOptions _backgroundOptions;
                 int _magnify = 1;
                 glm::vec2 _magnifyPos = glm::vec2(0.F, 0.F);
+                std::shared_ptr<Render2D::ImageSampler> _sampler;
+                std::shared_ptr<Image::Data> _cropSource;
+                Math::BBox2i _cropBBox;
+                Render2D::ImageOptions _cropOptions;
+                std::future<CropResult> _cropFuture;
+                std::shared_ptr<Image::Data> _crop;
+                Math::BBox2i _cropImageBBox;
+                std::shared_ptr<System::Timer> _cropTimer;
 
                 std::shared_ptr<Observer::Value<std::shared_ptr<MediaWidget> > > _activeWidgetObserver;
                 std::shared_ptr<Observer::Value<std::shared_ptr<Image::Data> > > _imageObserver;
@@ -91,6 +113,38 @@ namespace djv
                 Widget::_init(context);
 
                 auto weak = std::weak_ptr<ImageWidget>(std::dynamic_pointer_cast<ImageWidget>(shared_from_this()));
+
+                // Poll for finished crops so the render thread never waits on
+                // them.
+                _cropTimer = System::Timer::create(context);
+                _cropTimer->setRepeating(true);
+                _cropTimer->start(
+                    System::getTimerDuration(System::TimerValue::VeryFast),
+                    [weak](const std::chrono::steady_clock::time_point&, const Time::Duration&)
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            if (widget->_cropFuture.valid() &&
+                                widget->_cropFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                            {
+                                try
+                                {
+                                    const auto result = widget->_cropFuture.get();
+                                    widget->_sampler = result.sampler;
+                                    widget->_crop = result.crop;
+                                    widget->_cropImageBBox = result.bbox;
+                                }
+                                catch (const std::exception& e)
+                                {
+                                    widget->_sampler.reset();
+                                    widget->_crop.reset();
+                                    widget->_log(e.what(), System::LogLevel::Error);
+                                }
+                                widget->_redraw();
+                            }
+                        }
+                    });
+
                 if (auto windowSystem = context->getSystemT<WindowSystem>())
                 {
                     _activeWidgetObserver = Observer::Value<std::shared_ptr<MediaWidget> >::create(
@@ -277,14 +331,38 @@ namespace djv
 
                 if (_image)
                 {
-                    render->setFillColor(Image::Color(1.F, 1.F, 1.F));
-
                     const float magnify = powf(_magnify, 2.F);
                     glm::mat3x3 m(1.F);
                     m = glm::translate(m, glm::vec2(g.w() / 2.F, g.h() / 2.F) - glm::vec2(_magnifyPos.x * magnify, _magnifyPos.y * magnify));
                     m = glm::translate(m, g.min + glm::vec2(_imagePos.x * magnify, _imagePos.y * magnify));
                     m *= UI::ImageWidget::getXForm(_image, _imageData.rotate, glm::vec2(_imageZoom * magnify, _imageZoom * magnify), _imageData.aspectRatio);
-                    render->pushTransform(m);
+
+                    // Find the image pixels that are visible in the widget.
+                    const glm::mat3x3 mInverse = glm::inverse(m);
+                    const glm::vec3 pts[4] =
+                    {
+                        mInverse * glm::vec3(g.min.x, g.min.y, 1.F),
+                        mInverse * glm::vec3(g.max.x, g.min.y, 1.F),
+                        mInverse * glm::vec3(g.max.x, g.max.y, 1.F),
+                        mInverse * glm::vec3(g.min.x, g.max.y, 1.F)
+                    };
+                    glm::vec2 min(pts[0].x, pts[0].y);
+                    glm::vec2 max(pts[0].x, pts[0].y);
+                    for (size_t i = 1; i < 4; ++i)
+                    {
+                        min.x = std::min(min.x, pts[i].x);
+                        min.y = std::min(min.y, pts[i].y);
+                        max.x = std::max(max.x, pts[i].x);
+                        max.y = std::max(max.y, pts[i].y);
+                    }
+                    const int x0 = static_cast<int>(floorf(min.x));
+                    const int y0 = static_cast<int>(floorf(min.y));
+                    const Math::BBox2i bbox(
+                        x0,
+                        y0,
+                        std::max(static_cast<int>(ceilf(max.x)) - x0, 1),
+                        std::max(static_cast<int>(ceilf(max.y)) - y0, 1));
+
                     Render2D::ImageOptions options;
                     options.channelDisplay = _imageData.channelDisplay;
                     options.alphaBlend = _imageData.alphaBlend;
@@ -311,12 +389,49 @@ namespace djv
                     options.exposure = _imageData.exposure;
                     options.softClipEnabled = _imageData.softClipEnabled;
                     options.softClip = _imageData.softClip;
-                    options.cache = Render2D::ImageCache::Dynamic;
-                    render->drawImage(_image, glm::vec2(0.F, 0.F), options);
-                    render->popTransform();
+                    _cropUpdate(bbox, options);
+
+                    // The crop already has the image options applied. The
+                    // previous crop is drawn until the new one is ready.
+                    if (_crop)
+                    {
+                        render->setFillColor(Image::Color(1.F, 1.F, 1.F));
+                        render->pushTransform(m);
+                        Render2D::ImageOptions cropOptions;
+                        cropOptions.alphaBlend = options.alphaBlend;
+                        cropOptions.cache = Render2D::ImageCache::Dynamic;
+                        render->drawImage(_crop, glm::vec2(_cropImageBBox.min.x, _cropImageBBox.min.y), cropOptions);
+                        render->popTransform();
+                    }
                 }
             }
 
+            void ImageWidget::_cropUpdate(const Math::BBox2i& bbox, const Render2D::ImageOptions& options)
+            {
+                // Only one crop is computed at a time, the widget is redrawn
+                // when it is finished and the next crop is started then.
+                if ((_image == _cropSource && bbox == _cropBBox && options == _cropOptions) ||
+                    _cropFuture.valid())
+                    return;
+                _cropSource = _image;
+                _cropBBox = bbox;
+                _cropOptions = options;
+                auto image = _image;
+                auto sampler = _sampler;
+                _cropFuture = std::async(
+                    std::launch::async,
+                    [image, sampler, bbox, options]
+                    {
+                        CropResult out;
+                        out.sampler = sampler && sampler->getOptions() == options ?
+                            sampler :
+                            Render2D::ImageSampler::create(options);
+                        out.crop = out.sampler->crop(*image, bbox);
+                        out.bbox = Render2D::ImageSampler::getCropBBox(*image, bbox);
+                        return out;
+                    });
+            }
+
         } // namespace
 
         struct MagnifyWidget::Private
@@ -61,6 +61,7 @@ namespace djv
             std::shared_ptr<Observer::ValueSubject<Math::Frame::Sequence> > sequence;
             std::shared_ptr<Observer::ValueSubject<Math::Frame::Index> > currentFrame;
             std::shared_ptr<Observer::ValueSubject<std::shared_ptr<Image::Data> > > currentImage;
+            std::shared_ptr<Observer::ListSubject<std::shared_ptr<Image::Data> > > queuedImages;
             std::shared_ptr<Observer::ValueSubject<Playback> > playback;
             std::shared_ptr<Observer::ValueSubject<PlaybackMode> > playbackMode;
             std::shared_ptr<Observer::ValueSubject<AV::IO::InOutPoints> > inOutPoints;
@@ -120,6 +121,7 @@ namespace djv
             p.sequence = Observer::ValueSubject<Math::Frame::Sequence>::create();
             p.currentFrame = Observer::ValueSubject<Math::Frame::Index>::create(Math::Frame::invalid);
             p.currentImage = Observer::ValueSubject<std::shared_ptr<Image::Data> >::create();
+            p.queuedImages = Observer::ListSubject<std::shared_ptr<Image::Data> >::create();
             p.playback = Observer::ValueSubject<Playback>::create(Playback::First);
             p.playbackMode = Observer::ValueSubject<PlaybackMode>::create(PlaybackMode::First);
             p.inOutPoints = Observer::ValueSubject<AV::IO::InOutPoints>::create();
@@ -150,7 +152,7 @@ namespace djv
             {
                 if (auto media = weak.lock())
                 {
-                    media->_p->realSpeedSubject->setIfChanged(media->_p->realSpeed);
+                    media->_p->realSpeedSubject->setDeferred(media->_p->realSpeed);
                 }
             });
             p.cacheTimer = System::Timer::create(context);
@@ -241,7 +243,17 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (p.layers->setIfChanged(std::make_pair(p.info->get().video, value)))
             {
-                _open();
+                // Readers with a layer aware cache can switch without
+                // re-opening the file.
+                if (p.read && p.read->canSetLayer())
+                {
+                    p.read->setLayer(value);
+                    _seek(p.currentFrame->get());
+                }
+                else
+                {
+                    _open();
+                }
             }
         }
 
@@ -280,6 +292,11 @@ namespace djv
             return _p->currentImage;
         }
 
+        std::shared_ptr<Observer::IListSubject<std::shared_ptr<Image::Data> > > Media::observeQueuedImages() const
+        {
+            return _p->queuedImages;
+        }
+
         std::shared_ptr<Observer::IValueSubject<Math::Rational> > Media::observeSpeed() const
         {
             return _p->speed;
@@ -865,8 +882,8 @@ namespace djv
                                 {
                                     const auto& sequence = media->_p->read->getCacheSequence();
                                     const auto& frames = media->_p->read->getCachedFrames();
-                                    media->_p->cacheSequence->setIfChanged(sequence);
-                                    media->_p->cachedFrames->setIfChanged(frames);
+                                    media->_p->cacheSequence->setDeferred(sequence);
+                                    media->_p->cachedFrames->setDeferred(frames);
                                 }
                             }
                         });
@@ -899,10 +916,10 @@ namespace djv
                                     }
                                     if (valid)
                                     {
-                                        media->_p->videoQueueMax->setAlways(videoQueueMax);
-                                        media->_p->videoQueueCount->setAlways(videoQueueCount);
-                                        media->_p->audioQueueMax->setAlways(audioQueueMax);
-                                        media->_p->audioQueueCount->setAlways(audioQueueCount);
+                                        media->_p->videoQueueMax->setDeferred(videoQueueMax);
+                                        media->_p->videoQueueCount->setDeferred(videoQueueCount);
+                                        media->_p->audioQueueMax->setDeferred(audioQueueMax);
+                                        media->_p->audioQueueCount->setDeferred(audioQueueCount);
                                     }
                                 }
                             }
@@ -1192,6 +1209,7 @@ namespace djv
                 const Math::Frame::Index currentFrame = p.currentFrame->get();
                 AV::IO::VideoFrame frame;
                 bool gotFrame = false;
+                std::vector<std::shared_ptr<Image::Data> > queuedImages;
                 {
                     std::lock_guard<std::mutex> lock(p.read->getMutex());
                     auto& queue = p.read->getVideoQueue();
@@ -1222,7 +1240,15 @@ namespace djv
                         frame = queue.getFrame();
                         gotFrame = true;
                     }
+                    for (const auto& i : queue.getFrames())
+                    {
+                        if (i.data)
+                        {
+                            queuedImages.push_back(i.data);
+                        }
+                    }
                 }
+                p.queuedImages->setIfChanged(queuedImages);
                 if (gotFrame)
                 {
                     if (p.realSpeedFrameCount >= realSpeedFrameCount)
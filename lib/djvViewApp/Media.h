@@ -94,6 +94,9 @@ namespace djv
 
             std::shared_ptr<Core::Observer::IValueSubject<std::shared_ptr<Image::Data> > > observeCurrentImage() const;
 
+            //! Observe the images that are waiting in the video queue.
+            std::shared_ptr<Core::Observer::IListSubject<std::shared_ptr<Image::Data> > > observeQueuedImages() const;
+
             ///@}
 
             //! \name Playback
@@ -43,6 +43,9 @@ namespace djv
         {
             //! \todo Should this be configurable?
             const size_t zoomAnimation = 200;
+
+            //! \todo Should this be configurable?
+            const uint16_t tiledImageSizeMin = 4096;
             
         } // namespace
 
@@ -85,6 +88,7 @@ namespace djv
             std::shared_ptr<Observer::Value<Math::Frame::Sequence> > sequenceObserver;
             std::shared_ptr<Observer::Value<Math::Frame::Index> > currentFrameObserver;
             std::shared_ptr<Observer::List<std::shared_ptr<AnnotatePrimitive> > > annotationsObserver;
+            std::shared_ptr<Observer::List<std::shared_ptr<Image::Data> > > queuedImagesObserver;
 
             std::shared_ptr<System::Animation::Animation> zoomAnimation;
         };
@@ -265,6 +269,21 @@ namespace djv
                     }
                 });
 
+            // Upload the frames in the video queue in the background so that
+            // they are ready to be drawn.
+            p.queuedImagesObserver = Observer::List<std::shared_ptr<Image::Data> >::create(
+                p.media->observeQueuedImages(),
+                [weak](const std::vector<std::shared_ptr<Image::Data> >& value)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        for (const auto& i : value)
+                        {
+                            widget->_getRender()->uploadImage(i);
+                        }
+                    }
+                });
+
             p.zoomAnimation = System::Animation::Animation::create(context);
             p.zoomAnimation->setType(System::Animation::Type::SmoothStep);
         }
@@ -499,7 +518,12 @@ namespace djv
                 options.exposure = p.imageData.exposure;
                 options.softClipEnabled = p.imageData.softClipEnabled;
                 options.softClip = p.imageData.softClip;
-                options.cache = Render2D::ImageCache::Dynamic;
+                // Large still images are drawn with tiles so that only the
+                // visible tiles are uploaded, and zooming out uses mipmaps.
+                const bool tiled =
+                    Playback::Stop == p.media->observePlayback()->get() &&
+                    (image->getWidth() > tiledImageSizeMin || image->getHeight() > tiledImageSizeMin);
+                options.cache = tiled ? Render2D::ImageCache::Tiled : Render2D::ImageCache::Dynamic;
                 render->drawImage(image, glm::vec2(0.F, 0.F), options);
                 render->popTransform();
             }
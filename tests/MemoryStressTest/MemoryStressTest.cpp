@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvImage/TypeFunc.h>
+
+#include <djvCore/MemoryFunc.h>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+using namespace djv;
+
+// The size of a 4K 10-bit DPX frame.
+const size_t pixelCount = 4096 * 2160;
+const size_t iterations = 100;
+
+void print(const std::string& name, Core::Memory::SIMD simd, size_t byteCount, const std::function<void(void)>& function)
+{
+    Core::Memory::setSIMD(simd);
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        function();
+    }
+    const std::chrono::duration<double> delta = std::chrono::steady_clock::now() - start;
+    const double gigabytes = byteCount * iterations / static_cast<double>(Core::Memory::gigabyte);
+    std::cout << name << " (" << static_cast<int>(simd) << "): " << gigabytes / delta.count() << " GB/s" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<uint8_t> in(pixelCount * 8);
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        in[i] = static_cast<uint8_t>(i);
+    }
+    std::vector<uint8_t> out(in.size());
+    std::vector<Image::U16_T> u16(pixelCount * 3);
+
+    // The byte counts are for the input data. Only the SIMD instruction sets
+    // that the CPU supports are measured.
+    const auto supported = Core::Memory::getSupportedSIMD();
+    std::cout << "Supported SIMD: " << static_cast<int>(supported) << std::endl;
+    for (size_t i = static_cast<size_t>(Core::Memory::SIMD::First); i <= static_cast<size_t>(supported); ++i)
+    {
+        const auto simd = static_cast<Core::Memory::SIMD>(i);
+        for (size_t wordSize : { 2, 4, 8 })
+        {
+            print(
+                "Endian " + std::to_string(wordSize),
+                simd,
+                pixelCount * 4,
+                [&in, &out, wordSize]
+                {
+                    Core::Memory::endian(in.data(), out.data(), pixelCount * 4 / wordSize, wordSize);
+                });
+        }
+        print(
+            "Endian 4 in place",
+            simd,
+            pixelCount * 4,
+            [&out]
+            {
+                Core::Memory::endian(out.data(), pixelCount, 4);
+            });
+        print(
+            "Unpack U10",
+            simd,
+            pixelCount * 4,
+            [&in, &u16]
+            {
+                Image::unpackU10(reinterpret_cast<const Image::U10_S*>(in.data()), u16.data(), pixelCount);
+            });
+        print(
+            "Pack U10",
+            simd,
+            pixelCount * 6,
+            [&u16, &out]
+            {
+                Image::packU10(u16.data(), reinterpret_cast<Image::U10_S*>(out.data()), pixelCount);
+            });
+    }
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCore/ValueObserver.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace djv;
+
+const size_t observerCount = 1000;
+const size_t setCount = 10000;
+const size_t setsPerDispatch = 10;
+
+typedef std::vector<std::shared_ptr<Core::Observer::Value<int> > > Observers;
+
+Observers createObservers(const std::shared_ptr<Core::Observer::ValueSubject<int> >& subject, size_t& sum)
+{
+    Observers out;
+    for (size_t i = 0; i < observerCount; ++i)
+    {
+        out.push_back(Core::Observer::Value<int>::create(
+            subject,
+            [&sum](int value)
+            {
+                sum += value;
+            },
+            Core::Observer::CallbackAction::Suppress));
+    }
+    return out;
+}
+
+void print(const std::string& name, size_t count, const std::chrono::steady_clock::time_point& start)
+{
+    const std::chrono::duration<double> delta = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << static_cast<size_t>(count / delta.count()) << " per second" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    size_t sum = 0;
+
+    // Notify the observers immediately for every change.
+    {
+        auto subject = Core::Observer::ValueSubject<int>::create();
+        auto observers = createObservers(subject, sum);
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < setCount; ++i)
+        {
+            subject->setIfChanged(static_cast<int>(i + 1));
+        }
+        print("Immediate notifications", setCount * observerCount, start);
+    }
+
+    // Defer the changes and dispatch them once for several changes, like a
+    // timer that fires several times in a tick.
+    {
+        auto subject = Core::Observer::ValueSubject<int>::create();
+        auto observers = createObservers(subject, sum);
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < setCount; ++i)
+        {
+            subject->setDeferred(static_cast<int>(i + 1));
+            if (0 == (i + 1) % setsPerDispatch)
+            {
+                Core::Observer::dispatchDeferred();
+            }
+        }
+        Core::Observer::dispatchDeferred();
+        print("Deferred changes", setCount, start);
+        print("Deferred notifications", setCount / setsPerDispatch * observerCount, start);
+    }
+
+    // Destroy the observers in creation order while the subject is alive.
+    {
+        auto subject = Core::Observer::ValueSubject<int>::create();
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < setCount / 100; ++i)
+        {
+            auto observers = createObservers(subject, sum);
+            for (auto& j : observers)
+            {
+                j.reset();
+            }
+        }
+        print("Observer create and destroy", setCount / 100 * observerCount, start);
+    }
+
+    std::cout << "Sum: " << sum << std::endl;
+    return 0;
+}
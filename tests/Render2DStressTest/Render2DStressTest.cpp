@@ -186,13 +186,18 @@ void Application::run()
     while (!glfwWindowShouldClose(_glfwWindow))
     {
         glfwPollEvents();
+        const auto renderStart = std::chrono::steady_clock::now();
         _render();
+        const std::chrono::duration<float, std::milli> renderDelta = std::chrono::steady_clock::now() - renderStart;
         glfwSwapBuffers(_glfwWindow);
         auto now = std::chrono::steady_clock::now();
         std::chrono::duration<float> delta = now - time;
         time = now;
         const float dt = delta.count();
-        std::cout << "FPS: " << (dt > 0.f ? 1.f / dt : 0.f) << std::endl;
+        std::cout << "FPS: " << (dt > 0.f ? 1.f / dt : 0.f) <<
+            " Primitives: " << _render2D->getPrimitivesCount() <<
+            " Draw calls: " << _render2D->getDrawCallCount() <<
+            " CPU ms: " << renderDelta.count() << std::endl;
     }
 }
 
@@ -109,7 +109,12 @@ namespace djv
                 DJV_ASSERT(!queue.isEmpty());
                 DJV_ASSERT(3 == queue.getCount());
                 DJV_ASSERT(frame == queue.getFrame());
+                const auto frames = queue.getFrames();
+                DJV_ASSERT(3 == frames.size());
+                DJV_ASSERT(frame == frames[0]);
+                DJV_ASSERT(3 == frames[2].frame);
                 DJV_ASSERT(frame == queue.popFrame());
+                DJV_ASSERT(2 == queue.getFrame().frame);
                 queue.clearFrames();
                 DJV_ASSERT(queue.isEmpty());
                 queue.setFinished(true);
@@ -237,6 +242,37 @@ namespace djv
                     _print(ss.str());
                 }
             }
+
+            {
+                Cache cache;
+                cache.setMax(10);
+                cache.setSequenceSize(10);
+                const auto image = Image::Data::create(Image::Info(1, 2, Image::Type::RGB_U8));
+                const size_t byteCount = image->getDataByteCount();
+                cache.setMaxByteCount(byteCount * 12);
+                for (Math::Frame::Index i = 0; i < 10; ++i)
+                {
+                    cache.add(i, 0, Image::Data::create(Image::Info(1, 2, Image::Type::RGB_U8)));
+                }
+                DJV_ASSERT(Math::Frame::Sequence(Math::Frame::Range(0, 9)) == cache.getFrames());
+                cache.add(0, 1, image);
+                cache.add(1, 1, Image::Data::create(Image::Info(1, 2, Image::Type::RGB_U8)));
+                DJV_ASSERT(10 == cache.getCount());
+                DJV_ASSERT(cache.contains(0, 1));
+                DJV_ASSERT(!cache.contains(2, 1));
+                DJV_ASSERT(byteCount * 12 == cache.getTotalByteCount());
+                DJV_ASSERT(byteCount * 2 == cache.getLayerByteCount(1));
+                cache.setLayer(1);
+                DJV_ASSERT(2 == cache.getCount());
+                DJV_ASSERT(Math::Frame::Sequence(Math::Frame::Range(0, 1)) == cache.getFrames());
+                std::shared_ptr<Image::Data> image2;
+                DJV_ASSERT(cache.get(0, image2));
+                DJV_ASSERT(image == image2);
+                cache.setMaxByteCount(byteCount * 4);
+                DJV_ASSERT(byteCount * 4 == cache.getTotalByteCount());
+                DJV_ASSERT(cache.contains(0));
+                DJV_ASSERT(cache.contains(1));
+            }
         }
         
         void IOTest::_plugin()
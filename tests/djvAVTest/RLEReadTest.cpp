@@ -0,0 +1,840 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/RLEReadTest.h>
+
+#include <djvAV/IOSystem.h>
+
+#include <djvSystem/Context.h>
+#include <djvSystem/FileIO.h>
+#include <djvSystem/TimerFunc.h>
+
+#include <djvImage/TypeFunc.h>
+
+#include <djvCore/ErrorFunc.h>
+
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+using namespace djv::Core;
+using namespace djv::AV;
+using namespace djv::AV::IO;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            const uint16_t width = 13;
+            const uint16_t height = 5;
+
+            //! Get a test value. The values repeat along the X axis so that
+            //! the data has both runs and literals.
+            uint16_t getValue(size_t x, size_t y, size_t c, size_t bytes)
+            {
+                const uint16_t out = static_cast<uint16_t>((x / 4) * 40 + y * 3 + c * 50 + (x % 3 == 2 ? x : 0));
+                return 1 == bytes ? (out & 0xff) : static_cast<uint16_t>(out * 251);
+            }
+
+            void writeValue(std::vector<uint8_t>& out, uint32_t value, size_t bytes, bool msb)
+            {
+                for (size_t i = 0; i < bytes; ++i)
+                {
+                    const size_t shift = (msb ? (bytes - 1 - i) : i) * 8;
+                    out.push_back(static_cast<uint8_t>((value >> shift) & 0xff));
+                }
+            }
+
+            void setValue(std::vector<uint8_t>& out, size_t pos, uint32_t value, size_t bytes)
+            {
+                for (size_t i = 0; i < bytes; ++i)
+                {
+                    out[pos + i] = static_cast<uint8_t>((value >> ((bytes - 1 - i) * 8)) & 0xff);
+                }
+            }
+
+            void writeString(std::vector<uint8_t>& out, const char* value)
+            {
+                out.insert(out.end(), value, value + strlen(value));
+            }
+
+            //! Get the length of the run starting at the given position.
+            template<typename T>
+            size_t getRun(const std::vector<T>& values, size_t pos, size_t max)
+            {
+                size_t out = 1;
+                while (pos + out < values.size() && out < max && values[pos + out] == values[pos])
+                {
+                    ++out;
+                }
+                return out;
+            }
+
+            //! Get the length of the literal starting at the given position.
+            template<typename T>
+            size_t getLiteral(const std::vector<T>& values, size_t pos, size_t max)
+            {
+                size_t out = 1;
+                while (pos + out < values.size() && out < max && getRun(values, pos + out, 2) < 2)
+                {
+                    ++out;
+                }
+                return out;
+            }
+
+            //! Encode SGI RLE data. The high bit of the count marks a literal
+            //! and a zero count ends the scanline.
+            void writeSGIRle(std::vector<uint8_t>& out, const std::vector<uint16_t>& values, size_t bytes)
+            {
+                for (size_t x = 0; x < values.size();)
+                {
+                    const size_t run = getRun(values, x, 127);
+                    if (run > 1)
+                    {
+                        writeValue(out, static_cast<uint32_t>(run), bytes, true);
+                        writeValue(out, values[x], bytes, true);
+                        x += run;
+                    }
+                    else
+                    {
+                        const size_t literal = getLiteral(values, x, 127);
+                        writeValue(out, static_cast<uint32_t>(0x80 | literal), bytes, true);
+                        for (size_t i = 0; i < literal; ++i, ++x)
+                        {
+                            writeValue(out, values[x], bytes, true);
+                        }
+                    }
+                }
+                writeValue(out, 0, bytes, true);
+            }
+
+            //! Encode RLA RLE data. A positive count is a run of count + 1
+            //! bytes and a negative count is a literal.
+            void writeRLARle(std::vector<uint8_t>& out, const std::vector<uint8_t>& values)
+            {
+                for (size_t x = 0; x < values.size();)
+                {
+                    const size_t run = getRun(values, x, 128);
+                    if (run > 1)
+                    {
+                        out.push_back(static_cast<uint8_t>(run - 1));
+                        out.push_back(values[x]);
+                        x += run;
+                    }
+                    else
+                    {
+                        const size_t literal = getLiteral(values, x, 128);
+                        out.push_back(static_cast<uint8_t>(-static_cast<int>(literal)));
+                        out.insert(out.end(), values.begin() + x, values.begin() + x + literal);
+                        x += literal;
+                    }
+                }
+            }
+
+            //! Encode Targa and IFF RLE data. The high bit of the count marks
+            //! a run, the count is stored minus one, and the values are pixels
+            //! of the given size.
+            void writePacketRle(std::vector<uint8_t>& out, const std::vector<std::vector<uint8_t> >& values)
+            {
+                for (size_t x = 0; x < values.size();)
+                {
+                    const size_t run = getRun(values, x, 128);
+                    if (run > 1)
+                    {
+                        out.push_back(static_cast<uint8_t>(0x80 | (run - 1)));
+                        out.insert(out.end(), values[x].begin(), values[x].end());
+                        x += run;
+                    }
+                    else
+                    {
+                        const size_t literal = getLiteral(values, x, 128);
+                        out.push_back(static_cast<uint8_t>(literal - 1));
+                        for (size_t i = 0; i < literal; ++i, ++x)
+                        {
+                            out.insert(out.end(), values[x].begin(), values[x].end());
+                        }
+                    }
+                }
+            }
+
+            //! Get the expected image data. The values are stored in native
+            //! byte order unless the big endian flag is set.
+            std::vector<uint8_t> getImageData(const Image::Info& info, bool msb = false)
+            {
+                std::vector<uint8_t> out;
+                const size_t channels = Image::getChannelCount(info.type);
+                const size_t bytes = Image::getByteCount(Image::getDataType(info.type));
+                for (size_t y = 0; y < info.size.h; ++y)
+                {
+                    for (size_t x = 0; x < info.size.w; ++x)
+                    {
+                        for (size_t c = 0; c < channels; ++c)
+                        {
+                            const uint16_t value = getValue(x, y, c, bytes);
+                            writeValue(out, value, bytes, msb || Memory::Endian::MSB == Memory::getEndian());
+                        }
+                    }
+                }
+                return out;
+            }
+
+            std::vector<uint8_t> createSGI(const Image::Info& info, bool rle)
+            {
+                const size_t channels = Image::getChannelCount(info.type);
+                const size_t bytes = Image::getByteCount(Image::getDataType(info.type));
+                std::vector<uint8_t> out;
+                writeValue(out, 474, 2, true);
+                writeValue(out, rle ? 1 : 0, 1, true);
+                writeValue(out, static_cast<uint32_t>(bytes), 1, true);
+                writeValue(out, 3, 2, true);
+                writeValue(out, info.size.w, 2, true);
+                writeValue(out, info.size.h, 2, true);
+                writeValue(out, static_cast<uint32_t>(channels), 2, true);
+                writeValue(out, 0, 4, true);
+                writeValue(out, 1 == bytes ? 255 : 65535, 4, true);
+                out.resize(512, 0);
+                if (!rle)
+                {
+                    for (size_t c = 0; c < channels; ++c)
+                    {
+                        for (size_t y = 0; y < info.size.h; ++y)
+                        {
+                            for (size_t x = 0; x < info.size.w; ++x)
+                            {
+                                writeValue(out, getValue(x, y, c, bytes), bytes, true);
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    // The scanline offset and size tables are followed by the
+                    // scanlines.
+                    const size_t count = info.size.h * channels;
+                    const size_t tablePos = out.size();
+                    out.resize(out.size() + count * 4 * 2, 0);
+                    for (size_t c = 0; c < channels; ++c)
+                    {
+                        for (size_t y = 0; y < info.size.h; ++y)
+                        {
+                            std::vector<uint16_t> values;
+                            for (size_t x = 0; x < info.size.w; ++x)
+                            {
+                                values.push_back(getValue(x, y, c, bytes));
+                            }
+                            const size_t pos = out.size();
+                            writeSGIRle(out, values, bytes);
+                            setValue(out, tablePos + (y + info.size.h * c) * 4, static_cast<uint32_t>(pos), 4);
+                            setValue(out, tablePos + (count + y + info.size.h * c) * 4, static_cast<uint32_t>(out.size() - pos), 4);
+                        }
+                    }
+                }
+                return out;
+            }
+
+            //! Create a compressed single channel SGI image from the given
+            //! scanline data.
+            std::vector<uint8_t> createSGI(uint16_t w, const std::vector<uint8_t>& scanline)
+            {
+                std::vector<uint8_t> out;
+                writeValue(out, 474, 2, true);
+                writeValue(out, 1, 1, true);
+                writeValue(out, 1, 1, true);
+                writeValue(out, 3, 2, true);
+                writeValue(out, w, 2, true);
+                writeValue(out, 1, 2, true);
+                writeValue(out, 1, 2, true);
+                out.resize(512, 0);
+                writeValue(out, 520, 4, true);
+                writeValue(out, static_cast<uint32_t>(scanline.size()), 4, true);
+                out.insert(out.end(), scanline.begin(), scanline.end());
+                return out;
+            }
+
+            const size_t rlaHeaderSize = 740;
+
+            std::vector<uint8_t> createRLAHeader(int w, int h, int colorChannels, int matteChannels, int bitDepth)
+            {
+                std::vector<uint8_t> out(rlaHeaderSize, 0);
+                for (const size_t pos : { 0, 8 })
+                {
+                    setValue(out, pos + 2, static_cast<uint16_t>(w - 1), 2);
+                    setValue(out, pos + 6, static_cast<uint16_t>(h - 1), 2);
+                }
+                setValue(out, 20, colorChannels, 2);
+                setValue(out, 22, matteChannels, 2);
+                setValue(out, 658, bitDepth, 2);
+                setValue(out, 662, bitDepth, 2);
+                return out;
+            }
+
+            std::vector<uint8_t> createRLA(const Image::Info& info)
+            {
+                const size_t channels = Image::getChannelCount(info.type);
+                const size_t bytes = Image::getByteCount(Image::getDataType(info.type));
+                const int colorChannels = channels >= 3 ? 3 : 1;
+                std::vector<uint8_t> out = createRLAHeader(
+                    info.size.w,
+                    info.size.h,
+                    colorChannels,
+                    static_cast<int>(channels) - colorChannels,
+                    static_cast<int>(bytes * 8));
+
+                // The scanline table is followed by the scanlines. Each
+                // channel is stored as a size and the RLE data, with the
+                // bytes of each value stored as separate planes starting with
+                // the most significant.
+                const size_t tablePos = out.size();
+                out.resize(out.size() + info.size.h * 4, 0);
+                for (size_t y = 0; y < info.size.h; ++y)
+                {
+                    setValue(out, tablePos + y * 4, static_cast<uint32_t>(out.size()), 4);
+                    for (size_t c = 0; c < channels; ++c)
+                    {
+                        std::vector<uint8_t> data;
+                        for (size_t b = 0; b < bytes; ++b)
+                        {
+                            std::vector<uint8_t> values;
+                            for (size_t x = 0; x < info.size.w; ++x)
+                            {
+                                values.push_back(static_cast<uint8_t>(getValue(x, y, c, bytes) >> ((bytes - 1 - b) * 8)));
+                            }
+                            writeRLARle(data, values);
+                        }
+                        writeValue(out, static_cast<uint32_t>(data.size()), 2, true);
+                        out.insert(out.end(), data.begin(), data.end());
+                    }
+                }
+                return out;
+            }
+
+            //! Create a single channel RLA image from the given channel data.
+            std::vector<uint8_t> createRLA(int w, const std::vector<uint8_t>& data)
+            {
+                std::vector<uint8_t> out = createRLAHeader(w, 1, 1, 0, 8);
+                writeValue(out, static_cast<uint32_t>(rlaHeaderSize + 4), 4, true);
+                writeValue(out, static_cast<uint32_t>(data.size()), 2, true);
+                out.insert(out.end(), data.begin(), data.end());
+                return out;
+            }
+
+            std::vector<uint8_t> createTargaHeader(const Image::Info& info, bool rle)
+            {
+                const size_t channels = Image::getChannelCount(info.type);
+                const bool color = channels >= 3;
+                std::vector<uint8_t> out;
+                writeValue(out, 0, 1, false);
+                writeValue(out, 0, 1, false);
+                writeValue(out, color ? (rle ? 10 : 2) : (rle ? 11 : 3), 1, false);
+                writeValue(out, 0, 2, false);
+                writeValue(out, 0, 2, false);
+                writeValue(out, 0, 1, false);
+                writeValue(out, 0, 2, false);
+                writeValue(out, 0, 2, false);
+                writeValue(out, info.size.w, 2, false);
+                writeValue(out, info.size.h, 2, false);
+                writeValue(out, static_cast<uint32_t>(channels * 8), 1, false);
+                writeValue(out, 2 == channels || 4 == channels ? 8 : 0, 1, false);
+                return out;
+            }
+
+            std::vector<uint8_t> createTarga(const Image::Info& info, bool rle)
+            {
+                // The color pixels are stored as BGR(A).
+                const size_t channels = Image::getChannelCount(info.type);
+                std::vector<uint8_t> out = createTargaHeader(info, rle);
+                for (size_t y = 0; y < info.size.h; ++y)
+                {
+                    std::vector<std::vector<uint8_t> > pixels;
+                    for (size_t x = 0; x < info.size.w; ++x)
+                    {
+                        std::vector<uint8_t> pixel;
+                        for (size_t c = 0; c < channels; ++c)
+                        {
+                            pixel.push_back(static_cast<uint8_t>(getValue(x, y, c, 1)));
+                        }
+                        if (channels >= 3)
+                        {
+                            std::swap(pixel[0], pixel[2]);
+                        }
+                        pixels.push_back(pixel);
+                    }
+                    if (rle)
+                    {
+                        writePacketRle(out, pixels);
+                    }
+                    else
+                    {
+                        for (const auto& i : pixels)
+                        {
+                            out.insert(out.end(), i.begin(), i.end());
+                        }
+                    }
+                }
+                return out;
+            }
+
+            //! Get an IFF test value. The values in the last tile are noisy
+            //! so that the tile is stored uncompressed.
+            uint8_t getIFFValue(size_t x, size_t y, size_t c)
+            {
+                return x >= 7 && y >= 2 ?
+                    static_cast<uint8_t>(x * 37 + y * 101 + c * 53) :
+                    static_cast<uint8_t>((x / 4) * 40 + y * 3 + c * 50);
+            }
+
+            void writeChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data)
+            {
+                writeString(out, type);
+                writeValue(out, static_cast<uint32_t>(data.size()), 4, true);
+                out.insert(out.end(), data.begin(), data.end());
+                while (out.size() % 4)
+                {
+                    out.push_back(0);
+                }
+            }
+
+            std::vector<uint8_t> createIFFHeader(const Image::Info& info, uint16_t tiles)
+            {
+                std::vector<uint8_t> out;
+                writeValue(out, info.size.w, 4, true);
+                writeValue(out, info.size.h, 4, true);
+                writeValue(out, 1, 2, true);
+                writeValue(out, 1, 2, true);
+                writeValue(out, Image::Type::RGBA_U8 == info.type ? 3 : 1, 4, true);
+                writeValue(out, 0, 2, true);
+                writeValue(out, tiles, 2, true);
+                writeValue(out, 1, 4, true);
+                return out;
+            }
+
+            std::vector<uint8_t> createIFF(
+                const Image::Info& info,
+                const std::vector<std::vector<uint8_t> >& tiles)
+            {
+                std::vector<uint8_t> tbmp;
+                writeString(tbmp, "TBMP");
+                for (const auto& i : tiles)
+                {
+                    writeChunk(tbmp, "RGBA", i);
+                }
+                std::vector<uint8_t> cimg;
+                writeString(cimg, "CIMG");
+                writeChunk(cimg, "TBHD", createIFFHeader(info, static_cast<uint16_t>(tiles.size())));
+                writeChunk(cimg, "FOR4", tbmp);
+                std::vector<uint8_t> out;
+                writeChunk(out, "FOR4", cimg);
+                return out;
+            }
+
+            //! Create an IFF tile. The channels are stored in reverse order,
+            //! compressed tiles store each channel as a separate plane.
+            std::vector<uint8_t> createIFFTile(
+                const Image::Info& info,
+                uint16_t xmin,
+                uint16_t ymin,
+                uint16_t xmax,
+                uint16_t ymax,
+                bool& compressed)
+            {
+                const size_t channels = Image::getChannelCount(info.type);
+                std::vector<uint8_t> out;
+                writeValue(out, xmin, 2, true);
+                writeValue(out, ymin, 2, true);
+                writeValue(out, xmax, 2, true);
+                writeValue(out, ymax, 2, true);
+                std::vector<uint8_t> rle;
+                std::vector<uint8_t> raw;
+                for (int c = static_cast<int>(channels) - 1; c >= 0; --c)
+                {
+                    std::vector<std::vector<uint8_t> > values;
+                    for (uint16_t y = ymin; y <= ymax; ++y)
+                    {
+                        for (uint16_t x = xmin; x <= xmax; ++x)
+                        {
+                            values.push_back(std::vector<uint8_t>(1, getIFFValue(x, y, c)));
+                        }
+                    }
+                    writePacketRle(rle, values);
+                }
+                for (uint16_t y = ymin; y <= ymax; ++y)
+                {
+                    for (uint16_t x = xmin; x <= xmax; ++x)
+                    {
+                        for (int c = static_cast<int>(channels) - 1; c >= 0; --c)
+                        {
+                            raw.push_back(getIFFValue(x, y, c));
+                        }
+                    }
+                }
+                compressed = rle.size() < raw.size();
+                const auto& data = compressed ? rle : raw;
+                out.insert(out.end(), data.begin(), data.end());
+                return out;
+            }
+
+        } // namespace
+
+        RLEReadTest::RLEReadTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest(
+                "djv::AVTest::RLEReadTest",
+                System::File::Path(tempPath, "RLEReadTest"),
+                context)
+        {}
+
+        void RLEReadTest::run()
+        {
+            _sgi();
+            _rla();
+            _targa();
+            _iff();
+        }
+
+        void RLEReadTest::_sgi()
+        {
+            for (const auto type : {
+                Image::Type::L_U8,
+                Image::Type::RGB_U8,
+                Image::Type::RGBA_U8,
+                Image::Type::L_U16,
+                Image::Type::RGBA_U16 })
+            {
+                for (const bool rle : { false, true })
+                {
+                    const Image::Info info(width, height, type);
+                    std::stringstream ss;
+                    ss << "SGI " << type << (rle ? " RLE" : " Raw") << ".sgi";
+                    const auto image = _read(ss.str(), createSGI(info, rle));
+                    _compare(image, info, getImageData(info, true));
+                    DJV_ASSERT(image->getLayout().mirror.y);
+                    DJV_ASSERT(Memory::Endian::MSB == image->getLayout().endian);
+                }
+            }
+
+            const Image::Info info(width, height, Image::Type::RGB_U8);
+            const auto rle = createSGI(info, true);
+            {
+                // Truncate the scanline data.
+                auto data = rle;
+                data.resize(data.size() - 3);
+                DJV_ASSERT(!_read("SGI Truncated.sgi", data));
+            }
+            {
+                // Truncate the scanline table.
+                auto data = rle;
+                data.resize(520);
+                DJV_ASSERT(!_read("SGI Truncated Table.sgi", data));
+            }
+            {
+                // Point a scanline past the end of the file.
+                auto data = rle;
+                setValue(data, 512, static_cast<uint32_t>(data.size()), 4);
+                DJV_ASSERT(!_read("SGI Offset.sgi", data));
+                setValue(data, 512, 0, 4);
+                DJV_ASSERT(!_read("SGI Offset Header.sgi", data));
+            }
+            {
+                // Truncate the uncompressed data.
+                auto data = createSGI(info, false);
+                data.resize(data.size() - 1);
+                DJV_ASSERT(!_read("SGI Truncated Raw.sgi", data));
+            }
+
+            // End the scanline before it is full.
+            DJV_ASSERT(!_read("SGI End.sgi", createSGI(4, { 2, 10, 0 })));
+
+            // A literal that runs past the end of the data.
+            DJV_ASSERT(!_read("SGI Literal.sgi", createSGI(4, { 0x84, 1, 2, 3 })));
+
+            {
+                // Packets that run past the end of the scanline are clipped.
+                const auto image = _read("SGI Clip.sgi", createSGI(4, { 0x7f, 0xab, 0 }));
+                _compare(image, Image::Info(4, 1, Image::Type::L_U8), { 0xab, 0xab, 0xab, 0xab });
+                const auto image2 = _read("SGI Clip Literal.sgi", createSGI(4, { 0x86, 1, 2, 3, 4, 5, 6, 0 }));
+                _compare(image2, Image::Info(4, 1, Image::Type::L_U8), { 1, 2, 3, 4 });
+            }
+        }
+
+        void RLEReadTest::_rla()
+        {
+            for (const auto type : {
+                Image::Type::L_U8,
+                Image::Type::RGB_U8,
+                Image::Type::RGBA_U8,
+                Image::Type::L_U16,
+                Image::Type::RGBA_U16 })
+            {
+                const Image::Info info(width, height, type);
+                std::stringstream ss;
+                ss << "RLA " << type << " RLE.rla";
+                const auto image = _read(ss.str(), createRLA(info));
+                _compare(image, info, getImageData(info));
+                DJV_ASSERT(image->getLayout().mirror.y);
+            }
+
+            const Image::Info info(width, height, Image::Type::RGB_U8);
+            const auto rla = createRLA(info);
+            {
+                // Truncate the scanline data.
+                auto data = rla;
+                data.resize(data.size() - 3);
+                DJV_ASSERT(!_read("RLA Truncated.rla", data));
+            }
+            {
+                // Truncate the scanline table.
+                auto data = rla;
+                data.resize(rlaHeaderSize + 2);
+                DJV_ASSERT(!_read("RLA Truncated Table.rla", data));
+            }
+            {
+                // Point a scanline past the end of the file.
+                auto data = rla;
+                setValue(data, rlaHeaderSize, static_cast<uint32_t>(data.size()), 4);
+                DJV_ASSERT(!_read("RLA Offset.rla", data));
+                setValue(data, rlaHeaderSize, 0xffffffff, 4);
+                DJV_ASSERT(!_read("RLA Offset Negative.rla", data));
+            }
+            {
+                // An invalid image size.
+                auto data = rla;
+                setValue(data, 10, 0xfffe, 2);
+                DJV_ASSERT(!_read("RLA Size.rla", data));
+            }
+
+            // A channel size that is larger than the data.
+            {
+                auto data = createRLA(4, { 3, 0xab });
+                setValue(data, rlaHeaderSize + 4, 100, 2);
+                DJV_ASSERT(!_read("RLA Channel Size.rla", data));
+            }
+
+            // A literal that runs past the end of the channel.
+            DJV_ASSERT(!_read("RLA Literal.rla", createRLA(4, { 0xfb, 1, 2 })));
+
+            // A channel that ends before the scanline is full.
+            DJV_ASSERT(!_read("RLA End.rla", createRLA(4, { 1, 0xab })));
+
+            {
+                // Packets that run past the end of the scanline are clipped.
+                const auto image = _read("RLA Clip.rla", createRLA(4, { 0x7f, 0xab }));
+                _compare(image, Image::Info(4, 1, Image::Type::L_U8), { 0xab, 0xab, 0xab, 0xab });
+                const auto image2 = _read("RLA Clip Literal.rla", createRLA(4, { 0xfa, 1, 2, 3, 4, 5, 6 }));
+                _compare(image2, Image::Info(4, 1, Image::Type::L_U8), { 1, 2, 3, 4 });
+            }
+        }
+
+        void RLEReadTest::_targa()
+        {
+            for (const auto type : {
+                Image::Type::L_U8,
+                Image::Type::LA_U8,
+                Image::Type::RGB_U8,
+                Image::Type::RGBA_U8 })
+            {
+                for (const bool rle : { false, true })
+                {
+                    const Image::Info info(width, height, type);
+                    std::stringstream ss;
+                    ss << "Targa " << type << (rle ? " RLE" : " Raw") << ".tga";
+                    const auto image = _read(ss.str(), createTarga(info, rle));
+                    _compare(image, info, getImageData(info));
+                    DJV_ASSERT(image->getLayout().mirror.y);
+                }
+            }
+
+            const Image::Info info(width, height, Image::Type::RGB_U8);
+            {
+                // Truncate the RLE data.
+                auto data = createTarga(info, true);
+                data.resize(data.size() - 1);
+                DJV_ASSERT(!_read("Targa Truncated.tga", data));
+            }
+            {
+                // Truncate the uncompressed data.
+                auto data = createTarga(info, false);
+                data.resize(data.size() - 1);
+                DJV_ASSERT(!_read("Targa Truncated Raw.tga", data));
+            }
+            {
+                // A literal that runs past the end of the data.
+                const Image::Info info2(4, 1, Image::Type::L_U8);
+                auto data = createTargaHeader(info2, true);
+                data.insert(data.end(), { 3, 1, 2 });
+                DJV_ASSERT(!_read("Targa Literal.tga", data));
+            }
+            {
+                // Packets that run past the end of the scanline are clipped
+                // to the scanline.
+                const Image::Info info2(4, 2, Image::Type::L_U8);
+                auto data = createTargaHeader(info2, true);
+                data.insert(data.end(), { 0x85, 0xab, 0x83, 0xcd });
+                const auto image = _read("Targa Clip.tga", data);
+                _compare(image, info2, { 0xab, 0xab, 0xab, 0xab, 0xcd, 0xcd, 0xcd, 0xcd });
+            }
+        }
+
+        void RLEReadTest::_iff()
+        {
+            for (const auto type : {
+                Image::Type::RGB_U8,
+                Image::Type::RGBA_U8 })
+            {
+                // Split the image into a 2x2 grid of tiles. The tile in the
+                // noisy corner is stored uncompressed.
+                const Image::Info info(width, height, type);
+                std::vector<std::vector<uint8_t> > tiles;
+                size_t compressedCount = 0;
+                for (const auto& i : { std::make_pair(0, 1), std::make_pair(2, 4) })
+                {
+                    for (const auto& j : { std::make_pair(0, 6), std::make_pair(7, 12) })
+                    {
+                        bool compressed = false;
+                        tiles.push_back(createIFFTile(info, j.first, i.first, j.second, i.second, compressed));
+                        if (compressed)
+                        {
+                            ++compressedCount;
+                        }
+                    }
+                }
+                DJV_ASSERT(3 == compressedCount);
+                std::vector<uint8_t> expected;
+                const size_t channels = Image::getChannelCount(type);
+                for (size_t y = 0; y < height; ++y)
+                {
+                    for (size_t x = 0; x < width; ++x)
+                    {
+                        for (size_t c = 0; c < channels; ++c)
+                        {
+                            expected.push_back(getIFFValue(x, y, c));
+                        }
+                    }
+                }
+                std::stringstream ss;
+                ss << "IFF " << type;
+                const auto image = _read(ss.str() + " Tiles.iff", createIFF(info, tiles));
+                _compare(image, info, expected);
+                DJV_ASSERT(image->getLayout().mirror.y);
+
+                // Truncate the tile data.
+                auto data = createIFF(info, tiles);
+                data.resize(data.size() - 8);
+                DJV_ASSERT(!_read(ss.str() + " Truncated.iff", data));
+            }
+
+            const Image::Info info(4, 1, Image::Type::RGB_U8);
+            std::vector<uint8_t> tile;
+            writeValue(tile, 0, 2, true);
+            writeValue(tile, 0, 2, true);
+            writeValue(tile, 3, 2, true);
+            writeValue(tile, 0, 2, true);
+            {
+                // A tile outside of the image.
+                auto data = tile;
+                setValue(data, 4, 4, 2);
+                data.insert(data.end(), { 0x83, 1, 0x83, 2, 0x83, 3 });
+                DJV_ASSERT(!_read("IFF Tile.iff", createIFF(info, { data })));
+            }
+            {
+                // A tile that is missing a channel.
+                auto data = tile;
+                data.insert(data.end(), { 0x83, 1, 0x83, 2 });
+                DJV_ASSERT(!_read("IFF Channel.iff", createIFF(info, { data })));
+            }
+            {
+                // A literal that runs past the end of the tile.
+                auto data = tile;
+                data.insert(data.end(), { 0x83, 1, 0x83, 2, 0x05, 3 });
+                DJV_ASSERT(!_read("IFF Literal.iff", createIFF(info, { data })));
+            }
+            {
+                // A tile with extra data.
+                auto data = tile;
+                data.insert(data.end(), { 0x83, 1, 0x83, 2, 0x83, 3, 0 });
+                DJV_ASSERT(!_read("IFF Extra.iff", createIFF(info, { data })));
+            }
+            {
+                // Packets that run past the end of the tile are clipped.
+                auto data = tile;
+                data.insert(data.end(), { 0xff, 1, 0xff, 2, 0xff, 3 });
+                const auto image = _read("IFF Clip.iff", createIFF(info, { data }));
+                _compare(image, info, { 3, 2, 1, 3, 2, 1, 3, 2, 1, 3, 2, 1 });
+            }
+        }
+
+        std::shared_ptr<Image::Data> RLEReadTest::_read(const std::string& fileName, const std::vector<uint8_t>& data)
+        {
+            std::shared_ptr<Image::Data> out;
+            if (auto context = getContext().lock())
+            {
+                _print(fileName);
+                const System::File::Path path(getTempPath(), fileName);
+                {
+                    auto io = System::File::IO::create();
+                    io->open(path.get(), System::File::Mode::Write);
+                    io->write(data.data(), data.size());
+                }
+                try
+                {
+                    auto read = context->getSystemT<IOSystem>()->read(System::File::Info(path));
+                    read->getInfo().get();
+                    bool running = true;
+                    while (running)
+                    {
+                        bool sleep = false;
+                        {
+                            std::unique_lock<std::mutex> lock(read->getMutex(), std::try_to_lock);
+                            if (lock.owns_lock())
+                            {
+                                auto& readQueue = read->getVideoQueue();
+                                if (!readQueue.isEmpty())
+                                {
+                                    out = readQueue.popFrame().data;
+                                    running = false;
+                                }
+                                else if (readQueue.isFinished())
+                                {
+                                    running = false;
+                                }
+                                else
+                                {
+                                    sleep = true;
+                                }
+                            }
+                            else
+                            {
+                                sleep = true;
+                            }
+                        }
+                        if (sleep)
+                        {
+                            std::this_thread::sleep_for(System::getTimerDuration(System::TimerValue::Fast));
+                        }
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    _print(Error::format(e));
+                }
+            }
+            return out;
+        }
+
+        void RLEReadTest::_compare(
+            const std::shared_ptr<Image::Data>& image,
+            const Image::Info& info,
+            const std::vector<uint8_t>& data)
+        {
+            DJV_ASSERT(image);
+            DJV_ASSERT(info.size == image->getSize());
+            DJV_ASSERT(info.type == image->getType());
+            DJV_ASSERT(data.size() == image->getDataByteCount());
+            DJV_ASSERT(0 == memcmp(data.data(), image->getData(), data.size()));
+        }
+
+    } // namespace AVTest
+} // namespace djv
@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/Test.h>
+
+#include <djvImage/Data.h>
+
+namespace djv
+{
+    namespace AVTest
+    {
+        //! This class tests the readers for the run-length encoded formats
+        //! (SGI, RLA, Targa, and IFF). DJV does not write these formats, so
+        //! the test files are encoded by the test.
+        class RLEReadTest : public Test::ITest
+        {
+        public:
+            RLEReadTest(
+                const System::File::Path& tempPath,
+                const std::shared_ptr<System::Context>&);
+
+            void run() override;
+
+        private:
+            void _sgi();
+            void _rla();
+            void _targa();
+            void _iff();
+
+            std::shared_ptr<Image::Data> _read(const std::string& fileName, const std::vector<uint8_t>&);
+            void _compare(const std::shared_ptr<Image::Data>&, const Image::Info&, const std::vector<uint8_t>&);
+        };
+
+    } // namespace AVTest
+} // namespace djv
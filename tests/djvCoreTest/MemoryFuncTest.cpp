@@ -7,6 +7,7 @@
 #include <djvCore/MemoryFunc.h>
 
 #include <iostream>
+#include <vector>
 
 using namespace djv::Core;
 
@@ -24,6 +25,7 @@ namespace djv
         {
             _label();
             _endian();
+            _simd();
             _hash();
         }
         
@@ -145,6 +147,54 @@ namespace djv
             }
         }
         
+        void MemoryFuncTest::_simd()
+        {
+            const Memory::SIMD simd = Memory::getSIMD();
+            {
+                std::stringstream ss;
+                ss << "Supported SIMD: " << static_cast<int>(Memory::getSupportedSIMD());
+                _print(ss.str());
+            }
+
+            // Compare the SIMD kernels against the scalar code, the sizes
+            // exercise the remainders that are handled by the scalar code.
+            for (size_t wordSize : { 2, 4, 8 })
+            {
+                for (size_t size : { 0, 1, 3, 7, 8, 9, 16, 17, 33, 1001 })
+                {
+                    std::vector<uint8_t> data(size * wordSize);
+                    for (size_t i = 0; i < data.size(); ++i)
+                    {
+                        data[i] = static_cast<uint8_t>(i * 7 + 3);
+                    }
+                    Memory::setSIMD(Memory::SIMD::None);
+                    std::vector<uint8_t> result(data.size());
+                    Memory::endian(data.data(), result.data(), size, wordSize);
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        for (size_t j = 0; j < wordSize; ++j)
+                        {
+                            DJV_ASSERT(result[i * wordSize + j] == data[i * wordSize + wordSize - 1 - j]);
+                        }
+                    }
+                    for (size_t i = static_cast<size_t>(Memory::SIMD::First); i < static_cast<size_t>(Memory::SIMD::Count); ++i)
+                    {
+                        Memory::setSIMD(static_cast<Memory::SIMD>(i));
+                        std::vector<uint8_t> out(data.size());
+                        Memory::endian(data.data(), out.data(), size, wordSize);
+                        DJV_ASSERT(result == out);
+                        std::vector<uint8_t> inPlace = data;
+                        Memory::endian(inPlace.data(), size, wordSize);
+                        DJV_ASSERT(result == inPlace);
+                    }
+                }
+            }
+
+            Memory::setSIMD(Memory::SIMD::Count);
+            DJV_ASSERT(Memory::getSupportedSIMD() == Memory::getSIMD());
+            Memory::setSIMD(simd);
+        }
+
         void MemoryFuncTest::_hash()
         {
             size_t hash = 0;
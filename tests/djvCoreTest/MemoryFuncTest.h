@@ -22,6 +22,7 @@ namespace djv
         private:
             void _label();
             void _endian();
+            void _simd();
             void _hash();
         };
         
@@ -6,6 +6,8 @@
 
 #include <djvCore/ValueObserver.h>
 
+#include <vector>
+
 using namespace djv::Core;
 using namespace djv::Core::Observer;
 
@@ -60,6 +62,57 @@ namespace djv
                 DJV_ASSERT(1 == subject->getObserversCount());
             }
             DJV_ASSERT(0 == subject->getObserversCount());
+
+            {
+                size_t callbacks = 0;
+                auto observer = Observer::Value<int>::create(
+                    subject,
+                    [&callbacks](int)
+                    {
+                        ++callbacks;
+                    },
+                    Observer::CallbackAction::Suppress);
+                DJV_ASSERT(subject->setDeferred(3));
+                DJV_ASSERT(subject->setDeferred(4));
+                DJV_ASSERT(!subject->setDeferred(4));
+                DJV_ASSERT(4 == subject->get());
+                DJV_ASSERT(0 == callbacks);
+                DJV_ASSERT(1 == Observer::getDeferredCount());
+                Observer::dispatchDeferred();
+                DJV_ASSERT(1 == callbacks);
+                DJV_ASSERT(0 == Observer::getDeferredCount());
+                Observer::dispatchDeferred();
+                DJV_ASSERT(1 == callbacks);
+
+                DJV_ASSERT(subject->setDeferred(5));
+                DJV_ASSERT(subject->setIfChanged(6));
+                DJV_ASSERT(2 == callbacks);
+                Observer::dispatchDeferred();
+                DJV_ASSERT(2 == callbacks);
+            }
+
+            {
+                std::vector<std::shared_ptr<Observer::Value<int> > > observers;
+                for (size_t i = 0; i < 100; ++i)
+                {
+                    observers.push_back(Observer::Value<int>::create(
+                        subject,
+                        [&observers](int)
+                        {
+                            // Destroy observers while the subject is notifying.
+                            if (observers.size())
+                            {
+                                observers.pop_back();
+                            }
+                        },
+                        Observer::CallbackAction::Suppress));
+                }
+                DJV_ASSERT(100 == subject->getObserversCount());
+                subject->setAlways(7);
+                DJV_ASSERT(subject->getObserversCount() == observers.size());
+                observers.clear();
+                DJV_ASSERT(0 == subject->getObserversCount());
+            }
         }
         
     } // namespace CoreTest
@@ -5,9 +5,14 @@
 #include <djvGLTest/TextureAtlasTest.h>
 
 #include <djvGL/TextureAtlas.h>
+#include <djvGL/TextureAtlasPrivate.h>
 
 #include <djvImage/Data.h>
 
+#include <chrono>
+#include <deque>
+#include <random>
+
 using namespace djv::Core;
 using namespace djv::GL;
 
@@ -22,6 +27,26 @@ namespace djv
         {}
         
         void TextureAtlasTest::run()
+        {
+            _items();
+            _eviction();
+            _compact();
+            _compactIncremental();
+            _packerChurn();
+        }
+
+        namespace
+        {
+            bool overlaps(const TextureAtlasItem& a, const TextureAtlasItem& b)
+            {
+                return a.textureIndex == b.textureIndex &&
+                    a.textureU.getMin() < b.textureU.getMax() && b.textureU.getMin() < a.textureU.getMax() &&
+                    a.textureV.getMin() < b.textureV.getMax() && b.textureV.getMin() < a.textureV.getMax();
+            }
+
+        } // namespace
+
+        void TextureAtlasTest::_items()
         {
             for (const auto count : { 1, 2, 0 })
             {
@@ -63,6 +88,228 @@ namespace djv
             }
         }
 
+        void TextureAtlasTest::_eviction()
+        {
+            TextureAtlas atlas(2, 64, Image::Type::RGBA_U8, GL_NEAREST, 0);
+            auto data = Image::Data::create(Image::Info(16, 16, Image::Type::RGBA_U8));
+            TextureAtlasItem item;
+            const UID hot = atlas.addItem(data, item);
+            DJV_ASSERT(hot != 0);
+            std::vector<UID> uids;
+            for (size_t i = 0; i < 100; ++i)
+            {
+                uids.push_back(atlas.addItem(data, item));
+                DJV_ASSERT(uids.back() != 0);
+                DJV_ASSERT(atlas.getItem(hot, item));
+            }
+            DJV_ASSERT(100.F == atlas.getPercentageUsed());
+            DJV_ASSERT(100.F == atlas.getPercentageUsed(0));
+            const auto stats = atlas.getStats();
+            DJV_ASSERT(32 == stats.itemCount);
+            DJV_ASSERT(101 == stats.addCount);
+            DJV_ASSERT(69 == stats.evictCount);
+            DJV_ASSERT(101 * data->getDataByteCount() == stats.uploadByteCount);
+
+            std::vector<TextureAtlasItem> items;
+            for (const auto uid : uids)
+            {
+                if (atlas.getItem(uid, item))
+                {
+                    items.push_back(item);
+                }
+            }
+            DJV_ASSERT(atlas.getItem(hot, item));
+            items.push_back(item);
+            DJV_ASSERT(32 == items.size());
+            for (size_t i = 0; i < items.size(); ++i)
+            {
+                for (size_t j = i + 1; j < items.size(); ++j)
+                {
+                    DJV_ASSERT(!overlaps(items[i], items[j]));
+                }
+            }
+
+            auto large = Image::Data::create(Image::Info(65, 1, Image::Type::RGBA_U8));
+            DJV_ASSERT(0 == atlas.addItem(large, item));
+        }
+
+        void TextureAtlasTest::_compact()
+        {
+            TextureAtlas atlas(1, 64, Image::Type::RGBA_U8, GL_NEAREST, 0);
+            DJV_ASSERT(!atlas.compact());
+            auto data = Image::Data::create(Image::Info(16, 16, Image::Type::RGBA_U8));
+            std::vector<UID> uids;
+            TextureAtlasItem item;
+            for (size_t i = 0; i < 16; ++i)
+            {
+                uids.push_back(atlas.addItem(data, item));
+            }
+
+            // Use the items so the least recently used ones are scattered
+            // across the texture.
+            for (const size_t i : { 5, 10, 15, 7, 0, 1, 2, 3, 4, 6, 8, 9, 11, 12, 13, 14 })
+            {
+                atlas.getItem(uids[i], item);
+            }
+            auto wide = Image::Data::create(Image::Info(64, 16, Image::Type::RGBA_U8));
+            DJV_ASSERT(atlas.addItem(wide, item) != 0);
+            auto stats = atlas.getStats();
+            DJV_ASSERT(8 == stats.evictCount);
+            DJV_ASSERT(9 == stats.itemCount);
+
+            DJV_ASSERT(atlas.compact());
+            stats = atlas.getStats();
+            DJV_ASSERT(1 == stats.compactCount);
+            DJV_ASSERT(9 == stats.itemCount);
+            DJV_ASSERT(!atlas.compact());
+            std::vector<TextureAtlasItem> items;
+            for (const auto uid : uids)
+            {
+                if (atlas.getItem(uid, item))
+                {
+                    items.push_back(item);
+                }
+            }
+            DJV_ASSERT(8 == items.size());
+            for (size_t i = 0; i < items.size(); ++i)
+            {
+                for (size_t j = i + 1; j < items.size(); ++j)
+                {
+                    DJV_ASSERT(!overlaps(items[i], items[j]));
+                }
+            }
+
+            // The space from compacting is available for new items.
+            DJV_ASSERT(atlas.addItem(wide, item) != 0);
+            DJV_ASSERT(8 == atlas.getStats().evictCount);
+        }
+
+        void TextureAtlasTest::_compactIncremental()
+        {
+            TextureAtlas atlas(1, 64, Image::Type::RGBA_U8, GL_NEAREST, 0);
+            auto data = Image::Data::create(Image::Info(16, 16, Image::Type::RGBA_U8));
+            std::vector<UID> uids;
+            TextureAtlasItem item;
+            for (size_t i = 0; i < 16; ++i)
+            {
+                uids.push_back(atlas.addItem(data, item));
+            }
+            for (const size_t i : { 5, 10, 15, 7, 0, 1, 2, 3, 4, 6, 8, 9, 11, 12, 13, 14 })
+            {
+                atlas.getItem(uids[i], item);
+            }
+            auto wide = Image::Data::create(Image::Info(64, 16, Image::Type::RGBA_U8));
+            uids.push_back(atlas.addItem(wide, item));
+            DJV_ASSERT(uids.back() != 0);
+
+            // The items keep their locations until the compaction is finished.
+            TextureAtlasItem before;
+            DJV_ASSERT(atlas.getItem(uids.back(), before));
+            DJV_ASSERT(!atlas.compact(1));
+            TextureAtlasItem during;
+            DJV_ASSERT(atlas.getItem(uids.back(), during));
+            DJV_ASSERT(before.textureU == during.textureU);
+            DJV_ASSERT(before.textureV == during.textureV);
+
+            // Items added while the compaction is in progress are also moved.
+            auto small = Image::Data::create(Image::Info(8, 8, Image::Type::RGBA_U8));
+            uids.push_back(atlas.addItem(small, item));
+            DJV_ASSERT(uids.back() != 0);
+            size_t calls = 1;
+            while (!atlas.compact(1))
+            {
+                ++calls;
+                DJV_ASSERT(calls < 100);
+            }
+            ++calls;
+            {
+                std::stringstream ss;
+                ss << calls;
+                _print("Compaction calls: " + ss.str());
+            }
+            DJV_ASSERT(calls > 2);
+            DJV_ASSERT(1 == atlas.getStats().compactCount);
+
+            std::vector<TextureAtlasItem> items;
+            for (const auto uid : uids)
+            {
+                if (atlas.getItem(uid, item))
+                {
+                    items.push_back(item);
+                }
+            }
+            DJV_ASSERT(10 == items.size());
+            for (size_t i = 0; i < items.size(); ++i)
+            {
+                for (size_t j = i + 1; j < items.size(); ++j)
+                {
+                    DJV_ASSERT(!overlaps(items[i], items[j]));
+                }
+            }
+        }
+
+        void TextureAtlasTest::_packerChurn()
+        {
+            // Fill a texture with glyph sized items and then replace the least
+            // recently used items with new ones.
+            for (const int size : { 1024, 2048 })
+            {
+                std::mt19937 rng(1);
+                std::uniform_int_distribution<int> randomW(4, 26);
+                std::uniform_int_distribution<int> randomH(10, 30);
+                TextureAtlasPacker packer(size);
+                std::deque<TextureAtlasRect> items;
+                TextureAtlasRect rect;
+                while (packer.insert(randomW(rng), randomH(rng), rect))
+                {
+                    items.push_back(rect);
+                }
+                const size_t count = 10000;
+                auto worst = std::chrono::microseconds(0);
+                const auto start = std::chrono::steady_clock::now();
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const auto t = std::chrono::steady_clock::now();
+                    const int w = randomW(rng);
+                    const int h = randomH(rng);
+                    while (!packer.insert(w, h, rect))
+                    {
+                        if (items.empty())
+                        {
+                            packer.clear();
+                        }
+                        else
+                        {
+                            packer.remove(items.front());
+                            items.pop_front();
+                        }
+                    }
+                    items.push_back(rect);
+                    DJV_ASSERT(packer.getFreeCount() <= textureAtlasFreeMax);
+                    worst = std::max(worst, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t));
+                }
+                const auto total = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+                {
+                    std::stringstream ss;
+                    ss << size << ": " << items.size() << " items, " <<
+                        total.count() / static_cast<float>(count) << "us per insert, " <<
+                        worst.count() << "us worst";
+                    _print("Churn " + ss.str());
+                }
+
+                for (size_t i = 0; i < items.size(); ++i)
+                {
+                    const auto& a = items[i];
+                    DJV_ASSERT(a.x >= 0 && a.y >= 0 && a.x + a.w <= size && a.y + a.h <= size);
+                    for (size_t j = i + 1; j < items.size(); ++j)
+                    {
+                        const auto& b = items[j];
+                        DJV_ASSERT(!(a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h));
+                    }
+                }
+            }
+        }
+
     } // namespace GLTest
 } // namespace djv
 
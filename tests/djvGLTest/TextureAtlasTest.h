@@ -16,6 +16,13 @@ namespace djv
                 const std::shared_ptr<System::Context>&);
             
             void run() override;
+
+        private:
+            void _items();
+            void _eviction();
+            void _compact();
+            void _compactIncremental();
+            void _packerChurn();
         };
         
     } // namespace GLTest
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvGeomTest/BVHTest.h>
+
+#include <djvGeom/BVH.h>
+#include <djvGeom/TriangleMesh.h>
+#include <djvGeom/TriangleMeshFunc.h>
+
+#include <djvMath/VectorFunc.h>
+
+#include <limits>
+
+using namespace djv::Core;
+using namespace djv::Geom;
+
+namespace djv
+{
+    namespace GeomTest
+    {
+        BVHTest::BVHTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::GeomTest::BVHTest", tempPath, context)
+        {}
+        
+        void BVHTest::run()
+        {
+            {
+                auto bvh = BVH::create(std::vector<Math::BBox3f>());
+                DJV_ASSERT(bvh->getNodes().empty());
+                float t = std::numeric_limits<float>::max();
+                DJV_ASSERT(!bvh->intersect(
+                    glm::vec3(0.F, 0.F, 0.F),
+                    glm::vec3(0.F, 0.F, 1.F),
+                    t,
+                    [](uint32_t, float&) { return true; }));
+            }
+
+            {
+                // Cast axis-aligned rays that start on the bounding-box
+                // planes.
+                std::vector<Math::BBox3f> bboxes;
+                bboxes.push_back(Math::BBox3f(0.F, 0.F, 0.F, 1.F, 1.F, 1.F));
+                bboxes.push_back(Math::BBox3f(2.F, 0.F, 0.F, 1.F, 1.F, 1.F));
+                auto bvh = BVH::create(bboxes);
+                for (const auto& pos : {
+                    glm::vec3(.5F, 0.F, -5.F),
+                    glm::vec3(.5F, 1.F, -5.F),
+                    glm::vec3(0.F, .5F, -5.F),
+                    glm::vec3(3.F, 1.F, -5.F) })
+                {
+                    float t = std::numeric_limits<float>::max();
+                    DJV_ASSERT(bvh->intersect(
+                        pos,
+                        glm::vec3(0.F, 0.F, 1.F),
+                        t,
+                        [](uint32_t, float&) { return true; }));
+                }
+                float t = std::numeric_limits<float>::max();
+                DJV_ASSERT(!bvh->intersect(
+                    glm::vec3(3.5F, 0.F, -5.F),
+                    glm::vec3(0.F, 0.F, 1.F),
+                    t,
+                    [](uint32_t, float&) { return true; }));
+            }
+
+            {
+                // Create a grid of quads stacked along the Z axis.
+                TriangleMesh mesh;
+                const size_t size = 64;
+                for (size_t z = 0; z < 4; ++z)
+                {
+                    for (size_t y = 0; y < size; ++y)
+                    {
+                        for (size_t x = 0; x < size; ++x)
+                        {
+                            const size_t i = mesh.v.size();
+                            mesh.v.push_back(glm::vec3(x,       y,       z));
+                            mesh.v.push_back(glm::vec3(x + 1.F, y,       z));
+                            mesh.v.push_back(glm::vec3(x + 1.F, y + 1.F, z));
+                            mesh.v.push_back(glm::vec3(x,       y + 1.F, z));
+                            TriangleMesh::Triangle a;
+                            a.v0.v = i + 1;
+                            a.v1.v = i + 2;
+                            a.v2.v = i + 3;
+                            mesh.triangles.push_back(a);
+                            TriangleMesh::Triangle b;
+                            b.v0.v = i + 1;
+                            b.v1.v = i + 3;
+                            b.v2.v = i + 4;
+                            mesh.triangles.push_back(b);
+                        }
+                    }
+                }
+                mesh.bboxUpdate();
+
+                const auto bvh = mesh.getBVH();
+                DJV_ASSERT(bvh == mesh.getBVH());
+                DJV_ASSERT(bvh->getIndices().size() == mesh.triangles.size());
+                DJV_ASSERT(bvh->getBBox() == mesh.bbox);
+                {
+                    std::stringstream ss;
+                    ss << "Nodes: " << bvh->getNodes().size();
+                    _print(ss.str());
+                }
+
+                for (size_t i = 0; i < 100; ++i)
+                {
+                    const glm::vec3 pos(
+                        (i % 10) * 6.3F + .1F,
+                        (i / 10) * 6.3F + .2F,
+                        10.F);
+                    glm::vec3 hit(0.F, 0.F, 0.F);
+                    DJV_ASSERT(intersect(pos, glm::vec3(0.F, 0.F, -1.F), mesh, hit));
+                    DJV_ASSERT(fuzzyCompare(hit, glm::vec3(pos.x, pos.y, 3.F)));
+                    DJV_ASSERT(intersect(glm::vec3(pos.x, pos.y, -10.F), glm::vec3(0.F, 0.F, 1.F), mesh, hit));
+                    DJV_ASSERT(fuzzyCompare(hit, glm::vec3(pos.x, pos.y, 0.F)));
+                }
+                glm::vec3 hit(0.F, 0.F, 0.F);
+                DJV_ASSERT(!intersect(glm::vec3(-1.F, -1.F, 10.F), glm::vec3(0.F, 0.F, -1.F), mesh, hit));
+
+                // Copies build their own hierarchy.
+                TriangleMesh copy(mesh);
+                DJV_ASSERT(copy.getBVH() != bvh);
+                TriangleMesh copy2;
+                copy2 = mesh;
+                DJV_ASSERT(copy2.getBVH() != bvh);
+                DJV_ASSERT(mesh.getBVH() == bvh);
+
+                // Move the vertices in place.
+                for (auto& i : copy.v)
+                {
+                    i.z += 10.F;
+                }
+                copy.bboxUpdate();
+                DJV_ASSERT(intersect(glm::vec3(.1F, .2F, 20.F), glm::vec3(0.F, 0.F, -1.F), copy, hit));
+                DJV_ASSERT(fuzzyCompare(hit, glm::vec3(.1F, .2F, 13.F)));
+                DJV_ASSERT(intersect(glm::vec3(.1F, .2F, 20.F), glm::vec3(0.F, 0.F, -1.F), mesh, hit));
+                DJV_ASSERT(fuzzyCompare(hit, glm::vec3(.1F, .2F, 3.F)));
+
+                mesh.v.push_back(glm::vec3(0.F, 0.F, 0.F));
+                DJV_ASSERT(bvh != mesh.getBVH());
+                mesh.clear();
+                DJV_ASSERT(mesh.getBVH()->getNodes().empty());
+            }
+        }
+
+    } // namespace GeomTest
+} // namespace djv
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace GeomTest
+    {
+        class BVHTest : public Test::ITest
+        {
+        public:
+            BVHTest(
+                const System::File::Path& tempPath,
+                const std::shared_ptr<System::Context>&);
+            
+            void run() override;
+        };
+        
+    } // namespace GeomTest
+} // namespace djv
+
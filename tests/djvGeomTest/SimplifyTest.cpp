@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvGeomTest/SimplifyTest.h>
+
+#include <djvGeom/Shape.h>
+#include <djvGeom/Simplify.h>
+#include <djvGeom/TriangleMesh.h>
+
+#include <djvMath/MathFunc.h>
+#include <djvMath/VectorFunc.h>
+
+using namespace djv::Core;
+using namespace djv::Geom;
+
+namespace djv
+{
+    namespace GeomTest
+    {
+        SimplifyTest::SimplifyTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::GeomTest::SimplifyTest", tempPath, context)
+        {}
+        
+        void SimplifyTest::run()
+        {
+            {
+                TriangleMesh mesh;
+                TriangleMesh out;
+                simplify(mesh, 0, out);
+                DJV_ASSERT(out.triangles.empty());
+            }
+
+            {
+                // Create a flat grid with shared vertices.
+                TriangleMesh mesh;
+                const size_t size = 32;
+                for (size_t y = 0; y <= size; ++y)
+                {
+                    for (size_t x = 0; x <= size; ++x)
+                    {
+                        mesh.v.push_back(glm::vec3(x, y, 0.F));
+                    }
+                }
+                for (size_t y = 0; y < size; ++y)
+                {
+                    for (size_t x = 0; x < size; ++x)
+                    {
+                        const size_t i = x + y * (size + 1) + 1;
+                        const size_t j = i + size + 1;
+                        TriangleMesh::Triangle a;
+                        a.v0.v = i;
+                        a.v1.v = i + 1;
+                        a.v2.v = j + 1;
+                        mesh.triangles.push_back(a);
+                        TriangleMesh::Triangle b;
+                        b.v0.v = i;
+                        b.v1.v = j + 1;
+                        b.v2.v = j;
+                        mesh.triangles.push_back(b);
+                    }
+                }
+                mesh.bboxUpdate();
+
+                TriangleMesh out;
+                const size_t triangleCount = mesh.triangles.size() / 4;
+                simplify(mesh, triangleCount, out);
+                {
+                    std::stringstream ss;
+                    ss << "Triangles: " << mesh.triangles.size() << " -> " << out.triangles.size();
+                    _print(ss.str());
+                    ss.str(std::string());
+                    ss << "Vertices: " << mesh.v.size() << " -> " << out.v.size();
+                    _print(ss.str());
+                }
+                DJV_ASSERT(out.triangles.size() > 0);
+                DJV_ASSERT(out.triangles.size() <= triangleCount);
+                DJV_ASSERT(out.v.size() < mesh.v.size());
+
+                // The grid is flat and the boundary is preserved.
+                for (const auto& i : out.v)
+                {
+                    DJV_ASSERT(fuzzyCompare(i.z, 0.F));
+                }
+                DJV_ASSERT(fuzzyCompare(out.bbox.min, mesh.bbox.min));
+                DJV_ASSERT(fuzzyCompare(out.bbox.max, mesh.bbox.max));
+                for (const auto& i : out.triangles)
+                {
+                    DJV_ASSERT(i.v0.v > 0 && i.v0.v <= out.v.size());
+                    DJV_ASSERT(i.v1.v > 0 && i.v1.v <= out.v.size());
+                    DJV_ASSERT(i.v2.v > 0 && i.v2.v <= out.v.size());
+                }
+            }
+
+            {
+                auto mesh = std::shared_ptr<TriangleMesh>(new TriangleMesh);
+                Sphere(1.F, Sphere::Resolution(64, 64)).triangulate(*mesh);
+                mesh->bboxUpdate();
+                const auto lods = createLODs(mesh, 4, 256);
+                DJV_ASSERT(lods.size() > 1 && lods.size() <= 4);
+                DJV_ASSERT(lods[0] == mesh);
+                for (size_t i = 1; i < lods.size(); ++i)
+                {
+                    std::stringstream ss;
+                    ss << "LOD " << i << ": " << lods[i]->triangles.size();
+                    _print(ss.str());
+                    DJV_ASSERT(lods[i]->triangles.size() < lods[i - 1]->triangles.size());
+                    DJV_ASSERT(lods[i]->t.size() > 0);
+                }
+            }
+        }
+        
+    } // namespace GeomTest
+} // namespace djv
@@ -8,6 +8,8 @@
 #include <djvImage/Data.h>
 #include <djvImage/DataFunc.h>
 
+#include <cstdlib>
+
 using namespace djv::Core;
 using namespace djv::Image;
 
@@ -121,6 +123,26 @@ namespace djv
                     _print("Average: " + ss.str());
                 }
             }
+
+            {
+                DJV_ASSERT(!Image::createMipmap(nullptr));
+                auto data = Image::Data::create(Image::Info(3, 2, Image::Type::L_U8));
+                Image::U8_T* p = reinterpret_cast<Image::U8_T*>(data->getData(0));
+                p[0] = 0;
+                p[1] = 100;
+                p[2] = 200;
+                p = reinterpret_cast<Image::U8_T*>(data->getData(1));
+                p[0] = 100;
+                p[1] = 200;
+                p[2] = 50;
+                const auto mipmap = Image::createMipmap(data);
+                DJV_ASSERT(2 == mipmap->getWidth());
+                DJV_ASSERT(1 == mipmap->getHeight());
+                DJV_ASSERT(Image::Type::L_U8 == mipmap->getType());
+                p = reinterpret_cast<Image::U8_T*>(mipmap->getData());
+                DJV_ASSERT(abs(static_cast<int>(p[0]) - 100) <= 1);
+                DJV_ASSERT(abs(static_cast<int>(p[1]) - 125) <= 1);
+            }
         }
         
     } // namespace ImageTest
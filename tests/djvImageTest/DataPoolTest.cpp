@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvImageTest/DataPoolTest.h>
+
+#include <djvImage/Data.h>
+#include <djvImage/DataPool.h>
+
+#include <djvCore/Memory.h>
+
+#include <sstream>
+
+using namespace djv::Core;
+using namespace djv::Image;
+
+namespace djv
+{
+    namespace ImageTest
+    {
+        DataPoolTest::DataPoolTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::ImageTest::DataPoolTest", tempPath, context)
+        {}
+        
+        void DataPoolTest::run()
+        {
+            _sizeClass();
+            _pool();
+            _maxFreeByteCount();
+            _data();
+        }
+
+        void DataPoolTest::_sizeClass()
+        {
+            DJV_ASSERT(0 == DataPool::getSizeClass(0));
+            DJV_ASSERT(0 == DataPool::getSizeClass(1024));
+            DJV_ASSERT(Memory::megabyte == DataPool::getSizeClass(Memory::megabyte));
+            DJV_ASSERT(Memory::megabyte * 5 / 4 == DataPool::getSizeClass(Memory::megabyte + 1));
+            DJV_ASSERT(Memory::megabyte * 2 == DataPool::getSizeClass(Memory::megabyte * 7 / 4 + 1));
+            for (size_t i = Memory::megabyte; i < Memory::gigabyte; i = i * 3 / 2 + 1)
+            {
+                const size_t sizeClass = DataPool::getSizeClass(i);
+                DJV_ASSERT(sizeClass >= i);
+                DJV_ASSERT(sizeClass <= i * 5 / 4 + 1);
+                DJV_ASSERT(DataPool::getSizeClass(sizeClass) == sizeClass);
+            }
+        }
+
+        void DataPoolTest::_pool()
+        {
+            auto pool = DataPool::create();
+            DJV_ASSERT(!pool->hasHugePages());
+            pool->setHugePages(true);
+            DJV_ASSERT(pool->hasHugePages());
+            pool->setHugePages(false);
+
+            {
+                uint8_t* p = pool->allocate(100);
+                DJV_ASSERT(p);
+                p[99] = 1;
+                pool->release(p, 100);
+                const auto stats = pool->getStats();
+                DJV_ASSERT(0 == stats.allocCount);
+                DJV_ASSERT(0 == stats.usedCount);
+            }
+
+            const size_t byteCount = 3 * Memory::megabyte;
+            const size_t sizeClass = DataPool::getSizeClass(byteCount);
+            uint8_t* a = pool->allocate(byteCount);
+            uint8_t* b = pool->allocate(byteCount);
+            a[byteCount - 1] = 1;
+            b[byteCount - 1] = 1;
+            auto stats = pool->getStats();
+            DJV_ASSERT(2 == stats.allocCount);
+            DJV_ASSERT(2 == stats.usedCount);
+            DJV_ASSERT(2 * sizeClass == stats.usedByteCount);
+            DJV_ASSERT(0 == stats.freeCount);
+
+            pool->release(a, byteCount);
+            stats = pool->getStats();
+            DJV_ASSERT(1 == stats.usedCount);
+            DJV_ASSERT(1 == stats.freeCount);
+            DJV_ASSERT(sizeClass == stats.freeByteCount);
+
+            uint8_t* c = pool->allocate(byteCount - 1);
+            DJV_ASSERT(a == c);
+            stats = pool->getStats();
+            DJV_ASSERT(2 == stats.allocCount);
+            DJV_ASSERT(1 == stats.reuseCount);
+            DJV_ASSERT(0 == stats.freeCount);
+
+            pool->release(b, byteCount);
+            pool->release(c, byteCount - 1);
+            stats = pool->getStats();
+            DJV_ASSERT(0 == stats.usedCount);
+            DJV_ASSERT(2 == stats.freeCount);
+
+            pool->trim();
+            stats = pool->getStats();
+            DJV_ASSERT(0 == stats.freeCount);
+            DJV_ASSERT(0 == stats.freeByteCount);
+            DJV_ASSERT(2 == stats.releaseCount);
+
+            std::stringstream ss;
+            ss << "huge pages: " << stats.hugePageCount;
+            _print(ss.str());
+        }
+
+        void DataPoolTest::_maxFreeByteCount()
+        {
+            auto pool = DataPool::create();
+            const size_t byteCount = 4 * Memory::megabyte;
+            pool->setMaxFreeByteCount(byteCount);
+            DJV_ASSERT(byteCount == pool->getMaxFreeByteCount());
+
+            uint8_t* a = pool->allocate(byteCount);
+            uint8_t* b = pool->allocate(byteCount);
+            pool->release(a, byteCount);
+            pool->release(b, byteCount);
+            auto stats = pool->getStats();
+            DJV_ASSERT(1 == stats.freeCount);
+            DJV_ASSERT(1 == stats.releaseCount);
+
+            pool->setMaxFreeByteCount(0);
+            stats = pool->getStats();
+            DJV_ASSERT(0 == stats.freeCount);
+            DJV_ASSERT(2 == stats.releaseCount);
+        }
+
+        void DataPoolTest::_data()
+        {
+            auto pool = DataPool::getGlobal();
+            const auto stats = pool->getStats();
+            const Info info(1024, 1024, Type::RGBA_U8);
+            {
+                auto data = Data::create(info);
+                data->zero();
+                DJV_ASSERT(pool->getStats().usedCount == stats.usedCount + 1);
+            }
+            {
+                auto data = Data::create(info);
+                DJV_ASSERT(pool->getStats().reuseCount > stats.reuseCount);
+            }
+            DJV_ASSERT(pool->getStats().usedCount == stats.usedCount);
+        }
+        
+    } // namespace ImageTest
+} // namespace djv
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvImageTest/ParallelTest.h>
+
+#include <djvImage/Parallel.h>
+
+#include <atomic>
+#include <vector>
+
+using namespace djv::Core;
+using namespace djv::Image;
+
+namespace djv
+{
+    namespace ImageTest
+    {
+        ParallelTest::ParallelTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::ImageTest::ParallelTest", tempPath, context)
+        {}
+        
+        void ParallelTest::run()
+        {
+            for (const size_t count : { 0, 1, 7, 1000 })
+            {
+                for (const size_t cost : { 1, 1000000 })
+                {
+                    // Check that each item is visited exactly once.
+                    std::vector<std::atomic<int> > visits(count);
+                    for (auto& i : visits)
+                    {
+                        i = 0;
+                    }
+                    parallelRange(
+                        count,
+                        cost,
+                        [&visits](size_t begin, size_t end)
+                        {
+                            DJV_ASSERT(begin <= end);
+                            for (size_t i = begin; i < end; ++i)
+                            {
+                                ++visits[i];
+                            }
+                        });
+                    for (const auto& i : visits)
+                    {
+                        DJV_ASSERT(1 == i);
+                    }
+                }
+            }
+
+            {
+                const uint16_t height = 1080;
+                std::vector<std::atomic<int> > visits(height);
+                for (auto& i : visits)
+                {
+                    i = 0;
+                }
+                parallelScanlines(
+                    height,
+                    1920 * height,
+                    [&visits](uint16_t begin, uint16_t end)
+                    {
+                        for (uint16_t y = begin; y < end; ++y)
+                        {
+                            ++visits[y];
+                        }
+                    });
+                for (const auto& i : visits)
+                {
+                    DJV_ASSERT(1 == i);
+                }
+            }
+        }
+        
+    } // namespace ImageTest
+} // namespace djv
@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvImageTest/StatisticsTest.h>
+
+#include <djvImage/Data.h>
+#include <djvImage/Statistics.h>
+#include <djvImage/TypeFunc.h>
+
+#include <djvMath/MathFunc.h>
+
+#include <sstream>
+
+using namespace djv::Core;
+using namespace djv::Image;
+
+namespace djv
+{
+    namespace ImageTest
+    {
+        StatisticsTest::StatisticsTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::ImageTest::StatisticsTest", tempPath, context)
+        {}
+        
+        void StatisticsTest::run()
+        {
+            _histogram();
+            _types();
+            _scopes();
+            _step();
+        }
+        
+        void StatisticsTest::_histogram()
+        {
+            {
+                const auto statistics = Image::getStatistics(*Image::Data::create(Image::Info()));
+                DJV_ASSERT(0 == statistics.sampleCount);
+                DJV_ASSERT(statistics.histogram.empty());
+            }
+            
+            {
+                auto data = Image::Data::create(Image::Info(4, 1, Image::Type::L_U8));
+                Image::U8_T* p = reinterpret_cast<Image::U8_T*>(data->getData());
+                p[0] = 0;
+                p[1] = 255;
+                p[2] = 128;
+                p[3] = 128;
+                Image::StatisticsOptions options;
+                options.binCount = 4;
+                const auto statistics = Image::getStatistics(*data, options);
+                DJV_ASSERT(1 == statistics.channelCount);
+                DJV_ASSERT(4 == statistics.sampleCount);
+                DJV_ASSERT(std::vector<uint32_t>({ 1, 0, 2, 1 }) == statistics.histogram);
+                DJV_ASSERT(0.F == statistics.min[0]);
+                DJV_ASSERT(1.F == statistics.max[0]);
+            }
+            
+            {
+                // Values out of range are counted in the end bins.
+                auto data = Image::Data::create(Image::Info(3, 1, Image::Type::L_F32));
+                Image::F32_T* p = reinterpret_cast<Image::F32_T*>(data->getData());
+                p[0] = -1.F;
+                p[1] = .5F;
+                p[2] = 2.F;
+                Image::StatisticsOptions options;
+                options.binCount = 2;
+                const auto statistics = Image::getStatistics(*data, options);
+                DJV_ASSERT(std::vector<uint32_t>({ 1, 2 }) == statistics.histogram);
+                DJV_ASSERT(-1.F == statistics.min[0]);
+                DJV_ASSERT(2.F == statistics.max[0]);
+            }
+        }
+        
+        void StatisticsTest::_types()
+        {
+            for (auto type : Image::getTypeEnums())
+            {
+                if (Image::Type::None == type)
+                    continue;
+                auto data = Image::Data::create(Image::Info(64, 64, type));
+                data->zero();
+                const auto statistics = Image::getStatistics(*data);
+                {
+                    std::stringstream ss;
+                    ss << type << " samples: " << statistics.sampleCount;
+                    _print(ss.str());
+                }
+                DJV_ASSERT(Image::getChannelCount(type) == statistics.channelCount);
+                DJV_ASSERT(64 * 64 == statistics.sampleCount);
+                for (uint8_t c = 0; c < statistics.channelCount; ++c)
+                {
+                    DJV_ASSERT(64 * 64 == statistics.histogram[c * statistics.binCount]);
+                    DJV_ASSERT(0.F == statistics.min[c]);
+                    DJV_ASSERT(0.F == statistics.max[c]);
+                }
+            }
+        }
+        
+        void StatisticsTest::_scopes()
+        {
+            auto data = Image::Data::create(Image::Info(4, 2, Image::Type::RGB_F32));
+            Image::F32_T* p = reinterpret_cast<Image::F32_T*>(data->getData());
+            for (size_t i = 0; i < 4 * 2 * 3; ++i)
+            {
+                p[i] = .5F;
+            }
+            Image::StatisticsOptions options;
+            options.waveformWidth = 2;
+            options.waveformHeight = 4;
+            options.vectorscopeSize = 8;
+            const auto statistics = Image::getStatistics(*data, options);
+            DJV_ASSERT(2 == statistics.waveformWidth);
+            DJV_ASSERT(4 == statistics.waveformHeight);
+            DJV_ASSERT(3 * 2 * 4 == statistics.waveform.size());
+            for (size_t c = 0; c < 3; ++c)
+            {
+                // Each column covers two pixels of both scanlines.
+                DJV_ASSERT(4 == statistics.waveform[c * 8 + 2 * 2 + 0]);
+                DJV_ASSERT(4 == statistics.waveform[c * 8 + 2 * 2 + 1]);
+            }
+
+            // Gray has no chroma so all of the samples are in the center.
+            DJV_ASSERT(8 == statistics.vectorscopeSize);
+            DJV_ASSERT(8 == statistics.vectorscope[4 * 8 + 4]);
+        }
+        
+        void StatisticsTest::_step()
+        {
+            auto data = Image::Data::create(Image::Info(1000, 100, Image::Type::RGBA_U16));
+            data->zero();
+            Image::StatisticsOptions options;
+            DJV_ASSERT(options == options);
+            options.step = 4;
+            const auto statistics = Image::getStatistics(*data, options);
+            DJV_ASSERT(250 * 25 == statistics.sampleCount);
+        }
+        
+    } // namespace ImageTest
+} // namespace djv
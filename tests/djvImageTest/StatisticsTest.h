@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace ImageTest
+    {
+        class StatisticsTest : public Test::ITest
+        {
+        public:
+            StatisticsTest(
+                const System::File::Path& tempPath,
+                const std::shared_ptr<System::Context>&);
+            
+            void run() override;
+        
+        private:
+            void _histogram();
+            void _types();
+            void _scopes();
+            void _step();
+        };
+        
+    } // namespace ImageTest
+} // namespace djv
@@ -8,6 +8,8 @@
 
 #include <djvMath/RangeFunc.h>
 
+#include <djvCore/MemoryFunc.h>
+
 using namespace djv::Core;
 using namespace djv::Image;
 
@@ -36,6 +38,7 @@ namespace djv
         {
             _util();
             _convert();
+            _packU10();
             _serialize();
         }                
         
@@ -209,6 +212,61 @@ namespace djv
             }
         }
 
+        void TypeFuncTest::_packU10()
+        {
+            const Memory::SIMD simd = Memory::getSIMD();
+
+            // Compare the SIMD kernels against the scalar code, the sizes
+            // exercise the remainders that are handled by the scalar code.
+            for (size_t size : { 0, 1, 3, 4, 5, 8, 9, 15, 16, 17, 1003 })
+            {
+                std::vector<U10_S> u10(size);
+                std::vector<U16_T> u16(size * 3);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    u10[i].r = (i * 7) % 1024;
+                    u10[i].g = (i * 13 + 1) % 1024;
+                    u10[i].b = (i * 29 + 2) % 1024;
+                    u10[i].pad = i % 4;
+                    u16[i * 3] = static_cast<U16_T>(i * 101);
+                    u16[i * 3 + 1] = static_cast<U16_T>(i * 211 + 1);
+                    u16[i * 3 + 2] = static_cast<U16_T>(i * 307 + 2);
+                }
+
+                Memory::setSIMD(Memory::SIMD::None);
+                std::vector<U16_T> unpacked(size * 3);
+                unpackU10(u10.data(), unpacked.data(), size);
+                std::vector<U10_S> packed(size);
+                packU10(u16.data(), packed.data(), size);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    DJV_ASSERT(unpacked[i * 3] == u10[i].r << 6);
+                    DJV_ASSERT(unpacked[i * 3 + 1] == u10[i].g << 6);
+                    DJV_ASSERT(unpacked[i * 3 + 2] == u10[i].b << 6);
+                    DJV_ASSERT(packed[i].r == u16[i * 3] >> 6);
+                    DJV_ASSERT(packed[i].g == u16[i * 3 + 1] >> 6);
+                    DJV_ASSERT(packed[i].b == u16[i * 3 + 2] >> 6);
+                    DJV_ASSERT(0 == packed[i].pad);
+                }
+
+                for (size_t i = static_cast<size_t>(Memory::SIMD::First); i < static_cast<size_t>(Memory::SIMD::Count); ++i)
+                {
+                    Memory::setSIMD(static_cast<Memory::SIMD>(i));
+                    std::vector<U16_T> unpacked2(size * 3);
+                    unpackU10(u10.data(), unpacked2.data(), size);
+                    DJV_ASSERT(unpacked == unpacked2);
+                    std::vector<U10_S> packed2(size);
+                    packU10(u16.data(), packed2.data(), size);
+                    DJV_ASSERT(packed == packed2);
+                    std::vector<U16_T> converted(size * 3);
+                    convert(u10.data(), Type::RGB_U10, converted.data(), Type::RGB_U16, size);
+                    DJV_ASSERT(unpacked == converted);
+                }
+            }
+
+            Memory::setSIMD(simd);
+        }
+
         void TypeFuncTest::_serialize()
         {
             {
@@ -20,6 +20,7 @@ namespace djv
         private:
             void _util();
             void _convert();
+            void _packU10();
             void _serialize();
         };
         
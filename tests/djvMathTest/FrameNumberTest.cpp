@@ -89,6 +89,54 @@ namespace djv
                 sequence.add(Frame::Range(12, 100));
                 DJV_ASSERT(sequence.getRanges()[0] == Frame::Range(1, 10));
             }
+
+            {
+                Frame::Sequence sequence;
+                for (Frame::Number i = 0; i < 100; i += 2)
+                {
+                    sequence.add(Frame::Range(i));
+                }
+                DJV_ASSERT(50 == sequence.getRanges().size());
+                DJV_ASSERT(50 == sequence.getFrameCount());
+                DJV_ASSERT(49 == sequence.getLastIndex());
+                for (Frame::Index i = 0; i < 50; ++i)
+                {
+                    DJV_ASSERT(i * 2 == sequence.getFrame(i));
+                    DJV_ASSERT(i == sequence.getIndex(i * 2));
+                    DJV_ASSERT(sequence.contains(i * 2));
+                    DJV_ASSERT(!sequence.contains(i * 2 + 1));
+                    DJV_ASSERT(Frame::invalidIndex == sequence.getIndex(i * 2 + 1));
+                }
+                DJV_ASSERT(Frame::invalid == sequence.getFrame(-1));
+                DJV_ASSERT(Frame::invalid == sequence.getFrame(50));
+
+                sequence.add(Frame::Range(1, 9));
+                DJV_ASSERT(Frame::Range(0, 10) == sequence.getRanges()[0]);
+                DJV_ASSERT(46 == sequence.getRanges().size());
+                DJV_ASSERT(12 == sequence.getFrame(11));
+                DJV_ASSERT(11 == sequence.getIndex(12));
+            }
+
+            {
+                Frame::Sequence sequence(Frame::Range(1, 10));
+                sequence.remove(Frame::Range(4, 6));
+                DJV_ASSERT(2 == sequence.getRanges().size());
+                DJV_ASSERT(Frame::Range(1, 3) == sequence.getRanges()[0]);
+                DJV_ASSERT(Frame::Range(7, 10) == sequence.getRanges()[1]);
+                DJV_ASSERT(7 == sequence.getFrameCount());
+                DJV_ASSERT(7 == sequence.getFrame(3));
+                DJV_ASSERT(3 == sequence.getIndex(7));
+                sequence.remove(Frame::Range(20));
+                DJV_ASSERT(7 == sequence.getFrameCount());
+                sequence.remove(Frame::Range(0, 8));
+                DJV_ASSERT(1 == sequence.getRanges().size());
+                DJV_ASSERT(Frame::Range(9, 10) == sequence.getRanges()[0]);
+                sequence.add(Frame::Range(1, 8));
+                DJV_ASSERT(Frame::Sequence(Frame::Range(1, 10)) == sequence);
+                sequence.remove(Frame::Range(1, 10));
+                DJV_ASSERT(!sequence.isValid());
+                DJV_ASSERT(0 == sequence.getFrameCount());
+            }
         }
                 
         void FrameNumberTest::_operators()
@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvOCIOTest/CPUProcessorTest.h>
+
+#include <djvOCIO/CPUProcessor.h>
+#include <djvOCIO/OCIOSystem.h>
+
+#include <djvImage/Data.h>
+
+#include <djvSystem/Context.h>
+#include <djvSystem/ResourceSystem.h>
+
+#include <djvMath/MathFunc.h>
+
+#include <djvCore/ErrorFunc.h>
+
+#include <cmath>
+#include <sstream>
+
+using namespace djv::Core;
+using namespace djv::OCIO;
+
+namespace djv
+{
+    namespace OCIOTest
+    {
+        CPUProcessorTest::CPUProcessorTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::OCIOTest::CPUProcessorTest", tempPath, context)
+        {}
+        
+        void CPUProcessorTest::run()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto system = context->getSystemT<OCIO::OCIOSystem>();
+                auto resourceSystem = context->getSystemT<System::ResourceSystem>();
+                OCIO::Config config;
+                config.fileName = System::File::Path(
+                    resourceSystem->getPath(System::File::ResourcePath::Color),
+                    "spi-vfx/config.ocio").get();
+                system->setConfigMode(OCIO::ConfigMode::CmdLine);
+                system->setCmdLineConfig(config);
+            }
+            _identity();
+            _lut3D();
+            _lut3DLinear();
+            _image();
+            _error();
+        }
+
+        namespace
+        {
+            std::vector<float> createRamp(size_t count, size_t channelCount)
+            {
+                std::vector<float> out(count * channelCount);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    for (size_t j = 0; j < channelCount; ++j)
+                    {
+                        out[i * channelCount + j] = ((i * (j + 1) * 7) % count) / static_cast<float>(count - 1);
+                    }
+                }
+                return out;
+            }
+
+        } // namespace
+
+        void CPUProcessorTest::_identity()
+        {
+            for (auto mode : { CPUProcessorMode::LUT3D, CPUProcessorMode::Exact })
+            {
+                auto processor = CPUProcessor::create(Convert("lnf", "lnf"), mode);
+                DJV_ASSERT(Convert("lnf", "lnf") == processor->getConvert());
+                DJV_ASSERT(mode == processor->getMode());
+                for (size_t channelCount : { 3, 4 })
+                {
+                    const auto ramp = createRamp(1000, channelCount);
+                    auto data = ramp;
+                    processor->apply(data.data(), 1000, channelCount);
+                    for (size_t i = 0; i < data.size(); ++i)
+                    {
+                        DJV_ASSERT(fuzzyCompare(ramp[i], data[i], .001F));
+                    }
+                }
+            }
+        }
+
+        void CPUProcessorTest::_lut3D()
+        {
+            // The baked LUT should be close to the exact transform.
+            const Convert convert("lg10", "vd8");
+            auto lut3D = CPUProcessor::create(convert, CPUProcessorMode::LUT3D, 65);
+            auto exact = CPUProcessor::create(convert, CPUProcessorMode::Exact);
+            const size_t count = 100000;
+            auto a = createRamp(count, 3);
+            auto b = a;
+            lut3D->apply(a.data(), count, 3);
+            exact->apply(b.data(), count, 3);
+            float maxError = 0.F;
+            for (size_t i = 0; i < a.size(); ++i)
+            {
+                maxError = std::max(maxError, std::abs(a[i] - b[i]));
+            }
+            std::stringstream ss;
+            ss << "LUT3D max error: " << maxError;
+            _print(ss.str());
+            DJV_ASSERT(maxError < .02F);
+
+            CPUProcessor::clearCache();
+        }
+
+        void CPUProcessorTest::_lut3DLinear()
+        {
+            // Linear input should not be clipped at 1.0 or lose precision in
+            // the shadows. The input color space has a log allocation, values
+            // above the allocation and negative values are processed exactly.
+            const Convert convert("lnf", "lg10");
+            auto lut3D = CPUProcessor::create(convert, CPUProcessorMode::LUT3D, 65);
+            auto exact = CPUProcessor::create(convert, CPUProcessorMode::Exact);
+            std::vector<float> a;
+            for (float value = 1.F / 4096.F; value < 256.F; value *= 1.1F)
+            {
+                a.push_back(value);
+                a.push_back(value * .5F);
+                a.push_back(value * 2.F);
+            }
+            a.push_back(-1.F);
+            a.push_back(0.F);
+            a.push_back(1.F);
+            const size_t count = a.size() / 3;
+            const auto input = a;
+            auto b = a;
+            lut3D->apply(a.data(), count, 3);
+            exact->apply(b.data(), count, 3);
+            float maxError = 0.F;
+            for (size_t i = 0; i < a.size(); ++i)
+            {
+                maxError = std::max(maxError, std::abs(a[i] - b[i]));
+            }
+            std::stringstream ss;
+            ss << "LUT3D linear max error: " << maxError;
+            _print(ss.str());
+            DJV_ASSERT(maxError < .01F);
+            for (size_t i = 0; i < a.size(); i += 3)
+            {
+                if (input[i + 1] > 64.F)
+                {
+                    DJV_ASSERT(a[i] == b[i]);
+                    DJV_ASSERT(a[i + 1] == b[i + 1]);
+                    DJV_ASSERT(a[i + 2] == b[i + 2]);
+                }
+            }
+
+            CPUProcessor::clearCache();
+        }
+
+        void CPUProcessorTest::_image()
+        {
+            auto processor = CPUProcessor::create(Convert("lnf", "lnf"));
+            for (auto type : { Image::Type::L_U8, Image::Type::RGB_U10, Image::Type::RGBA_U16, Image::Type::RGB_F32 })
+            {
+                const Image::Info info(16, 16, type);
+                auto data = Image::Data::create(info);
+                data->zero();
+                processor->apply(*data);
+                auto zero = Image::Data::create(info);
+                zero->zero();
+                DJV_ASSERT(*zero == *data);
+            }
+        }
+
+        void CPUProcessorTest::_error()
+        {
+            try
+            {
+                CPUProcessor::create(Convert("error", "error"));
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(Error::format(e));
+            }
+        }
+
+    } // namespace OCIOTest
+} // namespace djv
+
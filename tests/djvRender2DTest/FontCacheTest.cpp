@@ -0,0 +1,231 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvRender2DTest/FontCacheTest.h>
+
+#include <djvRender2D/FontCache.h>
+
+#include <djvSystem/FileIO.h>
+#include <djvSystem/FileInfo.h>
+
+#include <djvImage/Data.h>
+
+#include <cstring>
+
+using namespace djv::Core;
+using namespace djv::Render2D;
+
+namespace djv
+{
+    namespace Render2DTest
+    {
+        FontCacheTest::FontCacheTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::Render2DTest::FontCacheTest", tempPath, context)
+        {}
+        
+        void FontCacheTest::run()
+        {
+            _fontHash();
+            _readWrite();
+            _error();
+        }
+
+        void FontCacheTest::_fontHash()
+        {
+            const System::File::Path path(getTempPath(), "FontCacheTest.ttf");
+            {
+                auto io = System::File::IO::create();
+                io->open(path.get(), System::File::Mode::Write);
+                io->writeU32(0);
+            }
+            const uint64_t hash = Font::Cache::getFontHash(System::File::Info(path));
+            DJV_ASSERT(hash == Font::Cache::getFontHash(System::File::Info(path)));
+            {
+                auto io = System::File::IO::create();
+                io->open(path.get(), System::File::Mode::Write);
+                io->writeU32(0);
+                io->writeU32(0);
+            }
+            DJV_ASSERT(hash != Font::Cache::getFontHash(System::File::Info(path)));
+        }
+
+        void FontCacheTest::_readWrite()
+        {
+            const System::File::Path path(getTempPath(), Font::Cache::fileName);
+            const Font::FontInfo fontInfo(1, 1, 14, 96);
+            Font::Cache::FontHashes fontHashes;
+            fontHashes[std::make_pair(1, 1)] = 100;
+            fontHashes[std::make_pair(2, 1)] = 200;
+
+            auto glyph = Font::Glyph::create();
+            glyph->glyphInfo = Font::GlyphInfo(65, fontInfo);
+            glyph->imageData = Image::Data::create(Image::Info(2, 3, Image::Type::L_U8));
+            for (size_t i = 0; i < glyph->imageData->getDataByteCount(); ++i)
+            {
+                glyph->imageData->getData()[i] = static_cast<uint8_t>(i);
+            }
+            glyph->offset = glm::vec2(1.F, 2.F);
+            glyph->advance = 3;
+            glyph->lsbDelta = -4;
+            glyph->rsbDelta = 5;
+
+            Font::Cache::Data data;
+            data.glyphs.push_back(glyph);
+            data.measure.push_back(std::make_pair(Font::Cache::MeasureKey("A", fontInfo, 0), glm::vec2(3.F, 14.F)));
+            data.textLines.push_back(std::make_pair(
+                Font::Cache::MeasureKey("A\n", fontInfo, 100),
+                std::vector<Font::TextLine>({
+                    Font::TextLine("A", glm::vec2(3.F, 14.F), { glyph, nullptr }) })));
+            Font::Cache::write(path, fontHashes, data);
+
+            {
+                const auto data2 = Font::Cache::read(path, fontHashes, true);
+                DJV_ASSERT(1 == data2.glyphs.size());
+                const auto& glyph2 = data2.glyphs[0];
+                DJV_ASSERT(glyph->glyphInfo == glyph2->glyphInfo);
+                DJV_ASSERT(glyph->offset == glyph2->offset);
+                DJV_ASSERT(glyph->advance == glyph2->advance);
+                DJV_ASSERT(glyph->lsbDelta == glyph2->lsbDelta);
+                DJV_ASSERT(glyph->rsbDelta == glyph2->rsbDelta);
+                DJV_ASSERT(*glyph->imageData == *glyph2->imageData);
+                DJV_ASSERT(data.measure == data2.measure);
+                DJV_ASSERT(1 == data2.textLines.size());
+                DJV_ASSERT(data.textLines[0].first == data2.textLines[0].first);
+                const auto& lines = data2.textLines[0].second;
+                DJV_ASSERT(1 == lines.size());
+                DJV_ASSERT("A" == lines[0].text);
+                DJV_ASSERT(glm::vec2(3.F, 14.F) == lines[0].size);
+                DJV_ASSERT(2 == lines[0].glyphs.size());
+                DJV_ASSERT(glyph2 == lines[0].glyphs[0]);
+                DJV_ASSERT(!lines[0].glyphs[1]);
+            }
+
+            {
+                const auto data2 = Font::Cache::read(path, fontHashes, false);
+                DJV_ASSERT(data2.glyphs.empty());
+                DJV_ASSERT(data.measure == data2.measure);
+                DJV_ASSERT(data2.textLines.empty());
+            }
+
+            {
+                Font::Cache::FontHashes fontHashes2;
+                fontHashes2[std::make_pair(3, 2)] = 100;
+                const auto data2 = Font::Cache::read(path, fontHashes2, true);
+                DJV_ASSERT(1 == data2.glyphs.size());
+                DJV_ASSERT(3 == data2.glyphs[0]->glyphInfo.fontInfo.getFamily());
+                DJV_ASSERT(2 == data2.glyphs[0]->glyphInfo.fontInfo.getFace());
+                DJV_ASSERT(1 == data2.measure.size());
+                DJV_ASSERT(3 == std::get<1>(data2.measure[0].first).getFamily());
+                DJV_ASSERT(1 == data2.textLines.size());
+            }
+
+            {
+                Font::Cache::FontHashes fontHashes2;
+                fontHashes2[std::make_pair(1, 1)] = 300;
+                const auto data2 = Font::Cache::read(path, fontHashes2, true);
+                DJV_ASSERT(data2.glyphs.empty());
+                DJV_ASSERT(data2.measure.empty());
+                DJV_ASSERT(data2.textLines.empty());
+            }
+        }
+
+        void FontCacheTest::_error()
+        {
+            try
+            {
+                Font::Cache::read(System::File::Path(getTempPath(), "FontCacheTest.djvfont"), {}, true);
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(e.what());
+            }
+
+            const System::File::Path path(getTempPath(), "FontCacheTest2.djvfont");
+            {
+                auto io = System::File::IO::create();
+                io->open(path.get(), System::File::Mode::Write);
+                io->writeU32(0);
+            }
+            try
+            {
+                Font::Cache::read(path, {}, true);
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(e.what());
+            }
+
+            // Replace the text lines count at the end of an empty cache with a
+            // count that is larger than the file.
+            const System::File::Path path2(getTempPath(), "FontCacheTest3.djvfont");
+            Font::Cache::write(path2, {}, Font::Cache::Data());
+            std::vector<uint8_t> data;
+            {
+                auto io = System::File::IO::create();
+                io->open(path2.get(), System::File::Mode::Read);
+                data.resize(io->getSize());
+                io->read(data.data(), data.size());
+            }
+            memset(data.data() + data.size() - sizeof(uint32_t), 0xff, sizeof(uint32_t));
+            {
+                auto io = System::File::IO::create();
+                io->open(path2.get(), System::File::Mode::Write);
+                io->write(data.data(), data.size());
+            }
+            try
+            {
+                Font::Cache::read(path2, {}, true);
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(e.what());
+            }
+
+            // Replace the glyph image size with a size that is larger than
+            // the file, the image should not be allocated.
+            const System::File::Path path3(getTempPath(), "FontCacheTest4.djvfont");
+            Font::Cache::FontHashes fontHashes;
+            fontHashes[std::make_pair(1, 1)] = 100;
+            auto glyph = Font::Glyph::create();
+            glyph->glyphInfo = Font::GlyphInfo(65, Font::FontInfo(1, 1, 14, 96));
+            glyph->imageData = Image::Data::create(Image::Info(2, 3, Image::Type::L_U8));
+            glyph->imageData->zero();
+            Font::Cache::Data cacheData;
+            cacheData.glyphs.push_back(glyph);
+            Font::Cache::write(path3, fontHashes, cacheData);
+            {
+                auto io = System::File::IO::create();
+                io->open(path3.get(), System::File::Mode::Read);
+                data.resize(io->getSize());
+                io->read(data.data(), data.size());
+            }
+            // The image is followed by the image data and the measure and
+            // text lines counts.
+            uint8_t* p = data.data() + data.size() - sizeof(uint32_t) * 2 - 6 - sizeof(uint16_t) * 2 - sizeof(uint8_t);
+            *p = static_cast<uint8_t>(Image::Type::RGBA_F32);
+            memset(p + 1, 0xff, sizeof(uint16_t) * 2);
+            {
+                auto io = System::File::IO::create();
+                io->open(path3.get(), System::File::Mode::Write);
+                io->write(data.data(), data.size());
+            }
+            try
+            {
+                Font::Cache::read(path3, fontHashes, true);
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(e.what());
+            }
+        }
+        
+    } // namespace Render2DTest
+} // namespace djv
+
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace Render2DTest
+    {
+        class FontCacheTest : public Test::ITest
+        {
+        public:
+            FontCacheTest(
+                const System::File::Path& tempPath,
+                const std::shared_ptr<System::Context>&);
+            
+            void run() override;
+            
+        private:
+            void _fontHash();
+            void _readWrite();
+            void _error();
+        };
+        
+    } // namespace Render2DTest
+} // namespace djv
+
@@ -247,6 +247,59 @@ namespace djv
                     ss << "Glyph cache percentage: " << system->getGlyphCachePercentage();
                     _print(ss.str());
                 }
+
+                DJV_ASSERT(system->getThreadCount() > 0);
+                const std::vector<std::string> textList =
+                {
+                    String::getRandomText(10),
+                    String::getRandomText(20),
+                    text
+                };
+                system->cacheGlyphs(textList, fontInfo);
+                auto measureBatchFuture = system->measure(textList, fontInfo);
+                auto glyphsBatchFuture = system->getGlyphs(textList, fontInfo);
+                std::vector<glm::vec2> measureBatch;
+                std::vector<std::vector<std::shared_ptr<Font::Glyph> > > glyphsBatch;
+                while (
+                    measureBatchFuture.valid() ||
+                    glyphsBatchFuture.valid())
+                {
+                    _tickFor(System::getTimerDuration(System::TimerValue::Fast));
+                    if (measureBatchFuture.valid() &&
+                        measureBatchFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    {
+                        measureBatch = measureBatchFuture.get();
+                    }
+                    if (glyphsBatchFuture.valid() &&
+                        glyphsBatchFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    {
+                        glyphsBatch = glyphsBatchFuture.get();
+                    }
+                }
+                DJV_ASSERT(textList.size() == measureBatch.size());
+                DJV_ASSERT(textList.size() == glyphsBatch.size());
+
+                // The batch results should be the same as the single results.
+                measureFuture = system->measure(text, fontInfo);
+                glyphsFuture = system->getGlyphs(text, fontInfo);
+                while (
+                    measureFuture.valid() ||
+                    glyphsFuture.valid())
+                {
+                    _tickFor(System::getTimerDuration(System::TimerValue::Fast));
+                    if (measureFuture.valid() &&
+                        measureFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    {
+                        measure = measureFuture.get();
+                    }
+                    if (glyphsFuture.valid() &&
+                        glyphsFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    {
+                        glyphs = glyphsFuture.get();
+                    }
+                }
+                DJV_ASSERT(measure == measureBatch[2]);
+                DJV_ASSERT(glyphs.size() == glyphsBatch[2].size());
             }
         }
 
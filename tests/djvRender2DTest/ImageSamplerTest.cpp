@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvRender2DTest/ImageSamplerTest.h>
+
+#include <djvRender2D/ImageSampler.h>
+
+#include <djvImage/Color.h>
+#include <djvImage/Data.h>
+
+#include <djvMath/MathFunc.h>
+
+using namespace djv::Core;
+using namespace djv::Render2D;
+
+namespace djv
+{
+    namespace Render2DTest
+    {
+        ImageSamplerTest::ImageSamplerTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::Render2DTest::ImageSamplerTest", tempPath, context)
+        {}
+        
+        void ImageSamplerTest::run()
+        {
+            // Create an image with increasing values from left to right.
+            auto data = Image::Data::create(Image::Info(4, 2, Image::Type::RGBA_F32));
+            for (uint16_t y = 0; y < data->getHeight(); ++y)
+            {
+                Image::F32_T* p = reinterpret_cast<Image::F32_T*>(data->getData(y));
+                for (uint16_t x = 0; x < data->getWidth(); ++x, p += 4)
+                {
+                    p[0] = x / 4.F;
+                    p[1] = y / 2.F;
+                    p[2] = 0.F;
+                    p[3] = 1.F;
+                }
+            }
+
+            {
+                auto sampler = ImageSampler::create();
+                DJV_ASSERT(sampler->getOptions() == ImageOptions());
+                const auto color = sampler->average(*data, Math::BBox2i(0, 0, 4, 2));
+                DJV_ASSERT(Image::Type::RGBA_F32 == color.getType());
+                DJV_ASSERT(fuzzyCompare(color.getF32(0), .375F));
+                DJV_ASSERT(fuzzyCompare(color.getF32(1), .25F));
+                DJV_ASSERT(fuzzyCompare(color.getF32(2), 0.F));
+                DJV_ASSERT(fuzzyCompare(color.getF32(3), 1.F));
+            }
+
+            {
+                // Regions are clipped to the image.
+                auto sampler = ImageSampler::create();
+                const auto color = sampler->average(*data, Math::BBox2i(3, 1, 10, 10));
+                DJV_ASSERT(fuzzyCompare(color.getF32(0), .75F));
+                DJV_ASSERT(fuzzyCompare(color.getF32(1), .5F));
+                DJV_ASSERT(!sampler->crop(*data, Math::BBox2i(10, 10, 2, 2)));
+                DJV_ASSERT(ImageSampler::getCropBBox(*data, Math::BBox2i(-1, -1, 3, 3)) == Math::BBox2i(0, 0, 2, 2));
+            }
+
+            {
+                // Mirroring is applied before sampling.
+                ImageOptions options;
+                options.mirror.x = true;
+                options.mirror.y = true;
+                auto sampler = ImageSampler::create(options);
+                const auto crop = sampler->crop(*data, Math::BBox2i(0, 0, 2, 1));
+                DJV_ASSERT(crop);
+                DJV_ASSERT(2 == crop->getWidth());
+                DJV_ASSERT(1 == crop->getHeight());
+                DJV_ASSERT(Image::Type::RGBA_F32 == crop->getType());
+                const Image::F32_T* p = reinterpret_cast<const Image::F32_T*>(crop->getData());
+                DJV_ASSERT(fuzzyCompare(p[0], .75F));
+                DJV_ASSERT(fuzzyCompare(p[1], .5F));
+                DJV_ASSERT(fuzzyCompare(p[4], .5F));
+            }
+
+            {
+                // Color operations and the channel display.
+                ImageOptions options;
+                options.colorEnabled = true;
+                options.color.invert = true;
+                options.channelDisplay = ImageChannelDisplay::Red;
+                auto sampler = ImageSampler::create(options);
+                const auto color = sampler->average(*data, Math::BBox2i(1, 0, 1, 1));
+                DJV_ASSERT(fuzzyCompare(color.getF32(0), .75F));
+                DJV_ASSERT(fuzzyCompare(color.getF32(1), .75F));
+                DJV_ASSERT(fuzzyCompare(color.getF32(2), .75F));
+            }
+
+            {
+                ImageOptions options;
+                options.levelsEnabled = true;
+                options.levels.inHigh = .5F;
+                options.softClipEnabled = true;
+                options.softClip = .1F;
+                auto sampler = ImageSampler::create(options);
+                float pixel[4] = { .25F, 1.F, 0.F, 1.F };
+                sampler->process(pixel, 1);
+                DJV_ASSERT(fuzzyCompare(pixel[0], .5F));
+                DJV_ASSERT(pixel[1] > .9F && pixel[1] < 1.F);
+                DJV_ASSERT(fuzzyCompare(pixel[3], 1.F));
+            }
+        }
+
+    } // namespace Render2DTest
+} // namespace djv
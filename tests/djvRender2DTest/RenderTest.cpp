@@ -21,6 +21,9 @@
 
 #include <djvCore/StringFunc.h>
 
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/matrix_transform_2d.hpp>
+
 using namespace djv::Core;
 using namespace djv::Render2D;
 
@@ -126,13 +129,31 @@ namespace djv
                 }
                 imageInfo.layout.mirror.x = true;
                 imageInfo.layout.mirror.y = true;
-                for (size_t i = 0; i < dynamicTextureCacheMax; ++i)
+                for (size_t i = 0; i < dynamicTextureCount * 2; ++i)
+                {
+                    image = Image::Data::create(imageInfo);
+                    render->drawImage(image, glm::vec2(200.f, 300.f), imageOptions);
+                }
+                for (size_t i = 0; i < dynamicTextureCount; ++i)
                 {
                     image = Image::Data::create(imageInfo);
+                    image->zero();
+                    render->uploadImage(image);
+                    render->uploadImage(image);
                     render->drawImage(image, glm::vec2(200.f, 300.f), imageOptions);
                 }
                 render->setFillColor(Image::Color(.6F, 1.F, .4F));
                 render->drawFilledImage(image, glm::vec2(400.f, 500.f));
+
+                auto tiledImage = Image::Data::create(Image::Info(1500, 700, Image::Type::RGB_U8));
+                tiledImage->zero();
+                imageOptions = ImageOptions();
+                imageOptions.cache = ImageCache::Tiled;
+                render->drawImage(tiledImage, glm::vec2(0.f, 0.f), imageOptions);
+                imageOptions.mirror.x = true;
+                render->pushTransform(glm::scale(glm::mat3x3(1.F), glm::vec2(.2F, .2F)));
+                render->drawImage(tiledImage, glm::vec2(0.f, 0.f), imageOptions);
+                render->popTransform();
                 
                 Font::FontInfo fontInfo(1, 1, 64, dpiDefault);
                 auto fontSystem = context->getSystemT<Font::FontSystem>();
@@ -158,6 +179,11 @@ namespace djv
                     ss << "Primitives count: " << render->getPrimitivesCount();
                     _print(ss.str());
                 }
+                {
+                    std::stringstream ss;
+                    ss << "Draw call count: " << render->getDrawCallCount();
+                    _print(ss.str());
+                }
                 {
                     std::stringstream ss;
                     ss << "Texture atlas percentage: " << render->getTextureAtlasPercentage();
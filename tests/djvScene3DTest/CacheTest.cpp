@@ -0,0 +1,478 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvScene3DTest/CacheTest.h>
+
+#include <djvScene3D/Cache.h>
+#include <djvScene3D/InstancePrimitive.h>
+#include <djvScene3D/Layer.h>
+#include <djvScene3D/Light.h>
+#include <djvScene3D/Material.h>
+#include <djvScene3D/MeshPrimitive.h>
+#include <djvScene3D/PointListPrimitive.h>
+#include <djvScene3D/Scene.h>
+
+#include <djvSystem/Context.h>
+#include <djvSystem/FileIO.h>
+#include <djvSystem/FileInfo.h>
+#include <djvSystem/FileInfoFunc.h>
+#include <djvSystem/LogSystem.h>
+#include <djvSystem/PathFunc.h>
+#include <djvSystem/ResourceSystem.h>
+#include <djvSystem/TextSystem.h>
+
+#include <djvGeom/PointList.h>
+#include <djvGeom/TriangleMesh.h>
+
+#include <sstream>
+
+using namespace djv::Core;
+using namespace djv::Scene3D;
+
+namespace djv
+{
+    namespace Scene3DTest
+    {
+        namespace
+        {
+            class SourceRead : public IO::IRead
+            {
+            public:
+                static std::shared_ptr<SourceRead> create(
+                    const System::File::Info& fileInfo,
+                    const std::shared_ptr<Scene>& scene,
+                    const std::shared_ptr<System::Context>& context)
+                {
+                    auto out = std::shared_ptr<SourceRead>(new SourceRead);
+                    out->_init(
+                        fileInfo,
+                        context->getSystemT<System::TextSystem>(),
+                        context->getSystemT<System::ResourceSystem>(),
+                        context->getSystemT<System::LogSystem>());
+                    out->_scene = scene;
+                    return out;
+                }
+
+                std::future<IO::Info> getInfo() override
+                {
+                    return std::async(std::launch::async, [] { return IO::Info(); });
+                }
+
+                std::future<std::shared_ptr<Scene> > getScene() override
+                {
+                    ++readCount;
+                    auto scene = _scene;
+                    return std::async(std::launch::async, [scene] { return scene; });
+                }
+
+                size_t readCount = 0;
+
+            private:
+                std::shared_ptr<Scene> _scene;
+            };
+
+            std::shared_ptr<Geom::TriangleMesh> createMesh(size_t size)
+            {
+                auto out = std::shared_ptr<Geom::TriangleMesh>(new Geom::TriangleMesh);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    const float f = static_cast<float>(i);
+                    out->v.push_back(glm::vec3(f, f + 1.F, f + 2.F));
+                    out->c.push_back(glm::vec3(f / size, 0.F, 1.F));
+                    out->t.push_back(glm::vec2(f / size, 1.F));
+                    out->n.push_back(glm::vec3(0.F, 0.F, 1.F));
+                }
+                for (size_t i = 0; i + 2 < size; ++i)
+                {
+                    Geom::TriangleMesh::Triangle triangle;
+                    triangle.v0 = Geom::TriangleMesh::Vertex(i + 1, i + 1, i + 1);
+                    triangle.v1 = Geom::TriangleMesh::Vertex(i + 2, i + 2, i + 2);
+                    triangle.v2 = Geom::TriangleMesh::Vertex(i + 3, i + 3, i + 3);
+                    out->triangles.push_back(triangle);
+                }
+                out->bboxUpdate();
+                return out;
+            }
+
+            void compareMesh(const Geom::TriangleMesh& a, const Geom::TriangleMesh& b)
+            {
+                DJV_ASSERT(a.v == b.v);
+                DJV_ASSERT(a.c == b.c);
+                DJV_ASSERT(a.t == b.t);
+                DJV_ASSERT(a.n == b.n);
+                DJV_ASSERT(a.triangles == b.triangles);
+                DJV_ASSERT(a.bbox == b.bbox);
+            }
+
+            std::shared_ptr<Scene> createScene()
+            {
+                auto out = Scene::create();
+                out->setSceneOrient(SceneOrient::ZUp);
+                out->setSceneXForm(glm::mat4x4(2.F));
+
+                auto material = DefaultMaterial::create();
+                material->setDiffuse(Image::Color(1.F, .5F, 0.F));
+                material->setShine(.25F);
+                material->setTransparency(.5F);
+                material->setReflectivity(.75F);
+                material->setDisableLighting(true);
+
+                auto mesh = MeshPrimitive::create();
+                mesh->setName("mesh");
+                mesh->setMaterialAssignment(MaterialAssignment::Primitive);
+                mesh->setMaterial(material);
+                auto triangleMesh = createMesh(10);
+                mesh->addMesh(triangleMesh);
+                mesh->setMeshLODs(0, { triangleMesh, createMesh(5), createMesh(3) });
+                mesh->addMesh(createMesh(4));
+                out->addDefinition(mesh);
+
+                auto instance = InstancePrimitive::create();
+                instance->setName("instance");
+                instance->setXForm(glm::mat4x4(3.F));
+                instance->addInstance(mesh);
+                out->addPrimitive(instance);
+
+                auto pointList = PointListPrimitive::create();
+                pointList->setName("pointList");
+                pointList->setVisible(false);
+                pointList->setColorAssignment(ColorAssignment::Primitive);
+                pointList->setColor(Image::Color(0.F, 1.F, 0.F));
+                auto points = std::shared_ptr<Geom::PointList>(new Geom::PointList);
+                points->v.push_back(glm::vec3(1.F, 2.F, 3.F));
+                points->v.push_back(glm::vec3(4.F, 5.F, 6.F));
+                points->c.push_back(glm::vec3(1.F, 0.F, 0.F));
+                points->c.push_back(glm::vec3(0.F, 0.F, 1.F));
+                points->bboxUpdate();
+                pointList->setPointList(points);
+                instance->addChild(pointList);
+
+                auto hemisphereLight = HemisphereLight::create();
+                hemisphereLight->setIntensity(.5F);
+                hemisphereLight->setUp(glm::vec3(0.F, 0.F, 1.F));
+                hemisphereLight->setTopColor(Image::Color(1.F, 1.F, 0.F));
+                hemisphereLight->setBottomColor(Image::Color(0.F, 0.F, 1.F));
+                out->addPrimitive(hemisphereLight);
+                auto directionalLight = DirectionalLight::create();
+                directionalLight->setEnabled(false);
+                directionalLight->setDirection(glm::vec3(1.F, 0.F, 0.F));
+                out->addPrimitive(directionalLight);
+                auto pointLight = PointLight::create();
+                pointLight->setIntensity(2.F);
+                out->addPrimitive(pointLight);
+                auto spotLight = SpotLight::create();
+                spotLight->setConeAngle(45.F);
+                spotLight->setDirection(glm::vec3(0.F, 1.F, 0.F));
+                out->addPrimitive(spotLight);
+
+                auto layer = Layer::create();
+                layer->setName("layer");
+                layer->setColor(Image::Color(1.F, 0.F, 1.F));
+                layer->setMaterial(material);
+                auto subLayer = Layer::create();
+                subLayer->setName("subLayer");
+                subLayer->setVisible(false);
+                subLayer->addItem(pointLight);
+                layer->addItem(instance);
+                layer->addItem(subLayer);
+                out->addLayer(layer);
+
+                return out;
+            }
+
+            void compareScene(const std::shared_ptr<Scene>& a, const std::shared_ptr<Scene>& b)
+            {
+                DJV_ASSERT(a->getSceneOrient() == b->getSceneOrient());
+                DJV_ASSERT(a->getSceneXForm() == b->getSceneXForm());
+                DJV_ASSERT(a->getPrimitives().size() == b->getPrimitives().size());
+                DJV_ASSERT(a->getDefinitions().size() == b->getDefinitions().size());
+                DJV_ASSERT(a->getLayers().size() == b->getLayers().size());
+
+                const auto& mesh = a->getDefinitions()[0];
+                const auto& mesh2 = b->getDefinitions()[0];
+                DJV_ASSERT(std::dynamic_pointer_cast<MeshPrimitive>(mesh2));
+                DJV_ASSERT(mesh->getName() == mesh2->getName());
+                DJV_ASSERT(mesh->getMaterialAssignment() == mesh2->getMaterialAssignment());
+                DJV_ASSERT(mesh->getMeshes().size() == mesh2->getMeshes().size());
+                for (size_t i = 0; i < mesh->getMeshes().size(); ++i)
+                {
+                    compareMesh(*mesh->getMeshes()[i], *mesh2->getMeshes()[i]);
+                }
+                const auto& lods = mesh->getMeshLODs();
+                const auto& lods2 = mesh2->getMeshLODs();
+                DJV_ASSERT(3 == lods2[0].size());
+                DJV_ASSERT(lods2[0][0] == mesh2->getMeshes()[0]);
+                for (size_t i = 1; i < lods[0].size(); ++i)
+                {
+                    compareMesh(*lods[0][i], *lods2[0][i]);
+                }
+
+                const auto material = std::dynamic_pointer_cast<DefaultMaterial>(mesh->getMaterial());
+                const auto material2 = std::dynamic_pointer_cast<DefaultMaterial>(mesh2->getMaterial());
+                DJV_ASSERT(material2);
+                DJV_ASSERT(material->getAmbient() == material2->getAmbient());
+                DJV_ASSERT(material->getDiffuse() == material2->getDiffuse());
+                DJV_ASSERT(material->getEmission() == material2->getEmission());
+                DJV_ASSERT(material->getSpecular() == material2->getSpecular());
+                DJV_ASSERT(material->getShine() == material2->getShine());
+                DJV_ASSERT(material->getTransparency() == material2->getTransparency());
+                DJV_ASSERT(material->getReflectivity() == material2->getReflectivity());
+                DJV_ASSERT(material->hasDisableLighting() == material2->hasDisableLighting());
+
+                const auto instance2 = std::dynamic_pointer_cast<InstancePrimitive>(b->getPrimitives()[0]);
+                DJV_ASSERT(instance2);
+                DJV_ASSERT(a->getPrimitives()[0]->getXForm() == instance2->getXForm());
+                DJV_ASSERT(1 == instance2->getInstances().size());
+                DJV_ASSERT(mesh2 == instance2->getInstances()[0]);
+
+                const auto& pointList = a->getPrimitives()[0]->getChildren()[0];
+                DJV_ASSERT(1 == instance2->getChildren().size());
+                const auto& pointList2 = instance2->getChildren()[0];
+                DJV_ASSERT(std::dynamic_pointer_cast<PointListPrimitive>(pointList2));
+                DJV_ASSERT(pointList->isVisible() == pointList2->isVisible());
+                DJV_ASSERT(pointList->getColorAssignment() == pointList2->getColorAssignment());
+                DJV_ASSERT(pointList->getColor() == pointList2->getColor());
+                DJV_ASSERT(pointList->getPointList()->v == pointList2->getPointList()->v);
+                DJV_ASSERT(pointList->getPointList()->c == pointList2->getPointList()->c);
+                DJV_ASSERT(pointList->getPointList()->bbox == pointList2->getPointList()->bbox);
+
+                const auto hemisphereLight = std::dynamic_pointer_cast<HemisphereLight>(a->getPrimitives()[1]);
+                const auto hemisphereLight2 = std::dynamic_pointer_cast<HemisphereLight>(b->getPrimitives()[1]);
+                DJV_ASSERT(hemisphereLight2);
+                DJV_ASSERT(hemisphereLight->getIntensity() == hemisphereLight2->getIntensity());
+                DJV_ASSERT(hemisphereLight->getUp() == hemisphereLight2->getUp());
+                DJV_ASSERT(hemisphereLight->getTopColor() == hemisphereLight2->getTopColor());
+                DJV_ASSERT(hemisphereLight->getBottomColor() == hemisphereLight2->getBottomColor());
+                const auto directionalLight = std::dynamic_pointer_cast<DirectionalLight>(a->getPrimitives()[2]);
+                const auto directionalLight2 = std::dynamic_pointer_cast<DirectionalLight>(b->getPrimitives()[2]);
+                DJV_ASSERT(directionalLight2);
+                DJV_ASSERT(directionalLight->isEnabled() == directionalLight2->isEnabled());
+                DJV_ASSERT(directionalLight->getDirection() == directionalLight2->getDirection());
+                const auto pointLight = std::dynamic_pointer_cast<PointLight>(a->getPrimitives()[3]);
+                const auto pointLight2 = std::dynamic_pointer_cast<PointLight>(b->getPrimitives()[3]);
+                DJV_ASSERT(pointLight2);
+                DJV_ASSERT(pointLight->getIntensity() == pointLight2->getIntensity());
+                const auto spotLight = std::dynamic_pointer_cast<SpotLight>(a->getPrimitives()[4]);
+                const auto spotLight2 = std::dynamic_pointer_cast<SpotLight>(b->getPrimitives()[4]);
+                DJV_ASSERT(spotLight2);
+                DJV_ASSERT(spotLight->getConeAngle() == spotLight2->getConeAngle());
+                DJV_ASSERT(spotLight->getDirection() == spotLight2->getDirection());
+
+                const auto& layer = a->getLayers()[0];
+                const auto& layer2 = b->getLayers()[0];
+                DJV_ASSERT(layer->getName() == layer2->getName());
+                DJV_ASSERT(layer->getColor() == layer2->getColor());
+                DJV_ASSERT(material2 == layer2->getMaterial());
+                DJV_ASSERT(2 == layer2->getItems().size());
+                DJV_ASSERT(instance2 == layer2->getItems()[0]);
+                const auto subLayer2 = std::dynamic_pointer_cast<Layer>(layer2->getItems()[1]);
+                DJV_ASSERT(subLayer2);
+                DJV_ASSERT("subLayer" == subLayer2->getName());
+                DJV_ASSERT(!subLayer2->isVisible());
+                DJV_ASSERT(1 == subLayer2->getItems().size());
+                DJV_ASSERT(pointLight2 == subLayer2->getItems()[0]);
+            }
+
+            System::File::Info createSource(const System::File::Path& path)
+            {
+                auto io = System::File::IO::create();
+                io->open(path.get(), System::File::Mode::Write);
+                io->writeU32(0);
+                io->close();
+                return System::File::Info(path);
+            }
+
+        } // namespace
+
+        CacheTest::CacheTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::Scene3DTest::CacheTest", tempPath, context)
+        {}
+
+        void CacheTest::run()
+        {
+            _readWrite();
+            _error();
+            _fallback();
+            _prune();
+        }
+
+        void CacheTest::_readWrite()
+        {
+            const auto sourceInfo = createSource(System::File::Path(getTempPath(), "CacheTest.obj"));
+            const auto path = IO::Cache::getFileName(getTempPath(), sourceInfo);
+            DJV_ASSERT(!IO::Cache::isValid(path, sourceInfo));
+
+            auto scene = createScene();
+            IO::Cache::write(path, sourceInfo, scene);
+            DJV_ASSERT(IO::Cache::isValid(path, sourceInfo));
+            compareScene(scene, IO::Cache::read(path, sourceInfo));
+
+            const auto sourceInfo2 = createSource(System::File::Path(getTempPath(), "CacheTest2.obj"));
+            DJV_ASSERT(!IO::Cache::isValid(path, sourceInfo2));
+            try
+            {
+                IO::Cache::read(path, sourceInfo2);
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(e.what());
+            }
+        }
+
+        void CacheTest::_error()
+        {
+            const auto sourceInfo = createSource(System::File::Path(getTempPath(), "CacheTest3.obj"));
+            const auto path = IO::Cache::getFileName(getTempPath(), sourceInfo);
+            try
+            {
+                IO::Cache::read(path, sourceInfo);
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(e.what());
+            }
+
+            // Truncate the cache at several points past the header so that the
+            // counts and arrays are cut off.
+            IO::Cache::write(path, sourceInfo, createScene());
+            std::vector<uint8_t> data;
+            {
+                auto io = System::File::IO::create();
+                io->open(path.get(), System::File::Mode::Read);
+                data.resize(io->getSize());
+                io->read(data.data(), data.size());
+            }
+            for (const size_t size : { data.size() / 4, data.size() / 2, data.size() - 1 })
+            {
+                {
+                    auto io = System::File::IO::create();
+                    io->open(path.get(), System::File::Mode::Write);
+                    io->write(data.data(), size);
+                }
+                try
+                {
+                    IO::Cache::read(path, sourceInfo);
+                    DJV_ASSERT(false);
+                }
+                catch (const std::exception& e)
+                {
+                    _print(e.what());
+                }
+            }
+        }
+
+        void CacheTest::_fallback()
+        {
+            if (auto context = getContext().lock())
+            {
+                const auto sourceInfo = createSource(System::File::Path(getTempPath(), "CacheTest4.obj"));
+                const auto path = IO::Cache::getFileName(getTempPath(), sourceInfo);
+                auto scene = createScene();
+                IO::Cache::write(path, sourceInfo, scene);
+
+                // Corrupt the cache after the header so that it still
+                // validates but cannot be read.
+                std::vector<uint8_t> data;
+                {
+                    auto io = System::File::IO::create();
+                    io->open(path.get(), System::File::Mode::Read);
+                    data.resize(io->getSize());
+                    io->read(data.data(), data.size());
+                }
+                {
+                    auto io = System::File::IO::create();
+                    io->open(path.get(), System::File::Mode::Write);
+                    io->write(data.data(), data.size() / 2);
+                }
+                DJV_ASSERT(IO::Cache::isValid(path, sourceInfo));
+
+                auto source = SourceRead::create(sourceInfo, scene, context);
+                auto read = IO::Cache::Read::create(
+                    sourceInfo,
+                    path,
+                    source,
+                    true,
+                    IO::Cache::byteMaxDefault,
+                    context->getSystemT<System::TextSystem>(),
+                    context->getSystemT<System::ResourceSystem>(),
+                    context->getSystemT<System::LogSystem>());
+                DJV_ASSERT(scene == read->getScene().get());
+                DJV_ASSERT(1 == source->readCount);
+
+                // The cache should have been rewritten.
+                compareScene(scene, IO::Cache::read(path, sourceInfo));
+                read = IO::Cache::Read::create(
+                    sourceInfo,
+                    path,
+                    source,
+                    true,
+                    IO::Cache::byteMaxDefault,
+                    context->getSystemT<System::TextSystem>(),
+                    context->getSystemT<System::ResourceSystem>(),
+                    context->getSystemT<System::LogSystem>());
+                compareScene(scene, read->getScene().get());
+                DJV_ASSERT(1 == source->readCount);
+            }
+        }
+
+        void CacheTest::_prune()
+        {
+            if (auto context = getContext().lock())
+            {
+                const System::File::Path cachePath(getTempPath(), "CacheTestPrune");
+                if (!System::File::Info(cachePath).doesExist())
+                {
+                    System::File::mkdir(cachePath);
+                }
+                auto scene = createScene();
+                std::vector<System::File::Path> paths;
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    std::stringstream ss;
+                    ss << "CacheTestPrune" << i << ".obj";
+                    const auto sourceInfo = createSource(System::File::Path(getTempPath(), ss.str()));
+                    paths.push_back(IO::Cache::getFileName(cachePath, sourceInfo));
+                    IO::Cache::write(paths.back(), sourceInfo, scene);
+                }
+                System::File::DirectoryListOptions options;
+                options.extensions.insert(IO::Cache::fileExtension);
+                DJV_ASSERT(3 == System::File::directoryList(cachePath, options).size());
+
+                // The cache is under the maximum size.
+                DJV_ASSERT(0 == IO::Cache::prune(cachePath, IO::Cache::byteMaxDefault));
+                DJV_ASSERT(3 == System::File::directoryList(cachePath, options).size());
+
+                // Remove everything except the kept file.
+                DJV_ASSERT(2 == IO::Cache::prune(cachePath, 0, paths[1]));
+                auto list = System::File::directoryList(cachePath, options);
+                DJV_ASSERT(1 == list.size());
+                DJV_ASSERT(paths[1] == list[0].getPath());
+
+                // Scenes written by the reader prune the cache.
+                const auto sourceInfo = createSource(System::File::Path(getTempPath(), "CacheTestPrune3.obj"));
+                const auto path = IO::Cache::getFileName(cachePath, sourceInfo);
+                auto source = SourceRead::create(sourceInfo, scene, context);
+                auto read = IO::Cache::Read::create(
+                    sourceInfo,
+                    path,
+                    source,
+                    false,
+                    0,
+                    context->getSystemT<System::TextSystem>(),
+                    context->getSystemT<System::ResourceSystem>(),
+                    context->getSystemT<System::LogSystem>());
+                DJV_ASSERT(scene == read->getScene().get());
+                list = System::File::directoryList(cachePath, options);
+                DJV_ASSERT(1 == list.size());
+                DJV_ASSERT(path == list[0].getPath());
+                compareScene(scene, IO::Cache::read(path, sourceInfo));
+            }
+        }
+
+    } // namespace Scene3DTest
+} // namespace djv
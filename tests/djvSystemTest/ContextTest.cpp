@@ -10,6 +10,7 @@
 #include <djvCore/String.h>
 
 #include <sstream>
+#include <thread>
 
 using namespace djv::Core;
 using namespace djv::System;
@@ -94,6 +95,22 @@ namespace djv
                     ss << "fps averge: " << context->getFPSAverage();
                     _print(ss.str());
                 }
+
+                DJV_ASSERT(system->getTickDeadline() == Time::TimePoint::max());
+                bool woken = false;
+                context->setWakeCallback(
+                    [&woken]
+                    {
+                        woken = true;
+                    });
+                std::thread thread(
+                    [context]
+                    {
+                        context->wake();
+                    });
+                thread.join();
+                DJV_ASSERT(woken);
+                context->setWakeCallback(nullptr);
             }
         }
         
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvSystemTest/TickHistogramTest.h>
+
+#include <djvSystem/Context.h>
+#include <djvSystem/TickHistogram.h>
+
+using namespace djv::Core;
+using namespace djv::System;
+
+namespace djv
+{
+    namespace SystemTest
+    {
+        TickHistogramTest::TickHistogramTest(
+            const File::Path& tempPath,
+            const std::shared_ptr<Context>& context) :
+            ITickTest("djv::SystemTest::TickHistogramTest", tempPath, context)
+        {}
+        
+        void TickHistogramTest::run()
+        {
+            _histogram();
+            _context();
+        }
+
+        void TickHistogramTest::_histogram()
+        {
+            {
+                const TickHistogram histogram("name");
+                DJV_ASSERT("name" == histogram.getName());
+                DJV_ASSERT(0 == histogram.getCount());
+                DJV_ASSERT(Time::Duration::zero() == histogram.getAverage());
+                DJV_ASSERT(Time::Duration::zero() == histogram.getPercentile(.5F));
+            }
+
+            {
+                DJV_ASSERT(Time::Duration(1) == TickHistogram::getBinMax(0));
+                DJV_ASSERT(Time::Duration(2) == TickHistogram::getBinMax(1));
+                DJV_ASSERT(Time::Duration(1024) == TickHistogram::getBinMax(10));
+            }
+
+            {
+                TickHistogram histogram;
+                for (size_t i = 0; i < 90; ++i)
+                {
+                    histogram.add(Time::Duration(100));
+                }
+                for (size_t i = 0; i < 10; ++i)
+                {
+                    histogram.add(Time::Duration(10000));
+                }
+                DJV_ASSERT(100 == histogram.getCount());
+                DJV_ASSERT(Time::Duration(109000) == histogram.getTotal());
+                DJV_ASSERT(Time::Duration(10000) == histogram.getMax());
+                DJV_ASSERT(Time::Duration(1090) == histogram.getAverage());
+                DJV_ASSERT(Time::Duration(128) == histogram.getPercentile(.5F));
+                DJV_ASSERT(Time::Duration(128) == histogram.getPercentile(.9F));
+                DJV_ASSERT(Time::Duration(10000) == histogram.getPercentile(.95F));
+                DJV_ASSERT(Time::Duration(10000) == histogram.getPercentile(1.F));
+
+                size_t sum = 0;
+                for (const auto i : histogram.getBins())
+                {
+                    sum += i;
+                }
+                DJV_ASSERT(100 == sum);
+                DJV_ASSERT(90 == histogram.getBins()[7]);
+                DJV_ASSERT(10 == histogram.getBins()[14]);
+
+                histogram.clear();
+                DJV_ASSERT(0 == histogram.getCount());
+                DJV_ASSERT(Time::Duration::zero() == histogram.getMax());
+                DJV_ASSERT(0 == histogram.getBins()[7]);
+            }
+
+            {
+                TickHistogram histogram;
+                histogram.add(Time::Duration::zero());
+                histogram.add(Time::Duration(std::chrono::hours(1)));
+                DJV_ASSERT(1 == histogram.getBins().front());
+                DJV_ASSERT(1 == histogram.getBins().back());
+            }
+        }
+
+        void TickHistogramTest::_context()
+        {
+            auto context = getContext().lock();
+            _tickFor(std::chrono::milliseconds(100));
+            const auto systems = context->getSystems();
+            const auto& histograms = context->getSystemTickHistograms();
+            DJV_ASSERT(histograms.size() == systems.size());
+            for (size_t i = 0; i < histograms.size(); ++i)
+            {
+                DJV_ASSERT(histograms[i].getName() == systems[i]->getSystemName());
+                DJV_ASSERT(histograms[i].getCount() > 0);
+            }
+
+            context->clearSystemTickHistograms();
+            for (const auto& i : context->getSystemTickHistograms())
+            {
+                DJV_ASSERT(0 == i.getCount());
+            }
+        }
+
+    } // namespace SystemTest
+} // namespace djv
+
@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvTestLib/TickTest.h>
+
+namespace djv
+{
+    namespace SystemTest
+    {
+        class TickHistogramTest : public Test::ITickTest
+        {
+        public:
+            TickHistogramTest(
+                const System::File::Path& tempPath,
+                const std::shared_ptr<System::Context>&);
+            
+            void run() override;
+            
+        private:
+            void _histogram();
+            void _context();
+        };
+        
+    } // namespace SystemTest
+} // namespace djv
+
@@ -63,6 +63,22 @@ namespace djv
                 timer->stop();
                 DJV_ASSERT(!timer->isActive());
             }
+
+            if (auto context = getContext().lock())
+            {
+                auto timerSystem = context->getSystemT<TimerSystem>();
+                const auto now = std::chrono::steady_clock::now();
+                auto timer = Timer::create(context);
+                timer->start(
+                    std::chrono::milliseconds(250),
+                    [](const std::chrono::steady_clock::time_point&, const Time::Duration&)
+                    {});
+                const auto deadline = timerSystem->getNextDeadline();
+                DJV_ASSERT(deadline >= now + std::chrono::milliseconds(250));
+                DJV_ASSERT(deadline <= std::chrono::steady_clock::now() + std::chrono::milliseconds(250));
+                DJV_ASSERT(timerSystem->getTickDeadline() == deadline);
+                DJV_ASSERT(context->getTickDeadline() <= deadline);
+            }
         }
         
     } // namespace SystemTest
@@ -52,15 +52,19 @@
 #include <djvSystemTest/PathTest.h>
 #include <djvSystemTest/RecentFilesModelTest.h>
 #include <djvSystemTest/TextSystemTest.h>
+#include <djvSystemTest/TickHistogramTest.h>
 #include <djvSystemTest/TimerFuncTest.h>
 #include <djvSystemTest/TimerTest.h>
 
 #include <djvImageTest/ColorFuncTest.h>
 #include <djvImageTest/ColorTest.h>
 #include <djvImageTest/DataFuncTest.h>
+#include <djvImageTest/DataPoolTest.h>
 #include <djvImageTest/DataTest.h>
 #include <djvImageTest/InfoFuncTest.h>
 #include <djvImageTest/InfoTest.h>
+#include <djvImageTest/ParallelTest.h>
+#include <djvImageTest/StatisticsTest.h>
 #include <djvImageTest/TagsTest.h>
 #include <djvImageTest/TypeFuncTest.h>
 #include <djvImageTest/TypeTest.h>
@@ -73,7 +77,9 @@
 #include <djvAudioTest/TypeFuncTest.h>
 #include <djvAudioTest/TypeTest.h>
 
+#include <djvGeomTest/BVHTest.h>
 #include <djvGeomTest/ShapeTest.h>
+#include <djvGeomTest/SimplifyTest.h>
 #include <djvGeomTest/TriangleMeshFuncTest.h>
 #include <djvGeomTest/TriangleMeshTest.h>
 
@@ -89,6 +95,7 @@
 #include <djvGLTest/TextureTest.h>
 #include <djvGLTest/TextureAtlasTest.h>
 
+#include <djvOCIOTest/CPUProcessorTest.h>
 #include <djvOCIOTest/OCIOSystemFuncTest.h>
 #include <djvOCIOTest/OCIOSystemTest.h>
 #include <djvOCIOTest/OCIOTest.h>
@@ -96,7 +103,9 @@
 #include <djvRender2DTest/DataFuncTest.h>
 #include <djvRender2DTest/DataTest.h>
 #include <djvRender2DTest/EnumFuncTest.h>
+#include <djvRender2DTest/FontCacheTest.h>
 #include <djvRender2DTest/FontSystemTest.h>
+#include <djvRender2DTest/ImageSamplerTest.h>
 #include <djvRender2DTest/RenderSystemTest.h>
 #include <djvRender2DTest/RenderTest.h>
 
@@ -105,11 +114,14 @@
 #include <djvRender3DTest/MaterialTest.h>
 #include <djvRender3DTest/RenderTest.h>
 
+#include <djvScene3DTest/CacheTest.h>
+
 #include <djvAVTest/AVSystemTest.h>
 #include <djvAVTest/CineonFuncTest.h>
 #include <djvAVTest/DPXFuncTest.h>
 #include <djvAVTest/IOTest.h>
 #include <djvAVTest/PPMFuncTest.h>
+#include <djvAVTest/RLEReadTest.h>
 #include <djvAVTest/SpeedFuncTest.h>
 #include <djvAVTest/ThumbnailSystemTest.h>
 #include <djvAVTest/TimeFuncTest.h>
@@ -220,15 +232,19 @@ int main(int argc, char ** argv)
         tests.emplace_back(new SystemTest::PathTest(tempPath, context));
         tests.emplace_back(new SystemTest::RecentFilesModelTest(tempPath, context));
         tests.emplace_back(new SystemTest::TextSystemTest(tempPath, context));
+        tests.emplace_back(new SystemTest::TickHistogramTest(tempPath, context));
         tests.emplace_back(new SystemTest::TimerFuncTest(tempPath, context));
         tests.emplace_back(new SystemTest::TimerTest(tempPath, context));
 
         tests.emplace_back(new ImageTest::ColorFuncTest(tempPath, context));
         tests.emplace_back(new ImageTest::ColorTest(tempPath, context));
         tests.emplace_back(new ImageTest::DataFuncTest(tempPath, context));
+        tests.emplace_back(new ImageTest::DataPoolTest(tempPath, context));
         tests.emplace_back(new ImageTest::DataTest(tempPath, context));
         tests.emplace_back(new ImageTest::InfoTest(tempPath, context));
         tests.emplace_back(new ImageTest::InfoFuncTest(tempPath, context));
+        tests.emplace_back(new ImageTest::ParallelTest(tempPath, context));
+        tests.emplace_back(new ImageTest::StatisticsTest(tempPath, context));
         tests.emplace_back(new ImageTest::TypeFuncTest(tempPath, context));
         tests.emplace_back(new ImageTest::TypeTest(tempPath, context));
         tests.emplace_back(new ImageTest::TagsTest(tempPath, context));
@@ -241,7 +257,9 @@ int main(int argc, char ** argv)
         tests.emplace_back(new AudioTest::TypeFuncTest(tempPath, context));
         tests.emplace_back(new AudioTest::TypeTest(tempPath, context));
 
+        tests.emplace_back(new GeomTest::BVHTest(tempPath, context));
         tests.emplace_back(new GeomTest::ShapeTest(tempPath, context));
+        tests.emplace_back(new GeomTest::SimplifyTest(tempPath, context));
         tests.emplace_back(new GeomTest::TriangleMeshFuncTest(tempPath, context));
         tests.emplace_back(new GeomTest::TriangleMeshTest(tempPath, context));
 
@@ -257,6 +275,7 @@ int main(int argc, char ** argv)
         tests.emplace_back(new GLTest::TextureFuncTest(tempPath, context));
         tests.emplace_back(new GLTest::TextureTest(tempPath, context));
 
+        tests.emplace_back(new OCIOTest::CPUProcessorTest(tempPath, context));
         tests.emplace_back(new OCIOTest::OCIOSystemFuncTest(tempPath, context));
         tests.emplace_back(new OCIOTest::OCIOSystemTest(tempPath, context));
         tests.emplace_back(new OCIOTest::OCIOTest(tempPath, context));
@@ -264,7 +283,9 @@ int main(int argc, char ** argv)
         tests.emplace_back(new Render2DTest::DataFuncTest(tempPath, context));
         tests.emplace_back(new Render2DTest::DataTest(tempPath, context));
         tests.emplace_back(new Render2DTest::EnumFuncTest(tempPath, context));
+        tests.emplace_back(new Render2DTest::FontCacheTest(tempPath, context));
         tests.emplace_back(new Render2DTest::FontSystemTest(tempPath, context));
+        tests.emplace_back(new Render2DTest::ImageSamplerTest(tempPath, context));
         tests.emplace_back(new Render2DTest::RenderSystemTest(tempPath, context));
         tests.emplace_back(new Render2DTest::RenderTest(tempPath, context));
 
@@ -273,11 +294,14 @@ int main(int argc, char ** argv)
         tests.emplace_back(new Render3DTest::MaterialTest(tempPath, context));
         tests.emplace_back(new Render3DTest::RenderTest(tempPath, context));
 
+        tests.emplace_back(new Scene3DTest::CacheTest(tempPath, context));
+
         tests.emplace_back(new AVTest::AVSystemTest(tempPath, context));
         tests.emplace_back(new AVTest::CineonFuncTest(tempPath, context));
         tests.emplace_back(new AVTest::DPXFuncTest(tempPath, context));
         tests.emplace_back(new AVTest::IOTest(tempPath, context));
         tests.emplace_back(new AVTest::PPMFuncTest(tempPath, context));
+        tests.emplace_back(new AVTest::RLEReadTest(tempPath, context));
         tests.emplace_back(new AVTest::SpeedFuncTest(tempPath, context));
         tests.emplace_back(new AVTest::ThumbnailSystemTest(tempPath, context));
         tests.emplace_back(new AVTest::TimeFuncTest(tempPath, context));
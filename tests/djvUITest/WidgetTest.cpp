@@ -171,6 +171,37 @@ namespace djv
             size_t _tick = 0;
             System::Event::PointerInfo _pointerInfo;
         };
+
+        //! This class provides a widget that counts its layout events and
+        //! resizes its children to fill it.
+        class LayoutCountWidget : public Widget
+        {
+            DJV_NON_COPYABLE(LayoutCountWidget);
+
+        protected:
+            LayoutCountWidget()
+            {}
+
+        public:
+            static std::shared_ptr<LayoutCountWidget> create(const std::shared_ptr<System::Context>& context)
+            {
+                auto out = std::shared_ptr<LayoutCountWidget>(new LayoutCountWidget);
+                out->_init(context);
+                return out;
+            }
+
+            size_t layoutCount = 0;
+
+        protected:
+            void _layoutEvent(System::Event::Layout&) override
+            {
+                ++layoutCount;
+                for (const auto& i : getChildWidgets())
+                {
+                    i->setGeometry(getGeometry());
+                }
+            }
+        };
         
         WidgetTest::WidgetTest(
             const System::File::Path& tempPath,
@@ -240,6 +271,25 @@ namespace djv
                     
                 window->close();
             }
+
+            if (auto context = getContext().lock())
+            {
+                // Resizing a child while laying out its parent should not lay
+                // out the parent again.
+                auto outer = LayoutCountWidget::create(context);
+                auto inner = LayoutCountWidget::create(context);
+                outer->addChild(inner);
+                auto window = Window::create(context);
+                window->addChild(outer);
+                window->show();
+
+                _tickFor(std::chrono::milliseconds(100));
+
+                DJV_ASSERT(inner->layoutCount > 0);
+                DJV_ASSERT(outer->layoutCount == inner->layoutCount);
+
+                window->close();
+            }
         }
 
     } // namespace UITest